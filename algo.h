@@ -2,10 +2,12 @@
 #define MYTINYSTL_ALGO_H
 
 #include <cstddef>
+#include <cstdint>
 #include <ctime>
 #include <functional>
 
 #include "algobase.h"
+#include "heap_algo.h"
 #include "memory.h"
 #include "functional.h"
 
@@ -99,6 +101,34 @@ count_if(InputIter first, InputIter last, UnaryPredicate pred) {
     return n;
 }
 
+// 普通迭代器：逐个比较
+template <class InputIter, class T>
+InputIter find_segments(InputIter first, InputIter last, const T& value, m_false_type) {
+    while (first != last && *first != value)
+        ++first;
+    return first;
+}
+
+// 分段迭代器：逐块在指针区间内查找，找到后还原为原迭代器
+template <class InputIter, class T>
+InputIter find_segments(InputIter first, InputIter last, const T& value, m_true_type) {
+    typedef segmented_iterator_traits<InputIter> traits;
+    auto seg = traits::segment(first);
+    const auto last_seg = traits::segment(last);
+    if (seg == last_seg) {
+        auto p = find_segments(traits::local(first), traits::local(last), value, m_false_type());
+        return p == traits::local(last) ? last : traits::compose(seg, p);
+    }
+    auto p = find_segments(traits::local(first), traits::end(seg), value, m_false_type());
+    if (p != traits::end(seg)) return traits::compose(seg, p);
+    for (++seg; seg != last_seg; ++seg) {
+        p = find_segments(traits::begin(seg), traits::end(seg), value, m_false_type());
+        if (p != traits::end(seg)) return traits::compose(seg, p);
+    }
+    p = find_segments(traits::begin(last_seg), traits::local(last), value, m_false_type());
+    return p == traits::local(last) ? last : traits::compose(last_seg, p);
+}
+
 /**
  * @brief 在[first, last)区间内找到等于 value 的元素，返回指向该元素的迭代器
  * @param first 起始迭代器
@@ -108,9 +138,8 @@ count_if(InputIter first, InputIter last, UnaryPredicate pred) {
  */
 template <class InputIter, class T>
 InputIter find(InputIter first, InputIter last, const T& value) {
-    while (first != last && *first != value)
-        ++first;
-    return first;
+    return mystl::find_segments(first, last, value,
+        m_bool_constant<segmented_iterator_traits<InputIter>::is_segmented>());
 }
 
 /**
@@ -213,6 +242,31 @@ ForwardIter search_n(ForwardIter first, ForwardIter last, Size count, const T& v
     }
 }
 
+// 普通迭代器：逐个调用 f
+template <class InputIter, class Function>
+Function for_each_segments(InputIter first, InputIter last, Function f, m_false_type) {
+    for (; first != last; ++first) {
+        f(*first);
+    }
+    return f;
+}
+
+// 分段迭代器：逐块对指针区间调用 f
+template <class InputIter, class Function>
+Function for_each_segments(InputIter first, InputIter last, Function f, m_true_type) {
+    typedef segmented_iterator_traits<InputIter> traits;
+    auto seg = traits::segment(first);
+    const auto last_seg = traits::segment(last);
+    if (seg == last_seg) {
+        return for_each_segments(traits::local(first), traits::local(last), mystl::move(f), m_false_type());
+    }
+    f = for_each_segments(traits::local(first), traits::end(seg), mystl::move(f), m_false_type());
+    for (++seg; seg != last_seg; ++seg) {
+        f = for_each_segments(traits::begin(seg), traits::end(seg), mystl::move(f), m_false_type());
+    }
+    return for_each_segments(traits::begin(last_seg), traits::local(last), mystl::move(f), m_false_type());
+}
+
 /**
  * @brief 使用函数对象 f 对[first, last)区间内的每个元素执行一个 operator() 操作
  * @param first 起始迭代器
@@ -222,10 +276,8 @@ ForwardIter search_n(ForwardIter first, ForwardIter last, Size count, const T& v
  */
 template <class InputIter, class Function>
 Function for_each(InputIter first, InputIter last, Function f) {
-    for (; first != last; ++first) {
-        f(*first);
-    }
-    return f;
+    return mystl::for_each_segments(first, last, mystl::move(f),
+        m_bool_constant<segmented_iterator_traits<InputIter>::is_segmented>());
 }
 
 /**
@@ -295,13 +347,13 @@ ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value) {
  */
 template <class ForwardIter, class T, class Compared>
 ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value, Compared comp) {
-    auto len = distance(first, last);
+    auto len = mystl::distance(first, last);
     auto half = len;
     ForwardIter middle;
     while (len > 0) {
         half = len >> 1;
         middle = first;
-        advance(middle, half);
+        mystl::advance(middle, half);
         if (comp(*middle, value)) {
             first = middle;
             ++first;
@@ -335,13 +387,13 @@ ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& value) {
  */
 template <class ForwardIter, class T, class Compared>
 ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& value, Compared comp) {
-    auto len = distance(first, last);
+    auto len = mystl::distance(first, last);
     auto half = len;
     ForwardIter middle;
     while (len > 0) {
         half = len >> 1;
         middle = first;
-        advance(middle, half);
+        mystl::advance(middle, half);
         if (comp(value, *middle)) {
             len = half;
         } else {
@@ -707,40 +759,226 @@ bool is_partitioned(ForwardIter first, ForwardIter last, UnaryPredicate pred) {
 // 排序算法
 // ============================================================================
 
+// 小区间阈值：长度不超过该值的区间不再划分，留给最后的插入排序统一处理
+constexpr size_t kSmallSectionSize = 16;
+
+// 九数取中阈值：区间长度超过该值时用 Tukey ninther 代替三数取中
+constexpr size_t kNintherThreshold = 128;
+
 /**
- * @brief 对[first, last)区间内的元素进行排序，使用给定的比较函数
+ * @brief 计算 floor(log2(n))，用于控制内省排序的递归深度
+ * @param n 区间长度，要求 n > 0
+ * @return floor(log2(n))
+ */
+template <class Size>
+Size slg2(Size n) {
+    Size k = 0;
+    for (; n > 1; n >>= 1) {
+        ++k;
+    }
+    return k;
+}
+
+/**
+ * @brief 返回 a、b、c 三个位置中值居中的那个迭代器（不移动元素）
+ * @param a 第一个候选位置
+ * @param b 第二个候选位置
+ * @param c 第三个候选位置
+ * @param comp 比较函数
+ * @return 指向中位数的迭代器
+ */
+template <class RandomIter, class Compared>
+RandomIter median_of_three(RandomIter a, RandomIter b, RandomIter c, Compared comp) {
+    if (comp(*a, *b)) {
+        if (comp(*b, *c)) return b;      // a < b < c
+        if (comp(*a, *c)) return c;      // a < c <= b
+        return a;                        // c <= a < b
+    }
+    if (comp(*a, *c)) return a;          // b <= a < c
+    if (comp(*b, *c)) return c;          // b < c <= a
+    return b;                            // c <= b <= a
+}
+
+/**
+ * @brief 无边界检查的分割：以 *pivot 为枢轴，把 [first, last) 分成两段
  * @param first 起始迭代器
  * @param last 结束迭代器
+ * @param pivot 指向枢轴的迭代器，位于 [first, last) 之外（紧邻 first 之前）
  * @param comp 比较函数
+ * @return 分割点，左段元素都不大于枢轴，右段元素都不小于枢轴
+ *
+ * 调用者保证区间内至少有一个不小于枢轴的元素，右侧扫描则以枢轴自身为哨兵，
+ * 因此两个内层循环都不需要检查越界。
  */
 template <class RandomIter, class Compared>
-void sort(RandomIter first, RandomIter last, Compared comp) {
+RandomIter unguarded_partition(RandomIter first, RandomIter last, RandomIter pivot, Compared comp) {
+    while (true) {
+        while (comp(*first, *pivot)) {
+            ++first;
+        }
+        --last;
+        while (comp(*pivot, *last)) {
+            --last;
+        }
+        if (!(first < last)) {
+            return first;
+        }
+        mystl::iter_swap(first, last);
+        ++first;
+    }
+}
+
+/**
+ * @brief 选取枢轴并分割 [first, last)
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @return 分割点
+ *
+ * 短区间使用三数取中，长区间使用九数取中（三组三数取中后再取中），
+ * 选出的枢轴被换到 first 处，对有序、逆序、管风琴等输入都能得到均衡的划分。
+ */
+template <class RandomIter, class Compared>
+RandomIter unguarded_partition_pivot(RandomIter first, RandomIter last, Compared comp) {
+    auto len = last - first;
+    auto mid = first + len / 2;
+    RandomIter pivot;
+    if (static_cast<size_t>(len) > kNintherThreshold) {
+        auto step = len / 8;
+        auto m1 = mystl::median_of_three(first + 1, first + 1 + step, first + 1 + 2 * step, comp);
+        auto m2 = mystl::median_of_three(mid - step, mid, mid + step, comp);
+        auto m3 = mystl::median_of_three(last - 1 - 2 * step, last - 1 - step, last - 1, comp);
+        pivot = mystl::median_of_three(m1, m2, m3, comp);
+    } else {
+        pivot = mystl::median_of_three(first + 1, mid, last - 1, comp);
+    }
+    mystl::iter_swap(first, pivot);
+    return mystl::unguarded_partition(first + 1, last, first, comp);
+}
+
+/**
+ * @brief 无边界检查的线性插入：把 *last 向左移动到合适位置
+ * @param last 待插入元素的位置
+ * @param comp 比较函数
+ *
+ * 调用者保证 last 左侧存在不大于 *last 的元素作为哨兵。
+ */
+template <class RandomIter, class Compared>
+void unguarded_linear_insert(RandomIter last, Compared comp) {
+    auto value = mystl::move(*last);
+    auto next = last;
+    --next;
+    while (comp(value, *next)) {
+        *last = mystl::move(*next);
+        last = next;
+        --next;
+    }
+    *last = mystl::move(value);
+}
+
+/**
+ * @brief 插入排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template <class RandomIter, class Compared>
+void insertion_sort(RandomIter first, RandomIter last, Compared comp) {
     if (first == last) {
         return;
     }
-    
-    // 简单的快速排序实现
-    auto pivot = first;
-    auto i = first + 1;
-    auto j = last - 1;
-    
-    while (i <= j) {
-        while (i <= j && comp(*i, *pivot)) {
-            ++i;
+    for (auto i = first + 1; i != last; ++i) {
+        if (comp(*i, *first)) {
+            // 比首元素还小，整体后移一位后放到最前面
+            auto value = mystl::move(*i);
+            mystl::move_backward(first, i, i + 1);
+            *first = mystl::move(value);
+        } else {
+            mystl::unguarded_linear_insert(i, comp);
         }
-        while (i <= j && comp(*pivot, *j)) {
-            --j;
+    }
+}
+
+/**
+ * @brief 无边界检查的插入排序，要求 first 左侧已有不大于区间内任何元素的哨兵
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template <class RandomIter, class Compared>
+void unguarded_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+    for (auto i = first; i != last; ++i) {
+        mystl::unguarded_linear_insert(i, comp);
+    }
+}
+
+/**
+ * @brief 内省排序收尾：对“分段有序”的区间做一次整体插入排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ *
+ * intro_sort 结束后每个元素距离最终位置不超过 kSmallSectionSize，
+ * 前 kSmallSectionSize 个元素做有边界检查的插入排序后即可作为后续元素的哨兵。
+ */
+template <class RandomIter, class Compared>
+void final_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+    if (static_cast<size_t>(last - first) > kSmallSectionSize) {
+        mystl::insertion_sort(first, first + kSmallSectionSize, comp);
+        mystl::unguarded_insertion_sort(first + kSmallSectionSize, last, comp);
+    } else {
+        mystl::insertion_sort(first, last, comp);
+    }
+}
+
+/**
+ * @brief 内省排序主循环
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param depth_limit 剩余允许的划分深度，耗尽后改用堆排序
+ * @param comp 比较函数
+ *
+ * 每次划分后只对较短的一段递归，较长的一段在循环中继续处理，
+ * 因此递归深度不超过 O(log n)；划分次数超过 depth_limit 时切换为堆排序，
+ * 保证最坏 O(n log n)。
+ */
+template <class RandomIter, class Size, class Compared>
+void intro_sort(RandomIter first, RandomIter last, Size depth_limit, Compared comp) {
+    while (static_cast<size_t>(last - first) > kSmallSectionSize) {
+        if (depth_limit == 0) {
+            // 划分过深，说明枢轴选择持续失败，改用堆排序
+            mystl::make_heap(first, last, comp);
+            mystl::sort_heap(first, last, comp);
+            return;
         }
-        if (i <= j) {
-            mystl::iter_swap(i, j);
-            ++i;
-            --j;
+        --depth_limit;
+        auto cut = mystl::unguarded_partition_pivot(first, last, comp);
+        if (cut - first < last - cut) {
+            mystl::intro_sort(first, cut, depth_limit, comp);
+            first = cut;
+        } else {
+            mystl::intro_sort(cut, last, depth_limit, comp);
+            last = cut;
         }
     }
-    
-    mystl::iter_swap(pivot, j);
-    mystl::sort(first, j, comp);
-    mystl::sort(j + 1, last, comp);
+}
+
+/**
+ * @brief 对[first, last)区间内的元素进行排序，使用给定的比较函数
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ *
+ * 内省排序：三数/九数取中的快速排序 + 深度超限时的堆排序 + 最终插入排序，
+ * 最坏时间复杂度 O(n log n)，递归深度 O(log n)。
+ */
+template <class RandomIter, class Compared>
+void sort(RandomIter first, RandomIter last, Compared comp) {
+    if (last - first < 2) {
+        return;
+    }
+    mystl::intro_sort(first, last, mystl::slg2(last - first) * 2, comp);
+    mystl::final_insertion_sort(first, last, comp);
 }
 
 /**
@@ -753,33 +991,457 @@ void sort(RandomIter first, RandomIter last) {
     mystl::sort(first, last, less<typename iterator_traits<RandomIter>::value_type>());
 }
 
+// ============================================================================
+// 模式消除快速排序（pdqsort）
+// ============================================================================
+
+// 长度小于该值的区间直接插入排序
+constexpr size_t kPdqInsertionSortThreshold = 24;
+
+// 区间长度超过该值时使用九数取中
+constexpr size_t kPdqNintherThreshold = 128;
+
+// 对“看起来已分割好”的区间尝试插入排序时，允许的最大元素移动次数
+constexpr size_t kPdqPartialInsertionSortLimit = 8;
+
+// 无分支分割时每个偏移块的元素个数，偏移量用 unsigned char 保存，不能超过 255
+constexpr size_t kPdqBlockSize = 64;
+
+// 偏移缓冲区按缓存行对齐
+constexpr size_t kPdqCachelineSize = 64;
+
 /**
- * @brief 对[first, last)区间内的元素进行稳定排序，使用给定的比较函数
+ * @brief 判断是否可以使用无分支分割
+ * @tparam T 元素类型
+ * @tparam Compared 比较函数类型
+ *
+ * 只有算术类型配合默认比较器时，比较本身足够廉价且没有副作用，
+ * 把比较结果当作整数累加（而不是分支跳转）才有收益。
+ */
+template <class T, class Compared>
+struct is_pdq_branchless : m_bool_constant<
+    std::is_arithmetic<T>::value &&
+    (std::is_same<Compared, mystl::less<T>>::value ||
+     std::is_same<Compared, mystl::greater<T>>::value ||
+     std::is_same<Compared, std::less<T>>::value ||
+     std::is_same<Compared, std::greater<T>>::value)> {};
+
+/**
+ * @brief 若 *b < *a 则交换两者
+ */
+template <class RandomIter, class Compared>
+void pdq_sort2(RandomIter a, RandomIter b, Compared comp) {
+    if (comp(*b, *a)) {
+        mystl::iter_swap(a, b);
+    }
+}
+
+/**
+ * @brief 对三个位置上的元素排序
+ */
+template <class RandomIter, class Compared>
+void pdq_sort3(RandomIter a, RandomIter b, RandomIter c, Compared comp) {
+    mystl::pdq_sort2(a, b, comp);
+    mystl::pdq_sort2(b, c, comp);
+    mystl::pdq_sort2(a, b, comp);
+}
+
+/**
+ * @brief 有移动次数上限的插入排序
  * @param first 起始迭代器
  * @param last 结束迭代器
  * @param comp 比较函数
+ * @return 若在移动次数上限内完成排序返回 true，否则中途放弃并返回 false
+ *
+ * 用于识别几乎有序的输入：放弃时区间仍是原元素的一个排列，可以继续快速排序。
  */
 template <class RandomIter, class Compared>
-void stable_sort(RandomIter first, RandomIter last, Compared comp) {
+bool pdq_partial_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
     if (first == last) {
+        return true;
+    }
+    size_t moves = 0;
+    for (auto cur = first + 1; cur != last; ++cur) {
+        auto sift = cur;
+        auto sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            auto value = mystl::move(*sift);
+            do {
+                *sift = mystl::move(*sift_1);
+                --sift;
+            } while (sift != first && comp(value, *--sift_1));
+            *sift = mystl::move(value);
+            moves += static_cast<size_t>(cur - sift);
+        }
+        if (moves > kPdqPartialInsertionSortLimit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 把与枢轴相等的元素放在左段的分割（处理大量重复元素）
+ * @param first 起始迭代器，*first 为枢轴
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @return 枢轴的最终位置，左侧元素都不大于枢轴，右侧元素都大于枢轴
+ *
+ * 仅在枢轴等于前一次分割的枢轴时调用：此时左段全部与枢轴相等，无需再排序。
+ */
+template <class RandomIter, class Compared>
+RandomIter pdq_partition_left(RandomIter first, RandomIter last, Compared comp) {
+    auto pivot = mystl::move(*first);
+    auto l = first;
+    auto r = last;
+    while (comp(pivot, *--r)) {}
+    if (r + 1 == last) {
+        while (l < r && !comp(pivot, *++l)) {}
+    } else {
+        while (!comp(pivot, *++l)) {}
+    }
+    while (l < r) {
+        mystl::iter_swap(l, r);
+        while (comp(pivot, *--r)) {}
+        while (!comp(pivot, *++l)) {}
+    }
+    *first = mystl::move(*r);
+    *r = mystl::move(pivot);
+    return r;
+}
+
+/**
+ * @brief 常规（有分支）分割，把与枢轴相等的元素放在右段
+ * @param first 起始迭代器，*first 为枢轴
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @return pair(枢轴的最终位置, 区间是否原本就已按枢轴分割好)
+ */
+template <class RandomIter, class Compared>
+mystl::pair<RandomIter, bool> pdq_partition_right(RandomIter first, RandomIter last, Compared comp) {
+    auto pivot = mystl::move(*first);
+    auto l = first;
+    auto r = last;
+    // 找到第一个不小于枢轴的元素；九数取中保证它存在
+    while (comp(*++l, pivot)) {}
+    // 找到最后一个小于枢轴的元素；若 l 没有移动过，需要防止越过 l
+    if (l - 1 == first) {
+        while (l < r && !comp(*--r, pivot)) {}
+    } else {
+        while (!comp(*--r, pivot)) {}
+    }
+    bool already_partitioned = l >= r;
+    while (l < r) {
+        mystl::iter_swap(l, r);
+        while (comp(*++l, pivot)) {}
+        while (!comp(*--r, pivot)) {}
+    }
+    auto pivot_pos = l - 1;
+    *first = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return mystl::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+/**
+ * @brief 按偏移表成对交换左右两侧放错位置的元素
+ * @param first 左侧偏移基准
+ * @param last 右侧偏移基准
+ * @param offsets_l 左侧偏移表
+ * @param offsets_r 右侧偏移表
+ * @param num 交换对数
+ * @param use_swaps 左右待交换个数相等时逐对交换，否则用循环移位减少一半写入
+ */
+template <class RandomIter>
+void pdq_swap_offsets(RandomIter first, RandomIter last,
+                      unsigned char* offsets_l, unsigned char* offsets_r,
+                      size_t num, bool use_swaps) {
+    if (use_swaps) {
+        for (size_t i = 0; i < num; ++i) {
+            mystl::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+    } else if (num > 0) {
+        auto l = first + offsets_l[0];
+        auto r = last - offsets_r[0];
+        auto tmp = mystl::move(*l);
+        *l = mystl::move(*r);
+        for (size_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = mystl::move(*l);
+            r = last - offsets_r[i];
+            *l = mystl::move(*r);
+        }
+        *r = mystl::move(tmp);
+    }
+}
+
+/**
+ * @brief 无分支块分割（BlockQuicksort），与 pdq_partition_right 语义相同
+ * @param first 起始迭代器，*first 为枢轴
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @return pair(枢轴的最终位置, 区间是否原本就已按枢轴分割好)
+ *
+ * 先在左右两端各扫描一个块，把比较结果当作 0/1 累加到偏移表的写入位置上
+ * （与 set_algo_branchless.h 中 first1 += !less 的做法相同），
+ * 扫描循环中没有依赖数据的分支；随后按偏移表批量交换放错一侧的元素。
+ */
+template <class RandomIter, class Compared>
+mystl::pair<RandomIter, bool> pdq_partition_right_branchless(RandomIter first, RandomIter last,
+                                                             Compared comp) {
+    auto pivot = mystl::move(*first);
+    auto l = first;
+    auto r = last;
+    while (comp(*++l, pivot)) {}
+    if (l - 1 == first) {
+        while (l < r && !comp(*--r, pivot)) {}
+    } else {
+        while (!comp(*--r, pivot)) {}
+    }
+    bool already_partitioned = l >= r;
+    if (!already_partitioned) {
+        mystl::iter_swap(l, r);
+        ++l;
+
+        unsigned char offsets_l_storage[kPdqBlockSize + kPdqCachelineSize];
+        unsigned char offsets_r_storage[kPdqBlockSize + kPdqCachelineSize];
+        unsigned char* offsets_l = reinterpret_cast<unsigned char*>(
+            (reinterpret_cast<uintptr_t>(offsets_l_storage) + kPdqCachelineSize - 1) &
+            ~static_cast<uintptr_t>(kPdqCachelineSize - 1));
+        unsigned char* offsets_r = reinterpret_cast<unsigned char*>(
+            (reinterpret_cast<uintptr_t>(offsets_r_storage) + kPdqCachelineSize - 1) &
+            ~static_cast<uintptr_t>(kPdqCachelineSize - 1));
+
+        auto offsets_l_base = l;
+        auto offsets_r_base = r;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (l < r) {
+            // 决定本轮左右两端各扫描多少个元素：只补充已经用空的那一侧
+            size_t num_unknown = static_cast<size_t>(r - l);
+            size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+            // 左侧：记录不小于枢轴（应去右侧）的元素偏移
+            if (left_split >= kPdqBlockSize) {
+                for (size_t i = 0; i < kPdqBlockSize;) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                }
+            } else {
+                for (size_t i = 0; i < left_split;) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*l, pivot); ++l;
+                }
+            }
+
+            // 右侧：记录小于枢轴（应去左侧）的元素偏移
+            if (right_split >= kPdqBlockSize) {
+                for (size_t i = 0; i < kPdqBlockSize;) {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                }
+            } else {
+                for (size_t i = 0; i < right_split;) {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--r, pivot);
+                }
+            }
+
+            // 成对交换，然后丢弃已处理完的偏移块
+            size_t num = mystl::min(num_l, num_r);
+            mystl::pdq_swap_offsets(offsets_l_base, offsets_r_base,
+                                    offsets_l + start_l, offsets_r + start_r,
+                                    num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = l;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = r;
+            }
+        }
+
+        // 此时 [l, r) 已经为空，把一侧剩余的错位元素换到分割点附近
+        if (num_l) {
+            offsets_l += start_l;
+            while (num_l--) {
+                mystl::iter_swap(offsets_l_base + offsets_l[num_l], --r);
+            }
+            l = r;
+        }
+        if (num_r) {
+            offsets_r += start_r;
+            while (num_r--) {
+                mystl::iter_swap(offsets_r_base - offsets_r[num_r], l);
+                ++l;
+            }
+            r = l;
+        }
+    }
+
+    auto pivot_pos = l - 1;
+    *first = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return mystl::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+/**
+ * @brief 按是否可用无分支分割派发
+ */
+template <class RandomIter, class Compared>
+mystl::pair<RandomIter, bool> pdq_partition_right_dispatch(RandomIter first, RandomIter last,
+                                                           Compared comp, m_true_type) {
+    return mystl::pdq_partition_right_branchless(first, last, comp);
+}
+
+template <class RandomIter, class Compared>
+mystl::pair<RandomIter, bool> pdq_partition_right_dispatch(RandomIter first, RandomIter last,
+                                                           Compared comp, m_false_type) {
+    return mystl::pdq_partition_right(first, last, comp);
+}
+
+/**
+ * @brief pdqsort 主循环
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @param bad_allowed 还允许出现的严重不均衡划分次数，耗尽后改用堆排序
+ * @param leftmost 当前区间是否位于整个序列最左端（左侧没有可作哨兵的元素）
+ * @param branchless 是否使用无分支块分割
+ */
+template <class RandomIter, class Compared, class Branchless>
+void pdq_sort_loop(RandomIter first, RandomIter last, Compared comp,
+                   int bad_allowed, bool leftmost, Branchless branchless) {
+    typedef typename iterator_traits<RandomIter>::difference_type diff_t;
+    while (true) {
+        diff_t size = last - first;
+
+        if (size < static_cast<diff_t>(kPdqInsertionSortThreshold)) {
+            if (leftmost) {
+                mystl::insertion_sort(first, last, comp);
+            } else {
+                mystl::unguarded_insertion_sort(first, last, comp);
+            }
+            return;
+        }
+
+        // 选取枢轴并放到 first 处
+        diff_t s2 = size / 2;
+        if (size > static_cast<diff_t>(kPdqNintherThreshold)) {
+            mystl::pdq_sort3(first, first + s2, last - 1, comp);
+            mystl::pdq_sort3(first + 1, first + (s2 - 1), last - 2, comp);
+            mystl::pdq_sort3(first + 2, first + (s2 + 1), last - 3, comp);
+            mystl::pdq_sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+            mystl::iter_swap(first, first + s2);
+        } else {
+            mystl::pdq_sort3(first + s2, first, last - 1, comp);
+        }
+
+        // *(first - 1) 是上一次划分的枢轴，区间内没有比它更小的元素；
+        // 若新枢轴与它相等，把相等元素全部归到左段，左段无需再排序
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            first = mystl::pdq_partition_left(first, last, comp) + 1;
+            continue;
+        }
+
+        auto part = mystl::pdq_partition_right_dispatch(first, last, comp, branchless);
+        auto pivot_pos = part.first;
+        bool already_partitioned = part.second;
+
+        diff_t l_size = pivot_pos - first;
+        diff_t r_size = last - (pivot_pos + 1);
+        bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            // 不均衡次数过多，退化为堆排序保证 O(n log n)
+            if (--bad_allowed == 0) {
+                mystl::make_heap(first, last, comp);
+                mystl::sort_heap(first, last, comp);
+                return;
+            }
+
+            // 交换若干固定位置的元素打乱可能的对抗性模式
+            if (l_size >= static_cast<diff_t>(kPdqInsertionSortThreshold)) {
+                mystl::iter_swap(first, first + l_size / 4);
+                mystl::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > static_cast<diff_t>(kPdqNintherThreshold)) {
+                    mystl::iter_swap(first + 1, first + (l_size / 4 + 1));
+                    mystl::iter_swap(first + 2, first + (l_size / 4 + 2));
+                    mystl::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    mystl::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= static_cast<diff_t>(kPdqInsertionSortThreshold)) {
+                mystl::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                mystl::iter_swap(last - 1, last - r_size / 4);
+                if (r_size > static_cast<diff_t>(kPdqNintherThreshold)) {
+                    mystl::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    mystl::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    mystl::iter_swap(last - 2, last - (1 + r_size / 4));
+                    mystl::iter_swap(last - 3, last - (2 + r_size / 4));
+                }
+            }
+        } else if (already_partitioned &&
+                   mystl::pdq_partial_insertion_sort(first, pivot_pos, comp) &&
+                   mystl::pdq_partial_insertion_sort(pivot_pos + 1, last, comp)) {
+            // 划分均衡且输入原本就已分割好，两段都能被少量插入排序完成
+            return;
+        }
+
+        // 左段递归，右段循环处理
+        mystl::pdq_sort_loop(first, pivot_pos, comp, bad_allowed, leftmost, branchless);
+        first = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+/**
+ * @brief 模式消除快速排序（pattern-defeating quicksort），使用给定的比较函数
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ *
+ * 在内省排序的基础上：
+ * - 算术类型配合默认比较器时使用无分支块分割，避免分割循环中的分支预测失败；
+ * - 识别已分割好的区间，对有序、逆序及局部有序输入接近线性时间；
+ * - 大量重复元素时把与枢轴相等的元素一次性归位；
+ * - 划分严重不均衡时交换固定位置元素打破对抗性模式，仍不均衡则改用堆排序。
+ * 不保证稳定性，最坏时间复杂度 O(n log n)。
+ */
+template <class RandomIter, class Compared>
+void pdq_sort(RandomIter first, RandomIter last, Compared comp) {
+    if (last - first < 2) {
         return;
     }
-    
-    // 简单的归并排序实现
-    auto mid = first + (last - first) / 2;
-    mystl::stable_sort(first, mid, comp);
-    mystl::stable_sort(mid, last, comp);
-    inplace_merge(first, mid, last, comp);
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    mystl::pdq_sort_loop(first, last, comp,
+                         static_cast<int>(mystl::slg2(last - first)), true,
+                         typename is_pdq_branchless<value_type, Compared>::type());
 }
 
 /**
- * @brief 对[first, last)区间内的元素进行稳定排序
+ * @brief 模式消除快速排序，使用 operator< 比较
  * @param first 起始迭代器
  * @param last 结束迭代器
  */
 template <class RandomIter>
-void stable_sort(RandomIter first, RandomIter last) {
-    mystl::stable_sort(first, last, less<typename iterator_traits<RandomIter>::value_type>());
+void pdq_sort(RandomIter first, RandomIter last) {
+    mystl::pdq_sort(first, last, less<typename iterator_traits<RandomIter>::value_type>());
 }
 
 /**
@@ -791,16 +1453,17 @@ void stable_sort(RandomIter first, RandomIter last) {
  */
 template <class RandomIter, class Compared>
 void partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
-    if (first == middle || middle == last) {
+    if (first == middle) {
         return;
     }
     
     // 标准 partial_sort：在 [first, middle) 建堆，扫描 [middle, last) 维护堆
     mystl::make_heap(first, middle, comp); // 使 first 处为堆顶
+    const auto len = middle - first;
     for (auto i = middle; i != last; ++i) {
         if (comp(*i, *first)) {            // 新元素更“小”，替换堆顶
             mystl::iter_swap(i, first);
-            mystl::pop_heap(first, middle, comp); // 调整堆
+            mystl::adjust_heap(first, decltype(len)(0), len, comp); // 新堆顶下沉
         }
     }
     // 将 [first, middle) 堆转为有序
@@ -867,14 +1530,195 @@ ForwardIter rotate(ForwardIter first, ForwardIter middle, ForwardIter last) {
 // merge 函数已移至 set_algo.h
 
 /**
- * @brief 原地合并两个已排序的序列
+ * @brief 无缓冲区的原地合并：按较长一段的中点切分，旋转后递归合并两半
  * @param first 第一个序列的起始迭代器
  * @param middle 第一个序列的结束迭代器，也是第二个序列的起始迭代器
  * @param last 第二个序列的结束迭代器
+ * @param len1 第一个序列的长度
+ * @param len2 第二个序列的长度
+ * @param comp 比较函数
+ *
+ * 不需要额外内存，时间复杂度 O(n log n)，作为申请不到缓冲区时的兜底方案。
  */
-template <class BidirectionalIter>
-void inplace_merge(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last) {
-    inplace_merge(first, middle, last, less<typename iterator_traits<BidirectionalIter>::value_type>());
+template <class BidirectionalIter, class Distance, class Compared>
+void merge_without_buffer(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last,
+                          Distance len1, Distance len2, Compared comp) {
+    while (len1 != 0 && len2 != 0) {
+        if (len1 + len2 == 2) {
+            if (comp(*middle, *first)) {
+                mystl::iter_swap(first, middle);
+            }
+            return;
+        }
+        BidirectionalIter first_cut = first;
+        BidirectionalIter second_cut = middle;
+        Distance len11 = 0;
+        Distance len22 = 0;
+        if (len1 > len2) {
+            len11 = len1 / 2;
+            mystl::advance(first_cut, len11);
+            second_cut = mystl::lower_bound(middle, last, *first_cut, comp);
+            len22 = mystl::distance(middle, second_cut);
+        } else {
+            len22 = len2 / 2;
+            mystl::advance(second_cut, len22);
+            first_cut = mystl::upper_bound(first, middle, *second_cut, comp);
+            len11 = mystl::distance(first, first_cut);
+        }
+        BidirectionalIter new_middle = mystl::rotate(first_cut, middle, second_cut);
+        // 对左半部分递归，右半部分循环处理
+        mystl::merge_without_buffer(first, first_cut, new_middle, len11, len22, comp);
+        first = new_middle;
+        middle = second_cut;
+        len1 -= len11;
+        len2 -= len22;
+    }
+}
+
+/**
+ * @brief 借助缓冲区旋转 [first, middle) 与 [middle, last)
+ * @param len1 第一段长度
+ * @param len2 第二段长度
+ * @param buffer 缓冲区起始位置
+ * @param buffer_size 缓冲区容量
+ * @return 原 first 处元素的新位置
+ *
+ * 较短一段能放进缓冲区时只需三次线性搬移，否则退化为 mystl::rotate。
+ */
+template <class BidirectionalIter, class Distance, class Pointer>
+BidirectionalIter rotate_adaptive(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last,
+                                  Distance len1, Distance len2, Pointer buffer, Distance buffer_size) {
+    if (len1 > len2 && len2 <= buffer_size) {
+        if (len2 == 0) {
+            return first;
+        }
+        Pointer buffer_end = mystl::move(middle, last, buffer);
+        mystl::move_backward(first, middle, last);
+        return mystl::move(buffer, buffer_end, first);
+    }
+    if (len1 <= buffer_size) {
+        if (len1 == 0) {
+            return last;
+        }
+        Pointer buffer_end = mystl::move(first, middle, buffer);
+        mystl::move(middle, last, first);
+        return mystl::move_backward(buffer, buffer_end, last);
+    }
+    return mystl::rotate(first, middle, last);
+}
+
+/**
+ * @brief 前向合并：[first1, last1) 在缓冲区中，[first2, last2) 在原位，结果写到 result 起
+ *
+ * result 总是落后于 first2，第二段剩余的元素已经就位，无需搬移。
+ */
+template <class Pointer, class BidirectionalIter, class Compared>
+void move_merge_adaptive(Pointer first1, Pointer last1, BidirectionalIter first2, BidirectionalIter last2,
+                         BidirectionalIter result, Compared comp) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first2, *first1)) {
+            *result = mystl::move(*first2);
+            ++first2;
+        } else {
+            *result = mystl::move(*first1);
+            ++first1;
+        }
+        ++result;
+    }
+    mystl::move(first1, last1, result);
+}
+
+/**
+ * @brief 后向合并：[first1, last1) 在原位，[first2, last2) 在缓冲区中，结果从 result 向前写
+ *
+ * 相等元素优先取第二段，从右向左写入，保证稳定性。
+ */
+template <class BidirectionalIter, class Pointer, class Compared>
+void move_merge_adaptive_backward(BidirectionalIter first1, BidirectionalIter last1,
+                                  Pointer first2, Pointer last2,
+                                  BidirectionalIter result, Compared comp) {
+    if (first1 == last1) {
+        mystl::move_backward(first2, last2, result);
+        return;
+    }
+    if (first2 == last2) {
+        return;
+    }
+    --last1;
+    --last2;
+    for (;;) {
+        if (comp(*last2, *last1)) {
+            *--result = mystl::move(*last1);
+            if (first1 == last1) {
+                mystl::move_backward(first2, ++last2, result);
+                return;
+            }
+            --last1;
+        } else {
+            *--result = mystl::move(*last2);
+            if (first2 == last2) {
+                return;
+            }
+            --last2;
+        }
+    }
+}
+
+/**
+ * @brief 借助缓冲区的自适应合并
+ * @param first 第一个序列的起始迭代器
+ * @param middle 第一个序列的结束迭代器，也是第二个序列的起始迭代器
+ * @param last 第二个序列的结束迭代器
+ * @param len1 第一个序列的长度
+ * @param len2 第二个序列的长度
+ * @param buffer 缓冲区起始位置，其中为可移动赋值的有效对象
+ * @param buffer_size 缓冲区容量
+ * @param comp 比较函数
+ *
+ * 较短一段放得进缓冲区时线性合并；只有部分缓冲区时按中点切分，
+ * 用 rotate_adaptive 交换中间两段后递归；没有缓冲区时使用 merge_without_buffer。
+ */
+template <class BidirectionalIter, class Distance, class Pointer, class Compared>
+void merge_adaptive(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last,
+                    Distance len1, Distance len2, Pointer buffer, Distance buffer_size, Compared comp) {
+    if (buffer_size <= 0) {
+        mystl::merge_without_buffer(first, middle, last, len1, len2, comp);
+        return;
+    }
+    while (len1 != 0 && len2 != 0) {
+        if (len1 <= len2 && len1 <= buffer_size) {
+            Pointer buffer_end = mystl::move(first, middle, buffer);
+            mystl::move_merge_adaptive(buffer, buffer_end, middle, last, first, comp);
+            return;
+        }
+        if (len2 <= buffer_size) {
+            Pointer buffer_end = mystl::move(middle, last, buffer);
+            mystl::move_merge_adaptive_backward(first, middle, buffer, buffer_end, last, comp);
+            return;
+        }
+        BidirectionalIter first_cut = first;
+        BidirectionalIter second_cut = middle;
+        Distance len11 = 0;
+        Distance len22 = 0;
+        if (len1 > len2) {
+            len11 = len1 / 2;
+            mystl::advance(first_cut, len11);
+            second_cut = mystl::lower_bound(middle, last, *first_cut, comp);
+            len22 = mystl::distance(middle, second_cut);
+        } else {
+            len22 = len2 / 2;
+            mystl::advance(second_cut, len22);
+            first_cut = mystl::upper_bound(first, middle, *second_cut, comp);
+            len11 = mystl::distance(first, first_cut);
+        }
+        BidirectionalIter new_middle = mystl::rotate_adaptive(first_cut, middle, second_cut,
+                                                              len1 - len11, len22, buffer, buffer_size);
+        mystl::merge_adaptive(first, first_cut, new_middle, len11, len22, buffer, buffer_size, comp);
+        first = new_middle;
+        middle = second_cut;
+        len1 -= len11;
+        len2 -= len22;
+    }
 }
 
 /**
@@ -883,32 +1727,593 @@ void inplace_merge(BidirectionalIter first, BidirectionalIter middle, Bidirectio
  * @param middle 第一个序列的结束迭代器，也是第二个序列的起始迭代器
  * @param last 第二个序列的结束迭代器
  * @param comp 比较函数
+ *
+ * 申请容纳较短一段的临时缓冲区：完整拿到时 O(n) 合并，只拿到部分时分治合并，
+ * 完全申请不到时退化为无缓冲区的旋转合并 O(n log n)。
  */
 template <class BidirectionalIter, class Compared>
 void inplace_merge(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last, Compared comp) {
     if (first == middle || middle == last) {
         return;
     }
-    
-    // 简单的原地合并实现
-    auto len1 = distance(first, middle);
-    auto len2 = distance(middle, last);
-    
-    if (len1 < len2) {
-        // 交换两个序列
-        mystl::swap_ranges(first, middle, middle);
-        inplace_merge(middle, middle + len1, last, comp);
+    typedef typename iterator_traits<BidirectionalIter>::value_type      value_type;
+    typedef typename iterator_traits<BidirectionalIter>::difference_type difference_type;
+    const difference_type len1 = mystl::distance(first, middle);
+    const difference_type len2 = mystl::distance(middle, last);
+    temporary_buffer<value_type> buf(first, mystl::min(len1, len2));
+    mystl::merge_adaptive(first, middle, last, len1, len2, buf.begin(),
+                          static_cast<difference_type>(buf.size()), comp);
+}
+
+/**
+ * @brief 原地合并两个已排序的序列
+ * @param first 第一个序列的起始迭代器
+ * @param middle 第一个序列的结束迭代器，也是第二个序列的起始迭代器
+ * @param last 第二个序列的结束迭代器
+ */
+template <class BidirectionalIter>
+void inplace_merge(BidirectionalIter first, BidirectionalIter middle, BidirectionalIter last) {
+    mystl::inplace_merge(first, middle, last, less<typename iterator_traits<BidirectionalIter>::value_type>());
+}
+
+// ============================================================================
+// 稳定排序（TimSort）
+// ============================================================================
+
+// 长度小于该值的区间不做合并，直接对单个 run 做二分插入排序
+constexpr ptrdiff_t kTimMinMerge = 32;
+
+// 连续从同一侧取出这么多个元素后进入 galloping 模式
+constexpr ptrdiff_t kTimMinGallop = 7;
+
+// run 栈容量：栈中 run 长度满足类斐波那契增长，85 层足以覆盖 64 位长度
+constexpr int kTimMaxPendingRuns = 85;
+
+/**
+ * @brief 计算最小 run 长度：取 n 的高 5 位，若其余位非 0 则再加一，
+ *        使 n / minrun 恰好为或略小于 2 的幂，合并时尽量平衡
+ * @param n 区间长度
+ * @return 位于 [kTimMinMerge / 2, kTimMinMerge] 的最小 run 长度
+ */
+template <class Distance>
+Distance tim_min_run_length(Distance n) {
+    Distance r = 0;
+    while (n >= kTimMinMerge) {
+        r |= (n & 1);
+        n >>= 1;
+    }
+    return n + r;
+}
+
+/**
+ * @brief 从 first 开始识别自然 run，严格降序的 run 原地翻转为升序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ * @return run 的长度
+ *
+ * 只翻转严格降序的 run，相等元素不会被交换，保证稳定性。
+ */
+template <class RandomIter, class Compared>
+typename iterator_traits<RandomIter>::difference_type
+tim_count_run_and_make_ascending(RandomIter first, RandomIter last, Compared comp) {
+    RandomIter run_end = first + 1;
+    if (run_end == last) {
+        return 1;
+    }
+    if (comp(*run_end++, *first)) {
+        while (run_end != last && comp(*run_end, *(run_end - 1))) {
+            ++run_end;
+        }
+        mystl::reverse(first, run_end);
+    } else {
+        while (run_end != last && !comp(*run_end, *(run_end - 1))) {
+            ++run_end;
+        }
+    }
+    return run_end - first;
+}
+
+/**
+ * @brief 二分插入排序：[first, start) 已有序，将 [start, last) 依次插入
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param start 第一个待插入元素的位置
+ * @param comp 比较函数
+ *
+ * 用 upper_bound 查找插入位置，相等元素插在已有元素之后，保证稳定性。
+ */
+template <class RandomIter, class Compared>
+void tim_binary_insertion_sort(RandomIter first, RandomIter last, RandomIter start, Compared comp) {
+    if (start == first) {
+        ++start;
+    }
+    for (; start < last; ++start) {
+        RandomIter pos = mystl::upper_bound(first, start, *start, comp);
+        if (pos != start) {
+            auto value = mystl::move(*start);
+            mystl::move_backward(pos, start, start + 1);
+            *pos = mystl::move(value);
+        }
+    }
+}
+
+/**
+ * @brief 在有序区间 base[0, len) 中查找 key 的最左插入位置，从 hint 处开始指数搜索
+ * @param key 待查找的值
+ * @param base 有序区间的起始位置
+ * @param len 区间长度
+ * @param hint 搜索起点，0 <= hint < len
+ * @param comp 比较函数
+ * @return 满足 base[k - 1] < key <= base[k] 的 k
+ */
+template <class T, class Iter, class Distance, class Compared>
+Distance tim_gallop_left(const T& key, Iter base, Distance len, Distance hint, Compared comp) {
+    Distance last_ofs = 0;
+    Distance ofs = 1;
+    if (comp(base[hint], key)) {
+        // 向右飞奔，直到 base[hint + last_ofs] < key <= base[hint + ofs]
+        const Distance max_ofs = len - hint;
+        while (ofs < max_ofs && comp(base[hint + ofs], key)) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) {
+            ofs = max_ofs;
+        }
+        last_ofs += hint;
+        ofs += hint;
+    } else {
+        // 向左飞奔，直到 base[hint - ofs] < key <= base[hint - last_ofs]
+        const Distance max_ofs = hint + 1;
+        while (ofs < max_ofs && !comp(base[hint - ofs], key)) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) {
+            ofs = max_ofs;
+        }
+        const Distance tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    }
+    // 此时 base[last_ofs] < key <= base[ofs]，在 (last_ofs, ofs] 内二分
+    ++last_ofs;
+    while (last_ofs < ofs) {
+        const Distance m = last_ofs + ((ofs - last_ofs) >> 1);
+        if (comp(base[m], key)) {
+            last_ofs = m + 1;
+        } else {
+            ofs = m;
+        }
+    }
+    return ofs;
+}
+
+/**
+ * @brief 在有序区间 base[0, len) 中查找 key 的最右插入位置，从 hint 处开始指数搜索
+ * @param key 待查找的值
+ * @param base 有序区间的起始位置
+ * @param len 区间长度
+ * @param hint 搜索起点，0 <= hint < len
+ * @param comp 比较函数
+ * @return 满足 base[k - 1] <= key < base[k] 的 k
+ */
+template <class T, class Iter, class Distance, class Compared>
+Distance tim_gallop_right(const T& key, Iter base, Distance len, Distance hint, Compared comp) {
+    Distance last_ofs = 0;
+    Distance ofs = 1;
+    if (comp(key, base[hint])) {
+        // 向左飞奔，直到 base[hint - ofs] <= key < base[hint - last_ofs]
+        const Distance max_ofs = hint + 1;
+        while (ofs < max_ofs && comp(key, base[hint - ofs])) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) {
+            ofs = max_ofs;
+        }
+        const Distance tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
     } else {
-        // 递归合并
-        auto mid1 = first + len1 / 2;
-        auto mid2 = mystl::lower_bound(middle, last, *mid1, comp);
-        auto mid3 = mid1 + distance(middle, mid2);
-        
-        mystl::rotate(mid1, middle, mid2);
-        inplace_merge(first, mid1, mid3, comp);
-        inplace_merge(mid3, mid2, last, comp);
+        // 向右飞奔，直到 base[hint + last_ofs] <= key < base[hint + ofs]
+        const Distance max_ofs = len - hint;
+        while (ofs < max_ofs && !comp(key, base[hint + ofs])) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) {
+            ofs = max_ofs;
+        }
+        last_ofs += hint;
+        ofs += hint;
+    }
+    // 此时 base[last_ofs] <= key < base[ofs]，在 (last_ofs, ofs] 内二分
+    ++last_ofs;
+    while (last_ofs < ofs) {
+        const Distance m = last_ofs + ((ofs - last_ofs) >> 1);
+        if (comp(key, base[m])) {
+            ofs = m;
+        } else {
+            last_ofs = m + 1;
+        }
+    }
+    return ofs;
+}
+
+/**
+ * @brief TimSort 的合并状态：待合并 run 栈、临时缓冲区与自适应的 galloping 阈值
+ * @tparam RandomIter 随机访问迭代器类型
+ * @tparam Compared 比较函数类型
+ *
+ * 缓冲区由调用方以 temporary_buffer 提供，其中是可移动赋值的有效对象；
+ * 缓冲区放不下较短的 run 时交给 merge_adaptive 分治合并。
+ */
+template <class RandomIter, class Compared>
+class tim_sorter {
+public:
+    typedef typename iterator_traits<RandomIter>::value_type      value_type;
+    typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+
+    tim_sorter(RandomIter first, Compared comp, value_type* buffer, difference_type buffer_size)
+        : a_(first), comp_(comp), min_gallop_(kTimMinGallop),
+          buf_(buffer), buf_size_(buffer_size), stack_size_(0) {}
+
+    tim_sorter(const tim_sorter&) = delete;
+    tim_sorter& operator=(const tim_sorter&) = delete;
+
+    /**
+     * @brief 压入一个新识别出的 run
+     */
+    void push_run(difference_type base, difference_type len) {
+        run_base_[stack_size_] = base;
+        run_len_[stack_size_] = len;
+        ++stack_size_;
+    }
+
+    /**
+     * @brief 合并栈顶的 run，直到恢复不变式：
+     *        run_len[i - 2] > run_len[i - 1] + run_len[i] 且 run_len[i - 1] > run_len[i]
+     *
+     * 同时检查栈顶下方第三、四个 run，避免原始 TimSort 中不变式被破坏的问题。
+     */
+    void merge_collapse() {
+        while (stack_size_ > 1) {
+            int n = stack_size_ - 2;
+            if ((n >= 1 && run_len_[n - 1] <= run_len_[n] + run_len_[n + 1]) ||
+                (n >= 2 && run_len_[n - 2] <= run_len_[n - 1] + run_len_[n])) {
+                if (run_len_[n - 1] < run_len_[n + 1]) {
+                    --n;
+                }
+            } else if (run_len_[n] > run_len_[n + 1]) {
+                break;
+            }
+            merge_at(n);
+        }
+    }
+
+    /**
+     * @brief 合并栈中剩余的所有 run，结束时栈中只剩一个 run
+     */
+    void merge_force_collapse() {
+        while (stack_size_ > 1) {
+            int n = stack_size_ - 2;
+            if (n > 0 && run_len_[n - 1] < run_len_[n + 1]) {
+                --n;
+            }
+            merge_at(n);
+        }
+    }
+
+private:
+    /**
+     * @brief 合并栈中第 i 和 i + 1 个 run
+     *
+     * 先用 galloping 剔除已经就位的前缀和后缀，再按较短一侧选择 merge_lo / merge_hi。
+     */
+    void merge_at(int i) {
+        difference_type base1 = run_base_[i];
+        difference_type len1 = run_len_[i];
+        const difference_type base2 = run_base_[i + 1];
+        difference_type len2 = run_len_[i + 1];
+
+        run_len_[i] = len1 + len2;
+        if (i == stack_size_ - 3) {
+            run_base_[i + 1] = run_base_[i + 2];
+            run_len_[i + 1] = run_len_[i + 2];
+        }
+        --stack_size_;
+
+        // run1 中不大于 run2 首元素的前缀已经就位
+        const difference_type k = mystl::tim_gallop_right(a_[base2], a_ + base1, len1,
+                                                          difference_type(0), comp_);
+        base1 += k;
+        len1 -= k;
+        if (len1 == 0) {
+            return;
+        }
+        // run2 中不小于 run1 末元素的后缀已经就位
+        len2 = mystl::tim_gallop_left(a_[base1 + len1 - 1], a_ + base2, len2, len2 - 1, comp_);
+        if (len2 == 0) {
+            return;
+        }
+
+        if (mystl::min(len1, len2) > buf_size_) {
+            mystl::merge_adaptive(a_ + base1, a_ + base2, a_ + base2 + len2, len1, len2,
+                                  buf_, buf_size_, comp_);
+            return;
+        }
+        if (len1 <= len2) {
+            merge_lo(base1, len1, base2, len2);
+        } else {
+            merge_hi(base1, len1, base2, len2);
+        }
+    }
+
+    /**
+     * @brief 从左向右合并，要求 len1 <= len2，且 run1 首元素大于 run2 首元素、
+     *        run1 末元素大于 run2 所有元素
+     */
+    void merge_lo(difference_type base1, difference_type len1,
+                  difference_type base2, difference_type len2) {
+        value_type* tmp = buf_;
+        mystl::move(a_ + base1, a_ + base1 + len1, tmp);
+
+        difference_type cursor1 = 0;      // 缓冲区中的 run1
+        difference_type cursor2 = base2;  // 原位的 run2
+        difference_type dest = base1;
+
+        a_[dest++] = mystl::move(a_[cursor2++]);
+        if (--len2 == 0) {
+            mystl::move(tmp + cursor1, tmp + cursor1 + len1, a_ + dest);
+            return;
+        }
+        if (len1 == 1) {
+            mystl::move(a_ + cursor2, a_ + cursor2 + len2, a_ + dest);
+            a_[dest + len2] = mystl::move(tmp[cursor1]);
+            return;
+        }
+
+        difference_type min_gallop = min_gallop_;
+        for (;;) {
+            difference_type count1 = 0;  // run1 连续胜出的次数
+            difference_type count2 = 0;  // run2 连续胜出的次数
+            bool done = false;
+
+            // 逐个比较，直到某一侧连续胜出 min_gallop 次
+            do {
+                if (comp_(a_[cursor2], tmp[cursor1])) {
+                    a_[dest++] = mystl::move(a_[cursor2++]);
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 0) { done = true; break; }
+                } else {
+                    a_[dest++] = mystl::move(tmp[cursor1++]);
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 1) { done = true; break; }
+                }
+            } while ((count1 | count2) < min_gallop);
+            if (done) {
+                break;
+            }
+
+            // galloping：成批搬移，直到两侧都不再连续胜出足够多
+            do {
+                count1 = mystl::tim_gallop_right(a_[cursor2], tmp + cursor1, len1,
+                                                 difference_type(0), comp_);
+                if (count1 != 0) {
+                    mystl::move(tmp + cursor1, tmp + cursor1 + count1, a_ + dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    len1 -= count1;
+                    if (len1 <= 1) { done = true; break; }
+                }
+                a_[dest++] = mystl::move(a_[cursor2++]);
+                if (--len2 == 0) { done = true; break; }
+
+                count2 = mystl::tim_gallop_left(tmp[cursor1], a_ + cursor2, len2,
+                                                difference_type(0), comp_);
+                if (count2 != 0) {
+                    mystl::move(a_ + cursor2, a_ + cursor2 + count2, a_ + dest);
+                    dest += count2;
+                    cursor2 += count2;
+                    len2 -= count2;
+                    if (len2 == 0) { done = true; break; }
+                }
+                a_[dest++] = mystl::move(tmp[cursor1++]);
+                if (--len1 == 1) { done = true; break; }
+                --min_gallop;
+            } while (count1 >= kTimMinGallop || count2 >= kTimMinGallop);
+            if (done) {
+                break;
+            }
+            if (min_gallop < 0) {
+                min_gallop = 0;
+            }
+            min_gallop += 2;  // 离开 galloping 模式的惩罚
+        }
+        min_gallop_ = min_gallop < 1 ? 1 : min_gallop;
+
+        if (len1 == 1) {
+            mystl::move(a_ + cursor2, a_ + cursor2 + len2, a_ + dest);
+            a_[dest + len2] = mystl::move(tmp[cursor1]);
+        } else {
+            // len1 == 0 仅在比较函数不满足严格弱序时出现，此时无元素可搬
+            mystl::move(tmp + cursor1, tmp + cursor1 + len1, a_ + dest);
+        }
+    }
+
+    /**
+     * @brief 从右向左合并，要求 len1 > len2，前置条件同 merge_lo
+     */
+    void merge_hi(difference_type base1, difference_type len1,
+                  difference_type base2, difference_type len2) {
+        value_type* tmp = buf_;
+        mystl::move(a_ + base2, a_ + base2 + len2, tmp);
+
+        difference_type cursor1 = base1 + len1 - 1;  // 原位的 run1
+        difference_type cursor2 = len2 - 1;          // 缓冲区中的 run2
+        difference_type dest = base2 + len2 - 1;
+
+        a_[dest--] = mystl::move(a_[cursor1--]);
+        if (--len1 == 0) {
+            mystl::move(tmp, tmp + len2, a_ + (dest - (len2 - 1)));
+            return;
+        }
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            mystl::move_backward(a_ + (cursor1 + 1), a_ + (cursor1 + 1 + len1), a_ + (dest + 1 + len1));
+            a_[dest] = mystl::move(tmp[cursor2]);
+            return;
+        }
+
+        difference_type min_gallop = min_gallop_;
+        for (;;) {
+            difference_type count1 = 0;
+            difference_type count2 = 0;
+            bool done = false;
+
+            do {
+                if (comp_(tmp[cursor2], a_[cursor1])) {
+                    a_[dest--] = mystl::move(a_[cursor1--]);
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 0) { done = true; break; }
+                } else {
+                    a_[dest--] = mystl::move(tmp[cursor2--]);
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 1) { done = true; break; }
+                }
+            } while ((count1 | count2) < min_gallop);
+            if (done) {
+                break;
+            }
+
+            do {
+                count1 = len1 - mystl::tim_gallop_right(tmp[cursor2], a_ + base1, len1,
+                                                        len1 - 1, comp_);
+                if (count1 != 0) {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    len1 -= count1;
+                    mystl::move_backward(a_ + (cursor1 + 1), a_ + (cursor1 + 1 + count1),
+                                         a_ + (dest + 1 + count1));
+                    if (len1 == 0) { done = true; break; }
+                }
+                a_[dest--] = mystl::move(tmp[cursor2--]);
+                if (--len2 == 1) { done = true; break; }
+
+                count2 = len2 - mystl::tim_gallop_left(a_[cursor1], tmp, len2, len2 - 1, comp_);
+                if (count2 != 0) {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    len2 -= count2;
+                    mystl::move(tmp + (cursor2 + 1), tmp + (cursor2 + 1 + count2), a_ + (dest + 1));
+                    if (len2 <= 1) { done = true; break; }
+                }
+                a_[dest--] = mystl::move(a_[cursor1--]);
+                if (--len1 == 0) { done = true; break; }
+                --min_gallop;
+            } while (count1 >= kTimMinGallop || count2 >= kTimMinGallop);
+            if (done) {
+                break;
+            }
+            if (min_gallop < 0) {
+                min_gallop = 0;
+            }
+            min_gallop += 2;
+        }
+        min_gallop_ = min_gallop < 1 ? 1 : min_gallop;
+
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            mystl::move_backward(a_ + (cursor1 + 1), a_ + (cursor1 + 1 + len1), a_ + (dest + 1 + len1));
+            a_[dest] = mystl::move(tmp[cursor2]);
+        } else {
+            mystl::move(tmp, tmp + len2, a_ + (dest - (len2 - 1)));
+        }
+    }
+
+private:
+    RandomIter      a_;
+    Compared        comp_;
+    difference_type min_gallop_;
+    value_type*     buf_;
+    difference_type buf_size_;
+    int             stack_size_;
+    difference_type run_base_[kTimMaxPendingRuns];
+    difference_type run_len_[kTimMaxPendingRuns];
+};
+
+/**
+ * @brief 对[first, last)区间内的元素进行稳定排序，使用给定的比较函数
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ *
+ * TimSort：识别自然升序/降序 run，短 run 用二分插入排序补足到 minrun，
+ * 按栈不变式合并相邻 run，合并时使用 galloping 跳过成段就位的元素。
+ * 已有序或基本有序的输入接近 O(n)，最坏 O(n log n)。
+ * 整个区间本身就是一个 run 时不申请缓冲区；否则通过 temporary_buffer 申请
+ * 半个区间大小的缓冲区，只拿到部分或申请失败时合并退化为分治/无缓冲区合并。
+ */
+template <class RandomIter, class Compared>
+void stable_sort(RandomIter first, RandomIter last, Compared comp) {
+    typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+    difference_type n = last - first;
+    if (n < 2) {
+        return;
+    }
+
+    difference_type run = mystl::tim_count_run_and_make_ascending(first, last, comp);
+    if (run == n) {
+        return;
+    }
+    // 短区间：一个 run 加二分插入排序即可
+    if (n < kTimMinMerge) {
+        mystl::tim_binary_insertion_sort(first, last, first + run, comp);
+        return;
     }
 
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    temporary_buffer<value_type> buf(first, (n + 1) / 2);
+    tim_sorter<RandomIter, Compared> sorter(first, comp, buf.begin(),
+                                            static_cast<difference_type>(buf.size()));
+    const difference_type min_run = mystl::tim_min_run_length(n);
+    difference_type lo = 0;
+    difference_type remaining = n;
+    for (;;) {
+        // 自然 run 太短时用二分插入排序扩展到 min(min_run, remaining)
+        if (run < min_run) {
+            const difference_type force = remaining <= min_run ? remaining : min_run;
+            mystl::tim_binary_insertion_sort(first + lo, first + lo + force, first + lo + run, comp);
+            run = force;
+        }
+        sorter.push_run(lo, run);
+        sorter.merge_collapse();
+        lo += run;
+        remaining -= run;
+        if (remaining == 0) {
+            break;
+        }
+        run = mystl::tim_count_run_and_make_ascending(first + lo, last, comp);
+    }
+    sorter.merge_force_collapse();
+}
+
+/**
+ * @brief 对[first, last)区间内的元素进行稳定排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ */
+template <class RandomIter>
+void stable_sort(RandomIter first, RandomIter last) {
+    mystl::stable_sort(first, last, less<typename iterator_traits<RandomIter>::value_type>());
 }
 
 } // namespace mystl
@@ -8,6 +8,7 @@
 #include "iterator.h"
 #include "util.h"
 #include "type_traits.h"
+#include "uninitialized.h"
 
 namespace mystl {
 
@@ -140,13 +141,79 @@ bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
  * @return 目标范围的结束迭代器
  */
 template<typename InputIterator, typename OutputIterator>
-OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result) {
+OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result);
+
+// 连续区间的逐元素拷贝
+template<typename InputIterator, typename OutputIterator>
+OutputIterator copy_contiguous(InputIterator first, InputIterator last, OutputIterator result) {
     for (; first != last; ++first, ++result) {
         *result = *first;
     }
     return result;
 }
 
+// 同类型、可平凡拷贝的指针区间：一次 memmove
+template<typename Tp, typename Up>
+typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+                        std::is_trivially_copyable<Up>::value, Up*>::type
+copy_contiguous(Tp* first, Tp* last, Up* result) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    if (n != 0) {
+        std::memmove(result, first, n * sizeof(Up));
+    }
+    return result + n;
+}
+
+// 源为指针区间、目标为分段迭代器：按目标块切段
+template<typename Tp, typename OutputIterator>
+OutputIterator copy_to_segments(Tp* first, Tp* last, OutputIterator result, m_true_type) {
+    typedef segmented_iterator_traits<OutputIterator> traits;
+    while (first != last) {
+        auto out = traits::local(result);
+        auto room = traits::end(traits::segment(result)) - out;
+        auto n = last - first < room ? last - first : room;
+        mystl::copy_contiguous(first, first + n, out);
+        first += n;
+        result += n;
+    }
+    return result;
+}
+
+template<typename InputIterator, typename OutputIterator>
+OutputIterator copy_to_segments(InputIterator first, InputIterator last, OutputIterator result, m_false_type) {
+    return mystl::copy_contiguous(first, last, result);
+}
+
+// 源不是分段迭代器
+template<typename InputIterator, typename OutputIterator>
+OutputIterator copy_from_segments(InputIterator first, InputIterator last, OutputIterator result, m_false_type) {
+    return mystl::copy_to_segments(first, last, result,
+        m_bool_constant<std::is_pointer<InputIterator>::value &&
+                        segmented_iterator_traits<OutputIterator>::is_segmented>());
+}
+
+// 源为分段迭代器：逐块交给指针区间的拷贝
+template<typename InputIterator, typename OutputIterator>
+OutputIterator copy_from_segments(InputIterator first, InputIterator last, OutputIterator result, m_true_type) {
+    typedef segmented_iterator_traits<InputIterator> traits;
+    auto seg = traits::segment(first);
+    const auto last_seg = traits::segment(last);
+    if (seg == last_seg) {
+        return mystl::copy(traits::local(first), traits::local(last), result);
+    }
+    result = mystl::copy(traits::local(first), traits::end(seg), result);
+    for (++seg; seg != last_seg; ++seg) {
+        result = mystl::copy(traits::begin(seg), traits::end(seg), result);
+    }
+    return mystl::copy(traits::begin(last_seg), traits::local(last), result);
+}
+
+template<typename InputIterator, typename OutputIterator>
+OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result) {
+    return mystl::copy_from_segments(first, last, result,
+        m_bool_constant<segmented_iterator_traits<InputIterator>::is_segmented>());
+}
+
 /**
  * @brief 反向拷贝范围
  * @param first 源范围的开始
@@ -207,12 +274,38 @@ BidirectionalIterator2 move_backward(BidirectionalIterator1 first,
  * @param value 填充值
  */
 template<typename ForwardIterator, typename T>
-void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+void fill(ForwardIterator first, ForwardIterator last, const T& value);
+
+template<typename ForwardIterator, typename T>
+void fill_segments(ForwardIterator first, ForwardIterator last, const T& value, m_false_type) {
     for (; first != last; ++first) {
         *first = value;
     }
 }
 
+// 分段迭代器：逐块填充指针区间
+template<typename ForwardIterator, typename T>
+void fill_segments(ForwardIterator first, ForwardIterator last, const T& value, m_true_type) {
+    typedef segmented_iterator_traits<ForwardIterator> traits;
+    auto seg = traits::segment(first);
+    const auto last_seg = traits::segment(last);
+    if (seg == last_seg) {
+        mystl::fill(traits::local(first), traits::local(last), value);
+        return;
+    }
+    mystl::fill(traits::local(first), traits::end(seg), value);
+    for (++seg; seg != last_seg; ++seg) {
+        mystl::fill(traits::begin(seg), traits::end(seg), value);
+    }
+    mystl::fill(traits::begin(last_seg), traits::local(last), value);
+}
+
+template<typename ForwardIterator, typename T>
+void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+    mystl::fill_segments(first, last, value,
+        m_bool_constant<segmented_iterator_traits<ForwardIterator>::is_segmented>());
+}
+
 /**
  * @brief 用值填充 n 个元素
  * @param first 范围的开始
@@ -276,132 +369,6 @@ ForwardIterator uninitialized_default_construct_n(ForwardIterator first, Size n)
     }
 }
 
-/**
- * @brief 用值初始化范围
- * @param first 范围的开始
- * @param last 范围的结束
- * @param value 初始化值
- */
-template<typename ForwardIterator, typename T>
-void uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& value) {
-    using value_type = typename iterator_traits<ForwardIterator>::value_type;
-    ForwardIterator current = first;
-    try {
-        for (; current != last; ++current) {
-            ::new (static_cast<void*>(&*current)) value_type(value);
-        }
-    } catch (...) {
-        for (; first != current; ++first) {
-            first->~value_type();
-        }
-        throw;
-    }
-}
-
-/**
- * @brief 用值初始化 n 个元素
- * @param first 范围的开始
- * @param n 元素数量
- * @param value 初始化值
- * @return 初始化后的结束迭代器
- */
-template<typename ForwardIterator, typename Size, typename T>
-ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const T& value) {
-    using value_type = typename iterator_traits<ForwardIterator>::value_type;
-    ForwardIterator current = first;
-    try {
-        for (; n > 0; --n, ++current) {
-            ::new (static_cast<void*>(&*current)) value_type(value);
-        }
-        return current;
-    } catch (...) {
-        for (; first != current; ++first) {
-            first->~value_type();
-        }
-        throw;
-    }
-}
-
-/**
- * @brief 拷贝构造未初始化的范围
- * @param first 源范围的开始
- * @param last 源范围的结束
- * @param result 目标范围的开始
- * @return 目标范围的结束迭代器
- */
-template<typename InputIterator, typename ForwardIterator>
-ForwardIterator uninitialized_copy(InputIterator first, InputIterator last,
-                                   ForwardIterator result) {
-    using value_type = typename iterator_traits<ForwardIterator>::value_type;
-    ForwardIterator current = result;
-    try {
-        for (; first != last; ++first, ++current) {
-            ::new (static_cast<void*>(&*current)) value_type(*first);
-        }
-        return current;
-    } catch (...) {
-        for (; result != current; ++result) {
-            result->~value_type();
-        }
-        throw;
-    }
-}
-
-/**
- * @brief 移动构造未初始化的范围
- * @param first 源范围的开始
- * @param last 源范围的结束
- * @param result 目标范围的开始
- * @return 目标范围的结束迭代器
- */
-template<typename InputIterator, typename ForwardIterator>
-ForwardIterator uninitialized_move(InputIterator first, InputIterator last,
-                                   ForwardIterator result) {
-    using value_type = typename iterator_traits<ForwardIterator>::value_type;
-    ForwardIterator current = result;
-    try {
-        for (; first != last; ++first, ++current) {
-            ::new (static_cast<void*>(&*current)) value_type(mystl::move(*first));
-        }
-        return current;
-    } catch (...) {
-        for (; result != current; ++result) {
-            result->~value_type();
-        }
-        throw;
-    }
-}
-
-// ============================================================================
-// 销毁算法
-// ============================================================================
-
-/**
- * @brief 销毁范围中的对象
- * @param first 范围的开始
- * @param last 范围的结束
- */
-template<typename ForwardIterator>
-void destroy(ForwardIterator first, ForwardIterator last) {
-    for (; first != last; ++first) {
-        first->~value_type();
-    }
-}
-
-/**
- * @brief 销毁 n 个对象
- * @param first 范围的开始
- * @param n 对象数量
- * @return 销毁后的结束迭代器
- */
-template<typename ForwardIterator, typename Size>
-ForwardIterator destroy_n(ForwardIterator first, Size n) {
-    for (; n > 0; --n, ++first) {
-        first->~value_type();
-    }
-    return first;
-}
-
 // ============================================================================
 // 特化版本（针对 POD 类型优化）
 // ============================================================================
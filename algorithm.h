@@ -13,6 +13,7 @@
  * - 堆算法 (heap_algo.h)
  * - 集合算法 (set_algo.h)
  * - 数值算法 (numeric.h)
+ * - 基数排序 (radix_sort.h)
  * 
  * 使用方法：
  * @code
@@ -50,6 +51,9 @@
 // 数值算法（数值计算算法）
 #include "numeric.h"
 
+// 基数排序（整数、浮点数与字符串键）- 依赖 algo.h
+#include "radix_sort.h"
+
 // ============================================================================
 // 命名空间说明
 // ============================================================================
@@ -98,7 +102,11 @@
  * 
  * @defgroup numeric 数值算法
  * @brief 提供数值计算相关的算法
- * @details 包含 accumulate, inner_product, partial_sum 等数值算法
+ * @details 包含 accumulate, reduce, transform_reduce, inner_product, partial_sum, inclusive_scan, exclusive_scan 等数值算法
+ * 
+ * @defgroup radix_sort 基数排序
+ * @brief 提供非比较排序
+ * @details 包含整数/浮点键的 LSD 基数排序与字符串键的 MSD American-flag 排序
  * 
  * @}
  */
@@ -148,6 +156,10 @@
 #error "numeric.h must be included before algorithm.h"
 #endif
 
+#ifndef MYTINYSTL_RADIX_SORT_H
+#error "radix_sort.h must be included before algorithm.h"
+#endif
+
 // ============================================================================
 // 使用说明
 // ============================================================================
@@ -185,7 +197,8 @@
  * - for_each
  * 
  * ### 修改算法
- * - sort, stable_sort
+ * - sort, stable_sort, pdq_sort
+ * - radix_sort
  * - reverse, reverse_copy
  * - unique, unique_copy
  * - remove, remove_if
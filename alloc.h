@@ -2,12 +2,35 @@
 #define MYTINYSTL_ALLOC_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <new>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <memory>
+#include <thread>
+#include <vector>
+#include "allocator.h"
+#include "construct.h"
 #include "exceptdef.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define MYSTL_ALLOC_HAS_MMAP 1
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#ifndef MYSTL_HAS_MALLOC_USABLE_SIZE
+#define MYSTL_HAS_MALLOC_USABLE_SIZE 1
+#endif
+#endif
+
 namespace mystl {
 
 // ============================================================================
@@ -15,9 +38,40 @@ namespace mystl {
 // ============================================================================
 
 // 内存池配置常量
-static const size_t ALIGN = 8;                    // 对齐字节数
-static const size_t MAX_BYTES = 128;              // 最大字节数
-static const size_t NFREELISTS = MAX_BYTES / ALIGN; // 自由链表数量
+static const size_t ALIGN = 8;                      // 小对象对齐字节数
+static const size_t SMALL_MAX_BYTES = 128;          // 按 ALIGN 等距分级的上限
+static const size_t MAX_BYTES = 32768;              // 内存池管理的最大字节数，更大的直接使用 malloc
+static const size_t NSMALLCLASSES = SMALL_MAX_BYTES / ALIGN;  // 等距大小类数量
+static const size_t CLASSES_PER_GROUP = 4;          // (2^k, 2^(k+1)] 区间内的几何大小类数量
+static const size_t NFREELISTS = NSMALLCLASSES + 8 * CLASSES_PER_GROUP;  // 大小类（自由链表）数量
+
+// 线程缓存配置常量
+static const size_t MAX_TRANSFER_BATCH = 32;        // 线程缓存与中心池之间每次转移的最多对象数
+static const size_t MIN_TRANSFER_BATCH = 2;         // 每次转移的最少对象数
+static const size_t TRANSFER_BYTES = 65536;         // 每次转移的目标字节数
+static const size_t TRANSFER_SLOTS = 64;            // 每个大小类可无锁转移的批次槽位数
+
+// 板（slab）配置常量
+static const size_t SLAB_UNIT = 65536;              // 板大小的单位
+static const size_t MIN_SLAB_OBJECTS = 8;           // 每块板至少容纳的对象数
+static const size_t CHUNK_BYTES = 1 << 20;          // 每次向系统申请的最小内存块
+
+// ============================================================================
+// 内存池统计
+// ============================================================================
+
+/**
+ * @brief 内存池统计信息，由 alloc::get_stats() 返回
+ */
+struct alloc_stats {
+    size_t heap_bytes;          // 当前持有的内存块字节数（向系统申请且尚未归还）
+    size_t slab_bytes;          // 已切成板的字节数
+    size_t allocated_bytes;     // 已交给使用者的对象字节数，含各线程缓存中的对象
+    size_t central_free_bytes;  // 中心池中的空闲对象字节数
+    size_t released_bytes;      // 累计归还系统的字节数
+    size_t trim_count;          // trim 执行次数
+    size_t rss_bytes;           // 进程常驻内存，无法获取时为 0
+};
 
 // ============================================================================
 // 内存池类
@@ -25,6 +79,22 @@ static const size_t NFREELISTS = MAX_BYTES / ALIGN; // 自由链表数量
 
 /**
  * @brief 内存池分配器
+ *
+ * 大小类仿 jemalloc：128 字节以内按 8 字节等距分级，之后每个 2 的幂区间等分为 4 级，
+ * 直到 32KB，内部碎片不超过 25%。每个大小类从内存块中切出专属的板（slab），
+ * 再从板中切出对象。
+ *
+ * 分为两层（仿 tcmalloc）：
+ *   - 线程缓存：每个线程每个大小类一条私有自由链表，分配与释放都不加锁；
+ *   - 中心池：线程缓存为空或过长时，整批转移对象（约 64KB，2 到 32 个对象）。
+ *     批次放在无锁栈中，槽位用尽时才退化到带锁的溢出链表；
+ *     切分新板时加大小类的锁，向系统申请新内存块时才需要全局锁。
+ * 线程退出时其缓存的对象全部归还中心池，可被其他线程复用；
+ * 允许在一个线程分配、在另一个线程释放。
+ *
+ * 内存块与板都登记在册。trim() 统计中心池中的空闲对象，把完全空闲的内存块归还系统，
+ * 所在内存块仍有对象在用的空闲板则释放物理页（MADV_DONTNEED）后留作备用单元。
+ * 可设置阈值在释放时自动 trim，或启动后台线程按衰减策略定期 trim。
  */
 class alloc {
 private:
@@ -34,35 +104,238 @@ private:
         char data[1];     // 数据区域
     };
 
-    // 自由链表数组
-    static obj* free_list[NFREELISTS];
+    // 中心池中的一批对象，next 为栈中下一个槽位的下标 + 1（0 表示栈底）
+    struct transfer_batch {
+        obj*                  head;
+        obj*                  tail;
+        size_t                count;
+        std::atomic<uint32_t> next;
+    };
+
+    // 每个大小类的中心自由链表
+    // 无锁栈的栈顶为 64 位：高 32 位是防 ABA 的版本号，低 32 位是槽位下标 + 1
+    struct central_list {
+        transfer_batch        slots[TRANSFER_SLOTS];
+        std::atomic<uint64_t> full;        // 装有对象的批次
+        std::atomic<uint64_t> empty;       // 已归还的空槽位
+        std::atomic<uint32_t> fresh;       // 已启用过的槽位数
+        std::atomic<size_t>   free_count;  // 中心池中的对象总数
+        std::mutex            mutex;       // 保护溢出链表与当前板
+        obj*                  overflow;
+        size_t                overflow_count;
+        char*                 slab_cur;    // 当前板中尚未切分的部分
+        char*                 slab_end;
+        size_t                slab_count;  // 持有的板数
+        size_t                carved;      // 从持有的板中已切出的对象数
+    };
+
+    // 板与内存块的登记信息，受 mutex_ 保护
+    struct slab_info {
+        char*  base;
+        size_t bytes;
+        size_t index;         // 所属大小类
+        size_t free_objects;  // trim 时统计的空闲对象数
+        bool   empty;         // trim 时判定为完全空闲
+        bool   drop;          // trim 时决定回收
+
+        // 非模板版本，避免 std::sort 在 mystl::swap 与 std::swap 之间产生歧义
+        friend void swap(slab_info& a, slab_info& b) {
+            slab_info tmp = a;
+            a = b;
+            b = tmp;
+        }
+    };
+
+    struct chunk_info {
+        char*  base;
+        size_t bytes;
+        size_t free_bytes;    // trim 时统计的空闲字节数
+        bool   drop;          // trim 时决定归还系统
+
+        friend void swap(chunk_info& a, chunk_info& b) {
+            chunk_info tmp = a;
+            a = b;
+            b = tmp;
+        }
+    };
+
+    // 后台 trim 线程，程序退出时自动停止
+    struct background_trimmer {
+        std::mutex              mutex;
+        std::condition_variable cv;
+        std::thread             thread;
+        bool                    stop;
+        ~background_trimmer();
+    };
+
+    // 线程缓存，平凡类型，线程退出期间仍可安全访问
+    // limit 在初始化前与线程退出后为 0，使释放总是进入慢路径
+    struct thread_cache {
+        obj*   list[NFREELISTS];
+        size_t length[NFREELISTS];
+        size_t limit[NFREELISTS];
+        bool   initialized;
+        bool   destroyed;
+    };
+
+    // 线程退出时归还线程缓存
+    struct thread_cache_cleaner {
+        ~thread_cache_cleaner();
+    };
+
+    // 静态状态都放在函数内的静态变量中，头文件被多个翻译单元包含时只有一份定义；
+    // 除 trimmer_ 外都是平凡析构的类型，程序退出阶段仍可安全访问
+    static central_list* central_() {
+        static central_list lists[NFREELISTS];
+        return lists;
+    }
+    static thread_cache& cache_() {
+        static thread_local thread_cache cache;
+        return cache;
+    }
 
     // 内存池状态
-    static char* start_free;  // 内存池起始位置
-    static char* end_free;    // 内存池结束位置
-    static size_t heap_size;  // 堆大小
+    static char*& start_free() {                 // 当前内存块中尚未切分的部分
+        static char* p = nullptr;
+        return p;
+    }
+    static char*& end_free() {
+        static char* p = nullptr;
+        return p;
+    }
+    static obj*& spare_units() {                 // 内存块切剩或 trim 回收的 SLAB_UNIT 大小空闲单元
+        static obj* p = nullptr;
+        return p;
+    }
+    static std::atomic<size_t>& heap_size() {    // 当前持有的内存块字节数
+        static std::atomic<size_t> n(0);
+        return n;
+    }
+    static size_t& slab_total() {                // 已切成板的字节数
+        static size_t n = 0;
+        return n;
+    }
+
+    // 线程安全：切分新板与登记时使用
+    static std::mutex& mutex_() {
+        static std::mutex m;
+        return m;
+    }
 
-    // 线程安全
-    static std::mutex mutex_;
+    // trim 状态
+    static std::mutex& trim_mutex_() {
+        static std::mutex m;
+        return m;
+    }
+    static std::atomic<size_t>& central_free_bytes_() {
+        static std::atomic<size_t> n(0);
+        return n;
+    }
+    static std::atomic<size_t>& released_bytes_() {
+        static std::atomic<size_t> n(0);
+        return n;
+    }
+    static std::atomic<size_t>& trim_count_() {
+        static std::atomic<size_t> n(0);
+        return n;
+    }
+    static std::atomic<size_t>& trim_threshold_() {
+        static std::atomic<size_t> n(0);
+        return n;
+    }
+    static std::atomic<size_t>& auto_trim_mark_() {
+        static std::atomic<size_t> n(0);
+        return n;
+    }
+    static std::atomic<bool>& auto_trimming_() {
+        static std::atomic<bool> b(false);
+        return b;
+    }
+    static background_trimmer& trimmer_() {
+        static background_trimmer t;
+        return t;
+    }
 
 private:
-    // 将字节数向上舍入到8的倍数
-    static size_t round_up(size_t bytes) {
-        return ((bytes + ALIGN - 1) & ~(ALIGN - 1));
+    // 将字节数向上舍入到 align 的倍数，align 须为 2 的幂
+    static size_t round_up(size_t bytes, size_t align = ALIGN) {
+        return ((bytes + align - 1) & ~(align - 1));
     }
 
-    // 根据字节数获取自由链表索引
-    static size_t free_list_index(size_t bytes) {
-        return ((bytes + ALIGN - 1) / ALIGN - 1);
+    // 每次在线程缓存与中心池之间转移的对象数
+    static size_t batch_size(size_t index) {
+        size_t n = TRANSFER_BYTES / class_size(index);
+        return n < MIN_TRANSFER_BATCH ? MIN_TRANSFER_BATCH : (n > MAX_TRANSFER_BATCH ? MAX_TRANSFER_BATCH : n);
     }
 
-    // 重新填充自由链表
-    static void* refill(size_t n);
+    // 每个大小类的板大小：至少 SLAB_UNIT，且至少容纳 MIN_SLAB_OBJECTS 个对象
+    static size_t slab_bytes(size_t index) {
+        size_t bytes = class_size(index) * MIN_SLAB_OBJECTS;
+        return bytes < SLAB_UNIT ? SLAB_UNIT : round_up(bytes, SLAB_UNIT);
+    }
+
+    // 无锁栈操作
+    static void push_slot(std::atomic<uint64_t>& top, transfer_batch* slots, uint32_t slot);
+    static bool pop_slot(std::atomic<uint64_t>& top, transfer_batch* slots, uint32_t& slot);
+
+    // 与中心池之间整批转移对象
+    static void release_to_central(size_t index, obj* head, obj* tail, size_t count);
+    static void fetch_from_central(size_t index, obj*& head, obj*& tail, size_t& count);
+
+    // 线程缓存的慢路径
+    static void* allocate_slow(size_t index);
+    static void deallocate_slow(size_t index);
+    static void init_thread_cache();
 
-    // 分配大块内存
-    static char* chunk_alloc(size_t size, int& nobjs);
+    // 从当前板切分一批新对象，调用者需持有该大小类的锁
+    static void refill(size_t index, obj*& head, obj*& tail, size_t& count);
+
+    // 从内存块切出一块板并登记，调用者需持有 mutex_
+    static char* slab_alloc(size_t index, size_t bytes);
+
+    // 登记表，永不析构，保证程序退出阶段仍可分配
+    static std::vector<slab_info>& slab_registry() {
+        static std::vector<slab_info>* slabs = new std::vector<slab_info>();
+        return *slabs;
+    }
+    static std::vector<chunk_info>& chunk_registry() {
+        static std::vector<chunk_info>* chunks = new std::vector<chunk_info>();
+        return *chunks;
+    }
+
+    // 向系统申请、归还内存块，以及释放物理页
+    static char* system_alloc(size_t bytes);
+    static void system_free(char* p, size_t bytes);
+    static void system_decommit(char* p, size_t bytes);
+
+    // trim 的实现，decay 为 true 时至少保留一半可回收内存
+    static size_t trim_impl(size_t keep_bytes, bool decay);
+    static void maybe_auto_trim();
 
 public:
+    // 根据字节数获取大小类（自由链表）索引，bytes 不超过 MAX_BYTES
+    static size_t size_class(size_t bytes) {
+        if (bytes <= SMALL_MAX_BYTES) {
+            return bytes == 0 ? 0 : (bytes + ALIGN - 1) / ALIGN - 1;
+        }
+        const size_t v = bytes - 1;
+        size_t lg = 7;
+        while ((v >> (lg + 1)) != 0) {
+            ++lg;
+        }
+        const size_t base = size_t(1) << lg;
+        return NSMALLCLASSES + (lg - 7) * CLASSES_PER_GROUP + (v - base) / (base / CLASSES_PER_GROUP);
+    }
+
+    // 大小类对应的对象字节数
+    static size_t class_size(size_t index) {
+        if (index < NSMALLCLASSES) {
+            return (index + 1) * ALIGN;
+        }
+        const size_t base = SMALL_MAX_BYTES << ((index - NSMALLCLASSES) / CLASSES_PER_GROUP);
+        return base + ((index - NSMALLCLASSES) % CLASSES_PER_GROUP + 1) * (base / CLASSES_PER_GROUP);
+    }
+
     // 分配内存
     static void* allocate(size_t n);
 
@@ -72,9 +345,48 @@ public:
     // 重新分配内存
     static void* reallocate(void* p, size_t old_sz, size_t new_sz);
 
+    // 原地扩展：p 处的块能容纳 new_sz 字节时返回 true，之后以 new_sz 释放
+    static bool try_expand(void* p, size_t old_sz, size_t new_sz);
+
+    // 申请 bytes 字节时实际得到的块大小：小块为所在大小类，大块为 malloc 块的可用字节
+    static size_t good_size(size_t bytes) {
+        return bytes <= MAX_BYTES ? class_size(size_class(bytes)) : malloc_good_size(bytes);
+    }
+
+    // 将当前线程缓存的对象全部归还中心池
+    static void flush_thread_cache();
+
+    /**
+     * @brief 将完全空闲的内存归还系统
+     * @param keep_bytes 至多保留这么多可回收的空闲内存，供后续分配复用
+     * @return 本次归还的字节数
+     * @note 只统计中心池与当前线程缓存；其他线程缓存中的对象仍视为在用
+     */
+    static size_t trim(size_t keep_bytes = 0) { return trim_impl(keep_bytes, false); }
+
+    /**
+     * @brief 设置自动 trim 阈值，中心池空闲字节数超过阈值时在释放路径上自动 trim
+     * @param bytes 阈值，0 表示关闭（默认）
+     */
+    static void set_trim_threshold(size_t bytes) {
+        trim_threshold_().store(bytes, std::memory_order_relaxed);
+        auto_trim_mark_().store(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 启动后台 trim 线程，每隔 interval 归还一半可回收内存，直到不超过 keep_bytes
+     */
+    static void start_background_trim(std::chrono::milliseconds interval, size_t keep_bytes = 0);
+
+    // 停止后台 trim 线程
+    static void stop_background_trim();
+
     // 获取内存池状态
-    static size_t get_heap_size() { return heap_size; }
+    static size_t get_heap_size() { return heap_size().load(std::memory_order_relaxed); }
     static size_t get_free_list_size(size_t index);
+    static size_t get_slab_count(size_t index);
+    static alloc_stats get_stats();
+    static size_t get_rss();
     static void print_memory_pool_status();
 };
 
@@ -82,38 +394,29 @@ public:
 // 内存池实现
 // ============================================================================
 
-// 静态成员定义
-alloc::obj* alloc::free_list[NFREELISTS] = {0};
-char* alloc::start_free = 0;
-char* alloc::end_free = 0;
-size_t alloc::heap_size = 0;
-std::mutex alloc::mutex_;
-
-void* alloc::allocate(size_t n) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
+inline void* alloc::allocate(size_t n) {
     if (n > MAX_BYTES) {
         // 大块内存直接使用 malloc
         return std::malloc(n);
     }
 
-    // 获取自由链表索引
-    size_t index = free_list_index(n);
-    obj* result = free_list[index];
+    // 获取大小类索引，0 字节按 1 字节处理
+    size_t index = size_class(n);
+    thread_cache& cache = cache_();
+    obj* result = cache.list[index];
 
     if (result == nullptr) {
-        // 自由链表为空，重新填充
-        return refill(round_up(n));
+        // 线程缓存为空，从中心池取一批
+        return allocate_slow(index);
     }
 
-    // 从自由链表中取出一个节点
-    free_list[index] = result->next;
+    // 从线程缓存中取出一个节点，无需加锁
+    cache.list[index] = result->next;
+    --cache.length[index];
     return result;
 }
 
-void alloc::deallocate(void* p, size_t n) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
+inline void alloc::deallocate(void* p, size_t n) {
     if (p == nullptr) {
         return;
     }
@@ -124,14 +427,18 @@ void alloc::deallocate(void* p, size_t n) {
         return;
     }
 
-    // 将内存块放回自由链表
+    // 将内存块放回线程缓存，过长时整批归还中心池
     obj* q = static_cast<obj*>(p);
-    size_t index = free_list_index(n);
-    q->next = free_list[index];
-    free_list[index] = q;
+    size_t index = size_class(n);
+    thread_cache& cache = cache_();
+    q->next = cache.list[index];
+    cache.list[index] = q;
+    if (++cache.length[index] > cache.limit[index]) {
+        deallocate_slow(index);
+    }
 }
 
-void* alloc::reallocate(void* p, size_t old_sz, size_t new_sz) {
+inline void* alloc::reallocate(void* p, size_t old_sz, size_t new_sz) {
     if (p == nullptr) {
         return allocate(new_sz);
     }
@@ -141,10 +448,16 @@ void* alloc::reallocate(void* p, size_t old_sz, size_t new_sz) {
         return nullptr;
     }
 
-    if (old_sz == new_sz) {
+    // 同一大小类内或大块余量足够时无需搬移
+    if (old_sz == new_sz || try_expand(p, old_sz, new_sz)) {
         return p;
     }
 
+    // 两端都是 malloc 管理的大块：交给 realloc，可能原地扩展或按页搬移
+    if (old_sz > MAX_BYTES && new_sz > MAX_BYTES) {
+        return std::realloc(p, new_sz);
+    }
+
     // 分配新内存
     void* new_p = allocate(new_sz);
     if (new_p == nullptr) {
@@ -161,114 +474,635 @@ void* alloc::reallocate(void* p, size_t old_sz, size_t new_sz) {
     return new_p;
 }
 
-void* alloc::refill(size_t n) {
-    int nobjs = 20;  // 尝试获取20个对象
-    char* chunk = chunk_alloc(n, nobjs);
+inline bool alloc::try_expand(void* p, size_t old_sz, size_t new_sz) {
+    if (p == nullptr) {
+        return false;
+    }
+    if (old_sz <= MAX_BYTES) {
+        // 小块：新大小落在同一大小类时，对象本身已有足够字节
+        return new_sz <= MAX_BYTES && size_class(old_sz) == size_class(new_sz);
+    }
+    if (new_sz <= MAX_BYTES) {
+        return false;
+    }
+#if defined(MYSTL_HAS_MALLOC_USABLE_SIZE)
+    // 大块：malloc 块的实际可用字节
+    return ::malloc_usable_size(p) >= new_sz;
+#else
+    return new_sz <= old_sz;
+#endif
+}
+
+inline void alloc::push_slot(std::atomic<uint64_t>& top, transfer_batch* slots, uint32_t slot) {
+    uint64_t old_top = top.load(std::memory_order_relaxed);
+    for (;;) {
+        slots[slot].next.store(static_cast<uint32_t>(old_top), std::memory_order_relaxed);
+        uint64_t new_top = (((old_top >> 32) + 1) << 32) | (slot + 1);
+        if (top.compare_exchange_weak(old_top, new_top, std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+inline bool alloc::pop_slot(std::atomic<uint64_t>& top, transfer_batch* slots, uint32_t& slot) {
+    uint64_t old_top = top.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t index = static_cast<uint32_t>(old_top);
+        if (index == 0) {
+            return false;
+        }
+        // 槽位从不释放，即使已被其他线程弹出，读取 next 也是安全的；版本号保证此时 CAS 失败
+        uint32_t next = slots[index - 1].next.load(std::memory_order_relaxed);
+        uint64_t new_top = (((old_top >> 32) + 1) << 32) | next;
+        if (top.compare_exchange_weak(old_top, new_top, std::memory_order_acquire,
+                                      std::memory_order_acquire)) {
+            slot = index - 1;
+            return true;
+        }
+    }
+}
+
+inline void alloc::release_to_central(size_t index, obj* head, obj* tail, size_t count) {
+    central_list& c = central_()[index];
+    c.free_count.fetch_add(count, std::memory_order_relaxed);
+    central_free_bytes_().fetch_add(count * class_size(index), std::memory_order_relaxed);
+
+    // 优先放入无锁槽位：先复用空槽位，再启用新槽位
+    uint32_t slot;
+    bool found = pop_slot(c.empty, c.slots, slot);
+    if (!found) {
+        uint32_t used = c.fresh.load(std::memory_order_relaxed);
+        while (used < TRANSFER_SLOTS &&
+               !c.fresh.compare_exchange_weak(used, used + 1, std::memory_order_relaxed)) {
+        }
+        if (used < TRANSFER_SLOTS) {
+            slot = used;
+            found = true;
+        }
+    }
+    if (found) {
+        c.slots[slot].head = head;
+        c.slots[slot].tail = tail;
+        c.slots[slot].count = count;
+        push_slot(c.full, c.slots, slot);
+        return;
+    }
+
+    // 槽位用尽，接到溢出链表头部
+    std::lock_guard<std::mutex> lock(c.mutex);
+    tail->next = c.overflow;
+    c.overflow = head;
+    c.overflow_count += count;
+}
+
+inline void alloc::fetch_from_central(size_t index, obj*& head, obj*& tail, size_t& count) {
+    central_list& c = central_()[index];
+
+    uint32_t slot;
+    if (pop_slot(c.full, c.slots, slot)) {
+        head = c.slots[slot].head;
+        tail = c.slots[slot].tail;
+        count = c.slots[slot].count;
+        push_slot(c.empty, c.slots, slot);
+        c.free_count.fetch_sub(count, std::memory_order_relaxed);
+        central_free_bytes_().fetch_sub(count * class_size(index), std::memory_order_relaxed);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if (c.overflow == nullptr) {
+        // 中心池为空，从板中切分新对象
+        refill(index, head, tail, count);
+        return;
+    }
+    const size_t batch = batch_size(index);
+    head = c.overflow;
+    tail = head;
+    count = 1;
+    while (count < batch && tail->next != nullptr) {
+        tail = tail->next;
+        ++count;
+    }
+    c.overflow = tail->next;
+    c.overflow_count -= count;
+    tail->next = nullptr;
+    c.free_count.fetch_sub(count, std::memory_order_relaxed);
+    central_free_bytes_().fetch_sub(count * class_size(index), std::memory_order_relaxed);
+}
+
+inline void* alloc::allocate_slow(size_t index) {
+    thread_cache& cache = cache_();
+    if (!cache.initialized) {
+        init_thread_cache();
+    }
+
+    obj* head;
+    obj* tail;
+    size_t count;
+    fetch_from_central(index, head, tail, count);
+
+    obj* result = head;
+    if (count > 1) {
+        if (cache.destroyed) {
+            // 线程正在退出，剩余对象直接还给中心池
+            release_to_central(index, head->next, tail, count - 1);
+        } else {
+            cache.list[index] = head->next;
+            cache.length[index] = count - 1;
+        }
+    }
+    return result;
+}
+
+inline void alloc::deallocate_slow(size_t index) {
+    thread_cache& cache = cache_();
+    if (!cache.initialized) {
+        init_thread_cache();
+    }
+
+    obj* head = cache.list[index];
+    if (cache.destroyed) {
+        // 线程正在退出，不再缓存
+        cache.list[index] = nullptr;
+        cache.length[index] = 0;
+        obj* tail = head;
+        size_t count = 1;
+        while (tail->next != nullptr) {
+            tail = tail->next;
+            ++count;
+        }
+        release_to_central(index, head, tail, count);
+        return;
+    }
+    if (cache.length[index] <= cache.limit[index]) {
+        return;
+    }
+
+    // 从链表头部截下一批归还中心池，其余留作缓存
+    const size_t batch = batch_size(index);
+    obj* tail = head;
+    for (size_t i = 1; i < batch; ++i) {
+        tail = tail->next;
+    }
+    cache.list[index] = tail->next;
+    cache.length[index] -= batch;
+    tail->next = nullptr;
+    release_to_central(index, head, tail, batch);
+    maybe_auto_trim();
+}
+
+inline void alloc::init_thread_cache() {
+    thread_cache& cache = cache_();
+    for (size_t index = 0; index < NFREELISTS; ++index) {
+        cache.limit[index] = 2 * batch_size(index);
+    }
+    cache.initialized = true;
+    // 首次使用时构造，线程退出时析构
+    static thread_local thread_cache_cleaner cleaner;
+    (void)cleaner;
+}
 
-    if (nobjs == 1) {
-        return chunk;
+inline alloc::thread_cache_cleaner::~thread_cache_cleaner() {
+    alloc::flush_thread_cache();
+    thread_cache& cache = cache_();
+    for (size_t index = 0; index < NFREELISTS; ++index) {
+        cache.limit[index] = 0;
     }
+    cache.destroyed = true;
+}
 
-    // 将剩余的内存块加入自由链表
-    obj* result = reinterpret_cast<obj*>(chunk);
-    obj* current = result;
-    obj* next;
+inline void alloc::flush_thread_cache() {
+    thread_cache& cache = cache_();
+    for (size_t index = 0; index < NFREELISTS; ++index) {
+        const size_t batch = batch_size(index);
+        while (cache.list[index] != nullptr) {
+            obj* head = cache.list[index];
+            obj* tail = head;
+            size_t count = 1;
+            while (count < batch && tail->next != nullptr) {
+                tail = tail->next;
+                ++count;
+            }
+            cache.list[index] = tail->next;
+            cache.length[index] -= count;
+            tail->next = nullptr;
+            release_to_central(index, head, tail, count);
+        }
+    }
+}
 
-    for (int i = 1; i < nobjs; ++i) {
-        next = reinterpret_cast<obj*>(chunk + i * n);
+inline void alloc::refill(size_t index, obj*& head, obj*& tail, size_t& count) {
+    central_list& c = central_()[index];
+    const size_t n = class_size(index);
+
+    if (static_cast<size_t>(c.slab_end - c.slab_cur) < n) {
+        // 当前板已切完，切出一块新板；板尾不足一个对象的部分舍弃
+        const size_t bytes = slab_bytes(index);
+        char* slab;
+        {
+            std::lock_guard<std::mutex> lock(mutex_());
+            slab = slab_alloc(index, bytes);
+        }
+        c.slab_cur = slab;
+        c.slab_end = slab + bytes / n * n;
+        ++c.slab_count;
+    }
+
+    // 从板中切出一批对象并串成链表
+    const size_t available = static_cast<size_t>(c.slab_end - c.slab_cur) / n;
+    const size_t batch = batch_size(index);
+    count = available < batch ? available : batch;
+    char* chunk = c.slab_cur;
+    c.slab_cur += count * n;
+    c.carved += count;
+
+    head = reinterpret_cast<obj*>(chunk);
+    obj* current = head;
+    for (size_t i = 1; i < count; ++i) {
+        obj* next = reinterpret_cast<obj*>(chunk + i * n);
         current->next = next;
         current = next;
     }
-
     current->next = nullptr;
+    tail = current;
+}
 
-    // 将第一个节点加入自由链表
-    size_t index = free_list_index(n);
-    free_list[index] = result->next;
+inline char* alloc::slab_alloc(size_t index, size_t bytes) {
+    char* result;
+    if (bytes == SLAB_UNIT && spare_units() != nullptr) {
+        // 优先使用备用单元
+        obj* unit = spare_units();
+        spare_units() = unit->next;
+        result = reinterpret_cast<char*>(unit);
+    } else {
+        if (static_cast<size_t>(end_free() - start_free()) < bytes) {
+            // 内存块空间不足：剩余部分按 SLAB_UNIT 切开留作备用，再申请新内存块
+            while (static_cast<size_t>(end_free() - start_free()) >= SLAB_UNIT) {
+                obj* unit = reinterpret_cast<obj*>(start_free());
+                unit->next = spare_units();
+                spare_units() = unit;
+                start_free() += SLAB_UNIT;
+            }
 
+            size_t bytes_to_get = (bytes > CHUNK_BYTES ? bytes : CHUNK_BYTES) +
+                                  (heap_size().load(std::memory_order_relaxed) >> 4);
+            bytes_to_get = round_up(bytes_to_get, SLAB_UNIT);
+            char* chunk = system_alloc(bytes_to_get);
+            if (chunk == nullptr) {
+                throw std::bad_alloc();
+            }
+            chunk_info info = {chunk, bytes_to_get, 0, false};
+            chunk_registry().push_back(info);
+            heap_size().fetch_add(bytes_to_get, std::memory_order_relaxed);
+            start_free() = chunk;
+            end_free() = chunk + bytes_to_get;
+        }
+        result = start_free();
+        start_free() += bytes;
+    }
+
+    slab_info info = {result, bytes, index, 0, false, false};
+    slab_registry().push_back(info);
+    slab_total() += bytes;
     return result;
 }
 
-char* alloc::chunk_alloc(size_t size, int& nobjs) {
-    char* result;
-    size_t total_bytes = size * nobjs;
-    size_t bytes_left = end_free - start_free;
+inline char* alloc::system_alloc(size_t bytes) {
+#ifdef MYSTL_ALLOC_HAS_MMAP
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return p == MAP_FAILED ? nullptr : static_cast<char*>(p);
+#else
+    return static_cast<char*>(std::malloc(bytes));
+#endif
+}
 
-    if (bytes_left >= total_bytes) {
-        // 内存池有足够空间
-        result = start_free;
-        start_free += total_bytes;
-        return result;
-    } else if (bytes_left >= size) {
-        // 内存池有部分空间
-        nobjs = bytes_left / size;
-        total_bytes = size * nobjs;
-        result = start_free;
-        start_free += total_bytes;
-        return result;
-    } else {
-        // 内存池空间不足，需要重新分配
-        size_t bytes_to_get = 2 * total_bytes + round_up(heap_size >> 4);
-
-        // 将剩余空间加入自由链表
-        if (bytes_left > 0) {
-            size_t index = free_list_index(bytes_left);
-            obj* obj_ptr = reinterpret_cast<obj*>(start_free);
-            obj_ptr->next = free_list[index];
-            free_list[index] = obj_ptr;
-        }
-
-        // 分配新内存
-        start_free = static_cast<char*>(std::malloc(bytes_to_get));
-        if (start_free == nullptr) {
-            // 分配失败，尝试从自由链表中获取内存
-            for (size_t i = size; i <= MAX_BYTES; i += ALIGN) {
-                size_t index = free_list_index(i);
-                obj* obj_ptr = free_list[index];
-                if (obj_ptr != nullptr) {
-                    free_list[index] = obj_ptr->next;
-                    start_free = reinterpret_cast<char*>(obj_ptr);
-                    end_free = start_free + i;
-                    return chunk_alloc(size, nobjs);
-                }
+inline void alloc::system_free(char* p, size_t bytes) {
+#ifdef MYSTL_ALLOC_HAS_MMAP
+    ::munmap(p, bytes);
+#else
+    (void)bytes;
+    std::free(p);
+#endif
+}
+
+inline void alloc::system_decommit(char* p, size_t bytes) {
+#ifdef MYSTL_ALLOC_HAS_MMAP
+    // 页仍然可读写，再次访问时得到清零的新页
+    ::madvise(p, bytes, MADV_DONTNEED);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+inline size_t alloc::trim_impl(size_t keep_bytes, bool decay) {
+    flush_thread_cache();
+
+    // 加锁顺序与 refill 一致：先大小类的锁，再 mutex_
+    std::lock_guard<std::mutex> trim_lock(trim_mutex_());
+    std::unique_lock<std::mutex> class_locks[NFREELISTS];
+    for (size_t i = 0; i < NFREELISTS; ++i) {
+        class_locks[i] = std::unique_lock<std::mutex>(central_()[i].mutex);
+    }
+    std::lock_guard<std::mutex> pool_lock(mutex_());
+    trim_count_().fetch_add(1, std::memory_order_relaxed);
+
+    // 1. 取出中心池中的全部空闲对象。其他线程仍可无锁地放入或取走批次，
+    //    那些对象不在统计之内，所在的板不会被判定为空闲
+    obj* drained[NFREELISTS];
+    for (size_t i = 0; i < NFREELISTS; ++i) {
+        central_list& c = central_()[i];
+        obj* list = c.overflow;
+        size_t count = c.overflow_count;
+        c.overflow = nullptr;
+        c.overflow_count = 0;
+        uint32_t slot;
+        while (pop_slot(c.full, c.slots, slot)) {
+            c.slots[slot].tail->next = list;
+            list = c.slots[slot].head;
+            count += c.slots[slot].count;
+            push_slot(c.empty, c.slots, slot);
+        }
+        drained[i] = list;
+        c.free_count.fetch_sub(count, std::memory_order_relaxed);
+        central_free_bytes_().fetch_sub(count * class_size(i), std::memory_order_relaxed);
+    }
+
+    // 2. 按地址统计每块板的空闲对象，判定完全空闲的板
+    std::vector<slab_info>& slabs = slab_registry();
+    std::vector<chunk_info>& chunks = chunk_registry();
+    std::sort(slabs.begin(), slabs.end(),
+              [](const slab_info& a, const slab_info& b) { return a.base < b.base; });
+    std::sort(chunks.begin(), chunks.end(),
+              [](const chunk_info& a, const chunk_info& b) { return a.base < b.base; });
+    auto find_slab = [&slabs](const char* p) {
+        return std::upper_bound(slabs.begin(), slabs.end(), p,
+                                [](const char* q, const slab_info& s) { return q < s.base; }) - 1;
+    };
+    auto find_chunk = [&chunks](const char* p) {
+        return std::upper_bound(chunks.begin(), chunks.end(), p,
+                                [](const char* q, const chunk_info& c) { return q < c.base; }) - 1;
+    };
+    for (auto& s : slabs) {
+        s.free_objects = 0;
+        s.drop = false;
+    }
+    for (auto& ch : chunks) {
+        ch.free_bytes = 0;
+        ch.drop = false;
+    }
+    for (size_t i = 0; i < NFREELISTS; ++i) {
+        for (obj* p = drained[i]; p != nullptr; p = p->next) {
+            ++find_slab(reinterpret_cast<char*>(p))->free_objects;
+        }
+    }
+    // 当前板中尚未切分的部分也是空闲的
+    auto uncarved = [](const slab_info& s) -> size_t {
+        const central_list& c = central_()[s.index];
+        if (c.slab_end > s.base && c.slab_end <= s.base + s.bytes) {
+            return static_cast<size_t>(c.slab_end - c.slab_cur) / class_size(s.index);
+        }
+        return 0;
+    };
+    size_t reclaimable = 0;
+    for (auto& s : slabs) {
+        s.empty = s.free_objects + uncarved(s) == s.bytes / class_size(s.index);
+        if (s.empty) {
+            find_chunk(s.base)->free_bytes += s.bytes;
+            reclaimable += s.bytes;
+        }
+    }
+    for (obj* u = spare_units(); u != nullptr; u = u->next) {
+        find_chunk(reinterpret_cast<char*>(u))->free_bytes += SLAB_UNIT;
+    }
+    if (end_free() != start_free()) {
+        find_chunk(start_free())->free_bytes += static_cast<size_t>(end_free() - start_free());
+    }
+
+    // 3. 决定回收哪些内存：先整块归还完全空闲的内存块，再释放其余空闲板的物理页
+    if (decay && keep_bytes < reclaimable / 2) {
+        keep_bytes = reclaimable / 2;
+    }
+    size_t released = 0;
+    for (auto& ch : chunks) {
+        if (ch.free_bytes == ch.bytes && reclaimable > keep_bytes) {
+            ch.drop = true;
+            reclaimable -= ch.bytes < reclaimable ? ch.bytes : reclaimable;
+        }
+    }
+    for (auto& s : slabs) {
+        if (s.empty && (find_chunk(s.base)->drop || reclaimable > keep_bytes)) {
+            if (!find_chunk(s.base)->drop) {
+                reclaimable -= s.bytes;
             }
-            // 所有尝试都失败
-            end_free = nullptr;
-            throw std::bad_alloc();
+            s.drop = true;
+        }
+    }
+
+    // 4. 不回收的空闲对象放回中心池
+    for (size_t i = 0; i < NFREELISTS; ++i) {
+        central_list& c = central_()[i];
+        size_t kept = 0;
+        obj* p = drained[i];
+        while (p != nullptr) {
+            obj* next = p->next;
+            if (!find_slab(reinterpret_cast<char*>(p))->drop) {
+                p->next = c.overflow;
+                c.overflow = p;
+                ++kept;
+            }
+            p = next;
+        }
+        c.overflow_count = kept;
+        c.free_count.fetch_add(kept, std::memory_order_relaxed);
+        central_free_bytes_().fetch_add(kept * class_size(i), std::memory_order_relaxed);
+    }
+
+    // 5. 回收板：所在内存块保留的，释放物理页后拆成备用单元
+    for (auto& s : slabs) {
+        if (!s.drop) {
+            continue;
+        }
+        central_list& c = central_()[s.index];
+        const size_t objects = s.bytes / class_size(s.index);
+        const size_t left = uncarved(s);
+        c.carved -= objects - left;
+        --c.slab_count;
+        if (c.slab_end > s.base && c.slab_end <= s.base + s.bytes) {
+            c.slab_cur = nullptr;
+            c.slab_end = nullptr;
+        }
+        slab_total() -= s.bytes;
+        if (!find_chunk(s.base)->drop) {
+            system_decommit(s.base, s.bytes);
+            for (char* u = s.base; u < s.base + s.bytes; u += SLAB_UNIT) {
+                obj* unit = reinterpret_cast<obj*>(u);
+                unit->next = spare_units();
+                spare_units() = unit;
+            }
+            released += s.bytes;
+        }
+    }
+    slabs.erase(std::remove_if(slabs.begin(), slabs.end(), [](const slab_info& s) { return s.drop; }),
+                slabs.end());
+
+    // 6. 归还完全空闲的内存块，先摘掉其中的备用单元
+    obj** link = &spare_units();
+    while (*link != nullptr) {
+        if (find_chunk(reinterpret_cast<char*>(*link))->drop) {
+            *link = (*link)->next;
+        } else {
+            link = &(*link)->next;
+        }
+    }
+    if (end_free() != start_free() && find_chunk(start_free())->drop) {
+        start_free() = nullptr;
+        end_free() = nullptr;
+    }
+    for (auto& ch : chunks) {
+        if (ch.drop) {
+            system_free(ch.base, ch.bytes);
+            heap_size().fetch_sub(ch.bytes, std::memory_order_relaxed);
+            released += ch.bytes;
         }
+    }
+    chunks.erase(std::remove_if(chunks.begin(), chunks.end(), [](const chunk_info& c) { return c.drop; }),
+                 chunks.end());
+
+    released_bytes_().fetch_add(released, std::memory_order_relaxed);
+    return released;
+}
+
+inline void alloc::maybe_auto_trim() {
+    const size_t threshold = trim_threshold_().load(std::memory_order_relaxed);
+    if (threshold == 0 ||
+        central_free_bytes_().load(std::memory_order_relaxed) <= auto_trim_mark_().load(std::memory_order_relaxed) ||
+        auto_trimming_().exchange(true, std::memory_order_acquire)) {
+        return;
+    }
+    trim_impl(threshold / 2, false);
+    // 剩余空闲对象多半分散在仍在用的板上，空闲量再翻倍之前不再触发，避免反复扫描
+    const size_t left = central_free_bytes_().load(std::memory_order_relaxed);
+    auto_trim_mark_().store(left > threshold / 2 ? 2 * left : threshold, std::memory_order_relaxed);
+    auto_trimming_().store(false, std::memory_order_release);
+}
+
+inline void alloc::start_background_trim(std::chrono::milliseconds interval, size_t keep_bytes) {
+    stop_background_trim();
+    std::lock_guard<std::mutex> lock(trimmer_().mutex);
+    trimmer_().stop = false;
+    trimmer_().thread = std::thread([interval, keep_bytes] {
+        std::unique_lock<std::mutex> lock(trimmer_().mutex);
+        while (!trimmer_().cv.wait_for(lock, interval, [] { return trimmer_().stop; })) {
+            lock.unlock();
+            trim_impl(keep_bytes, true);
+            lock.lock();
+        }
+    });
+}
+
+inline void alloc::stop_background_trim() {
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(trimmer_().mutex);
+        trimmer_().stop = true;
+        worker.swap(trimmer_().thread);
+    }
+    trimmer_().cv.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+inline alloc::background_trimmer::~background_trimmer() {
+    alloc::stop_background_trim();
+}
 
-        heap_size += bytes_to_get;
-        end_free = start_free + bytes_to_get;
-        return chunk_alloc(size, nobjs);
+inline size_t alloc::get_free_list_size(size_t index) {
+    if (index >= NFREELISTS) {
+        return 0;
     }
+
+    // 中心池加上当前线程的缓存；其他线程的缓存不计入
+    return central_()[index].free_count.load(std::memory_order_relaxed) + cache_().length[index];
 }
 
-size_t alloc::get_free_list_size(size_t index) {
+inline size_t alloc::get_slab_count(size_t index) {
     if (index >= NFREELISTS) {
         return 0;
     }
 
-    size_t count = 0;
-    obj* current = free_list[index];
-    while (current != nullptr) {
-        ++count;
-        current = current->next;
+    std::lock_guard<std::mutex> lock(central_()[index].mutex);
+    return central_()[index].slab_count;
+}
+
+inline alloc_stats alloc::get_stats() {
+    alloc_stats stats = alloc_stats();
+    for (size_t i = 0; i < NFREELISTS; ++i) {
+        size_t carved;
+        {
+            std::lock_guard<std::mutex> lock(central_()[i].mutex);
+            carved = central_()[i].carved;
+        }
+        const size_t free = central_()[i].free_count.load(std::memory_order_relaxed);
+        stats.allocated_bytes += (carved > free ? carved - free : 0) * class_size(i);
+        stats.central_free_bytes += free * class_size(i);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_());
+        stats.slab_bytes = slab_total();
+    }
+    stats.heap_bytes = get_heap_size();
+    stats.released_bytes = released_bytes_().load(std::memory_order_relaxed);
+    stats.trim_count = trim_count_().load(std::memory_order_relaxed);
+    stats.rss_bytes = get_rss();
+    return stats;
+}
+
+inline size_t alloc::get_rss() {
+#if defined(__linux__)
+    // /proc/self/statm 第二列为常驻页数
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (f == nullptr) {
+        return 0;
     }
-    return count;
+    unsigned long total = 0;
+    unsigned long resident = 0;
+    const int n = std::fscanf(f, "%lu %lu", &total, &resident);
+    std::fclose(f);
+    return n == 2 ? static_cast<size_t>(resident) * static_cast<size_t>(::sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
 }
 
-void alloc::print_memory_pool_status() {
+inline void alloc::print_memory_pool_status() {
+    char* start;
+    char* end;
+    {
+        std::lock_guard<std::mutex> lock(mutex_());
+        start = start_free();
+        end = end_free();
+    }
+    const alloc_stats stats = get_stats();
     std::cout << "=== 内存池状态 ===" << std::endl;
-    std::cout << "堆大小: " << heap_size << " 字节" << std::endl;
-    std::cout << "内存池起始: " << static_cast<void*>(start_free) << std::endl;
-    std::cout << "内存池结束: " << static_cast<void*>(end_free) << std::endl;
+    std::cout << "堆大小: " << stats.heap_bytes << " 字节" << std::endl;
+    std::cout << "已切成板: " << stats.slab_bytes << " 字节，在用 " << stats.allocated_bytes
+              << " 字节，中心池空闲 " << stats.central_free_bytes << " 字节" << std::endl;
+    std::cout << "累计归还系统: " << stats.released_bytes << " 字节（trim " << stats.trim_count
+              << " 次），进程常驻内存: " << stats.rss_bytes << " 字节" << std::endl;
+    std::cout << "内存池起始: " << static_cast<void*>(start) << std::endl;
+    std::cout << "内存池结束: " << static_cast<void*>(end) << std::endl;
     std::cout << "自由链表状态:" << std::endl;
     
     for (size_t i = 0; i < NFREELISTS; ++i) {
-        size_t size = (i + 1) * ALIGN;
+        size_t size = class_size(i);
         size_t count = get_free_list_size(i);
-        if (count > 0) {
-            std::cout << "  大小 " << size << " 字节: " << count << " 个块" << std::endl;
+        size_t slabs = get_slab_count(i);
+        if (count > 0 || slabs > 0) {
+            std::cout << "  大小 " << size << " 字节: " << count << " 个块，" << slabs << " 块板（每块 "
+                      << slab_bytes(i) << " 字节）" << std::endl;
         }
     }
 }
@@ -335,6 +1169,32 @@ public:
         }
     }
 
+    // 原地扩展：同一大小类内或 malloc 大块余量足够时成功
+    bool try_expand(pointer p, size_type old_n, size_type new_n) noexcept {
+        return new_n <= max_size() && alloc::try_expand(p, old_n * sizeof(T), new_n * sizeof(T));
+    }
+
+    // 申请 n 个对象时整块实际能容纳的对象数，不小于 n
+    size_type good_size(size_type n) const noexcept {
+        if (n == 0 || n > max_size()) {
+            return n;
+        }
+        const size_type fit = alloc::good_size(n * sizeof(T)) / sizeof(T);
+        return fit < n ? n : fit;
+    }
+
+    // 按字节重新分配（alloc::reallocate），只适用于可平凡重定位的类型；失败时原块不变
+    pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+        if (new_n == 0 || new_n > max_size()) {
+            throw std::bad_alloc();
+        }
+        pointer result = static_cast<pointer>(alloc::reallocate(p, old_n * sizeof(T), new_n * sizeof(T)));
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
     template<typename U, typename... Args>
     void construct(U* p, Args&&... args) {
         mystl::construct(p, std::forward<Args>(args)...);
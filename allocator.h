@@ -2,13 +2,83 @@
 #define MYTINYSTL_ALLOCATOR_H_
 
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <new>
 #include <type_traits>
 #include "construct.h"
 #include "exceptdef.h"
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#ifndef MYSTL_HAS_MALLOC_USABLE_SIZE
+#define MYSTL_HAS_MALLOC_USABLE_SIZE 1
+#endif
+#endif
+
 namespace mystl {
 
+// ============================================================================
+// 对齐内存分配
+// ============================================================================
+
+/**
+ * @brief 对齐内存分配
+ * @param size 分配大小
+ * @param alignment 对齐要求，须为 2 的幂，小于指针对齐时按指针对齐处理
+ * @return 对齐的内存指针，失败或 alignment 不是 2 的幂时返回 nullptr
+ *
+ * 多申请 alignment - 1 + sizeof(void*) 字节，对齐后把 malloc 返回的原始地址
+ * 保存在返回地址之前，aligned_free 据此释放。
+ */
+inline void* aligned_alloc(size_t size, size_t alignment) {
+    if (alignment < alignof(void*)) {
+        alignment = alignof(void*);
+    }
+    if ((alignment & (alignment - 1)) != 0 || size > SIZE_MAX - alignment - sizeof(void*)) {
+        return nullptr;
+    }
+    void* raw = std::malloc(size + alignment - 1 + sizeof(void*));
+    if (raw == nullptr) {
+        return nullptr;
+    }
+
+    // 计算对齐地址，并在其前面记录原始地址
+    uintptr_t addr = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+    uintptr_t aligned_addr = (addr + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    reinterpret_cast<void**>(aligned_addr)[-1] = raw;
+    return reinterpret_cast<void*>(aligned_addr);
+}
+
+/**
+ * @brief 对齐内存释放
+ * @param ptr aligned_alloc 返回的指针，可以为 nullptr
+ */
+inline void aligned_free(void* ptr) {
+    if (ptr != nullptr) {
+        std::free(static_cast<void**>(ptr)[-1]);
+    }
+}
+
+/**
+ * @brief malloc(bytes) 返回的块至少能用的字节数，用于把容量凑满整块
+ * @param bytes 申请的字节数
+ *
+ * glibc 的块以 16 字节为粒度、带 8 字节头部，最小 24 字节可用；其他平台按申请值返回。
+ */
+inline size_t malloc_good_size(size_t bytes) noexcept {
+#if defined(MYSTL_HAS_MALLOC_USABLE_SIZE)
+    if (bytes > SIZE_MAX - 23) {
+        return bytes;
+    }
+    const size_t usable = ((bytes + 8 + 15) & ~static_cast<size_t>(15)) - 8;
+    return usable < 24 ? 24 : usable;
+#else
+    return bytes;
+#endif
+}
+
 // ============================================================================
 // 标准分配器
 // ============================================================================
@@ -16,6 +86,9 @@ namespace mystl {
 /**
  * @brief 标准分配器模板类
  * @tparam T 分配的对象类型
+ *
+ * alignof(T) 超过 operator new 保证的对齐（alignof(std::max_align_t)）时，
+ * 改用 aligned_alloc/aligned_free，保证过对齐类型（如 alignas(64) 的结构体）的地址正确。
  */
 template<typename T>
 class allocator {
@@ -62,7 +135,9 @@ public:
         }
         
         size_type total_size = n * sizeof(T);
-        pointer result = static_cast<pointer>(::operator new(total_size));
+        pointer result = over_aligned
+            ? static_cast<pointer>(mystl::aligned_alloc(total_size, alignof(T)))
+            : static_cast<pointer>(::operator new(total_size));
         
         if (result == nullptr) {
             throw std::bad_alloc();
@@ -74,7 +149,11 @@ public:
     // 内存释放
     void deallocate(pointer p, size_type n) {
         if (p != nullptr) {
-            ::operator delete(p);
+            if (over_aligned) {
+                mystl::aligned_free(p);
+            } else {
+                ::operator delete(p);
+            }
         }
     }
 
@@ -105,8 +184,15 @@ public:
     bool operator!=(const allocator<U>&) const noexcept {
         return false;
     }
+
+private:
+    // operator new 只保证 max_align_t 的对齐
+    static constexpr bool over_aligned = alignof(T) > alignof(std::max_align_t);
 };
 
+template<typename T>
+constexpr bool allocator<T>::over_aligned;
+
 // ============================================================================
 // 特化分配器
 // ============================================================================
@@ -127,10 +213,321 @@ public:
     };
 };
 
+// ============================================================================
+// 对齐分配器
+// ============================================================================
+
+/**
+ * @brief 按指定字节数对齐的分配器
+ * @tparam T 分配的对象类型
+ * @tparam Align 对齐字节数，须为 2 的幂；小于 alignof(T) 时按 alignof(T)
+ *
+ * 例如 mystl::vector<float, mystl::aligned_allocator<float, 64>> 的 data() 始终 64 字节对齐，
+ * SIMD 内核可以直接使用对齐加载。分配大小向上取整到对齐的倍数，
+ * 处理尾部时整向量加载不会越过分配的内存。
+ */
+template<typename T, size_t Align = 64>
+class aligned_allocator {
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0, "aligned_allocator: Align 必须是 2 的幂");
+
+public:
+    // 类型定义
+    typedef T            value_type;
+    typedef T*           pointer;
+    typedef const T*     const_pointer;
+    typedef T&           reference;
+    typedef const T&     const_reference;
+    typedef size_t       size_type;
+    typedef ptrdiff_t    difference_type;
+
+    // 实际使用的对齐字节数
+    static constexpr size_t alignment = Align > alignof(T) ? Align : alignof(T);
+
+    // 分配器特征
+    template<typename U>
+    struct rebind {
+        typedef aligned_allocator<U, Align> other;
+    };
+
+public:
+    // 构造函数和析构函数
+    aligned_allocator() noexcept = default;
+    aligned_allocator(const aligned_allocator&) noexcept = default;
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+    ~aligned_allocator() noexcept = default;
+
+    // 赋值操作符
+    aligned_allocator& operator=(const aligned_allocator&) = default;
+
+    // 地址获取
+    pointer address(reference x) const noexcept {
+        return &x;
+    }
+
+    const_pointer address(const_reference x) const noexcept {
+        return &x;
+    }
+
+    // 内存分配
+    pointer allocate(size_type n, const void* hint = 0) {
+        (void)hint;
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        const size_type bytes = (n * sizeof(T) + alignment - 1) & ~(alignment - 1);
+        pointer result = static_cast<pointer>(mystl::aligned_alloc(bytes, alignment));
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
+    // 内存释放
+    void deallocate(pointer p, size_type) noexcept {
+        mystl::aligned_free(p);
+    }
+
+    // 对象构造
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        mystl::construct(p, mystl::forward<Args>(args)...);
+    }
+
+    // 对象析构
+    template<typename U>
+    void destroy(U* p) {
+        mystl::destroy(p);
+    }
+
+    // 最大分配大小
+    size_type max_size() const noexcept {
+        return (size_type(-1) - alignment) / sizeof(T);
+    }
+
+    // 比较操作：对齐相同的分配器都通过 aligned_free 释放，可以互相释放
+    template<typename U>
+    bool operator==(const aligned_allocator<U, Align>&) const noexcept {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const aligned_allocator<U, Align>&) const noexcept {
+        return false;
+    }
+};
+
+template<typename T, size_t Align>
+constexpr size_t aligned_allocator<T, Align>::alignment;
+
+// ============================================================================
+// malloc 分配器
+// ============================================================================
+
+/**
+ * @brief 直接使用 malloc/free 的分配器，支持原地扩展与 realloc
+ * @tparam T 分配的对象类型，对齐不超过 alignof(std::max_align_t)
+ *
+ * try_expand 在 glibc 上利用 malloc_usable_size 报告的块内余量原地扩展；
+ * reallocate 调用 realloc，大块可由 libc 原地扩展或用 mremap 搬移页面，
+ * 只适用于可平凡重定位的元素，vector 据 is_trivially_relocatable 决定是否使用。
+ */
+template<typename T>
+class malloc_allocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc_allocator: 不支持过对齐类型");
+
+public:
+    // 类型定义
+    typedef T            value_type;
+    typedef T*           pointer;
+    typedef const T*     const_pointer;
+    typedef T&           reference;
+    typedef const T&     const_reference;
+    typedef size_t       size_type;
+    typedef ptrdiff_t    difference_type;
+
+    // 分配器特征
+    template<typename U>
+    struct rebind {
+        typedef malloc_allocator<U> other;
+    };
+
+public:
+    // 构造函数和析构函数
+    malloc_allocator() noexcept = default;
+    malloc_allocator(const malloc_allocator&) noexcept = default;
+    template<typename U>
+    malloc_allocator(const malloc_allocator<U>&) noexcept {}
+    ~malloc_allocator() noexcept = default;
+
+    // 赋值操作符
+    malloc_allocator& operator=(const malloc_allocator&) = default;
+
+    // 地址获取
+    pointer address(reference x) const noexcept {
+        return &x;
+    }
+
+    const_pointer address(const_reference x) const noexcept {
+        return &x;
+    }
+
+    // 内存分配
+    pointer allocate(size_type n, const void* hint = 0) {
+        (void)hint;
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        pointer result = static_cast<pointer>(std::malloc(n == 0 ? 1 : n * sizeof(T)));
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
+    // 内存释放
+    void deallocate(pointer p, size_type) noexcept {
+        std::free(p);
+    }
+
+    /**
+     * @brief 原地扩展
+     * @return p 处的块已能容纳 new_n 个对象时返回 true，内容与地址都不变
+     */
+    bool try_expand(pointer p, size_type old_n, size_type new_n) noexcept {
+        (void)old_n;
+#if defined(MYSTL_HAS_MALLOC_USABLE_SIZE)
+        return p != nullptr && new_n <= max_size() && ::malloc_usable_size(p) >= new_n * sizeof(T);
+#else
+        (void)p;
+        (void)new_n;
+        return false;
+#endif
+    }
+
+    // 申请 n 个对象时整块实际能容纳的对象数，不小于 n
+    size_type good_size(size_type n) const noexcept {
+        if (n == 0 || n > max_size()) {
+            return n;
+        }
+        const size_type fit = mystl::malloc_good_size(n * sizeof(T)) / sizeof(T);
+        return fit < n ? n : fit;
+    }
+
+    /**
+     * @brief 按字节重新分配，只适用于可平凡重定位的类型
+     * @return 新块地址，前 min(old_n, new_n) 个对象按字节保留
+     * @throws std::bad_alloc 失败时原块不变
+     */
+    pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+        (void)old_n;
+        if (new_n > max_size()) {
+            throw std::bad_alloc();
+        }
+        pointer result = static_cast<pointer>(std::realloc(static_cast<void*>(p), new_n == 0 ? 1 : new_n * sizeof(T)));
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
+    // 对象构造
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        mystl::construct(p, mystl::forward<Args>(args)...);
+    }
+
+    // 对象析构
+    template<typename U>
+    void destroy(U* p) {
+        mystl::destroy(p);
+    }
+
+    // 最大分配大小
+    size_type max_size() const noexcept {
+        return size_type(-1) / sizeof(T);
+    }
+
+    // 比较操作
+    template<typename U>
+    bool operator==(const malloc_allocator<U>&) const noexcept {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const malloc_allocator<U>&) const noexcept {
+        return false;
+    }
+};
+
 // ============================================================================
 // 分配器工具函数
 // ============================================================================
 
+/**
+ * @brief 检测分配器是否提供 try_expand(p, old_n, new_n)：把 p 处的块原地扩展到 new_n 个对象
+ * @tparam Alloc 分配器类型
+ */
+template<typename Alloc>
+struct has_try_expand {
+private:
+    template<typename A>
+    static auto test(int) -> decltype(
+        std::declval<A&>().try_expand(std::declval<typename A::pointer>(), size_t(), size_t()),
+        m_true_type{}
+    );
+
+    template<typename>
+    static m_false_type test(...);
+
+public:
+    using type = decltype(test<Alloc>(0));
+    static constexpr bool value = type::value;
+};
+
+/**
+ * @brief 检测分配器是否提供 reallocate(p, old_n, new_n)：按字节把块搬到（可能原地的）新位置
+ * @tparam Alloc 分配器类型
+ */
+template<typename Alloc>
+struct has_reallocate {
+private:
+    template<typename A>
+    static auto test(int) -> decltype(
+        std::declval<typename A::pointer&>() =
+            std::declval<A&>().reallocate(std::declval<typename A::pointer>(), size_t(), size_t()),
+        m_true_type{}
+    );
+
+    template<typename>
+    static m_false_type test(...);
+
+public:
+    using type = decltype(test<Alloc>(0));
+    static constexpr bool value = type::value;
+};
+
+/**
+ * @brief 检测分配器是否提供 good_size(n)：申请 n 个对象时整块实际能容纳的对象数
+ * @tparam Alloc 分配器类型
+ */
+template<typename Alloc>
+struct has_good_size {
+private:
+    template<typename A>
+    static auto test(int) -> decltype(
+        size_t(std::declval<const A&>().good_size(size_t())),
+        m_true_type{}
+    );
+
+    template<typename>
+    static m_false_type test(...);
+
+public:
+    using type = decltype(test<Alloc>(0));
+    static constexpr bool value = type::value;
+};
+
 /**
  * @brief 分配器特征
  * @tparam Alloc 分配器类型
@@ -160,6 +557,32 @@ struct allocator_traits {
         a.deallocate(p, n);
     }
 
+    /**
+     * @brief 原地扩展：分配器提供 try_expand 时调用，否则返回 false
+     * @return true 表示 p 处的块已能容纳 new_n 个对象，之后以 new_n 释放
+     */
+    static bool try_expand(allocator_type& a, pointer p, size_type old_n, size_type new_n) noexcept {
+        return try_expand_aux(a, p, old_n, new_n, typename has_try_expand<Alloc>::type());
+    }
+
+    /**
+     * @brief 按字节重新分配：分配器提供 reallocate 时调用（realloc、mremap 等），
+     *        否则分配新块、memcpy、释放旧块。只适用于可平凡重定位的类型
+     * @throws std::bad_alloc 失败时原块不变
+     */
+    static pointer reallocate(allocator_type& a, pointer p, size_type old_n, size_type new_n) {
+        return reallocate_aux(a, p, old_n, new_n, typename has_reallocate<Alloc>::type());
+    }
+
+    /**
+     * @brief 申请 n 个对象时整块实际能容纳的对象数：分配器提供 good_size 时调用，否则返回 n
+     * 按返回值申请不会多占内存，用于把容量向上取整到分配器的大小类
+     */
+    static size_type good_size(const allocator_type& a, size_type n) noexcept {
+        const size_type fit = good_size_aux(a, n, typename has_good_size<Alloc>::type());
+        return fit < n ? n : fit;
+    }
+
     // 构造对象
     template<typename T, typename... Args>
     static void construct(allocator_type& a, T* p, Args&&... args) {
@@ -185,6 +608,40 @@ struct allocator_traits {
     static const_pointer address(const allocator_type& a, const_reference x) {
         return a.address(x);
     }
+
+private:
+    static bool try_expand_aux(allocator_type& a, pointer p, size_type old_n, size_type new_n,
+                               m_true_type) noexcept {
+        return a.try_expand(p, old_n, new_n);
+    }
+
+    static bool try_expand_aux(allocator_type&, pointer, size_type, size_type, m_false_type) noexcept {
+        return false;
+    }
+
+    static size_type good_size_aux(const allocator_type& a, size_type n, m_true_type) noexcept {
+        return a.good_size(n);
+    }
+
+    static size_type good_size_aux(const allocator_type&, size_type n, m_false_type) noexcept {
+        return n;
+    }
+
+    static pointer reallocate_aux(allocator_type& a, pointer p, size_type old_n, size_type new_n,
+                                  m_true_type) {
+        return a.reallocate(p, old_n, new_n);
+    }
+
+    static pointer reallocate_aux(allocator_type& a, pointer p, size_type old_n, size_type new_n,
+                                  m_false_type) {
+        pointer result = a.allocate(new_n);
+        if (p != nullptr) {
+            std::memcpy(static_cast<void*>(result), static_cast<const void*>(p),
+                        (old_n < new_n ? old_n : new_n) * sizeof(value_type));
+            a.deallocate(p, old_n);
+        }
+        return result;
+    }
 };
 
 // ============================================================================
@@ -0,0 +1,300 @@
+#ifndef MYTINYSTL_ARENA_H_
+#define MYTINYSTL_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "construct.h"
+#include "util.h"
+
+namespace mystl {
+
+// ============================================================================
+// 单调内存区配置
+// ============================================================================
+
+static const size_t ARENA_MIN_CHUNK = 1024;         // 向上游申请的最小内存块
+static const size_t ARENA_GROWTH_FACTOR = 2;        // 上游内存块的几何增长倍数
+static const size_t ARENA_DEFAULT_ALIGN = alignof(std::max_align_t);  // 默认对齐
+
+// ============================================================================
+// 单调内存区
+// ============================================================================
+
+/**
+ * @brief 单调（bump）内存区
+ *
+ * 分配只是把游标按对齐后的大小向前推进；deallocate 为空操作，内存在 release()
+ * 或析构时一次性归还。先使用初始缓冲区（调用者提供，或 inline_arena 的栈上数组），
+ * 用尽后向上游（malloc）申请内存块，块大小按 ARENA_GROWTH_FACTOR 几何增长，
+ * 因此上游调用次数只与总字节数的对数成正比，release() 的代价与对象数量无关。
+ *
+ * 适合“一次请求内大量创建临时容器，请求结束时整体丢弃”的场景。非线程安全，
+ * 每个线程（或每个请求）使用自己的内存区。
+ */
+class monotonic_arena {
+public:
+    /**
+     * @brief 无初始缓冲区，第一次分配时向上游申请
+     * @param initial_chunk 第一个上游内存块的大小
+     */
+    explicit monotonic_arena(size_t initial_chunk = ARENA_MIN_CHUNK) noexcept
+        : cur_(nullptr), end_(nullptr), buffer_(nullptr), buffer_size_(0), chunks_(nullptr),
+          first_chunk_(initial_chunk < ARENA_MIN_CHUNK ? ARENA_MIN_CHUNK : initial_chunk),
+          next_chunk_(first_chunk_), allocated_(0), upstream_bytes_(0), chunk_count_(0) {}
+
+    /**
+     * @brief 使用调用者提供的初始缓冲区
+     * @param buffer 初始缓冲区，生命周期须长于内存区
+     * @param size 缓冲区字节数；用尽后第一个上游内存块为其 ARENA_GROWTH_FACTOR 倍
+     */
+    monotonic_arena(void* buffer, size_t size) noexcept
+        : cur_(static_cast<char*>(buffer)), end_(static_cast<char*>(buffer) + size),
+          buffer_(static_cast<char*>(buffer)), buffer_size_(size), chunks_(nullptr),
+          first_chunk_(size * ARENA_GROWTH_FACTOR < ARENA_MIN_CHUNK ? ARENA_MIN_CHUNK
+                                                                    : size * ARENA_GROWTH_FACTOR),
+          next_chunk_(first_chunk_), allocated_(0), upstream_bytes_(0), chunk_count_(0) {}
+
+    monotonic_arena(const monotonic_arena&) = delete;
+    monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+    ~monotonic_arena() { release(); }
+
+    /**
+     * @brief 分配内存
+     * @param bytes 字节数
+     * @param align 对齐字节数，须为 2 的幂
+     * @return 对齐的内存地址
+     * @throws std::bad_alloc 上游分配失败
+     */
+    void* allocate(size_t bytes, size_t align = ARENA_DEFAULT_ALIGN) {
+        char* p = align_up(cur_, align);
+        if (p != nullptr && p <= end_ && bytes <= static_cast<size_t>(end_ - p)) {
+            cur_ = p + bytes;
+            allocated_ += bytes;
+            return p;
+        }
+        return allocate_slow(bytes, align);
+    }
+
+    /**
+     * @brief 释放内存：空操作，内存在 release() 时整体归还
+     */
+    void deallocate(void*, size_t, size_t = ARENA_DEFAULT_ALIGN) noexcept {}
+
+    /**
+     * @brief 原地扩展最近一次分配的内存
+     * @param p 之前分配的地址
+     * @param old_bytes 当前大小
+     * @param new_bytes 目标大小
+     * @return p 是当前块中最后一次分配且剩余空间足够时推进游标并返回 true
+     *
+     * 内存区中只有一个在增长的 vector 时，扩容全部原地完成，不会留下被丢弃的旧缓冲区。
+     */
+    bool try_expand(void* p, size_t old_bytes, size_t new_bytes) noexcept {
+        char* q = static_cast<char*>(p);
+        if (q == nullptr || new_bytes < old_bytes || q + old_bytes != cur_ ||
+            new_bytes - old_bytes > static_cast<size_t>(end_ - cur_)) {
+            return false;
+        }
+        cur_ += new_bytes - old_bytes;
+        allocated_ += new_bytes - old_bytes;
+        return true;
+    }
+
+    /**
+     * @brief 归还全部上游内存块，回到初始缓冲区
+     *
+     * 之前分配的所有内存随之失效，调用者负责不再使用其中的对象。
+     * 代价与上游内存块数成正比，与分配过的对象数量无关。
+     */
+    void release() noexcept {
+        while (chunks_ != nullptr) {
+            chunk_header* next = chunks_->next;
+            std::free(chunks_);
+            chunks_ = next;
+        }
+        cur_ = buffer_;
+        end_ = buffer_ == nullptr ? nullptr : buffer_ + buffer_size_;
+        next_chunk_ = first_chunk_;
+        allocated_ = 0;
+        upstream_bytes_ = 0;
+        chunk_count_ = 0;
+    }
+
+    // 统计信息
+    size_t bytes_allocated() const noexcept { return allocated_; }         // 自上次 release() 以来分配的字节数
+    size_t upstream_bytes() const noexcept { return upstream_bytes_; }     // 当前持有的上游内存块字节数
+    size_t chunk_count() const noexcept { return chunk_count_; }           // 当前持有的上游内存块数
+    size_t remaining() const noexcept { return static_cast<size_t>(end_ - cur_); }  // 当前块剩余字节数
+
+    bool operator==(const monotonic_arena& rhs) const noexcept { return this == &rhs; }
+    bool operator!=(const monotonic_arena& rhs) const noexcept { return this != &rhs; }
+
+private:
+    // 上游内存块头部，块内数据紧随其后
+    struct chunk_header {
+        chunk_header* next;
+        size_t        size;
+    };
+
+    static char* align_up(char* p, size_t align) noexcept {
+        const uintptr_t a = static_cast<uintptr_t>(align);
+        return reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(p) + a - 1) & ~(a - 1));
+    }
+
+    void* allocate_slow(size_t bytes, size_t align);
+
+    char*         cur_;             // 当前块中下一个可用字节
+    char*         end_;             // 当前块末尾
+    char*         buffer_;          // 初始缓冲区
+    size_t        buffer_size_;
+    chunk_header* chunks_;          // 上游内存块链表，最新的在前
+    size_t        first_chunk_;     // release() 后第一个上游内存块的大小
+    size_t        next_chunk_;      // 下一个上游内存块的大小
+    size_t        allocated_;
+    size_t        upstream_bytes_;
+    size_t        chunk_count_;
+};
+
+inline void* monotonic_arena::allocate_slow(size_t bytes, size_t align) {
+    // 块头之后按 align 对齐；超过 malloc 对齐保证的部分由额外的 align 字节补足
+    const size_t header = sizeof(chunk_header);
+    const size_t need = header + align + bytes;
+    if (need < bytes) {
+        throw std::bad_alloc();
+    }
+    const size_t size = next_chunk_ < need ? need : next_chunk_;
+    chunk_header* chunk = static_cast<chunk_header*>(std::malloc(size));
+    if (chunk == nullptr) {
+        throw std::bad_alloc();
+    }
+    chunk->next = chunks_;
+    chunk->size = size;
+    chunks_ = chunk;
+    next_chunk_ = size <= SIZE_MAX / ARENA_GROWTH_FACTOR ? size * ARENA_GROWTH_FACTOR : size;
+    upstream_bytes_ += size;
+    ++chunk_count_;
+
+    char* data = reinterpret_cast<char*>(chunk) + header;
+    char* p = align_up(data, align);
+    cur_ = p + bytes;
+    end_ = reinterpret_cast<char*>(chunk) + size;
+    allocated_ += bytes;
+    return p;
+}
+
+/**
+ * @brief 自带栈上初始缓冲区的单调内存区
+ * @tparam N 初始缓冲区字节数
+ *
+ * 用法：在请求处理函数中定义 mystl::inline_arena<4096> arena; 小请求完全不访问堆。
+ */
+template <size_t N>
+class inline_arena : public monotonic_arena {
+public:
+    inline_arena() noexcept : monotonic_arena(storage_, N) {}
+
+private:
+    // 基类只保存地址，构造时 storage_ 尚未初始化不影响使用
+    alignas(std::max_align_t) char storage_[N];
+};
+
+// ============================================================================
+// 内存区分配器
+// ============================================================================
+
+/**
+ * @brief 从 monotonic_arena 分配内存的分配器
+ * @tparam T 分配的对象类型
+ *
+ * 接口与 mystl::allocator 一致，可作为 vector、list、deque 的 Alloc 参数；
+ * deallocate 为空操作。分配器只保存内存区指针，rebind 后的副本共享同一内存区，
+ * 指向同一内存区的分配器相等。没有默认构造函数，容器须以分配器（或内存区）构造：
+ *   mystl::vector<int, mystl::arena_allocator<int>> v(arena);
+ */
+template <typename T>
+class arena_allocator {
+public:
+    // 类型定义
+    typedef T            value_type;
+    typedef T*           pointer;
+    typedef const T*     const_pointer;
+    typedef T&           reference;
+    typedef const T&     const_reference;
+    typedef size_t       size_type;
+    typedef ptrdiff_t    difference_type;
+
+    // 分配器特征
+    template <typename U>
+    struct rebind {
+        typedef arena_allocator<U> other;
+    };
+
+public:
+    // 构造函数：可由内存区隐式转换，便于直接把内存区传给容器构造函数
+    arena_allocator(monotonic_arena& arena) noexcept : arena_(&arena) {}
+    arena_allocator(const arena_allocator&) noexcept = default;
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    arena_allocator& operator=(const arena_allocator&) = default;
+
+    // 地址获取
+    pointer address(reference x) const noexcept { return &x; }
+    const_pointer address(const_reference x) const noexcept { return &x; }
+
+    // 内存分配
+    pointer allocate(size_type n, const void* hint = 0) {
+        (void)hint;
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        return static_cast<pointer>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // 内存释放：空操作
+    void deallocate(pointer, size_type) noexcept {}
+
+    // 原地扩展：p 是内存区最近一次分配且剩余空间足够时成功
+    bool try_expand(pointer p, size_type old_n, size_type new_n) noexcept {
+        return new_n <= max_size() && arena_->try_expand(p, old_n * sizeof(T), new_n * sizeof(T));
+    }
+
+    // 对象构造
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        mystl::construct(p, mystl::forward<Args>(args)...);
+    }
+
+    // 对象析构
+    template <typename U>
+    void destroy(U* p) {
+        mystl::destroy(p);
+    }
+
+    // 最大分配大小
+    size_type max_size() const noexcept { return size_type(-1) / sizeof(T); }
+
+    // 所用内存区
+    monotonic_arena* arena() const noexcept { return arena_; }
+
+    // 比较操作
+    template <typename U>
+    bool operator==(const arena_allocator<U>& rhs) const noexcept {
+        return arena_ == rhs.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const arena_allocator<U>& rhs) const noexcept {
+        return arena_ != rhs.arena();
+    }
+
+private:
+    monotonic_arena* arena_;
+};
+
+} // namespace mystl
+
+#endif // MYTINYSTL_ARENA_H_
@@ -5,6 +5,7 @@
 #include <type_traits>
 #include "type_traits.h"
 #include "exceptdef.h"
+#include "util.h"
 
 namespace mystl {
 
@@ -38,7 +39,34 @@ void destroy(T* ptr) {
     }
 }
 
-// 注意：destroy(ForwardIterator, ForwardIterator) 已在 algobase.h 中定义
+/**
+ * @brief 析构迭代器区间内的对象
+ * @tparam ForwardIterator 前向迭代器类型
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ */
+template<typename ForwardIterator>
+void destroy(ForwardIterator first, ForwardIterator last) {
+    for (; first != last; ++first) {
+        mystl::destroy(&*first);
+    }
+}
+
+/**
+ * @brief 析构从 first 开始的 n 个对象
+ * @tparam ForwardIterator 前向迭代器类型
+ * @tparam Size 数量类型
+ * @param first 起始迭代器
+ * @param n 对象数量
+ * @return 最后一个被析构对象的下一个位置
+ */
+template<typename ForwardIterator, typename Size>
+ForwardIterator destroy_n(ForwardIterator first, Size n) {
+    for (; n > 0; --n, ++first) {
+        mystl::destroy(&*first);
+    }
+    return first;
+}
 
 /**
  * @brief 析构多个对象（特化版本 - 平凡析构）
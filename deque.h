@@ -2,20 +2,32 @@
 #define MYTINYSTL_DEQUE_H
 
 #include<new>
+#include <algorithm>
 #include <cstddef>
 #include <type_traits>
 #include "iterator.h" 
+#include "allocator.h"
 #include "util.h"
 #include "construct.h"
+#include "uninitialized.h"
 #include "exceptdef.h"
 
 namespace mystl {
     
+    //不大于 n 的最大 2 的幂（n 为 0 时取 1）
+    constexpr size_t deque_floor_pow2(size_t n) { return n <= 1 ? 1 : 2 * deque_floor_pow2(n / 2); }
+    //2 的幂 n 的以 2 为底的对数
+    constexpr size_t deque_log2(size_t n) { return n <= 1 ? 0 : 1 + deque_log2(n / 2); }
+
+    //默认块大小取不超过 512 字节能放下的最大 2 的幂个元素，下标换算为（块, 块内偏移）时只需移位和按位与
     template <typename T,std::size_t BufS = 0>
     struct deque_buf_size {
         static constexpr size_t value =  BufS != 0 ? BufS : 
         //static_cast<size_t>(1)为1 * sizeof(T),表示至少有一个元素，为有效缓冲区
-        (sizeof(T) < 512 ? static_cast<size_t>(512 / sizeof(T)) : static_cast<size_t>(1)); //至少一个缓冲区
+        (sizeof(T) < 512 ? deque_floor_pow2(512 / sizeof(T)) : static_cast<size_t>(1)); //至少一个缓冲区
+        //显式指定的 BufS 可能不是 2 的幂，此时退回除法与取模
+        static constexpr bool is_pow2 = (value & (value - 1)) == 0;
+        static constexpr size_t shift = deque_log2(value);
     };
 
     //非类型模板参数（int,size_t）BufS为0时，即表示使用默认值
@@ -31,6 +43,12 @@ namespace mystl {
         using map_pointer       =nonconst_pointer*;
         //缓冲区大小
         static constexpr std::size_t buffer_size = deque_buf_size<T,BufS>::value;
+        //非负偏移所在的块序号
+        static difference_type node_index(difference_type offset) noexcept {
+            return deque_buf_size<T,BufS>::is_pow2
+                ? static_cast<difference_type>(static_cast<size_t>(offset) >> deque_buf_size<T,BufS>::shift)
+                : offset / static_cast<difference_type>(buffer_size);
+        }
         nonconst_pointer cur;
         nonconst_pointer first;
         nonconst_pointer last;
@@ -69,8 +87,8 @@ namespace mystl {
                 return *this;
             } else {
                 difference_type node_offset = (offset >= 0)
-                    ? (offset / bs)
-                    : -((-offset + bs - 1) / bs);
+                    ? node_index(offset)
+                    : -node_index(-offset + bs - 1);
                 set_node(node + node_offset);
                 cur = first + (offset - node_offset * bs);
                 return *this;
@@ -119,10 +137,29 @@ namespace mystl {
     }
 };
 
-    template <typename T,std::size_t BufS = 0>
+    //deque 迭代器按块分段：段迭代器是 map 槽位，块内是普通指针
+    template <typename T,std::size_t BufS>
+    struct segmented_iterator_traits<deque_iterator<T,BufS>> {
+        static constexpr bool is_segmented = true;
+        using iterator          = deque_iterator<T,BufS>;
+        using segment_iterator  = typename iterator::map_pointer;
+        using local_iterator    = typename iterator::pointer;
+
+        static segment_iterator segment(const iterator& it) noexcept { return it.node; }
+        static local_iterator local(const iterator& it) noexcept { return it.cur; }
+        static local_iterator begin(segment_iterator seg) noexcept { return *seg; }
+        static local_iterator end(segment_iterator seg) noexcept { return *seg + iterator::buffer_size; }
+        static iterator compose(segment_iterator seg, local_iterator p) noexcept {
+            return iterator(const_cast<typename iterator::nonconst_pointer>(p), *seg, *seg + iterator::buffer_size, seg);
+        }
+    };
+
+    //Alloc 按元素类型给出，块与 map 分别 rebind 到 T 与 T*
+    template <typename T,typename Alloc = mystl::allocator<T>,std::size_t BufS = 0>
     class deque {
         public:
         using value_type        = T;
+        using allocator_type    = Alloc;
         using pointer           = T*;
         using reference         = T&;
         using const_pointer     = const T*;
@@ -143,20 +180,60 @@ namespace mystl {
         iterator finish_;//结束迭代器   //finish_.last 属于 finish_ 当前所处的块（尾后所在块，可能是备用空块）
 
         size_type size_;
+
+        using data_alloc        = typename Alloc::template rebind<T>::other;
+        using map_alloc         = typename Alloc::template rebind<pointer>::other;
+        allocator_type alloc_;
+
+        // 备用块缓存：pop 腾空的块先留在这里，两端需要新块时优先取用，
+        // 队列在块边界来回进出时不再反复向分配器申请、归还
+        static constexpr size_type spare_block_limit = 4;
+        pointer spare_[spare_block_limit];
+        size_type spare_count_ = 0;
+
         //分配器,释放节点
         pointer allocate_node(){
-            const size_type n = deque_buf_size<T,BufS>::value;
-        return static_cast<pointer>(::operator new(sizeof(T) * n));
+            data_alloc a(alloc_);
+            return a.allocate(deque_buf_size<T,BufS>::value);
+        }
+        void deallocate_node(pointer buf) noexcept{
+            data_alloc a(alloc_);
+            a.deallocate(buf,deque_buf_size<T,BufS>::value);
+        }
+        //取一个空块：先用缓存，缓存为空再分配
+        pointer take_node(){
+            if (spare_count_ != 0) return spare_[--spare_count_];
+            return allocate_node();
+        }
+        //归还一个空块：缓存未满时留下，否则交还分配器
+        void put_node(pointer buf) noexcept{
+            if (spare_count_ < spare_block_limit) {
+                spare_[spare_count_++] = buf;
+            } else {
+                deallocate_node(buf);
+            }
+        }
+        void release_spare_nodes() noexcept{
+            while (spare_count_ != 0) deallocate_node(spare_[--spare_count_]);
+        }
+        //移动时接管other的备用块，调用前自身缓存为空
+        void steal_spare_nodes(deque& other) noexcept{
+            for (size_type i = 0; i < other.spare_count_; ++i) spare_[i] = other.spare_[i];
+            spare_count_ = other.spare_count_;
+            other.spare_count_ = 0;
+        }
+        //分配器,释放map区
+        pointer* allocate_map(size_type n){
+            map_alloc a(alloc_);
+            return a.allocate(n);
+        }
+        void deallocate_map(pointer* map,size_type n) noexcept{
+            map_alloc a(alloc_);
+            a.deallocate(map,n);
         }
-        //强异常保证的插入实现(待实现)
-        iterator do_insert_strong(iterator pos,const_iterator first,const_iterator last)
-
-        iterator do_insert_strong(iterator pos,iterator first,iterator last)
-
-        void deallocate_node(pointer buf) noexcept{::operator delete(buf);}
         //创建map区和节点,释放节点
         void create_map_and_nodes(size_type num_nodes){
-            map_ = static_cast<pointer*>(::operator new(sizeof(pointer) * num_nodes));
+            map_ = allocate_map(num_nodes);
             map_size_ = num_nodes;
             for(size_type i = 0; i < num_nodes; ++i)
             {
@@ -164,6 +241,7 @@ namespace mystl {
             }
         }
         void destroy_map_and_nodes() noexcept{
+            release_spare_nodes();
             if (!map_) return;
             // 释放所有已分配的块
             for (size_type i = 0; i < map_size_; ++i) {
@@ -172,7 +250,7 @@ namespace mystl {
                     map_[i] = nullptr;
                 }
             }
-            ::operator delete(map_);
+            deallocate_map(map_,map_size_);
             map_ = nullptr;
             map_size_ = 0;
         }
@@ -180,7 +258,7 @@ namespace mystl {
         void initialize_empty()
         {
             map_size_ = 8;
-            map_ =static_cast<pointer*>(::operator new(sizeof(pointer) * map_size_));
+            map_ = allocate_map(map_size_);
             const size_type center = map_size_ / 2;
             for (size_type i = 0; i < map_size_; ++i) {
                 map_[i] = nullptr;
@@ -192,64 +270,83 @@ namespace mystl {
             finish_.cur = start_.first;
         }
 
-        //目标：当块内满时，若相邻槽位是空的，就分配新块并且将新块的指针赋值给相邻槽位，然后跳过去再插入,
-        // 若相邻槽位不可用(下一步做 map 扩容）
-        void require_back_slot(){
-            if (finish_.cur != finish_.last) return; // 当前块未满，无需处理
-
-            // 需要移动到尾部的下一个块
-            if (finish_.node + 1 < map_ + map_size_) {
-                // map 仍有槽位
-                if (*(finish_.node + 1) == nullptr) {
-                    *(finish_.node + 1) = allocate_node();
-                }
+        //尾部构造一个元素。写入块内最后一个位置前先备好下一块，构造成功后 finish_ 跨入新块，
+        //保证 finish_.cur 不等于 finish_.last，end() 与前向遍历的迭代器相等；构造抛出异常时归还新块
+        template <class... Args>
+        void construct_back(Args&&... args){
+            if (finish_.cur + 1 != finish_.last) {
+                mystl::construct(finish_.cur,mystl::forward<Args>(args)...);
+                ++finish_.cur;
             } else {
-                // map 无槽位，需要扩容（在尾部预留）
-                reallocate_map(1, false);
-                if (*(finish_.node + 1) == nullptr) {
-                    *(finish_.node + 1) = allocate_node();
+                if (finish_.node + 1 == map_ + map_size_) reallocate_map(1, false);
+                pointer buf = take_node();
+                try {
+                    mystl::construct(finish_.cur,mystl::forward<Args>(args)...);
+                } catch (...) {
+                    put_node(buf);
+                    throw;
                 }
+                *(finish_.node + 1) = buf;
+                finish_.set_node(finish_.node + 1);
+                finish_.cur = finish_.first;
             }
-            finish_.set_node(finish_.node + 1);
-            finish_.cur = finish_.first;
+            ++size_;
         }
 
-        void require_front_slot(){
-            if (start_.cur != start_.first) return; // 当前块前部仍有空间
-
-            if (start_.node > map_) {
-                // map 左侧仍有槽位
-                if (*(start_.node - 1) == nullptr) {
-                    *(start_.node - 1) = allocate_node();
-                }
+        //头部构造一个元素：块前部已满时在新块末尾构造，成功后 start_ 才移入新块
+        template <class... Args>
+        void construct_front(Args&&... args){
+            if (start_.cur != start_.first) {
+                mystl::construct(start_.cur - 1,mystl::forward<Args>(args)...);
+                --start_.cur;
             } else {
-                // 已在最左端，无槽位可用，扩容到前部
-                reallocate_map(1, true);
-                if (*(start_.node - 1) == nullptr) {
-                    *(start_.node - 1) = allocate_node();
+                if (start_.node == map_) reallocate_map(1, true);
+                pointer buf = take_node();
+                pointer slot = buf + (deque_buf_size<T,BufS>::value - 1);
+                try {
+                    mystl::construct(slot,mystl::forward<Args>(args)...);
+                } catch (...) {
+                    put_node(buf);
+                    throw;
                 }
+                *(start_.node - 1) = buf;
+                start_.set_node(start_.node - 1);
+                start_.cur = slot;
             }
-            start_.set_node(start_.node - 1);
-            start_.cur = start_.last;
+            ++size_;
         }
         
         void reallocate_map(std::size_t nodes_to_add,bool add_at_front)
         {
             const size_type old_nodes = static_cast<size_type>(finish_.node - start_.node + 1);
-            size_type new_map_size = mystl::max(map_size_ * 2, map_size_ + nodes_to_add + 2);
+            const size_type new_num_nodes = old_nodes + nodes_to_add;
+            //队列式使用时有效区在map中持续漂移，一端用完而map大半空闲：就地居中，不重新分配
+            if (map_size_ > 2 * new_num_nodes) {
+                pointer* old_start = start_.node;
+                pointer* new_start = map_ + (map_size_ - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
+                mystl::move_bytes(new_start, old_start, old_nodes);
+                //腾出的槽位置空，保持有效区之外的槽位都为空
+                pointer* clear_first = new_start < old_start ? mystl::max(new_start + old_nodes, old_start) : old_start;
+                pointer* clear_last = new_start < old_start ? old_start + old_nodes : mystl::min(new_start, old_start + old_nodes);
+                for (; clear_first < clear_last; ++clear_first) *clear_first = nullptr;
+                //块本身不动，只更新迭代器所在槽位
+                start_.node = new_start;
+                finish_.node = new_start + old_nodes - 1;
+                return;
+            }
+            //新增块可能远多于原有块（批量插入），两侧都要留得下 nodes_to_add 个槽位
+            size_type new_map_size = mystl::max(map_size_ * 2, map_size_ + 2 * nodes_to_add + 2);
 
-            pointer* new_map = static_cast<pointer*>(::operator new(sizeof(pointer) * new_map_size));
+            pointer* new_map = allocate_map(new_map_size);
             for(size_type i = 0;i < new_map_size;++i) new_map[i] = nullptr;
 
             const size_type old_start_index = static_cast<size_type>(start_.node - map_);
             const size_type bias = add_at_front ? nodes_to_add : 0;
             const size_type new_start_index = (new_map_size - old_nodes) /  2 + bias;
 
-            //拷贝旧的map到新的map
-            for(size_type i = 0;i <old_nodes;++i)
-            {
-                new_map[new_start_index + i] = map_[old_start_index + i];
-            }
+            //旧map中的块指针整块搬到新map
+            mystl::uninitialized_relocate(map_ + old_start_index, map_ + old_start_index + old_nodes,
+                                          new_map + new_start_index);
             //保留块内偏移
             const difference_type start_off = start_.cur - start_.first;
             const difference_type finish_off = finish_.cur - finish_.first;
@@ -261,12 +358,325 @@ namespace mystl {
             start_.cur = start_.first + start_off;
             finish_.cur = finish_.first + finish_off;
 
-            ::operator delete(map_);
+            deallocate_map(map_,map_size_);
             map_ = new_map;
             map_size_ = new_map_size;
         }
+
+        // ====== 批量插入、删除的辅助函数 ======
+
+        static constexpr size_type block_size = deque_buf_size<T,BufS>::value;
+
+        //从首元素所在块算起的偏移 -> 块序号、块内偏移
+        static size_type block_index(size_type off) noexcept {
+            return deque_buf_size<T,BufS>::is_pow2 ? off >> deque_buf_size<T,BufS>::shift : off / block_size;
+        }
+        static size_type block_offset(size_type off) noexcept {
+            return deque_buf_size<T,BufS>::is_pow2 ? off & (block_size - 1) : off % block_size;
+        }
+
+        //在头部之前备好容纳 n 个元素的块，返回插入后的新起点；start_ 本身不变
+        iterator reserve_elements_at_front(size_type n) {
+            const size_type vacancies = static_cast<size_type>(start_.cur - start_.first);
+            if (n > vacancies) {
+                const size_type new_nodes = (n - vacancies + block_size - 1) / block_size;
+                if (new_nodes > static_cast<size_type>(start_.node - map_)) reallocate_map(new_nodes, true);
+                size_type i = 1;
+                try {
+                    for (; i <= new_nodes; ++i) *(start_.node - i) = take_node();
+                } catch (...) {
+                    for (size_type j = 1; j < i; ++j) {
+                        put_node(*(start_.node - j));
+                        *(start_.node - j) = nullptr;
+                    }
+                    throw;
+                }
+            }
+            return start_ - static_cast<difference_type>(n);
+        }
+        //在尾部之后备好容纳 n 个元素的块，finish_ 所在块要留出一个尾后位置
+        iterator reserve_elements_at_back(size_type n) {
+            const size_type vacancies = static_cast<size_type>(finish_.last - finish_.cur) - 1;
+            if (n > vacancies) {
+                const size_type new_nodes = (n - vacancies + block_size - 1) / block_size;
+                if (new_nodes > static_cast<size_type>(map_ + map_size_ - finish_.node - 1)) reallocate_map(new_nodes, false);
+                size_type i = 1;
+                try {
+                    for (; i <= new_nodes; ++i) *(finish_.node + i) = take_node();
+                } catch (...) {
+                    for (size_type j = 1; j < i; ++j) {
+                        put_node(*(finish_.node + j));
+                        *(finish_.node + j) = nullptr;
+                    }
+                    throw;
+                }
+            }
+            return finish_ + static_cast<difference_type>(n);
+        }
+        //归还 [first.node, last.node) 之间的整块
+        void free_nodes(pointer* first, pointer* last) noexcept {
+            for (; first < last; ++first) {
+                put_node(*first);
+                *first = nullptr;
+            }
+        }
+
+        //元素区间的析构，可平凡析构时什么也不做
+        static void destroy_range(iterator first, iterator last) noexcept {
+            if (std::is_trivially_destructible<T>::value) return;
+            for (; first != last; ++first) mystl::destroy(first.cur);
+        }
+
+        //把 [first, last) 按块分段搬到 result 开始处，目标在源之前或不重叠；
+        //可平凡拷贝时每段一次 memmove，否则逐元素移动赋值
+        static iterator move_segments(iterator first, iterator last, iterator result) {
+            difference_type n = last - first;
+            while (n > 0) {
+                const difference_type chunk = mystl::min(n, mystl::min(first.last - first.cur, result.last - result.cur));
+                if (std::is_trivially_copyable<T>::value) {
+                    mystl::move_bytes(result.cur, first.cur, static_cast<size_type>(chunk));
+                } else {
+                    std::move(first.cur, first.cur + chunk, result.cur);
+                }
+                first += chunk;
+                result += chunk;
+                n -= chunk;
+            }
+            return result;
+        }
+        //把 [first, last) 按块分段搬到以 result 结尾处，目标在源之后或不重叠
+        static iterator move_segments_backward(iterator first, iterator last, iterator result) {
+            const difference_type bs = static_cast<difference_type>(block_size);
+            difference_type n = last - first;
+            while (n > 0) {
+                //位于块首时，本段取前一块的末尾
+                difference_type src_len = last.cur - last.first;
+                pointer src_end = last.cur;
+                if (src_len == 0) {
+                    src_len = bs;
+                    src_end = *(last.node - 1) + bs;
+                }
+                difference_type dst_len = result.cur - result.first;
+                pointer dst_end = result.cur;
+                if (dst_len == 0) {
+                    dst_len = bs;
+                    dst_end = *(result.node - 1) + bs;
+                }
+                const difference_type chunk = mystl::min(n, mystl::min(src_len, dst_len));
+                if (std::is_trivially_copyable<T>::value) {
+                    mystl::move_bytes(dst_end - chunk, src_end - chunk, static_cast<size_type>(chunk));
+                } else {
+                    std::move_backward(src_end - chunk, src_end, dst_end);
+                }
+                last -= chunk;
+                result -= chunk;
+                n -= chunk;
+            }
+            return result;
+        }
+        //从 first 起取 n 个值按块赋给 result 开始的位置，返回源的下一个位置
+        template <class ForwardIt>
+        static ForwardIt copy_segments(ForwardIt first, difference_type n, iterator result) {
+            while (n > 0) {
+                const difference_type chunk = mystl::min(n, result.last - result.cur);
+                for (pointer p = result.cur, e = p + chunk; p != e; ++p, ++first) *p = *first;
+                result += chunk;
+                n -= chunk;
+            }
+            return first;
+        }
+        static void fill_segments(const value_type& value, difference_type n, iterator result) {
+            while (n > 0) {
+                const difference_type chunk = mystl::min(n, result.last - result.cur);
+                std::fill(result.cur, result.cur + chunk, value);
+                result += chunk;
+                n -= chunk;
+            }
+        }
+
+        //在下标 index 处插入 [first, last) 共 n 个元素，只移动较短的一侧。
+        //可平凡拷贝时直接逐块 memmove 后写入；否则先把靠近端点的元素移到新备好的未初始化区，
+        //再在已构造的区间内移动赋值（SGI 的做法）
+        template <class ForwardIt>
+        void insert_range_aux(size_type index, ForwardIt first, ForwardIt last, size_type n) {
+            const difference_type dn = static_cast<difference_type>(n);
+            const difference_type before = static_cast<difference_type>(index);
+            if (index < size_ - index) {
+                iterator new_start = reserve_elements_at_front(n);
+                iterator old_start = start_;
+                iterator pos = start_ + before;
+                if (std::is_trivially_copyable<T>::value) {
+                    move_segments(old_start, pos, new_start);
+                    copy_segments(first, dn, new_start + before);
+                    start_ = new_start;
+                    size_ += n;
+                    return;
+                }
+                try {
+                    if (before >= dn) {
+                        iterator start_n = old_start + dn;
+                        mystl::uninitialized_move(old_start, start_n, new_start);
+                        start_ = new_start;
+                        size_ += n;
+                        move_segments(start_n, pos, old_start);
+                        copy_segments(first, dn, pos - dn);
+                    } else {
+                        ForwardIt mid = first;
+                        mystl::advance(mid, dn - before);
+                        iterator cur = mystl::uninitialized_move(old_start, pos, new_start);
+                        try {
+                            mystl::uninitialized_copy(first, mid, cur);
+                        } catch (...) {
+                            destroy_range(new_start, cur);
+                            throw;
+                        }
+                        start_ = new_start;
+                        size_ += n;
+                        copy_segments(mid, before, old_start);
+                    }
+                } catch (...) {
+                    if (start_ != new_start) free_nodes(new_start.node, start_.node);
+                    throw;
+                }
+            } else {
+                iterator new_finish = reserve_elements_at_back(n);
+                iterator old_finish = finish_;
+                iterator pos = start_ + before;
+                const difference_type after = static_cast<difference_type>(size_ - index);
+                if (std::is_trivially_copyable<T>::value) {
+                    move_segments_backward(pos, old_finish, new_finish);
+                    copy_segments(first, dn, pos);
+                    finish_ = new_finish;
+                    size_ += n;
+                    return;
+                }
+                try {
+                    if (after > dn) {
+                        iterator finish_n = old_finish - dn;
+                        mystl::uninitialized_move(finish_n, old_finish, old_finish);
+                        finish_ = new_finish;
+                        size_ += n;
+                        move_segments_backward(pos, finish_n, old_finish);
+                        copy_segments(first, dn, pos);
+                    } else {
+                        ForwardIt mid = first;
+                        mystl::advance(mid, after);
+                        iterator cur = mystl::uninitialized_copy(mid, last, old_finish);
+                        try {
+                            mystl::uninitialized_move(pos, old_finish, cur);
+                        } catch (...) {
+                            destroy_range(old_finish, cur);
+                            throw;
+                        }
+                        finish_ = new_finish;
+                        size_ += n;
+                        copy_segments(first, after, pos);
+                    }
+                } catch (...) {
+                    if (finish_ != new_finish) free_nodes(finish_.node + 1, new_finish.node + 1);
+                    throw;
+                }
+            }
+        }
+
+        //在下标 index 处插入 n 个 value，步骤同 insert_range_aux
+        void insert_fill_aux(size_type index, size_type n, const value_type& value) {
+            const difference_type dn = static_cast<difference_type>(n);
+            const difference_type before = static_cast<difference_type>(index);
+            if (index < size_ - index) {
+                iterator new_start = reserve_elements_at_front(n);
+                iterator old_start = start_;
+                iterator pos = start_ + before;
+                if (std::is_trivially_copyable<T>::value) {
+                    move_segments(old_start, pos, new_start);
+                    fill_segments(value, dn, new_start + before);
+                    start_ = new_start;
+                    size_ += n;
+                    return;
+                }
+                try {
+                    if (before >= dn) {
+                        iterator start_n = old_start + dn;
+                        mystl::uninitialized_move(old_start, start_n, new_start);
+                        start_ = new_start;
+                        size_ += n;
+                        move_segments(start_n, pos, old_start);
+                        fill_segments(value, dn, pos - dn);
+                    } else {
+                        iterator cur = mystl::uninitialized_move(old_start, pos, new_start);
+                        try {
+                            mystl::uninitialized_fill(cur, old_start, value);
+                        } catch (...) {
+                            destroy_range(new_start, cur);
+                            throw;
+                        }
+                        start_ = new_start;
+                        size_ += n;
+                        fill_segments(value, before, old_start);
+                    }
+                } catch (...) {
+                    if (start_ != new_start) free_nodes(new_start.node, start_.node);
+                    throw;
+                }
+            } else {
+                iterator new_finish = reserve_elements_at_back(n);
+                iterator old_finish = finish_;
+                iterator pos = start_ + before;
+                const difference_type after = static_cast<difference_type>(size_ - index);
+                if (std::is_trivially_copyable<T>::value) {
+                    move_segments_backward(pos, old_finish, new_finish);
+                    fill_segments(value, dn, pos);
+                    finish_ = new_finish;
+                    size_ += n;
+                    return;
+                }
+                try {
+                    if (after > dn) {
+                        iterator finish_n = old_finish - dn;
+                        mystl::uninitialized_move(finish_n, old_finish, old_finish);
+                        finish_ = new_finish;
+                        size_ += n;
+                        move_segments_backward(pos, finish_n, old_finish);
+                        fill_segments(value, dn, pos);
+                    } else {
+                        iterator mid = old_finish + (dn - after);
+                        mystl::uninitialized_fill(old_finish, mid, value);
+                        try {
+                            mystl::uninitialized_move(pos, old_finish, mid);
+                        } catch (...) {
+                            destroy_range(old_finish, mid);
+                            throw;
+                        }
+                        finish_ = new_finish;
+                        size_ += n;
+                        fill_segments(value, after, pos);
+                    }
+                } catch (...) {
+                    if (finish_ != new_finish) free_nodes(finish_.node + 1, new_finish.node + 1);
+                    throw;
+                }
+            }
+        }
+
+        template <class InputIterator>
+        void insert_dispatch(size_type index, InputIterator first, InputIterator last, mystl::input_iterator_tag) {
+            //单趟迭代器先收集到临时 deque，再按前向区间一次插入
+            deque tmp(alloc_);
+            for (; first != last; ++first) tmp.push_back(*first);
+            insert_range_aux(index, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()), tmp.size());
+        }
+        template <class ForwardIt>
+        void insert_dispatch(size_type index, ForwardIt first, ForwardIt last, mystl::forward_iterator_tag) {
+            const size_type n = static_cast<size_type>(mystl::distance(first, last));
+            if (n != 0) insert_range_aux(index, first, last, n);
+        }
        public:
-       deque() noexcept : map_(nullptr),map_size_(0),start_(),finish_(),size_(0){initialize_empty();}
+       deque() : map_(nullptr),map_size_(0),start_(),finish_(),size_(0){initialize_empty();}
+       //指定分配器：块与map区都由alloc分配
+       explicit deque(const allocator_type& alloc)
+       : map_(nullptr),map_size_(0),start_(),finish_(),size_(0),alloc_(alloc){initialize_empty();}
+
+       allocator_type get_allocator() const noexcept{return alloc_;}
 
        bool      empty() const noexcept {return start_ == finish_;}
        size_type size()  const noexcept {return size_;}  //等待实现
@@ -283,39 +693,10 @@ namespace mystl {
        const_iterator end() const noexcept{return const_iterator(finish_.cur,finish_.first,finish_.last,finish_.node);}
        const_iterator cend() const noexcept{return const_iterator(finish_.cur,finish_.first,finish_.last,finish_.node);}
 
-       void push_back(const value_type& value){
-        require_back_slot();
-        if(finish_.cur != finish_.last){
-           mystl::construct(finish_.cur,value);
-            ++finish_.cur;
-        }     
-        ++size_;
-    }
-       void push_back(value_type&& value){
-        require_back_slot();
-        if(finish_.cur != finish_.last){
-          mystl::construct(finish_.cur,mystl::forward<value_type>(value));
-            ++finish_.cur;
-        }
-        ++size_;
-       }
-
-       void push_front(const value_type& value){
-        require_front_slot();
-        if(start_.cur != start_.first){
-          mystl::construct(start_.cur - 1,value);
-            --start_.cur;
-        }
-        ++size_;
-       }
-       void push_front(value_type&& value){
-        require_front_slot();
-        if(start_.cur != start_.first){
-            mystl::construct(start_.cur - 1,mystl::forward<value_type>(value));
-            --start_.cur;
-        }
-        ++size_;
-        }
+       void push_back(const value_type& value){construct_back(value);}
+       void push_back(value_type&& value){construct_back(mystl::move(value));}
+       void push_front(const value_type& value){construct_front(value);}
+       void push_front(value_type&& value){construct_front(mystl::move(value));}
        void pop_back(){
         if(empty())return;
         if(finish_.cur != finish_.first){
@@ -325,7 +706,7 @@ namespace mystl {
             pointer old_buf = finish_.first;
             size_type index = static_cast<size_type>(finish_.node - map_);
             *(map_ + index) = nullptr;
-            deallocate_node(old_buf);
+            put_node(old_buf);
 
             finish_.set_node(finish_.node - 1);
             finish_.cur = finish_.last - 1;
@@ -344,7 +725,7 @@ namespace mystl {
             pointer old_buf = start_.first;
             size_type index = static_cast<size_type>(start_.node - map_);
             *(map_ + index) = nullptr;  
-            deallocate_node(old_buf);
+            put_node(old_buf);
 
            start_.set_node(start_.node + 1);
            start_.cur = start_.first;
@@ -352,17 +733,16 @@ namespace mystl {
         --size_;
        }
 
+       //下标直接换算为（块, 块内偏移），不经过迭代器的分支判断
        reference operator[](size_type n)
        {
-        iterator it  = start_;
-        it += static_cast<difference_type>(n);
-        return *it;
+        const size_type off = n + static_cast<size_type>(start_.cur - start_.first);
+        return start_.node[block_index(off)][block_offset(off)];
        }
        const_reference operator[](size_type n) const
        {
-        const_iterator it = start_;
-        it += static_cast<difference_type>(n);
-        return *it;
+        const size_type off = n + static_cast<size_type>(start_.cur - start_.first);
+        return start_.node[block_index(off)][block_offset(off)];
        }
 
        reference at(size_type n)
@@ -393,14 +773,14 @@ namespace mystl {
         const size_type start_index = static_cast<size_type>(start_.node - map_);
         for (pointer* p = map_; p != map_ + map_size_; ++p) {
             if (p != start_.node && *p) {
-                deallocate_node(*p);
+                put_node(*p);
                 *p = nullptr;
             }
         }
 
         // 确保当前槽位有一个有效块
         if (map_[start_index] == nullptr) {
-            map_[start_index] = allocate_node();
+            map_[start_index] = take_node();
         }
 
         start_.set_node(map_ + start_index);
@@ -411,22 +791,25 @@ namespace mystl {
        }
 
        ~deque() {
+        release_spare_nodes();
         if (!map_) return; // moved-from 安全
         clear();
+        release_spare_nodes();
         const size_type idx = static_cast<size_type>(start_.node - map_);
         if (map_[idx]) {
             deallocate_node(map_[idx]);
             map_[idx] = nullptr;
         }
-        ::operator delete(map_);
+        deallocate_map(map_,map_size_);
         map_ = nullptr;
         map_size_ = 0;
        }
 
-       // 收缩到合适大小
-       void shrink_to_fit() noexcept{
+       // 收缩到合适大小，同时归还缓存的备用块
+       void shrink_to_fit(){
+            release_spare_nodes();
             if(!map_) return;
-            const size_type old_nodes = static_cast<size_type>(finish_ - start_ + 1);
+            const size_type old_nodes = static_cast<size_type>(finish_.node - start_.node + 1);
             size_type new_map_size = old_nodes + 2;
             if(new_map_size < static_cast<size_type>(8)){
                 new_map_size = static_cast<size_type>(8);
@@ -436,22 +819,20 @@ namespace mystl {
             const difference_type start_off = start_.cur - start_.first;
             const difference_type finish_off = finish_.cur - finish_.first;
 
-            pointer*new_map = static_cast<pointer*>(::operator new(sizeof(pointer) * new_map_size));
+            pointer*new_map = allocate_map(new_map_size);
             for(size_type i = 0;i < new_map_size;++i) new_map[i] = nullptr;
 
             const size_type old_start_index = static_cast<size_type>(start_.node - map_);
             const size_type new_start_index = (new_map_size - old_nodes) / 2;
-            for(size_type i =0;i < old_nodes;++i)
-            {
-                new_map[new_start_index + i] = map_[old_start_index + i];
-            }
+            mystl::uninitialized_relocate(map_ + old_start_index, map_ + old_start_index + old_nodes,
+                                          new_map + new_start_index);
 
             start_.set_node(new_map + new_start_index);
             finish_.set_node(new_map + new_start_index + old_nodes - 1);
             start_.cur = start_.first + start_off;
             finish_.cur = finish_.first + finish_off;
 
-            ::operator delete(map_);
+            deallocate_map(map_,map_size_);
             map_ = new_map;
             map_size_ = new_map_size;
        }
@@ -494,190 +875,98 @@ namespace mystl {
         assign(ilist.begin(),ilist.end());
        }
         //返回插入位置的迭代器
-        //单点插入，左半段右移，右半段左移
+        //单点插入，只移动较短的一侧
         iterator insert(iterator pos,const value_type& value){
-            difference_type index = pos - start_;
-
-            if(index < static_cast<difference_type>(size_ / 2)) {
-                push_front(front());
-                pos = start_ + 1;
-                iterator it_src = start_ + 1;
-                iterator it_dst = start_;
-                for(;it_src != pos;++it_src,++it_dst)
-                {
-                    *it_dst = mystl::move(*it_src);
-                }
-                *(start_ + index) = value;
-                return start_ + index;
-            }else{
-                push_back(back());
-                pos = start_ + index;
-                iterator it_src =  finish_ - 2;
-                iterator it_dst = finish_ - 1;
-                while(it_src >= pos) {
-                    *it_dst = mystl::move(*it_src);
-                    --it_dst;
-                    --it_src;
-                }
-                *pos = value;
-                return pos;
-            }
+            return emplace(pos,value);
         }
-        //右值插入，左半段右移，右半段左移
+        //右值插入
         iterator insert(iterator pos,value_type&& value)
         {
-            difference_type index = pos - start_;
-
-            if(index < static_cast<difference_type>(size_ / 2)) {
-                push_front(front());
-                pos = start_ + 1;
-                iterator it_src = start_ + 1;
-                iterator it_dst = start_;
-                for(;it_src != pos;++it_src,++it_dst)
-                {
-                    *it_dst = mystl::move(*it_src);
-                }
-                *(start_ + index) = mystl::move(value);
-                return start_ + index;
-            }else{
-                push_back(back());
-                pos = start_ + index;
-                iterator it_src =  finish_ - 2;
-                iterator it_dst = finish_ - 1;
-                while(it_src >= pos) {
-                    *it_dst = mystl::move(*it_src);
-                    --it_dst;
-                    --it_src;
-                }
-                *pos = mystl::move(value);
-                return start_ + index;
-            }
+            return emplace(pos,mystl::move(value));
         }
-        //单点插入，左半段右移，右半段左移
+        //插入count个value，一次备好所需的块，较短一侧整体只移动一次
         iterator insert(iterator pos,size_type count,const value_type& value)
         {
-            if(count == 0) return pos;
-            difference_type index = pos - start_;
-            for(size_type i = 0;i < count;++i)
-            {
-                pos = insert(start_ + index + static_cast<difference_type>(i),value);
-            }
-            return start_ + index;
+            const size_type index = static_cast<size_type>(pos - start_);
+            if(count != 0) insert_fill_aux(index,count,value);
+            return start_ + static_cast<difference_type>(index);
         }
-        //区间插入，左半段右移，右半段左移
+        //区间插入，较短一侧整体只移动一次
         //SFINAE机制，如果InputIterator是整数类型，则不进行插入
         template<typename InputIterator,typename 
         = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
         iterator insert(iterator pos,InputIterator first,InputIterator last)
         {
-            if(first == last) return pos;
-            difference_type index = pos - start_;
-            size_type i = 0;
-            for(;first != last;++first,++i)
-            {
-                pos = insert(start_ + index + static_cast<difference_type>(i),*first);
+            const size_type index = static_cast<size_type>(pos - start_);
+            if(first != last) {
+                insert_dispatch(index,first,last,typename mystl::iterator_traits<InputIterator>::iterator_category());
             }
-            return start_ + index;
+            return start_ + static_cast<difference_type>(index);
         }
-        //初始化列表插入，左半段右移，右半段左移
+        //初始化列表插入
         iterator insert(iterator pos,std::initializer_list<value_type> ilist)
         {
-            difference_type index = pos - start_;
-            size_type i = 0;
-            for(const auto& it : ilist)
-            {
-                pos = insert(start_ + index + static_cast<difference_type>(i),it);
-                ++i;
-            }
-            return start_ + index;
+            const size_type index = static_cast<size_type>(pos - start_);
+            if(ilist.size() != 0) insert_range_aux(index,ilist.begin(),ilist.end(),ilist.size());
+            return start_ + static_cast<difference_type>(index);
         }
 
-        //区间插入，左半段右移，右半段左移
+        //区间插入，源区间可能就在本容器内，先复制到临时缓冲区
         iterator insert(iterator pos,const_iterator first,const_iterator last)
         {
-            difference_type index = pos - start_;
+            const size_type index = static_cast<size_type>(pos - start_);
             size_type n = static_cast<size_type>(last - first);
-            if(n == 0) return start_ + index;
-            pointer tmp = static_cast<pointer>(::operator new(sizeof(value_type)*n));
-            for(int i = 0;first != last;++first,++i)
-            {
-                mystl::construct(tmp + i,*first);
+            if(n == 0) return start_ + static_cast<difference_type>(index);
+            data_alloc a(alloc_);
+            pointer tmp = a.allocate(n);
+            try {
+                mystl::uninitialized_copy(first,last,tmp);
+            } catch (...) {
+                a.deallocate(tmp,n);
+                throw;
             }
-            for(int i = 0;i< n;i++)
-            {
-                insert(start_ + index + static_cast<difference_type>(i),*(tmp + i));
+            try {
+                insert_range_aux(index,std::make_move_iterator(tmp),std::make_move_iterator(tmp + n),n);
+            } catch (...) {
+                mystl::destroy(tmp,tmp + n);
+                a.deallocate(tmp,n);
+                throw;
             }
             mystl::destroy(tmp,tmp + n);
-            ::operator delete(tmp);
-            return start_ + index;
+            a.deallocate(tmp,n);
+            return start_ + static_cast<difference_type>(index);
         }
-        //单点erase，左半段右移，右半段左移
+        //单点erase
         iterator erase(iterator pos) {
-           difference_type index = pos - start_;
-           if(index < static_cast<difference_type>(size_ / 2)) {
-            if (pos != start_) {
-                iterator it_src = pos - 1;
-                iterator it_dst = pos;
-                while(it_src >= start_) {
-                    *it_dst = mystl::move(*it_src);
-                    --it_src;
-                    --it_dst;
-                }
-            }
-            pop_front();
-          //返回删除元素的下一个位置
-            return start_ + index;
-           }
-           else {
-                iterator it_src = pos + 1;
-                iterator it_dst = pos;
-               for(;it_src != finish_;++it_src,++it_dst)
-                { 
-                    *it_dst = *it_src;
-                }
-                pop_back();
-                return start_ + index;
-           }
+            return erase(pos,pos + 1);
         }
 
-        //区间erase，左半段右移，右半段左移
+        //区间erase，只移动较短的一侧，腾空的整块直接归还
         iterator erase(iterator first,iterator last) {
-            if(first ==  last) return first;
-            difference_type index_first = first - start_;
-            difference_type index_last = last - start_;
-            size_type n = static_cast<size_type>(index_last - index_first);  
-
-            if(index_first < static_cast<difference_type>(size_ - index_last))
-            {
-                if (first != start_) {
-                    iterator it_src = first - 1;
-                    iterator it_dst = last - 1;
-                    while(it_src >= start_) {
-                        *it_dst = *it_src;
-                        --it_dst;
-                        --it_src;
-                    }
-                }
-              for(size_type i = 0;i < n;i++) pop_front();
-              return start_ + index_first;
+            if(first == last) return first;
+            const difference_type n = last - first;
+            const difference_type before = first - start_;
+            const difference_type after = static_cast<difference_type>(size_) - n - before;
+            if(before < after) {
+                move_segments_backward(start_,first,last);
+                iterator new_start = start_ + n;
+                destroy_range(start_,new_start);
+                free_nodes(start_.node,new_start.node);
+                start_ = new_start;
             } else {
-                iterator it_src = last;
-                iterator it_dst = first;
-                for(;it_src != finish_;++it_src,++it_dst)
-                {
-                    *it_dst= *it_src;
-                }
-                for(size_type i = 0;i < n;i++) pop_back();
-                return start_ + index_first;
-            }       
+                move_segments(last,finish_,first);
+                iterator new_finish = finish_ - n;
+                destroy_range(new_finish,finish_);
+                free_nodes(new_finish.node + 1,finish_.node + 1);
+                finish_ = new_finish;
+            }
+            size_ -= static_cast<size_type>(n);
+            return start_ + before;
         }
 //emplace_back返回最后一个元素的迭代器
         template <class... Args>
         iterator emplace_back(Args&&... args) {
-            require_back_slot();
-            mystl::construct(finish_.cur,mystl::forward<Args>(args)...);
-            ++finish_.cur;
-            ++size_;
+            construct_back(mystl::forward<Args>(args)...);
             iterator it  = finish_;
             --it;
             return it;
@@ -685,18 +974,30 @@ namespace mystl {
 //emplace_front返回第一个元素的迭代器
         template <class... Args>
         iterator emplace_front(Args&&... args){
-            require_front_slot();
             //修正完美转发，避免value_type(mystl::forward<Args>(args)...)这种写法，
             // 因为value_type可能没有构造函数
-            mystl::construct(start_.cur - 1,mystl::forward<Args>(args)...);
-            --start_.cur;
-            ++size_;
+            construct_front(mystl::forward<Args>(args)...);
             return start_;
         }
 //emplace返回插入位置的迭代器
+        //两端直接构造；中间位置先构造临时对象，较短一侧整体挪一位后移动赋值
         template <class... Args>
         iterator emplace(iterator pos,Args&&... args){
-        return insert(pos,value_type(mystl::forward<Args>(args)...));
+            if(pos == start_) return emplace_front(mystl::forward<Args>(args)...);
+            if(pos == finish_) return emplace_back(mystl::forward<Args>(args)...);
+            const size_type index = static_cast<size_type>(pos - start_);
+            value_type tmp(mystl::forward<Args>(args)...);
+            if(index < size_ / 2) {
+                construct_front(mystl::move(front()));
+                //原第 1..index-1 个元素此时位于 start_+2..start_+index，整体前移一位
+                move_segments(start_ + 2,start_ + static_cast<difference_type>(index) + 1,start_ + 1);
+            } else {
+                construct_back(mystl::move(back()));
+                move_segments_backward(start_ + static_cast<difference_type>(index),finish_ - 2,finish_ - 1);
+            }
+            iterator it = start_ + static_cast<difference_type>(index);
+            *it = mystl::move(tmp);
+            return it;
         }
 
         void swap(deque& other) noexcept{
@@ -705,6 +1006,13 @@ namespace mystl {
             mystl::swap(start_,other.start_);
             mystl::swap(finish_,other.finish_);
             mystl::swap(size_,other.size_);
+            //备用块属于各自的分配器，随分配器一起交换
+            const size_type spares = mystl::max(spare_count_, other.spare_count_);
+            for (size_type i = 0; i < spares; ++i) mystl::swap(spare_[i],other.spare_[i]);
+            mystl::swap(spare_count_,other.spare_count_);
+            allocator_type a = alloc_;
+            alloc_ = other.alloc_;
+            other.alloc_ = a;
         }
 
         //ADL机制，找到swap函数,不用找命名空间
@@ -750,13 +1058,15 @@ namespace mystl {
         }
 
         //拷贝构造
-        deque(const deque& other) : map_(nullptr),map_size_(0),start_(),finish_(),size_(0)
+        deque(const deque& other) : map_(nullptr),map_size_(0),start_(),finish_(),size_(0),alloc_(other.alloc_)
         {
             initialize_empty();
             assign(other.begin(),other.end());
         }
-        deque(deque&& other) noexcept:map_(other.map_),map_size_(other.map_size_),start_(other.start_),finish_(other.finish_),size_(other.size_)
+        //块与map区随分配器一起转移
+        deque(deque&& other) noexcept:map_(other.map_),map_size_(other.map_size_),start_(other.start_),finish_(other.finish_),size_(other.size_),alloc_(other.alloc_)
         {
+            steal_spare_nodes(other);
             other.map_ = nullptr;
             other.map_size_ = 0;
             other.start_ = iterator();
@@ -776,11 +1086,13 @@ namespace mystl {
             if(this == &other) return *this;
             clear();
             destroy_map_and_nodes();
+            alloc_ = other.alloc_;
             map_ = other.map_;
             map_size_ = other.map_size_;
             start_ = other.start_;
             finish_ = other.finish_;
             size_ = other.size_;
+            steal_spare_nodes(other);
             other.map_ = nullptr;
             other.map_size_ = 0;
             other.start_ = iterator();
@@ -789,7 +1101,8 @@ namespace mystl {
             return *this;
         }
         //初始化列表赋值
-        deque(std::initializer_list<value_type> ilist) : map_(nullptr),map_size_(0),start_(),finish_(),size_(0)
+        deque(std::initializer_list<value_type> ilist,const allocator_type& alloc = allocator_type())
+        : map_(nullptr),map_size_(0),start_(),finish_(),size_(0),alloc_(alloc)
         {
             initialize_empty();
             assign(ilist.begin(),ilist.end());
@@ -801,6 +1114,15 @@ namespace mystl {
         }
 
         };//class deque
+
+    namespace pmr {
+    template <typename T> class polymorphic_allocator;
+
+    // 使用多态分配器的 deque，分配策略在运行时由 memory_resource 决定（需包含 memory_resource.h）
+    template <typename T>
+    using deque = mystl::deque<T, polymorphic_allocator<T>>;
+    } // namespace pmr
+
     }//namespace mystl
     
     #endif
\ No newline at end of file
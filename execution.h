@@ -0,0 +1,1024 @@
+#ifndef MYTINYSTL_EXECUTION_H
+#define MYTINYSTL_EXECUTION_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "algo.h"
+#include "heap_algo.h"
+#include "memory.h"
+#include "numeric.h"
+#include "vector.h"
+#include "thread_pool.h"
+#include "type_traits.h"
+
+namespace mystl {
+
+// ============================================================================
+// 执行策略
+// ============================================================================
+
+namespace execution {
+
+/**
+ * @brief 顺序执行策略：调用对应的串行算法
+ */
+class sequenced_policy {
+public:
+    constexpr sequenced_policy() noexcept {}
+};
+
+/**
+ * @brief 并行执行策略：在线程池上执行，默认使用 thread_pool::default_pool()
+ *
+ * 用 par.on(pool) 指定线程池，例如 mystl::sort(mystl::execution::par.on(pool), first, last)。
+ */
+class parallel_policy {
+public:
+    constexpr parallel_policy() noexcept : pool_(nullptr) {}
+    constexpr explicit parallel_policy(thread_pool* pool) noexcept : pool_(pool) {}
+
+    /**
+     * @brief 返回在指定线程池上执行的策略
+     */
+    parallel_policy on(thread_pool& pool) const noexcept {
+        return parallel_policy(&pool);
+    }
+
+    /**
+     * @brief 执行所用的线程池
+     */
+    thread_pool& pool() const {
+        return pool_ != nullptr ? *pool_ : thread_pool::default_pool();
+    }
+
+private:
+    thread_pool* pool_;
+};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy  par{};
+
+/**
+ * @brief 判断 T 是否为执行策略类型
+ */
+template <class T>
+struct is_execution_policy : m_false_type {};
+
+template <>
+struct is_execution_policy<sequenced_policy> : m_true_type {};
+
+template <>
+struct is_execution_policy<parallel_policy> : m_true_type {};
+
+} // namespace execution
+
+// 仅当 Policy 去掉引用和 cv 限定后是执行策略时，重载才参与决议
+template <class Policy, class R = void>
+struct enable_if_execution_policy
+    : std::enable_if<execution::is_execution_policy<typename std::decay<Policy>::type>::value, R> {};
+
+// 执行策略对应的线程池，顺序执行时为空
+inline thread_pool* execution_pool(const execution::sequenced_policy&) noexcept {
+    return nullptr;
+}
+
+inline thread_pool* execution_pool(const execution::parallel_policy& policy) {
+    return &policy.pool();
+}
+
+// ============================================================================
+// 并行排序的实现
+// ============================================================================
+
+// 区间长度小于该值时不做并行，线程调度的开销会超过收益
+constexpr ptrdiff_t kParallelSortThreshold = 1 << 15;
+
+// 每个工作线程平均分到的叶子任务数，多切几份便于负载均衡
+constexpr ptrdiff_t kParallelTasksPerThread = 4;
+
+// 并行 partial_sort 中每块的长度至少为 k 的这么多倍
+constexpr ptrdiff_t kParallelPartialSortChunkFactor = 8;
+
+/**
+ * @brief 串行叶子排序：不稳定
+ */
+struct parallel_leaf_sort {
+    template <class RandomIter, class Compared>
+    void operator()(RandomIter first, RandomIter last, Compared comp) const {
+        mystl::sort(first, last, comp);
+    }
+};
+
+/**
+ * @brief 串行叶子排序：稳定
+ */
+struct parallel_leaf_stable_sort {
+    template <class RandomIter, class Compared>
+    void operator()(RandomIter first, RandomIter last, Compared comp) const {
+        mystl::stable_sort(first, last, comp);
+    }
+};
+
+/**
+ * @brief 计算叶子任务的长度：至少为串行阈值的一半，且总任务数约为线程数的若干倍
+ */
+inline ptrdiff_t parallel_leaf_size(ptrdiff_t n, size_t threads) {
+    const ptrdiff_t by_threads = n / (static_cast<ptrdiff_t>(threads) * kParallelTasksPerThread);
+    return mystl::max(by_threads, kParallelSortThreshold / 2);
+}
+
+/**
+ * @brief 两个有序序列的串行合并，结果移动到 out；相等元素先取第一个序列，保证稳定
+ */
+template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+OutputIter parallel_serial_move_merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                                      OutputIter out, Compared comp) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first2, *first1)) {
+            *out = mystl::move(*first2);
+            ++first2;
+        } else {
+            *out = mystl::move(*first1);
+            ++first1;
+        }
+        ++out;
+    }
+    out = mystl::move(first1, last1, out);
+    return mystl::move(first2, last2, out);
+}
+
+/**
+ * @brief 并行归并排序：叶子用串行排序，两半结果在原区间与缓冲区之间交替合并
+ * @tparam RandomIter 区间迭代器类型
+ * @tparam Pointer 缓冲区指针类型
+ * @tparam LeafSorter 叶子排序器，决定整体是否稳定
+ */
+template <class RandomIter, class Pointer, class Compared, class LeafSorter>
+class parallel_merge_sorter {
+public:
+    parallel_merge_sorter(thread_pool& pool, Compared comp, ptrdiff_t leaf_size)
+        : pool_(pool), comp_(comp), leaf_size_(leaf_size) {}
+
+    /**
+     * @brief 排序 [first, last)，to_buffer 为 true 时结果写入 buf，否则留在原区间
+     * @param buf 与区间等长的缓冲区，其中为可移动赋值的有效对象
+     */
+    void sort(RandomIter first, RandomIter last, Pointer buf, bool to_buffer) {
+        const ptrdiff_t n = last - first;
+        if (n <= leaf_size_) {
+            LeafSorter()(first, last, comp_);
+            if (to_buffer) {
+                mystl::move(first, last, buf);
+            }
+            return;
+        }
+        const ptrdiff_t half = n / 2;
+        RandomIter middle = first + half;
+        Pointer buf_middle = buf + half;
+        {
+            task_group group(pool_);
+            parallel_merge_sorter* self = this;
+            group.run([self, first, middle, buf, to_buffer] {
+                self->sort(first, middle, buf, !to_buffer);
+            });
+            sort(middle, last, buf_middle, !to_buffer);
+            group.wait();
+        }
+        // 两半的结果在另一侧，合并回目标位置
+        if (to_buffer) {
+            merge(first, middle, middle, last, buf);
+        } else {
+            merge(buf, buf_middle, buf_middle, buf + n, first);
+        }
+    }
+
+    /**
+     * @brief 并行合并：在较长序列的中点切分，另一序列二分查找对应位置，两部分并行合并
+     */
+    template <class Iter1, class Iter2, class OutputIter>
+    void merge(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2, OutputIter out) {
+        const ptrdiff_t n1 = last1 - first1;
+        const ptrdiff_t n2 = last2 - first2;
+        if (n1 + n2 <= leaf_size_) {
+            mystl::parallel_serial_move_merge(first1, last1, first2, last2, out, comp_);
+            return;
+        }
+        Iter1 cut1 = first1;
+        Iter2 cut2 = first2;
+        if (n1 >= n2) {
+            cut1 = first1 + n1 / 2;
+            cut2 = mystl::lower_bound(first2, last2, *cut1, comp_);
+        } else {
+            cut2 = first2 + n2 / 2;
+            cut1 = mystl::upper_bound(first1, last1, *cut2, comp_);
+        }
+        OutputIter out_cut = out + ((cut1 - first1) + (cut2 - first2));
+        task_group group(pool_);
+        parallel_merge_sorter* self = this;
+        group.run([self, first1, cut1, first2, cut2, out] {
+            self->merge(first1, cut1, first2, cut2, out);
+        });
+        merge(cut1, last1, cut2, last2, out_cut);
+        group.wait();
+    }
+
+private:
+    thread_pool& pool_;
+    Compared     comp_;
+    ptrdiff_t    leaf_size_;
+};
+
+/**
+ * @brief 并行快速排序：分割后两侧并行递归，申请不到归并缓冲区时使用
+ */
+template <class RandomIter, class Compared>
+void parallel_quick_sort(thread_pool& pool, RandomIter first, RandomIter last, Compared comp,
+                         ptrdiff_t leaf_size, int depth_limit) {
+    if (last - first <= leaf_size || depth_limit == 0) {
+        mystl::sort(first, last, comp);
+        return;
+    }
+    RandomIter cut = mystl::unguarded_partition_pivot(first, last, comp);
+    task_group group(pool);
+    group.run([&pool, first, cut, comp, leaf_size, depth_limit] {
+        mystl::parallel_quick_sort(pool, first, cut, comp, leaf_size, depth_limit - 1);
+    });
+    mystl::parallel_quick_sort(pool, cut, last, comp, leaf_size, depth_limit - 1);
+    group.wait();
+}
+
+/**
+ * @brief 并行排序
+ * @param pool 线程池
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ *
+ * 叶子区间用 mystl::sort，之后并行归并；申请不到与区间等长的缓冲区时改用并行快速排序。
+ */
+template <class RandomIter, class Compared>
+void parallel_sort(thread_pool& pool, RandomIter first, RandomIter last, Compared comp) {
+    const ptrdiff_t n = last - first;
+    if (n < kParallelSortThreshold || pool.size() < 2) {
+        mystl::sort(first, last, comp);
+        return;
+    }
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    const ptrdiff_t leaf_size = mystl::parallel_leaf_size(n, pool.size());
+    temporary_buffer<value_type> buf(first, n);
+    if (buf.size() < n) {
+        mystl::parallel_quick_sort(pool, first, last, comp, leaf_size,
+                                   static_cast<int>(mystl::slg2(n)) * 2);
+        return;
+    }
+    parallel_merge_sorter<RandomIter, value_type*, Compared, parallel_leaf_sort>
+        sorter(pool, comp, leaf_size);
+    sorter.sort(first, last, buf.begin(), false);
+}
+
+/**
+ * @brief 并行稳定排序
+ * @param pool 线程池
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ *
+ * 叶子区间用 mystl::stable_sort，之后并行稳定归并；申请不到缓冲区时退化为串行 stable_sort。
+ */
+template <class RandomIter, class Compared>
+void parallel_stable_sort(thread_pool& pool, RandomIter first, RandomIter last, Compared comp) {
+    const ptrdiff_t n = last - first;
+    if (n < kParallelSortThreshold || pool.size() < 2) {
+        mystl::stable_sort(first, last, comp);
+        return;
+    }
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    temporary_buffer<value_type> buf(first, n);
+    if (buf.size() < n) {
+        mystl::stable_sort(first, last, comp);
+        return;
+    }
+    parallel_merge_sorter<RandomIter, value_type*, Compared, parallel_leaf_stable_sort>
+        sorter(pool, comp, mystl::parallel_leaf_size(n, pool.size()));
+    sorter.sort(first, last, buf.begin(), false);
+}
+
+/**
+ * @brief 并行部分排序
+ * @param pool 线程池
+ * @param first 起始迭代器
+ * @param middle 部分排序的结束位置
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ *
+ * 把区间切成若干块，各块并行做 partial_sort 取出块内最小的 k 个，
+ * 再多路归并各块的有序前缀得到全局最小的 k 个，最后把它们搬到 [first, middle)。
+ * k 接近 n 时直接并行全排序更快。
+ */
+template <class RandomIter, class Compared>
+void parallel_partial_sort(thread_pool& pool, RandomIter first, RandomIter middle, RandomIter last,
+                           Compared comp) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    const ptrdiff_t n = last - first;
+    const ptrdiff_t k = middle - first;
+    if (k == 0) {
+        return;
+    }
+    if (n < kParallelSortThreshold || pool.size() < 2) {
+        mystl::partial_sort(first, middle, last, comp);
+        return;
+    }
+    if (k >= n / 4) {
+        mystl::parallel_sort(pool, first, last, comp);
+        return;
+    }
+    // 每块远大于 k 时块内 partial_sort 才接近线性，块数不超过线程数
+    const ptrdiff_t chunks = mystl::min(static_cast<ptrdiff_t>(pool.size()),
+                                        n / (kParallelPartialSortChunkFactor * k));
+    if (chunks < 2) {
+        mystl::partial_sort(first, middle, last, comp);
+        return;
+    }
+    temporary_buffer<value_type> buf(first, k);
+    if (buf.size() < k) {
+        mystl::partial_sort(first, middle, last, comp);
+        return;
+    }
+
+    // 1. 各块并行取出块内最小的 k 个并排好序
+    mystl::vector<ptrdiff_t> bounds;
+    for (ptrdiff_t i = 0; i <= chunks; ++i) {
+        bounds.push_back(n * i / chunks);
+    }
+    {
+        task_group group(pool);
+        for (ptrdiff_t i = 0; i < chunks; ++i) {
+            RandomIter chunk_first = first + bounds[i];
+            RandomIter chunk_last = first + bounds[i + 1];
+            group.run([chunk_first, chunk_last, k, comp] {
+                mystl::partial_sort(chunk_first, chunk_first + k, chunk_last, comp);
+            });
+        }
+        group.wait();
+    }
+
+    // 2. 多路归并各块的有序前缀，把全局最小的 k 个移到缓冲区；taken[i] 为第 i 块被取走的个数
+    mystl::vector<ptrdiff_t> taken(static_cast<size_t>(chunks), 0);
+    mystl::vector<ptrdiff_t> heap;
+    for (ptrdiff_t i = 0; i < chunks; ++i) {
+        heap.push_back(i);
+    }
+    // 小顶堆：块头元素越小越靠近堆顶
+    auto head_greater = [&](ptrdiff_t a, ptrdiff_t b) {
+        return comp(first[bounds[b] + taken[b]], first[bounds[a] + taken[a]]);
+    };
+    mystl::make_heap(heap.begin(), heap.end(), head_greater);
+    value_type* out = buf.begin();
+    for (ptrdiff_t produced = 0; produced < k; ++produced) {
+        const ptrdiff_t i = heap[0];
+        *out++ = mystl::move(first[bounds[i] + taken[i]]);
+        ++taken[i];
+        if (taken[i] == k) {
+            // 该块的有序前缀已取完，用堆尾替换堆顶
+            heap[0] = heap.back();
+            heap.pop_back();
+            if (heap.empty()) {
+                break;
+            }
+        }
+        mystl::adjust_heap(heap.begin(), ptrdiff_t(0), static_cast<ptrdiff_t>(heap.size()), head_greater);
+    }
+
+    // 3. 被取走的位置成了空洞：把 [first, middle) 中未被取走的元素移入 [middle, last) 中的空洞，
+    //    再把缓冲区中的结果移回 [first, middle)
+    mystl::vector<ptrdiff_t> kept_in_front;   // [first, middle) 中未被取走的位置
+    mystl::vector<ptrdiff_t> holes_in_back;   // [middle, last) 中的空洞
+    for (ptrdiff_t i = 0; i < chunks; ++i) {
+        const ptrdiff_t hole_end = bounds[i] + taken[i];
+        for (ptrdiff_t p = bounds[i]; p < hole_end; ++p) {
+            if (p >= k) {
+                holes_in_back.push_back(p);
+            }
+        }
+        for (ptrdiff_t p = hole_end; p < bounds[i + 1] && p < k; ++p) {
+            kept_in_front.push_back(p);
+        }
+    }
+    for (size_t j = 0; j < kept_in_front.size(); ++j) {
+        first[holes_in_back[j]] = mystl::move(first[kept_in_front[j]]);
+    }
+    mystl::move(buf.begin(), buf.begin() + k, first);
+}
+
+// ============================================================================
+// 带执行策略的排序算法
+// ============================================================================
+
+template <class RandomIter, class Compared>
+void sort_dispatch(const execution::sequenced_policy&, RandomIter first, RandomIter last, Compared comp) {
+    mystl::sort(first, last, comp);
+}
+
+template <class RandomIter, class Compared>
+void sort_dispatch(const execution::parallel_policy& policy, RandomIter first, RandomIter last, Compared comp) {
+    mystl::parallel_sort(policy.pool(), first, last, comp);
+}
+
+template <class RandomIter, class Compared>
+void stable_sort_dispatch(const execution::sequenced_policy&, RandomIter first, RandomIter last, Compared comp) {
+    mystl::stable_sort(first, last, comp);
+}
+
+template <class RandomIter, class Compared>
+void stable_sort_dispatch(const execution::parallel_policy& policy, RandomIter first, RandomIter last,
+                          Compared comp) {
+    mystl::parallel_stable_sort(policy.pool(), first, last, comp);
+}
+
+template <class RandomIter, class Compared>
+void partial_sort_dispatch(const execution::sequenced_policy&, RandomIter first, RandomIter middle,
+                           RandomIter last, Compared comp) {
+    mystl::partial_sort(first, middle, last, comp);
+}
+
+template <class RandomIter, class Compared>
+void partial_sort_dispatch(const execution::parallel_policy& policy, RandomIter first, RandomIter middle,
+                           RandomIter last, Compared comp) {
+    mystl::parallel_partial_sort(policy.pool(), first, middle, last, comp);
+}
+
+/**
+ * @brief 按执行策略对[first, last)区间内的元素进行排序，使用给定的比较函数
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template <class ExecutionPolicy, class RandomIter, class Compared>
+typename enable_if_execution_policy<ExecutionPolicy>::type
+sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last, Compared comp) {
+    mystl::sort_dispatch(policy, first, last, comp);
+}
+
+/**
+ * @brief 按执行策略对[first, last)区间内的元素进行排序
+ */
+template <class ExecutionPolicy, class RandomIter>
+typename enable_if_execution_policy<ExecutionPolicy>::type
+sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last) {
+    mystl::sort_dispatch(policy, first, last, less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+/**
+ * @brief 按执行策略对[first, last)区间内的元素进行稳定排序，使用给定的比较函数
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template <class ExecutionPolicy, class RandomIter, class Compared>
+typename enable_if_execution_policy<ExecutionPolicy>::type
+stable_sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last, Compared comp) {
+    mystl::stable_sort_dispatch(policy, first, last, comp);
+}
+
+/**
+ * @brief 按执行策略对[first, last)区间内的元素进行稳定排序
+ */
+template <class ExecutionPolicy, class RandomIter>
+typename enable_if_execution_policy<ExecutionPolicy>::type
+stable_sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last) {
+    mystl::stable_sort_dispatch(policy, first, last, less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+/**
+ * @brief 按执行策略对[first, last)区间内的元素进行部分排序，使用给定的比较函数
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first 起始迭代器
+ * @param middle 部分排序的结束位置
+ * @param last 结束迭代器
+ * @param comp 比较函数
+ */
+template <class ExecutionPolicy, class RandomIter, class Compared>
+typename enable_if_execution_policy<ExecutionPolicy>::type
+partial_sort(ExecutionPolicy&& policy, RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
+    mystl::partial_sort_dispatch(policy, first, middle, last, comp);
+}
+
+/**
+ * @brief 按执行策略对[first, last)区间内的元素进行部分排序
+ */
+template <class ExecutionPolicy, class RandomIter>
+typename enable_if_execution_policy<ExecutionPolicy>::type
+partial_sort(ExecutionPolicy&& policy, RandomIter first, RandomIter middle, RandomIter last) {
+    mystl::partial_sort_dispatch(policy, first, middle, last,
+                                 less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+// ============================================================================
+// 并行归约的实现
+// ============================================================================
+
+// 区间长度小于该值时串行归约：归约受内存带宽限制，小区间并行得不偿失
+constexpr ptrdiff_t kParallelReduceThreshold = 1 << 16;
+
+// 并行归约中每块的最小长度
+constexpr ptrdiff_t kParallelReduceMinChunk = 1 << 14;
+
+/**
+ * @brief 是否值得在 pool 上并行处理长度为 n 的区间
+ */
+inline bool parallel_worthwhile(thread_pool* pool, ptrdiff_t n, ptrdiff_t threshold) {
+    return pool != nullptr && pool->size() > 1 && n >= threshold;
+}
+
+/**
+ * @brief 并行处理长度为 n 的区间时切分的块数，第 c 块为 [n * c / chunks, n * (c + 1) / chunks)
+ */
+inline ptrdiff_t parallel_chunk_count(thread_pool& pool, ptrdiff_t n) {
+    const ptrdiff_t max_chunks = static_cast<ptrdiff_t>(pool.size()) * kParallelTasksPerThread;
+    return mystl::max(ptrdiff_t(1), mystl::min(max_chunks, n / kParallelReduceMinChunk));
+}
+
+/**
+ * @brief 把 [0, n) 切成若干连续的块并行求值
+ * @param fill 结果数组的初始填充值
+ * @param chunk_fn chunk_fn(begin, end) 返回块 [begin, end) 的结果，块非空
+ * @return 各块结果，按块的先后顺序排列，合并顺序与调度无关，结果可复现
+ */
+template <class T, class ChunkFn>
+mystl::vector<T> parallel_reduce_partials(thread_pool& pool, ptrdiff_t n, const T& fill, ChunkFn chunk_fn) {
+    const ptrdiff_t chunks = mystl::parallel_chunk_count(pool, n);
+    mystl::vector<T> partials(static_cast<size_t>(chunks), fill);
+    task_group group(pool);
+    for (ptrdiff_t c = 1; c < chunks; ++c) {
+        group.run([&partials, &chunk_fn, n, chunks, c] {
+            partials[c] = chunk_fn(n * c / chunks, n * (c + 1) / chunks);
+        });
+    }
+    partials[0] = chunk_fn(0, n / chunks);
+    group.wait();
+    return partials;
+}
+
+template <class RandomIter, class T, class BinaryOp, class UnaryOp>
+T parallel_transform_reduce(thread_pool* pool, RandomIter first, RandomIter last, T init,
+                            BinaryOp reduce_op, UnaryOp transform_op, random_access_iterator_tag) {
+    const ptrdiff_t n = last - first;
+    if (!mystl::parallel_worthwhile(pool, n, kParallelReduceThreshold)) {
+        return mystl::transform_reduce(first, last, init, reduce_op, transform_op);
+    }
+    // 每块以自己的首元素为初值，init 只参与最后的合并
+    mystl::vector<T> partials = mystl::parallel_reduce_partials(*pool, n, init,
+        [&](ptrdiff_t b, ptrdiff_t e) -> T {
+            return mystl::transform_reduce(first + (b + 1), first + e, static_cast<T>(transform_op(first[b])),
+                                           reduce_op, transform_op);
+        });
+    return mystl::reduce_fold(partials.begin(), partials.end(), init, reduce_op, reduce_identity());
+}
+
+template <class InputIter, class T, class BinaryOp, class UnaryOp, class Category>
+T parallel_transform_reduce(thread_pool*, InputIter first, InputIter last, T init,
+                            BinaryOp reduce_op, UnaryOp transform_op, Category) {
+    return mystl::transform_reduce(first, last, init, reduce_op, transform_op);
+}
+
+template <class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2>
+T parallel_transform_reduce2(thread_pool* pool, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                             BinaryOp1 reduce_op, BinaryOp2 transform_op,
+                             random_access_iterator_tag, random_access_iterator_tag) {
+    const ptrdiff_t n = last1 - first1;
+    if (!mystl::parallel_worthwhile(pool, n, kParallelReduceThreshold)) {
+        return mystl::transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+    }
+    mystl::vector<T> partials = mystl::parallel_reduce_partials(*pool, n, init,
+        [&](ptrdiff_t b, ptrdiff_t e) -> T {
+            return mystl::transform_reduce(first1 + (b + 1), first1 + e, first2 + (b + 1),
+                                           static_cast<T>(transform_op(first1[b], first2[b])),
+                                           reduce_op, transform_op);
+        });
+    return mystl::reduce_fold(partials.begin(), partials.end(), init, reduce_op, reduce_identity());
+}
+
+template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2,
+          class Category1, class Category2>
+T parallel_transform_reduce2(thread_pool*, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                             BinaryOp1 reduce_op, BinaryOp2 transform_op, Category1, Category2) {
+    return mystl::transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+}
+
+/**
+ * @brief 并行高精度求和：各块独立做补偿或成对求和，块结果再用同一方法合并
+ * @param get get(i) 返回第 i 个加数
+ */
+template <class T, class Getter>
+T parallel_accurate_sum(thread_pool& pool, ptrdiff_t n, T init, Getter get, kahan_summation_tag) {
+    typedef mystl::pair<T, T> parts;
+    mystl::vector<parts> partials = mystl::parallel_reduce_partials(pool, n, parts(),
+        [&](ptrdiff_t b, ptrdiff_t e) -> parts {
+            return mystl::kahan_sum_parts_n(e - b, T(), [&](ptrdiff_t i) -> T { return get(b + i); });
+        });
+    // 各块的部分和与补偿量分别合并，避免逐块舍入
+    T sum = init;
+    T comp = T();
+    for (size_t i = 0; i < partials.size(); ++i) {
+        mystl::neumaier_add(sum, comp, partials[i].first);
+        comp += partials[i].second;
+    }
+    return sum + comp;
+}
+
+template <class T, class Getter>
+T parallel_accurate_sum(thread_pool& pool, ptrdiff_t n, T init, Getter get, pairwise_summation_tag) {
+    mystl::vector<T> partials = mystl::parallel_reduce_partials(pool, n, T(),
+        [&](ptrdiff_t b, ptrdiff_t e) -> T {
+            auto chunk_get = [&](ptrdiff_t i) -> T { return get(b + i); };
+            return mystl::pairwise_sum_n<T>(0, e - b, chunk_get);
+        });
+    return mystl::reduce(partials.begin(), partials.end(), init, pairwise_summation);
+}
+
+// ============================================================================
+// 带执行策略的归约算法
+// ============================================================================
+
+/**
+ * @brief 按执行策略对范围内每个元素做变换后归约
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first 范围的开始迭代器
+ * @param last 范围的结束迭代器
+ * @param init 初始值
+ * @param reduce_op 归约操作，须满足结合律与交换律
+ * @param transform_op 变换操作
+ * @return T 归约结果
+ *
+ * 并行时区间被切成连续的块，块结果按顺序合并，相同线程数下结果可复现。
+ * 非随机访问迭代器总是串行执行。
+ */
+template <class ExecutionPolicy, class InputIter, class T, class BinaryOp, class UnaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+transform_reduce(ExecutionPolicy&& policy, InputIter first, InputIter last, T init,
+                 BinaryOp reduce_op, UnaryOp transform_op) {
+    return mystl::parallel_transform_reduce(mystl::execution_pool(policy), first, last, init, reduce_op,
+                                            transform_op,
+                                            typename iterator_traits<InputIter>::iterator_category());
+}
+
+/**
+ * @brief 按执行策略对两个范围逐对变换后归约
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first1 第一个范围的开始迭代器
+ * @param last1 第一个范围的结束迭代器
+ * @param first2 第二个范围的开始迭代器
+ * @param init 初始值
+ * @param reduce_op 归约操作，须满足结合律与交换律
+ * @param transform_op 二元变换操作
+ * @return T 归约结果
+ */
+template <class ExecutionPolicy, class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+transform_reduce(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                 BinaryOp1 reduce_op, BinaryOp2 transform_op) {
+    return mystl::parallel_transform_reduce2(mystl::execution_pool(policy), first1, last1, first2, init,
+                                             reduce_op, transform_op,
+                                             typename iterator_traits<InputIter1>::iterator_category(),
+                                             typename iterator_traits<InputIter2>::iterator_category());
+}
+
+/**
+ * @brief 按执行策略计算两个范围的内积
+ */
+template <class ExecutionPolicy, class InputIter1, class InputIter2, class T>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+transform_reduce(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+    return mystl::transform_reduce(policy, first1, last1, first2, init, mystl::plus<T>(), mystl::multiplies<T>());
+}
+
+/**
+ * @brief 按执行策略用 Kahan 补偿求和计算两个范围的内积
+ */
+template <class ExecutionPolicy, class RandomIter1, class RandomIter2, class T>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+transform_reduce(ExecutionPolicy&& policy, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                 kahan_summation_tag tag) {
+    thread_pool* pool = mystl::execution_pool(policy);
+    if (!mystl::parallel_worthwhile(pool, last1 - first1, kParallelReduceThreshold)) {
+        return mystl::transform_reduce(first1, last1, first2, init, tag);
+    }
+    return mystl::parallel_accurate_sum(*pool, last1 - first1, init,
+        [&](ptrdiff_t i) -> T { return static_cast<T>(first1[i]) * first2[i]; }, tag);
+}
+
+/**
+ * @brief 按执行策略用成对求和计算两个范围的内积
+ */
+template <class ExecutionPolicy, class RandomIter1, class RandomIter2, class T>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+transform_reduce(ExecutionPolicy&& policy, RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                 pairwise_summation_tag tag) {
+    thread_pool* pool = mystl::execution_pool(policy);
+    if (!mystl::parallel_worthwhile(pool, last1 - first1, kParallelReduceThreshold)) {
+        return mystl::transform_reduce(first1, last1, first2, init, tag);
+    }
+    return mystl::parallel_accurate_sum(*pool, last1 - first1, init,
+        [&](ptrdiff_t i) -> T { return static_cast<T>(first1[i]) * first2[i]; }, tag);
+}
+
+/**
+ * @brief 按执行策略使用自定义二元操作归约范围内的元素
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first 范围的开始迭代器
+ * @param last 范围的结束迭代器
+ * @param init 初始值
+ * @param binary_op 二元操作，须满足结合律与交换律
+ * @return T 归约结果
+ */
+template <class ExecutionPolicy, class InputIter, class T, class BinaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+reduce(ExecutionPolicy&& policy, InputIter first, InputIter last, T init, BinaryOp binary_op) {
+    return mystl::transform_reduce(policy, first, last, init, binary_op, reduce_identity());
+}
+
+/**
+ * @brief 按执行策略计算范围内元素的和
+ */
+template <class ExecutionPolicy, class InputIter, class T>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+reduce(ExecutionPolicy&& policy, InputIter first, InputIter last, T init) {
+    return mystl::reduce(policy, first, last, init, mystl::plus<T>());
+}
+
+/**
+ * @brief 按执行策略计算范围内元素的和，初始值为值类型的零值
+ */
+template <class ExecutionPolicy, class InputIter>
+typename enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<InputIter>::value_type>::type
+reduce(ExecutionPolicy&& policy, InputIter first, InputIter last) {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return mystl::reduce(policy, first, last, value_type());
+}
+
+/**
+ * @brief 按执行策略用 Kahan 补偿求和计算范围内元素的和，适用于浮点类型
+ */
+template <class ExecutionPolicy, class RandomIter, class T>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+reduce(ExecutionPolicy&& policy, RandomIter first, RandomIter last, T init, kahan_summation_tag tag) {
+    thread_pool* pool = mystl::execution_pool(policy);
+    if (!mystl::parallel_worthwhile(pool, last - first, kParallelReduceThreshold)) {
+        return mystl::reduce(first, last, init, tag);
+    }
+    return mystl::parallel_accurate_sum(*pool, last - first, init,
+                                        [&](ptrdiff_t i) -> T { return first[i]; }, tag);
+}
+
+/**
+ * @brief 按执行策略用成对求和计算范围内元素的和，适用于浮点类型
+ */
+template <class ExecutionPolicy, class RandomIter, class T>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+reduce(ExecutionPolicy&& policy, RandomIter first, RandomIter last, T init, pairwise_summation_tag tag) {
+    thread_pool* pool = mystl::execution_pool(policy);
+    if (!mystl::parallel_worthwhile(pool, last - first, kParallelReduceThreshold)) {
+        return mystl::reduce(first, last, init, tag);
+    }
+    return mystl::parallel_accurate_sum(*pool, last - first, init,
+                                        [&](ptrdiff_t i) -> T { return first[i]; }, tag);
+}
+
+/**
+ * @brief 按执行策略计算两个范围的内积，允许重新结合加法
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first1 第一个范围的开始迭代器
+ * @param last1 第一个范围的结束迭代器
+ * @param first2 第二个范围的开始迭代器
+ * @param init 初始值
+ * @return T 内积结果
+ *
+ * 与串行 inner_product 的严格左折叠不同，结果可能因舍入顺序不同而略有差异。
+ */
+template <class ExecutionPolicy, class InputIter1, class InputIter2, class T>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+inner_product(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+    return mystl::transform_reduce(policy, first1, last1, first2, init);
+}
+
+/**
+ * @brief 按执行策略使用自定义二元操作计算两个范围的内积
+ * @param binary_op1 累加操作，须满足结合律与交换律
+ * @param binary_op2 乘法操作
+ */
+template <class ExecutionPolicy, class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+typename enable_if_execution_policy<ExecutionPolicy, T>::type
+inner_product(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+              BinaryOp1 binary_op1, BinaryOp2 binary_op2) {
+    return mystl::transform_reduce(policy, first1, last1, first2, init, binary_op1, binary_op2);
+}
+
+// ============================================================================
+// 并行扫描的实现
+// ============================================================================
+
+// 区间长度小于该值时串行扫描
+constexpr ptrdiff_t kParallelScanThreshold = 1 << 16;
+
+// 块内求和：加法满足交换律，可用多累加器；其他操作只保证结合律，须按顺序折叠
+template <class T, class RandomIter, class BinaryOp, class UnaryOp>
+T parallel_scan_chunk_sum(RandomIter first, RandomIter last, BinaryOp op, UnaryOp transform, m_true_type) {
+    return mystl::transform_reduce(first + 1, last, static_cast<T>(transform(*first)), op, transform);
+}
+
+template <class T, class RandomIter, class BinaryOp, class UnaryOp>
+T parallel_scan_chunk_sum(RandomIter first, RandomIter last, BinaryOp op, UnaryOp transform, m_false_type) {
+    return mystl::reduce_fold(first + 1, last, static_cast<T>(transform(*first)), op, transform);
+}
+
+// 块内扫描：没有变换时走 scan_impl，可以使用 SIMD
+template <class RandomIter, class OutputIter, class T, class BinaryOp>
+void parallel_scan_chunk(RandomIter first, RandomIter last, OutputIter result, T carry, bool has_carry,
+                         bool exclusive, BinaryOp op, reduce_identity) {
+    mystl::scan_impl(first, last, result, carry, has_carry, exclusive, op);
+}
+
+template <class RandomIter, class OutputIter, class T, class BinaryOp, class UnaryOp>
+void parallel_scan_chunk(RandomIter first, RandomIter last, OutputIter result, T carry, bool has_carry,
+                         bool exclusive, BinaryOp op, UnaryOp transform) {
+    mystl::scan_loop(first, last, result, carry, has_carry, exclusive, op, transform);
+}
+
+/**
+ * @brief 两趟分块并行扫描
+ * @param init 初始值，has_init 为 false 时不使用
+ * @param exclusive 是否为不包含当前元素的扫描
+ *
+ * 第一趟并行计算每块的归约结果；按顺序扫描各块的结果得到每块的进位；
+ * 第二趟各块以自己的进位为初值并行扫描。输入只读两遍、输出只写一遍，允许原地扫描。
+ */
+template <class RandomIter, class OutputIter, class T, class BinaryOp, class UnaryOp>
+OutputIter parallel_scan(thread_pool* pool, RandomIter first, RandomIter last, OutputIter result, T init,
+                         bool has_init, bool exclusive, BinaryOp op, UnaryOp transform,
+                         random_access_iterator_tag, random_access_iterator_tag) {
+    const ptrdiff_t n = last - first;
+    if (!mystl::parallel_worthwhile(pool, n, kParallelScanThreshold)) {
+        mystl::parallel_scan_chunk(first, last, result, init, has_init, exclusive, op, transform);
+        return result + n;
+    }
+    // 第一趟：各块的归约结果
+    mystl::vector<T> sums = mystl::parallel_reduce_partials(*pool, n, init,
+        [&](ptrdiff_t b, ptrdiff_t e) -> T {
+            return mystl::parallel_scan_chunk_sum<T>(first + b, first + e, op, transform,
+                                                     is_plus_operation<BinaryOp, T>());
+        });
+    const ptrdiff_t chunks = static_cast<ptrdiff_t>(sums.size());
+
+    // 各块的进位：sums 的不包含当前元素的扫描
+    mystl::vector<T> carries(sums.size(), init);
+    T carry = init;
+    for (ptrdiff_t c = 0; c < chunks; ++c) {
+        carries[c] = carry;
+        carry = (c > 0 || has_init) ? op(carry, sums[c]) : sums[c];
+    }
+
+    // 第二趟：各块带进位扫描
+    task_group group(*pool);
+    for (ptrdiff_t c = 1; c < chunks; ++c) {
+        const ptrdiff_t b = n * c / chunks;
+        const ptrdiff_t e = n * (c + 1) / chunks;
+        group.run([&, b, e, c] {
+            mystl::parallel_scan_chunk(first + b, first + e, result + b, carries[c], true, exclusive, op, transform);
+        });
+    }
+    mystl::parallel_scan_chunk(first, first + n / chunks, result, carries[0], has_init, exclusive, op, transform);
+    group.wait();
+    return result + n;
+}
+
+template <class InputIter, class OutputIter, class T, class BinaryOp, class UnaryOp,
+          class Category1, class Category2>
+OutputIter parallel_scan(thread_pool*, InputIter first, InputIter last, OutputIter result, T init,
+                         bool has_init, bool exclusive, BinaryOp op, UnaryOp transform, Category1, Category2) {
+    return mystl::scan_loop(first, last, result, init, has_init, exclusive, op, transform);
+}
+
+// ============================================================================
+// 带执行策略的扫描算法
+// ============================================================================
+
+/**
+ * @brief 按执行策略使用自定义二元操作和初始值计算包含当前元素的前缀和
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first 输入范围的开始迭代器
+ * @param last 输入范围的结束迭代器
+ * @param result 输出范围的开始迭代器，可以等于 first
+ * @param binary_op 二元操作函数对象，须满足结合律
+ * @param init 初始值
+ * @return 输出范围的结束迭代器
+ *
+ * 并行时使用两趟分块扫描，输入和输出都须为随机访问迭代器，否则串行执行。
+ */
+template <class ExecutionPolicy, class InputIter, class OutputIter, class BinaryOp, class T>
+typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+inclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result,
+               BinaryOp binary_op, T init) {
+    return mystl::parallel_scan(mystl::execution_pool(policy), first, last, result, init, true, false,
+                                binary_op, reduce_identity(),
+                                typename iterator_traits<InputIter>::iterator_category(),
+                                typename iterator_traits<OutputIter>::iterator_category());
+}
+
+/**
+ * @brief 按执行策略使用自定义二元操作计算包含当前元素的前缀和
+ */
+template <class ExecutionPolicy, class InputIter, class OutputIter, class BinaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+inclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result, BinaryOp binary_op) {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return mystl::parallel_scan(mystl::execution_pool(policy), first, last, result, value_type(), false, false,
+                                binary_op, reduce_identity(),
+                                typename iterator_traits<InputIter>::iterator_category(),
+                                typename iterator_traits<OutputIter>::iterator_category());
+}
+
+/**
+ * @brief 按执行策略计算包含当前元素的前缀和
+ */
+template <class ExecutionPolicy, class InputIter, class OutputIter>
+typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+inclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result) {
+    typedef typename iterator_traits<InputIter>::value_type value_type;
+    return mystl::inclusive_scan(policy, first, last, result, mystl::plus<value_type>());
+}
+
+/**
+ * @brief 按执行策略使用自定义二元操作计算不包含当前元素的前缀和
+ * @param policy 执行策略：execution::seq 或 execution::par
+ * @param first 输入范围的开始迭代器
+ * @param last 输入范围的结束迭代器
+ * @param result 输出范围的开始迭代器，可以等于 first
+ * @param init 初始值
+ * @param binary_op 二元操作函数对象，须满足结合律
+ * @return 输出范围的结束迭代器
+ */
+template <class ExecutionPolicy, class InputIter, class OutputIter, class T, class BinaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+exclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result, T init,
+               BinaryOp binary_op) {
+    return mystl::parallel_scan(mystl::execution_pool(policy), first, last, result, init, true, true,
+                                binary_op, reduce_identity(),
+                                typename iterator_traits<InputIter>::iterator_category(),
+                                typename iterator_traits<OutputIter>::iterator_category());
+}
+
+/**
+ * @brief 按执行策略计算不包含当前元素的前缀和
+ */
+template <class ExecutionPolicy, class InputIter, class OutputIter, class T>
+typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+exclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result, T init) {
+    return mystl::exclusive_scan(policy, first, last, result, init, mystl::plus<T>());
+}
+
+/**
+ * @brief 按执行策略对每个元素做变换后，使用初始值计算包含当前元素的前缀和
+ */
+template <class ExecutionPolicy, class InputIter, class OutputIter, class BinaryOp, class UnaryOp, class T>
+typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+transform_inclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result,
+                         BinaryOp binary_op, UnaryOp unary_op, T init) {
+    return mystl::parallel_scan(mystl::execution_pool(policy), first, last, result, init, true, false,
+                                binary_op, unary_op,
+                                typename iterator_traits<InputIter>::iterator_category(),
+                                typename iterator_traits<OutputIter>::iterator_category());
+}
+
+/**
+ * @brief 按执行策略对每个元素做变换后计算包含当前元素的前缀和
+ */
+template <class ExecutionPolicy, class InputIter, class OutputIter, class BinaryOp, class UnaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+transform_inclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result,
+                         BinaryOp binary_op, UnaryOp unary_op) {
+    typedef typename std::decay<decltype(unary_op(*first))>::type value_type;
+    return mystl::parallel_scan(mystl::execution_pool(policy), first, last, result, value_type(), false, false,
+                                binary_op, unary_op,
+                                typename iterator_traits<InputIter>::iterator_category(),
+                                typename iterator_traits<OutputIter>::iterator_category());
+}
+
+/**
+ * @brief 按执行策略对每个元素做变换后计算不包含当前元素的前缀和
+ */
+template <class ExecutionPolicy, class InputIter, class OutputIter, class T, class BinaryOp, class UnaryOp>
+typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+transform_exclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result, T init,
+                         BinaryOp binary_op, UnaryOp unary_op) {
+    return mystl::parallel_scan(mystl::execution_pool(policy), first, last, result, init, true, true,
+                                binary_op, unary_op,
+                                typename iterator_traits<InputIter>::iterator_category(),
+                                typename iterator_traits<OutputIter>::iterator_category());
+}
+
+} // namespace mystl
+
+#endif // !MYTINYSTL_EXECUTION_H
@@ -0,0 +1,159 @@
+#ifndef MYTINYSTL_GROWTH_POLICY_H_
+#define MYTINYSTL_GROWTH_POLICY_H_
+
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include "allocator.h"
+#include "type_traits.h"
+
+namespace mystl {
+
+// ============================================================================
+// 容器增长策略
+// ============================================================================
+//
+// 增长策略决定连续存储容器容量不足时的新容量，接口为一个静态成员函数：
+//
+//   template<typename Alloc>
+//   static size_t next_capacity(const Alloc& alloc, size_t capacity, size_t required);
+//
+// capacity 为当前容量，required 为至少需要容纳的元素个数（大于 capacity）。返回值小于
+// required 时容器按 required 分配；容器负责把结果限制在 max_size() 以内。
+// 策略可以声明 stats_type 指定容器每个实例携带的增长计数器，默认不计数。
+
+/**
+ * @brief 容量翻倍：摊还 O(1) 插入，最多浪费一半内存
+ */
+struct growth_double {
+    template<typename Alloc>
+    static size_t next_capacity(const Alloc&, size_t capacity, size_t required) noexcept {
+        const size_t grown = capacity > size_t(-1) / 2 ? size_t(-1) : capacity * 2;
+        return grown < required ? required : grown;
+    }
+};
+
+/**
+ * @brief 容量增长到 1.5 倍：浪费不超过三分之一，且释放的旧块之和能在几次增长后被新块复用
+ */
+struct growth_one_and_half {
+    template<typename Alloc>
+    static size_t next_capacity(const Alloc&, size_t capacity, size_t required) noexcept {
+        const size_t grown = capacity > size_t(-1) / 3 * 2 ? size_t(-1) : capacity + (capacity + 1) / 2;
+        return grown < required ? required : grown;
+    }
+};
+
+/**
+ * @brief 每次固定增加 Increment 个元素：内存最省，但插入退化为摊还 O(n)，只适合大小可预期的场景
+ * @tparam Increment 每次增加的元素个数，大于 0
+ */
+template<size_t Increment>
+struct growth_fixed {
+    static_assert(Increment > 0, "growth_fixed: Increment 必须大于 0");
+
+    template<typename Alloc>
+    static size_t next_capacity(const Alloc&, size_t capacity, size_t required) noexcept {
+        // 向上取整到 capacity + k * Increment，保证一次插入多个元素时也只增长一次
+        const size_t steps = (required - capacity + Increment - 1) / Increment;
+        return steps > (size_t(-1) - capacity) / Increment ? required : capacity + steps * Increment;
+    }
+};
+
+/**
+ * @brief 在 Base 的结果上向上取整到分配器的大小类，把分配器本来就会多给的字节用作容量
+ * @tparam Base 基础增长策略
+ *
+ * 取整依据 allocator_traits::good_size：pool_allocator 取所在大小类，malloc_allocator 取
+ * malloc 块的可用字节，huge_page_allocator 取 2MB 的整数倍，其他分配器不变。
+ */
+template<typename Base = growth_double>
+struct growth_size_class {
+    template<typename Alloc>
+    static size_t next_capacity(const Alloc& alloc, size_t capacity, size_t required) noexcept {
+        return mystl::allocator_traits<Alloc>::good_size(alloc, Base::next_capacity(alloc, capacity, required));
+    }
+};
+
+// ============================================================================
+// 增长计数器
+// ============================================================================
+
+/**
+ * @brief 单个容器实例的增长计数器
+ *
+ * 在容量变化时更新：换到新缓冲区记为一次重新分配（包括分配器 realloc/mremap），
+ * 分配器原地扩展单独计数；peak_wasted_bytes 为每次容量变化后
+ * (capacity - size) * sizeof(T) 的最大值，反映增长策略造成的空闲容量。
+ */
+struct growth_stats {
+    size_t reallocations;        // 重新分配次数
+    size_t in_place_expansions;  // 分配器原地扩展次数
+    size_t bytes_moved;          // 重新分配时搬移的元素字节数
+    size_t peak_wasted_bytes;    // 空闲容量字节数的峰值
+
+    growth_stats() noexcept : reallocations(0), in_place_expansions(0), bytes_moved(0), peak_wasted_bytes(0) {}
+
+    void on_reallocate(size_t moved_bytes) noexcept {
+        ++reallocations;
+        bytes_moved += moved_bytes;
+    }
+
+    void on_expand_in_place() noexcept { ++in_place_expansions; }
+
+    void on_capacity_change(size_t wasted_bytes) noexcept {
+        if (wasted_bytes > peak_wasted_bytes) {
+            peak_wasted_bytes = wasted_bytes;
+        }
+    }
+
+    void reset() noexcept { *this = growth_stats(); }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const growth_stats& s) {
+    return os << "重新分配 " << s.reallocations << " 次, 原地扩展 " << s.in_place_expansions << " 次, 搬移 "
+              << s.bytes_moved << " 字节, 空闲容量峰值 " << s.peak_wasted_bytes << " 字节";
+}
+
+/**
+ * @brief 不计数：空类，容器以空基类持有，不占空间
+ */
+struct no_growth_stats {
+    void on_reallocate(size_t) noexcept {}
+    void on_expand_in_place() noexcept {}
+    void on_capacity_change(size_t) noexcept {}
+    void reset() noexcept {}
+};
+
+/**
+ * @brief 给任意增长策略加上每个实例的增长计数器
+ * @tparam Policy 增长策略
+ *
+ * 例如 mystl::vector<int, mystl::allocator<int>, mystl::growth_tracked<mystl::growth_one_and_half>>，
+ * 通过 growth_stats() 读取计数。
+ */
+template<typename Policy>
+struct growth_tracked : Policy {
+    typedef growth_stats stats_type;
+};
+
+/**
+ * @brief 增长策略的计数器类型：策略声明了 stats_type 时取之，否则为 no_growth_stats
+ * @tparam Policy 增长策略
+ */
+template<typename Policy>
+struct growth_stats_type {
+private:
+    template<typename P>
+    static typename P::stats_type test(int);
+
+    template<typename>
+    static no_growth_stats test(...);
+
+public:
+    typedef decltype(test<Policy>(0)) type;
+};
+
+} // namespace mystl
+
+#endif // MYTINYSTL_GROWTH_POLICY_H_
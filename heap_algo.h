@@ -109,6 +109,33 @@ void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
     mystl::pop_heap(first, last, mystl::less<typename mystl::iterator_traits<RandomAccessIterator>::value_type>());
 }
 
+/**
+ * @brief 将 hole_index 处的元素下沉，恢复 [first, first + len) 的堆性质
+ * @param first 堆的起始迭代器
+ * @param hole_index 需要下沉的位置
+ * @param len 堆的长度
+ * @param comp 比较函数对象
+ *
+ * 用于替换堆顶后重新调整（如 partial_sort），只移动不交换。
+ */
+template<typename RandomAccessIterator, typename Distance, typename Compare>
+void adjust_heap(RandomAccessIterator first, Distance hole_index, Distance len, Compare comp) {
+    auto value = mystl::move(*(first + hole_index));
+    Distance child = 2 * hole_index + 1;
+    while (child < len) {
+        if (child + 1 < len && comp(*(first + child), *(first + (child + 1)))) {
+            ++child;
+        }
+        if (!comp(value, *(first + child))) {
+            break;
+        }
+        *(first + hole_index) = mystl::move(*(first + child));
+        hole_index = child;
+        child = 2 * hole_index + 1;
+    }
+    *(first + hole_index) = mystl::move(value);
+}
+
 /**
  * @brief 构建堆
  * @param first 堆的起始迭代器
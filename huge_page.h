@@ -0,0 +1,396 @@
+#ifndef MYTINYSTL_HUGE_PAGE_H_
+#define MYTINYSTL_HUGE_PAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define MYSTL_HUGE_PAGE_HAS_MMAP 1
+#endif
+
+namespace mystl {
+
+// ============================================================================
+// 大页配置
+// ============================================================================
+
+static const size_t HUGE_PAGE_SIZE = 2u << 20;       // x86-64 / AArch64 的 2MB 大页
+static const size_t HUGE_PAGE_THRESHOLD = 2u << 20;  // huge_page_allocator 默认阈值，更小的请求走普通分配器
+
+/**
+ * @brief huge_page_alloc 实际得到的页类型
+ */
+enum class huge_page_kind {
+    none,           // 分配失败
+    hugetlb,        // MAP_HUGETLB：系统预留的大页池
+    transparent,    // 普通匿名映射 + MADV_HUGEPAGE，由内核按透明大页（THP）提供
+    regular         // 系统不支持大页或 madvise 失败，退化为普通 4KB 页
+};
+
+// ============================================================================
+// 大页内存分配
+// ============================================================================
+
+/**
+ * @brief 大页分配的实际字节数：向上取整到 HUGE_PAGE_SIZE 的倍数
+ */
+inline size_t huge_page_round(size_t bytes) noexcept {
+    return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+/**
+ * @brief 透明大页是否可用
+ * @return /sys/kernel/mm/transparent_hugepage/enabled 为 always 或 madvise 时返回 true
+ */
+inline bool transparent_huge_pages_enabled() noexcept {
+#if defined(__linux__)
+    std::FILE* f = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (f == nullptr) {
+        return false;
+    }
+    char buf[128] = {0};
+    const size_t n = std::fread(buf, 1, sizeof(buf) - 1, f);
+    std::fclose(f);
+    buf[n] = '\0';
+    return std::strstr(buf, "[never]") == nullptr && std::strchr(buf, '[') != nullptr;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief 按 2MB 对齐分配大块内存，并提示内核使用大页
+ * @param bytes 字节数，实际映射 huge_page_round(bytes) 字节
+ * @param kind 可选，返回实际得到的页类型
+ * @return 2MB 对齐、已清零的内存，失败返回 nullptr
+ *
+ * 依次尝试：
+ * 1. MAP_HUGETLB：系统预留了大页池（vm.nr_hugepages > 0）时直接得到大页；
+ * 2. 多映射 2MB 的普通匿名映射，裁掉首尾使起始地址 2MB 对齐，再 madvise(MADV_HUGEPAGE)，
+ *    THP 为 madvise 模式时也能在缺页时直接分配大页；
+ * 3. madvise 失败或 THP 关闭时保留该映射，按普通页使用。
+ * 不支持 mmap 的平台用 aligned_alloc 按 2MB 对齐分配。
+ * 用 huge_page_free 以相同的 bytes 释放。
+ */
+inline void* huge_page_alloc(size_t bytes, huge_page_kind* kind = nullptr) noexcept {
+    if (kind != nullptr) {
+        *kind = huge_page_kind::none;
+    }
+    if (bytes == 0 || bytes > SIZE_MAX - 2 * HUGE_PAGE_SIZE) {
+        return nullptr;
+    }
+    const size_t len = huge_page_round(bytes);
+
+#if defined(MYSTL_HUGE_PAGE_HAS_MMAP)
+#if defined(MAP_HUGETLB)
+    void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) {
+        if (kind != nullptr) {
+            *kind = huge_page_kind::hugetlb;
+        }
+        return p;
+    }
+#endif
+
+    // 多映射一个大页的长度，保证其中存在 2MB 对齐的起点
+    char* raw = static_cast<char*>(
+        ::mmap(nullptr, len + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (raw == static_cast<char*>(MAP_FAILED)) {
+        return nullptr;
+    }
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+    char* aligned = reinterpret_cast<char*>((addr + HUGE_PAGE_SIZE - 1) & ~(uintptr_t(HUGE_PAGE_SIZE) - 1));
+    const size_t head = static_cast<size_t>(aligned - raw);
+    const size_t tail = HUGE_PAGE_SIZE - head;
+    if (head != 0) {
+        ::munmap(raw, head);
+    }
+    if (tail != 0) {
+        ::munmap(aligned + len, tail);
+    }
+
+    huge_page_kind got = huge_page_kind::regular;
+#if defined(MADV_HUGEPAGE)
+    if (::madvise(aligned, len, MADV_HUGEPAGE) == 0 && transparent_huge_pages_enabled()) {
+        got = huge_page_kind::transparent;
+    }
+#endif
+    if (kind != nullptr) {
+        *kind = got;
+    }
+    return aligned;
+#else
+    void* p = mystl::aligned_alloc(len, HUGE_PAGE_SIZE);
+    if (p != nullptr) {
+        std::memset(p, 0, len);
+        if (kind != nullptr) {
+            *kind = huge_page_kind::regular;
+        }
+    }
+    return p;
+#endif
+}
+
+/**
+ * @brief 释放 huge_page_alloc 分配的内存
+ * @param p huge_page_alloc 返回的指针，可以为 nullptr
+ * @param bytes 分配时传入的字节数
+ */
+inline void huge_page_free(void* p, size_t bytes) noexcept {
+    if (p == nullptr) {
+        return;
+    }
+#if defined(MYSTL_HUGE_PAGE_HAS_MMAP)
+    ::munmap(p, huge_page_round(bytes));
+#else
+    (void)bytes;
+    mystl::aligned_free(p);
+#endif
+}
+
+/**
+ * @brief 原地扩展 huge_page_alloc 分配的内存
+ * @param p huge_page_alloc 返回的指针
+ * @param old_bytes 当前大小
+ * @param new_bytes 目标大小，不小于 old_bytes
+ * @return 成功返回 true，地址与内容不变，之后以 new_bytes 释放
+ *
+ * 映射按 2MB 取整，取整后长度不变时直接成功；否则用不带 MREMAP_MAYMOVE 的 mremap
+ * 在原地址之后延长映射，后面的地址空间已被占用时失败。
+ */
+inline bool huge_page_try_expand(void* p, size_t old_bytes, size_t new_bytes) noexcept {
+    if (p == nullptr || new_bytes < old_bytes || new_bytes > SIZE_MAX - 2 * HUGE_PAGE_SIZE) {
+        return false;
+    }
+    const size_t old_len = huge_page_round(old_bytes);
+    const size_t new_len = huge_page_round(new_bytes);
+    if (new_len == old_len) {
+        return true;
+    }
+#if defined(MYSTL_HUGE_PAGE_HAS_MMAP) && defined(MREMAP_MAYMOVE)
+    return ::mremap(p, old_len, new_len, 0) != MAP_FAILED;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief 重新分配 huge_page_alloc 分配的内存，内容按字节保留
+ * @param p huge_page_alloc 返回的指针
+ * @param old_bytes 当前大小
+ * @param new_bytes 目标大小
+ * @return 新地址（2MB 对齐），失败返回 nullptr 且原内存不变
+ *
+ * 缩小时解除尾部映射；扩大时先尝试原地扩展，再映射一段新的 2MB 对齐区域，
+ * 用 mremap(MREMAP_FIXED) 把旧页面整体挪到新区域开头。搬移的是页表项而不是数据，
+ * 代价与页数成正比，与字节数无关；MADV_HUGEPAGE 标记随映射一起移动。
+ * 不支持 mremap 的平台退化为拷贝。
+ */
+inline void* huge_page_realloc(void* p, size_t old_bytes, size_t new_bytes) noexcept {
+    if (p == nullptr) {
+        return huge_page_alloc(new_bytes);
+    }
+    if (new_bytes == 0) {
+        return nullptr;
+    }
+    const size_t old_len = huge_page_round(old_bytes);
+    const size_t new_len = huge_page_round(new_bytes);
+#if defined(MYSTL_HUGE_PAGE_HAS_MMAP)
+    if (new_len < old_len) {
+        ::munmap(static_cast<char*>(p) + new_len, old_len - new_len);
+        return p;
+    }
+#endif
+    if (new_len == old_len || huge_page_try_expand(p, old_bytes, new_bytes)) {
+        return p;
+    }
+
+    void* result = huge_page_alloc(new_bytes);
+    if (result == nullptr) {
+        return nullptr;
+    }
+#if defined(MYSTL_HUGE_PAGE_HAS_MMAP) && defined(MREMAP_FIXED)
+    if (::mremap(p, old_len, old_len, MREMAP_MAYMOVE | MREMAP_FIXED, result) != MAP_FAILED) {
+        return result;
+    }
+#endif
+    std::memcpy(result, p, old_bytes < new_bytes ? old_bytes : new_bytes);
+    huge_page_free(p, old_bytes);
+    return result;
+}
+
+// ============================================================================
+// 大页分配器
+// ============================================================================
+
+/**
+ * @brief 大块请求使用大页的分配器
+ * @tparam T 分配的对象类型
+ * @tparam Threshold 字节数阈值，n * sizeof(T) 不小于该值时使用 huge_page_alloc，
+ *                   否则转给 mystl::allocator<T>
+ *
+ * 数百 MB 的 vector<double> 按 4KB 页映射需要数万个 TLB 项，随机访问时 TLB 缺失
+ * 成为主要开销；按 2MB 大页映射后页表项减少到 1/512。用法：
+ *   mystl::vector<double, mystl::huge_page_allocator<double>> v;
+ *   mystl::deque<double, mystl::huge_page_allocator<double>> d;  // map 区足够大时同样使用大页
+ * 小于阈值的请求（vector 增长初期、deque 的缓冲区）仍走普通分配器，不会为每个小块浪费 2MB。
+ * 是否走大页只由请求字节数决定，deallocate 据此选择释放方式，分配器本身无状态。
+ * 大页不可用时退化为普通页的匿名映射，行为不变，只是没有 TLB 收益。
+ */
+template<typename T, size_t Threshold = HUGE_PAGE_THRESHOLD>
+class huge_page_allocator {
+public:
+    // 类型定义
+    typedef T            value_type;
+    typedef T*           pointer;
+    typedef const T*     const_pointer;
+    typedef T&           reference;
+    typedef const T&     const_reference;
+    typedef size_t       size_type;
+    typedef ptrdiff_t    difference_type;
+
+    // 分配器特征
+    template<typename U>
+    struct rebind {
+        typedef huge_page_allocator<U, Threshold> other;
+    };
+
+public:
+    // 构造函数和析构函数
+    huge_page_allocator() noexcept = default;
+    huge_page_allocator(const huge_page_allocator&) noexcept = default;
+    template<typename U>
+    huge_page_allocator(const huge_page_allocator<U, Threshold>&) noexcept {}
+    ~huge_page_allocator() noexcept = default;
+
+    // 赋值操作符
+    huge_page_allocator& operator=(const huge_page_allocator&) = default;
+
+    // 地址获取
+    pointer address(reference x) const noexcept {
+        return &x;
+    }
+
+    const_pointer address(const_reference x) const noexcept {
+        return &x;
+    }
+
+    /**
+     * @brief n 个对象的请求是否走大页
+     */
+    static bool uses_huge_pages(size_type n) noexcept {
+        return n * sizeof(T) >= Threshold;
+    }
+
+    // 内存分配
+    pointer allocate(size_type n, const void* hint = 0) {
+        (void)hint;
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        if (!uses_huge_pages(n)) {
+            return mystl::allocator<T>().allocate(n);
+        }
+        pointer result = static_cast<pointer>(mystl::huge_page_alloc(n * sizeof(T)));
+        if (result == nullptr) {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
+    // 内存释放
+    void deallocate(pointer p, size_type n) noexcept {
+        if (p == nullptr) {
+            return;
+        }
+        if (!uses_huge_pages(n)) {
+            mystl::allocator<T>().deallocate(p, n);
+        } else {
+            mystl::huge_page_free(p, n * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief 申请 n 个对象时整块实际能容纳的对象数：走大页时向上取整到 2MB 的整数倍
+     */
+    size_type good_size(size_type n) const noexcept {
+        if (n > max_size() || !uses_huge_pages(n)) {
+            return n;
+        }
+        const size_type fit = mystl::huge_page_round(n * sizeof(T)) / sizeof(T);
+        return fit < n ? n : fit;
+    }
+
+    /**
+     * @brief 原地扩展：新旧大小都走大页时由 huge_page_try_expand 处理，否则返回 false
+     */
+    bool try_expand(pointer p, size_type old_n, size_type new_n) noexcept {
+        return new_n <= max_size() && uses_huge_pages(old_n) &&
+               mystl::huge_page_try_expand(p, old_n * sizeof(T), new_n * sizeof(T));
+    }
+
+    /**
+     * @brief 按字节重新分配，只适用于可平凡重定位的类型
+     *
+     * 新旧大小都走大页时用 huge_page_realloc（mremap 搬移页面），否则分配新块、拷贝、释放旧块。
+     * @throws std::bad_alloc 失败时原块不变
+     */
+    pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+        if (new_n == 0 || new_n > max_size()) {
+            throw std::bad_alloc();
+        }
+        if (p != nullptr && uses_huge_pages(old_n) && uses_huge_pages(new_n)) {
+            pointer result = static_cast<pointer>(mystl::huge_page_realloc(p, old_n * sizeof(T), new_n * sizeof(T)));
+            if (result == nullptr) {
+                throw std::bad_alloc();
+            }
+            return result;
+        }
+        pointer result = allocate(new_n);
+        if (p != nullptr) {
+            std::memcpy(static_cast<void*>(result), static_cast<const void*>(p),
+                        (old_n < new_n ? old_n : new_n) * sizeof(T));
+            deallocate(p, old_n);
+        }
+        return result;
+    }
+
+    // 对象构造
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        mystl::construct(p, mystl::forward<Args>(args)...);
+    }
+
+    // 对象析构
+    template<typename U>
+    void destroy(U* p) {
+        mystl::destroy(p);
+    }
+
+    // 最大分配大小
+    size_type max_size() const noexcept {
+        return (size_type(-1) - 2 * HUGE_PAGE_SIZE) / sizeof(T);
+    }
+
+    // 比较操作：无状态，阈值相同的分配器可以互相释放
+    template<typename U>
+    bool operator==(const huge_page_allocator<U, Threshold>&) const noexcept {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const huge_page_allocator<U, Threshold>&) const noexcept {
+        return false;
+    }
+};
+
+} // namespace mystl
+
+#endif // MYTINYSTL_HUGE_PAGE_H_
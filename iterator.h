@@ -162,6 +162,17 @@ void advance_dispatch(RandomAccessIterator& it, Distance n, random_access_iterat
     it += n;
 }
 
+// 分段迭代器萃取：元素按若干连续块存放的容器（如 deque）特化本模板，
+// 算法据此把 [first, last) 拆成逐块的指针区间，内层循环不再检查块边界。
+// 特化需提供 segment_iterator（指向块的迭代器）、local_iterator（块内指针），以及
+//   segment(it) / local(it)：it 所在的块与块内位置
+//   begin(seg) / end(seg)：块的首尾
+//   compose(seg, p)：由块与块内位置 p 还原迭代器，p 必须在 [begin(seg), end(seg)) 内
+template<typename Iterator>
+struct segmented_iterator_traits {
+    static constexpr bool is_segmented = false;
+};
+
 // 反向迭代器
 template<typename Iterator>
 class reverse_iterator {
@@ -87,17 +87,18 @@ namespace mystl {
       bool operator !=(const self& rhs) const {return node != rhs.node; }
     };//private
     //定义最小 list 主体（接口骨架）
-    template <typename T>
+    //Alloc 按元素类型给出，内部 rebind 到节点类型
+    template <typename T, typename Alloc = mystl::allocator<T>>
     class list {
       public:
       using value_type     = T;
-      // using allocator_type = Alloc;
+      using allocator_type = Alloc;
       using size_type      = std::size_t;
       using reference      = value_type&;
       using const_reference = const value_type&;
 
       using node_type      = list_node<T>;
-      using node_alloc     = mystl::allocator<node_type>;
+      using node_alloc     = typename Alloc::template rebind<node_type>::other;
 
       using iterator       = list_iterator<T>;
       using const_iterator = list_const_iterator<T>;
@@ -112,12 +113,23 @@ namespace mystl {
       //构造 / 析构
        list():head_(nullptr),tail_(nullptr),size_(0){}
 
-       //复制构造：用other的内容初始化*this
-       list(const list& other) : head_(nullptr),tail_(nullptr),size_(0){
+       //指定分配器：所有节点都由 alloc 分配
+       explicit list(const allocator_type& alloc)
+       :head_(nullptr),tail_(nullptr),size_(0),alloc_(alloc){}
+
+       //复制构造：用other的内容初始化*this，沿用other的分配器
+       list(const list& other) : head_(nullptr),tail_(nullptr),size_(0),alloc_(other.alloc_){
+        insert(cend(),other.begin(),other.end());
+       }
+
+       list(const list& other,const allocator_type& alloc)
+       : head_(nullptr),tail_(nullptr),size_(0),alloc_(alloc){
         insert(cend(),other.begin(),other.end());
        }
 
-       list(list&& other) noexcept : head_(other.head_),tail_(other.tail_),size_(other.size_){
+       //节点随分配器一起转移
+       list(list&& other) noexcept
+       : head_(other.head_),tail_(other.tail_),size_(other.size_),alloc_(other.alloc_){
         other.head_ = other.tail_ = nullptr;
         other.size_ = 0;
       }
@@ -138,6 +150,7 @@ namespace mystl {
           head_ = rhs.head_;
           tail_ = rhs.tail_;
           size_ = rhs.size_;
+          alloc_ = rhs.alloc_;
           rhs.head_ = rhs.tail_ = nullptr;
           rhs.size_ = 0;
         }
@@ -156,6 +169,8 @@ namespace mystl {
        bool empty() const noexcept{return size_ == 0;}
        size_type size() const noexcept{return size_;}
 
+       allocator_type get_allocator() const noexcept{return allocator_type(alloc_);}
+
    private:
        template<typename U>
        node_type* create_node(U&& value) {
@@ -251,6 +266,10 @@ namespace mystl {
         size_type s = size_;
         size_ = other.size_;
         other.size_ = s;
+
+        node_alloc a = alloc_;
+        alloc_ = other.alloc_;
+        other.alloc_ = a;
        }
        public:
        reference front()  noexcept{return head_->value;}
@@ -584,8 +603,8 @@ namespace mystl {
       }
 
       //初始化列表构造
-      list(std::initializer_list<T> ilist)
-      :head_(nullptr),tail_(nullptr),size_(0) {
+      list(std::initializer_list<T> ilist,const allocator_type& alloc = allocator_type())
+      :head_(nullptr),tail_(nullptr),size_(0),alloc_(alloc) {
       insert(cend(),ilist.begin(),ilist.end());
       }
 
@@ -619,7 +638,16 @@ namespace mystl {
       bool operator>(const list& rhs) const {return rhs < *this;}
       bool operator>=(const list& rhs) const {return !(*this < rhs);}
     }; //class list
+    template <typename T, typename Alloc>
+    inline void swap(list<T, Alloc>& a, list<T, Alloc>& b) noexcept { a.swap(b); }
+
+    namespace pmr {
+    template <typename T> class polymorphic_allocator;
+
+    // 使用多态分配器的 list，分配策略在运行时由 memory_resource 决定（需包含 memory_resource.h）
     template <typename T>
-    inline void swap(list<T>& a, list<T>& b) noexcept { a.swap(b); }
+    using list = mystl::list<T, polymorphic_allocator<T>>;
+    } // namespace pmr
+
 } //namespace mystl
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define MYTINYSTL_MEMORY_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <type_traits>
 
@@ -80,6 +81,10 @@ public:
     }
 };
 
+// 只持有一个裸指针，搬移字节即可转移所有权
+template<typename T>
+struct is_trivially_relocatable<unique_ptr<T>> : m_true_type {};
+
 /**
  * @brief 创建 unique_ptr
  * @tparam T 类型
@@ -126,35 +131,129 @@ const T* addressof(const T& obj) noexcept {
     );
 }
 
+// ============================================================================
+// 临时缓冲区
+// ============================================================================
+
 /**
- * @brief 对齐内存分配
- * @param size 分配大小
- * @param alignment 对齐要求
- * @return 对齐的内存指针
+ * @brief 申请一块最多容纳 len 个 T 的未初始化临时缓冲区
+ * @tparam T 元素类型
+ * @param len 期望的元素个数
+ * @return 缓冲区指针与实际容量，申请不到时返回 (nullptr, 0)
+ *
+ * 通过 mystl::allocator 申请，失败时容量减半重试，直到成功或减为 0，不抛出异常。
  */
-inline void* aligned_alloc(size_t size, size_t alignment) {
-    // 简单的对齐分配实现
-    size_t total_size = size + alignment - 1;
-    void* ptr = std::malloc(total_size);
-    if (ptr == nullptr) {
-        return nullptr;
+template<typename T>
+mystl::pair<T*, ptrdiff_t> get_temporary_buffer(ptrdiff_t len) noexcept {
+    const ptrdiff_t max_len = static_cast<ptrdiff_t>(PTRDIFF_MAX / sizeof(T));
+    if (len > max_len) {
+        len = max_len;
     }
-    
-    // 计算对齐地址
-    uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
-    uintptr_t aligned_addr = (addr + alignment - 1) & ~(alignment - 1);
-    
-    return reinterpret_cast<void*>(aligned_addr);
+    mystl::allocator<T> alloc;
+    while (len > 0) {
+        try {
+            T* p = alloc.allocate(static_cast<size_t>(len));
+            return mystl::pair<T*, ptrdiff_t>(p, len);
+        } catch (...) {
+            len /= 2;
+        }
+    }
+    return mystl::pair<T*, ptrdiff_t>(nullptr, 0);
 }
 
 /**
- * @brief 对齐内存释放
- * @param ptr 内存指针
+ * @brief 归还 get_temporary_buffer 申请的缓冲区
+ * @tparam T 元素类型
+ * @param p 缓冲区指针
+ * @param len 缓冲区容量
  */
-inline void aligned_free(void* ptr) {
-    std::free(ptr);
+template<typename T>
+void return_temporary_buffer(T* p, ptrdiff_t len) noexcept {
+    if (p != nullptr) {
+        mystl::allocator<T>().deallocate(p, static_cast<size_t>(len));
+    }
 }
 
+/**
+ * @brief 临时缓冲区 RAII 封装，供 inplace_merge、stable_sort 等算法使用
+ * @tparam T 元素类型
+ *
+ * 构造时按请求长度申请缓冲区（可能拿到更小的容量），并以一个已有元素为种子
+ * 沿缓冲区依次移动构造，最后把值移回种子，使缓冲区内全部是可移动赋值的有效对象；
+ * 平凡类型跳过这一步。析构时析构这些对象并归还内存。
+ */
+template<typename T>
+class temporary_buffer {
+public:
+    typedef T*        pointer;
+    typedef ptrdiff_t size_type;
+
+    /**
+     * @brief 申请缓冲区
+     * @param seed 指向一个有效元素的迭代器，用于构造缓冲区中的对象，结束后值不变
+     * @param requested_len 期望的元素个数
+     */
+    template<typename ForwardIter>
+    temporary_buffer(ForwardIter seed, ptrdiff_t requested_len)
+        : requested_len_(requested_len), len_(0), buffer_(nullptr) {
+        mystl::pair<T*, ptrdiff_t> p = mystl::get_temporary_buffer<T>(requested_len);
+        buffer_ = p.first;
+        len_ = p.second;
+        if (buffer_ != nullptr) {
+            try {
+                construct_buffer(seed, typename std::is_trivial<T>::type());
+            } catch (...) {
+                mystl::return_temporary_buffer(buffer_, len_);
+                buffer_ = nullptr;
+                len_ = 0;
+                throw;
+            }
+        }
+    }
+
+    ~temporary_buffer() {
+        mystl::destroy(buffer_, buffer_ + len_);
+        mystl::return_temporary_buffer(buffer_, len_);
+    }
+
+    temporary_buffer(const temporary_buffer&) = delete;
+    temporary_buffer& operator=(const temporary_buffer&) = delete;
+
+    // 实际容量，可能小于请求的长度
+    ptrdiff_t size() const noexcept { return len_; }
+    ptrdiff_t requested_size() const noexcept { return requested_len_; }
+    pointer begin() const noexcept { return buffer_; }
+    pointer end() const noexcept { return buffer_ + len_; }
+
+private:
+    // 平凡类型无需构造
+    template<typename ForwardIter>
+    void construct_buffer(ForwardIter, std::true_type) {}
+
+    // 非平凡类型：种子值依次移过整个缓冲区再移回
+    template<typename ForwardIter>
+    void construct_buffer(ForwardIter seed, std::false_type) {
+        T* const last = buffer_ + len_;
+        T* cur = buffer_;
+        mystl::construct(cur, mystl::move(*seed));
+        T* prev = cur++;
+        try {
+            for (; cur != last; prev = cur++) {
+                mystl::construct(cur, mystl::move(*prev));
+            }
+        } catch (...) {
+            mystl::destroy(buffer_, cur);
+            throw;
+        }
+        *seed = mystl::move(*prev);
+    }
+
+private:
+    ptrdiff_t requested_len_;
+    ptrdiff_t len_;
+    T*        buffer_;
+};
+
 // ============================================================================
 // 内存管理工具
 // ============================================================================
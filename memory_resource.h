@@ -0,0 +1,498 @@
+#ifndef MYTINYSTL_MEMORY_RESOURCE_H_
+#define MYTINYSTL_MEMORY_RESOURCE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include "allocator.h"
+#include "alloc.h"
+#include "arena.h"
+#include "construct.h"
+#include "util.h"
+
+namespace mystl {
+namespace pmr {
+
+// ============================================================================
+// 内存资源基类
+// ============================================================================
+
+static const size_t MAX_ALIGN = alignof(std::max_align_t);  // 池化资源直接支持的最大对齐
+
+/**
+ * @brief 多态内存资源（仿 std::pmr::memory_resource）
+ *
+ * 容器只依赖 polymorphic_allocator<T>，具体的分配策略（new/delete、内存池、单调内存区）
+ * 在运行时通过 memory_resource* 选择，同一个 pmr::vector<T> 类型可以跑在任何资源上，
+ * 不必为每种策略实例化一份容器代码。
+ */
+class memory_resource {
+public:
+    virtual ~memory_resource() = default;
+
+    /**
+     * @brief 分配内存
+     * @param bytes 字节数
+     * @param align 对齐字节数，须为 2 的幂
+     * @throws std::bad_alloc 分配失败
+     */
+    void* allocate(size_t bytes, size_t align = MAX_ALIGN) { return do_allocate(bytes, align); }
+
+    /**
+     * @brief 释放内存，bytes 与 align 须与分配时一致
+     */
+    void deallocate(void* p, size_t bytes, size_t align = MAX_ALIGN) { do_deallocate(p, bytes, align); }
+
+    /**
+     * @brief 判断两个资源能否互相释放对方分配的内存
+     */
+    bool is_equal(const memory_resource& other) const noexcept { return do_is_equal(other); }
+
+private:
+    virtual void* do_allocate(size_t bytes, size_t align) = 0;
+    virtual void do_deallocate(void* p, size_t bytes, size_t align) = 0;
+    virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& a, const memory_resource& b) noexcept {
+    return &a == &b || a.is_equal(b);
+}
+
+inline bool operator!=(const memory_resource& a, const memory_resource& b) noexcept {
+    return !(a == b);
+}
+
+// ============================================================================
+// new/delete 与空资源
+// ============================================================================
+
+/**
+ * @brief 使用全局 operator new/delete 的资源
+ *
+ * 超过 MAX_ALIGN 的对齐要求改用 mystl::aligned_alloc/aligned_free。
+ */
+class new_delete_resource_type : public memory_resource {
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (align <= MAX_ALIGN) {
+            return ::operator new(bytes);
+        }
+        void* p = mystl::aligned_alloc(bytes, align);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t, size_t align) override {
+        if (p == nullptr) {
+            return;
+        }
+        if (align <= MAX_ALIGN) {
+            ::operator delete(p);
+        } else {
+            mystl::aligned_free(p);
+        }
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return dynamic_cast<const new_delete_resource_type*>(&other) != nullptr;
+    }
+};
+
+/**
+ * @brief 任何分配都失败的资源，用于检查某段代码不会分配内存
+ */
+class null_resource_type : public memory_resource {
+private:
+    void* do_allocate(size_t, size_t) override { throw std::bad_alloc(); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const memory_resource& other) const noexcept override { return &other == this; }
+};
+
+inline memory_resource* new_delete_resource() noexcept {
+    static new_delete_resource_type instance;
+    return &instance;
+}
+
+inline memory_resource* null_memory_resource() noexcept {
+    static null_resource_type instance;
+    return &instance;
+}
+
+inline std::atomic<memory_resource*>& default_resource_storage() noexcept {
+    static std::atomic<memory_resource*> resource(new_delete_resource());
+    return resource;
+}
+
+/**
+ * @brief 默认资源：默认构造的 polymorphic_allocator 使用它，初始为 new_delete_resource()
+ */
+inline memory_resource* get_default_resource() noexcept {
+    return default_resource_storage().load(std::memory_order_acquire);
+}
+
+/**
+ * @brief 设置默认资源，传入 nullptr 恢复为 new_delete_resource()
+ * @return 之前的默认资源
+ */
+inline memory_resource* set_default_resource(memory_resource* r) noexcept {
+    if (r == nullptr) {
+        r = new_delete_resource();
+    }
+    return default_resource_storage().exchange(r, std::memory_order_acq_rel);
+}
+
+// ============================================================================
+// 内存池资源
+// ============================================================================
+
+/**
+ * @brief 线程安全的内存池资源，建立在 mystl::alloc 之上
+ *
+ * mystl::alloc 是全进程共享、带线程缓存的内存池，所有 synchronized_pool_resource
+ * 实例共用它，因此彼此相等，一个实例分配的内存可由另一个释放。
+ * 大小类的对象按其大小的最低位对齐（至多 MAX_ALIGN），分配时把字节数向上取整到 align
+ * 的倍数即可满足不超过 MAX_ALIGN 的对齐；更大的对齐交给上游资源。
+ */
+class synchronized_pool_resource : public memory_resource {
+public:
+    explicit synchronized_pool_resource(memory_resource* upstream = get_default_resource()) noexcept
+        : upstream_(upstream) {}
+
+    synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+    synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+    memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+    // 把各线程释放到中心池的空闲内存归还系统，见 alloc::trim()
+    size_t release() { return alloc::trim(); }
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (align > MAX_ALIGN) {
+            return upstream_->allocate(bytes, align);
+        }
+        void* p = alloc::allocate(round_up(bytes, align));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        if (align > MAX_ALIGN) {
+            upstream_->deallocate(p, bytes, align);
+        } else {
+            alloc::deallocate(p, round_up(bytes, align));
+        }
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        const synchronized_pool_resource* o = dynamic_cast<const synchronized_pool_resource*>(&other);
+        return o != nullptr && *o->upstream_ == *upstream_;
+    }
+
+    static size_t round_up(size_t bytes, size_t align) noexcept { return (bytes + align - 1) & ~(align - 1); }
+
+    memory_resource* upstream_;
+};
+
+/**
+ * @brief 单线程内存池资源
+ *
+ * 每个实例拥有自己的自由链表（大小类与 mystl::alloc 相同），不加锁、不经过线程缓存，
+ * 内存块从上游资源按几何增长申请。超过 MAX_BYTES 或对齐超过 MAX_ALIGN 的分配直接
+ * 转给上游，并挂在实例上，release() 或析构时连同全部内存块一起归还上游。
+ * 只能在一个线程内使用。
+ */
+class unsynchronized_pool_resource : public memory_resource {
+public:
+    explicit unsynchronized_pool_resource(memory_resource* upstream = get_default_resource()) noexcept
+        : upstream_(upstream), chunks_(nullptr), large_(nullptr), cur_(nullptr), end_(nullptr),
+          next_chunk_(MIN_CHUNK) {
+        for (size_t i = 0; i < NFREELISTS; ++i) {
+            free_[i] = nullptr;
+        }
+    }
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+    unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+    ~unsynchronized_pool_resource() override { release(); }
+
+    memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+    /**
+     * @brief 把全部内存块与大块分配归还上游，之前分配的内存随之失效
+     */
+    void release() noexcept {
+        while (chunks_ != nullptr) {
+            chunk* next = chunks_->next;
+            upstream_->deallocate(chunks_, chunks_->bytes, MAX_ALIGN);
+            chunks_ = next;
+        }
+        while (large_ != nullptr) {
+            large_block* next = large_->next;
+            upstream_->deallocate(reinterpret_cast<char*>(large_ + 1) - large_->offset, large_->bytes,
+                                  large_->align);
+            large_ = next;
+        }
+        for (size_t i = 0; i < NFREELISTS; ++i) {
+            free_[i] = nullptr;
+        }
+        cur_ = end_ = nullptr;
+        next_chunk_ = MIN_CHUNK;
+    }
+
+private:
+    static const size_t MIN_CHUNK = 16384;          // 第一个内存块大小
+    static const size_t MAX_CHUNK = CHUNK_BYTES;    // 内存块几何增长的上限
+
+    struct free_block {
+        free_block* next;
+    };
+
+    // 内存块头部，大小为 MAX_ALIGN 的倍数，块内对象从其后开始
+    struct alignas(MAX_ALIGN) chunk {
+        chunk* next;
+        size_t bytes;
+    };
+
+    // 大块分配的头部，紧贴在返回地址之前
+    struct alignas(MAX_ALIGN) large_block {
+        large_block* prev;
+        large_block* next;
+        size_t       bytes;     // 向上游申请的字节数
+        size_t       offset;    // 返回地址相对上游地址的偏移
+        size_t       align;     // 向上游申请时的对齐
+    };
+
+    void* do_allocate(size_t bytes, size_t align) override {
+        if (align > MAX_ALIGN || bytes > MAX_BYTES) {
+            return allocate_large(bytes, align);
+        }
+        const size_t index = alloc::size_class((bytes + align - 1) & ~(align - 1));
+        free_block* b = free_[index];
+        if (b != nullptr) {
+            free_[index] = b->next;
+            return b;
+        }
+        return carve(index);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        if (p == nullptr) {
+            return;
+        }
+        if (align > MAX_ALIGN || bytes > MAX_BYTES) {
+            deallocate_large(p);
+            return;
+        }
+        const size_t index = alloc::size_class((bytes + align - 1) & ~(align - 1));
+        free_block* b = static_cast<free_block*>(p);
+        b->next = free_[index];
+        free_[index] = b;
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return &other == this; }
+
+    // 从当前内存块切出一个对象；同一大小类的对象始终按 class_size 的最低位（至多 MAX_ALIGN）对齐，
+    // 所以自由链表中的任何对象都满足该大小类可能的对齐要求
+    void* carve(size_t index) {
+        const size_t size = alloc::class_size(index);
+        const size_t lowbit = size & (~size + 1);
+        const uintptr_t a = lowbit < MAX_ALIGN ? lowbit : MAX_ALIGN;
+        char* p = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(cur_) + a - 1) & ~(a - 1));
+        if (cur_ == nullptr || p > end_ || size > static_cast<size_t>(end_ - p)) {
+            refill(size);
+            p = cur_;
+        }
+        cur_ = p + size;
+        return p;
+    }
+
+    void refill(size_t size) {
+        size_t bytes = next_chunk_;
+        while (bytes < sizeof(chunk) + size) {
+            bytes *= 2;
+        }
+        chunk* c = static_cast<chunk*>(upstream_->allocate(bytes, MAX_ALIGN));
+        c->next = chunks_;
+        c->bytes = bytes;
+        chunks_ = c;
+        cur_ = reinterpret_cast<char*>(c + 1);
+        end_ = reinterpret_cast<char*>(c) + bytes;
+        if (next_chunk_ < MAX_CHUNK) {
+            next_chunk_ *= 2;
+        }
+    }
+
+    void* allocate_large(size_t bytes, size_t align) {
+        const size_t a = align > MAX_ALIGN ? align : MAX_ALIGN;
+        const size_t offset = sizeof(large_block) > a ? sizeof(large_block) : a;
+        if (bytes > size_t(-1) - offset) {
+            throw std::bad_alloc();
+        }
+        char* raw = static_cast<char*>(upstream_->allocate(bytes + offset, a));
+        large_block* h = reinterpret_cast<large_block*>(raw + offset) - 1;
+        h->bytes = bytes + offset;
+        h->offset = offset;
+        h->align = a;
+        h->prev = nullptr;
+        h->next = large_;
+        if (large_ != nullptr) {
+            large_->prev = h;
+        }
+        large_ = h;
+        return raw + offset;
+    }
+
+    void deallocate_large(void* p) {
+        large_block* h = static_cast<large_block*>(p) - 1;
+        if (h->prev != nullptr) {
+            h->prev->next = h->next;
+        } else {
+            large_ = h->next;
+        }
+        if (h->next != nullptr) {
+            h->next->prev = h->prev;
+        }
+        upstream_->deallocate(static_cast<char*>(p) - h->offset, h->bytes, h->align);
+    }
+
+    memory_resource* upstream_;
+    free_block*      free_[NFREELISTS];
+    chunk*           chunks_;
+    large_block*     large_;
+    char*            cur_;
+    char*            end_;
+    size_t           next_chunk_;
+};
+
+// ============================================================================
+// 单调缓冲区资源
+// ============================================================================
+
+/**
+ * @brief 单调缓冲区资源，建立在 mystl::monotonic_arena 之上
+ *
+ * deallocate 为空操作，release() 或析构时一次性归还全部内存。
+ * 上游内存由 monotonic_arena 直接向 malloc 申请。
+ */
+class monotonic_buffer_resource : public memory_resource {
+public:
+    monotonic_buffer_resource() noexcept : arena_() {}
+    explicit monotonic_buffer_resource(size_t initial_size) noexcept : arena_(initial_size) {}
+    monotonic_buffer_resource(void* buffer, size_t size) noexcept : arena_(buffer, size) {}
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+    void release() noexcept { arena_.release(); }
+
+    const monotonic_arena& arena() const noexcept { return arena_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override { return arena_.allocate(bytes, align); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const memory_resource& other) const noexcept override { return &other == this; }
+
+    monotonic_arena arena_;
+};
+
+// ============================================================================
+// 多态分配器
+// ============================================================================
+
+/**
+ * @brief 把分配转发给 memory_resource 的分配器
+ * @tparam T 分配的对象类型
+ *
+ * 接口与 mystl::allocator 一致；默认构造时使用 get_default_resource()，
+ * 也可由 memory_resource* 隐式转换，便于直接把资源传给容器构造函数：
+ *   mystl::pmr::vector<int> v(&pool);
+ */
+template <typename T>
+class polymorphic_allocator {
+public:
+    // 类型定义
+    typedef T            value_type;
+    typedef T*           pointer;
+    typedef const T*     const_pointer;
+    typedef T&           reference;
+    typedef const T&     const_reference;
+    typedef size_t       size_type;
+    typedef ptrdiff_t    difference_type;
+
+    // 分配器特征
+    template <typename U>
+    struct rebind {
+        typedef polymorphic_allocator<U> other;
+    };
+
+public:
+    // 构造函数
+    polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+    polymorphic_allocator(memory_resource* r) noexcept : resource_(r) {}
+    polymorphic_allocator(const polymorphic_allocator&) noexcept = default;
+    template <typename U>
+    polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept : resource_(other.resource()) {}
+
+    polymorphic_allocator& operator=(const polymorphic_allocator&) = default;
+
+    // 地址获取
+    pointer address(reference x) const noexcept { return &x; }
+    const_pointer address(const_reference x) const noexcept { return &x; }
+
+    // 内存分配
+    pointer allocate(size_type n, const void* hint = 0) {
+        (void)hint;
+        if (n > max_size()) {
+            throw std::bad_alloc();
+        }
+        return static_cast<pointer>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // 内存释放
+    void deallocate(pointer p, size_type n) { resource_->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    // 对象构造
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        mystl::construct(p, mystl::forward<Args>(args)...);
+    }
+
+    // 对象析构
+    template <typename U>
+    void destroy(U* p) {
+        mystl::destroy(p);
+    }
+
+    // 最大分配大小
+    size_type max_size() const noexcept { return size_type(-1) / sizeof(T); }
+
+    // 所用资源
+    memory_resource* resource() const noexcept { return resource_; }
+
+    // 比较操作：资源相等即可互相释放
+    template <typename U>
+    bool operator==(const polymorphic_allocator<U>& rhs) const noexcept {
+        return *resource_ == *rhs.resource();
+    }
+
+    template <typename U>
+    bool operator!=(const polymorphic_allocator<U>& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    memory_resource* resource_;
+};
+
+} // namespace pmr
+} // namespace mystl
+
+#endif // MYTINYSTL_MEMORY_RESOURCE_H_
@@ -1,8 +1,19 @@
 #ifndef MYTINYSTL_NUMERIC_H
 #define MYTINYSTL_NUMERIC_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "functional.h"
 #include "iterator.h"
+#include "type_traits.h"
+#include "util.h"
 
 namespace mystl {
 
@@ -10,6 +21,32 @@ namespace mystl {
 // 累加算法 (accumulate)
 // ============================================================================
 
+// 普通迭代器：逐个累加
+template<typename InputIterator, typename T>
+T accumulate_segments(InputIterator first, InputIterator last, T init, m_false_type) {
+    T result = init;
+    for(; first != last; ++first) {
+        result += *first;
+    }
+    return result;
+}
+
+// 分段迭代器：逐块累加指针区间，块内循环可向量化
+template<typename InputIterator, typename T>
+T accumulate_segments(InputIterator first, InputIterator last, T init, m_true_type) {
+    typedef segmented_iterator_traits<InputIterator> traits;
+    auto seg = traits::segment(first);
+    const auto last_seg = traits::segment(last);
+    if (seg == last_seg) {
+        return accumulate_segments(traits::local(first), traits::local(last), init, m_false_type());
+    }
+    T result = accumulate_segments(traits::local(first), traits::end(seg), init, m_false_type());
+    for (++seg; seg != last_seg; ++seg) {
+        result = accumulate_segments(traits::begin(seg), traits::end(seg), result, m_false_type());
+    }
+    return accumulate_segments(traits::begin(last_seg), traits::local(last), result, m_false_type());
+}
+
 /**
  * @brief 计算范围内元素的累加和
  * @tparam InputIterator 输入迭代器类型
@@ -21,13 +58,36 @@ namespace mystl {
  */
 template<typename InputIterator, typename T>
 T accumulate(InputIterator first, InputIterator last, T init) {
+    return mystl::accumulate_segments(first, last, init,
+        m_bool_constant<segmented_iterator_traits<InputIterator>::is_segmented>());
+}
+
+// 普通迭代器：逐个用 binary_op 累加
+template<typename InputIterator, typename T, typename BinaryOperation>
+T accumulate_segments(InputIterator first, InputIterator last, T init, BinaryOperation& binary_op, m_false_type) {
     T result = init;
     for(; first != last; ++first) {
-        result += *first;
+        result = binary_op(result, *first);
     }
     return result;
 }
 
+// 分段迭代器：逐块对指针区间累加
+template<typename InputIterator, typename T, typename BinaryOperation>
+T accumulate_segments(InputIterator first, InputIterator last, T init, BinaryOperation& binary_op, m_true_type) {
+    typedef segmented_iterator_traits<InputIterator> traits;
+    auto seg = traits::segment(first);
+    const auto last_seg = traits::segment(last);
+    if (seg == last_seg) {
+        return accumulate_segments(traits::local(first), traits::local(last), init, binary_op, m_false_type());
+    }
+    T result = accumulate_segments(traits::local(first), traits::end(seg), init, binary_op, m_false_type());
+    for (++seg; seg != last_seg; ++seg) {
+        result = accumulate_segments(traits::begin(seg), traits::end(seg), result, binary_op, m_false_type());
+    }
+    return accumulate_segments(traits::begin(last_seg), traits::local(last), result, binary_op, m_false_type());
+}
+
 /**
  * @brief 使用自定义二元操作计算范围内元素的累加
  * @tparam InputIterator 输入迭代器类型
@@ -41,11 +101,8 @@ T accumulate(InputIterator first, InputIterator last, T init) {
  */
 template<typename InputIterator, typename T, typename BinaryOperation>
 T accumulate(InputIterator first, InputIterator last, T init, BinaryOperation binary_op) {
-    T result = init;
-    for(; first != last; ++first) {
-        result = binary_op(result, *first);
-    }
-    return result;
+    return mystl::accumulate_segments(first, last, init, binary_op,
+        m_bool_constant<segmented_iterator_traits<InputIterator>::is_segmented>());
 }
 
 // ============================================================================
@@ -98,6 +155,326 @@ T inner_product(InputIterator1 first1, InputIterator1 last1, InputIterator2 firs
     return result;
 }
 
+// ============================================================================
+// 归约算法 (reduce / transform_reduce)
+// ============================================================================
+
+// 与 accumulate 不同，reduce 允许对运算重新结合与交换（要求 binary_op 满足结合律与交换律），
+// 因此可以使用多个独立累加器打破循环依赖，让 CPU 并行执行加法并便于编译器向量化。
+
+// 多累加器归约的累加器个数
+constexpr ptrdiff_t kReduceLanes = 8;
+
+// 成对求和中直接用多累加器求和的块长度
+constexpr ptrdiff_t kPairwiseSumBlock = 128;
+
+/**
+ * @brief 补偿求和标记：Kahan-Neumaier 补偿求和，误差界与 n 无关；编译时不能开启 -ffast-math
+ */
+struct kahan_summation_tag {};
+
+/**
+ * @brief 成对求和标记：递归二分求和，误差界 O(log n)，速度接近普通求和
+ */
+struct pairwise_summation_tag {};
+
+constexpr kahan_summation_tag    kahan_summation{};
+constexpr pairwise_summation_tag pairwise_summation{};
+
+/**
+ * @brief 多累加器归约：第 j 个累加器负责下标模 kReduceLanes 余 j 的元素，最后按顺序合并
+ * @param n 元素个数
+ * @param init 初始值
+ * @param op 归约操作
+ * @param get get(i) 返回第 i 个元素（已做变换）
+ */
+template<typename T, typename BinaryOperation, typename Getter>
+T reduce_lanes(ptrdiff_t n, T init, BinaryOperation op, Getter get) {
+    if (n < kReduceLanes) {
+        for (ptrdiff_t i = 0; i < n; ++i) {
+            init = op(init, get(i));
+        }
+        return init;
+    }
+    T acc0 = get(0), acc1 = get(1), acc2 = get(2), acc3 = get(3);
+    T acc4 = get(4), acc5 = get(5), acc6 = get(6), acc7 = get(7);
+    ptrdiff_t i = kReduceLanes;
+    for (; i + kReduceLanes <= n; i += kReduceLanes) {
+        acc0 = op(acc0, get(i));
+        acc1 = op(acc1, get(i + 1));
+        acc2 = op(acc2, get(i + 2));
+        acc3 = op(acc3, get(i + 3));
+        acc4 = op(acc4, get(i + 4));
+        acc5 = op(acc5, get(i + 5));
+        acc6 = op(acc6, get(i + 6));
+        acc7 = op(acc7, get(i + 7));
+    }
+    for (; i < n; ++i) {
+        acc0 = op(acc0, get(i));
+    }
+    acc0 = op(acc0, acc1);
+    acc2 = op(acc2, acc3);
+    acc4 = op(acc4, acc5);
+    acc6 = op(acc6, acc7);
+    return op(init, op(op(acc0, acc2), op(acc4, acc6)));
+}
+
+/**
+ * @brief 顺序归约：按顺序左折叠，只要求 op 满足结合律，用于非算术类型或非随机访问迭代器
+ */
+template<typename InputIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+T reduce_fold(InputIterator first, InputIterator last, T init, BinaryOperation op, UnaryOperation transform) {
+    for(; first != last; ++first) {
+        init = op(init, transform(*first));
+    }
+    return init;
+}
+
+/**
+ * @brief 恒等变换
+ */
+struct reduce_identity {
+    template<typename T>
+    T&& operator()(T&& x) const noexcept {
+        return static_cast<T&&>(x);
+    }
+};
+
+template<typename RandomIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+T transform_reduce_dispatch(RandomIterator first, RandomIterator last, T init, BinaryOperation op,
+                            UnaryOperation transform, random_access_iterator_tag, m_true_type) {
+    return mystl::reduce_lanes(last - first, init, op,
+                               [&](ptrdiff_t i) -> T { return transform(first[i]); });
+}
+
+template<typename InputIterator, typename T, typename BinaryOperation, typename UnaryOperation,
+         typename Category, typename Arithmetic>
+T transform_reduce_dispatch(InputIterator first, InputIterator last, T init, BinaryOperation op,
+                            UnaryOperation transform, Category, Arithmetic) {
+    return mystl::reduce_fold(first, last, init, op, transform);
+}
+
+/**
+ * @brief 对范围内每个元素做变换后归约
+ * @tparam InputIterator 输入迭代器类型
+ * @tparam T 结果类型
+ * @tparam BinaryOperation 归约操作类型，须满足结合律与交换律
+ * @tparam UnaryOperation 变换操作类型
+ * @param first 范围的开始迭代器
+ * @param last 范围的结束迭代器
+ * @param init 初始值
+ * @param reduce_op 归约操作
+ * @param transform_op 变换操作
+ * @return T 归约结果
+ *
+ * 随机访问迭代器且结果为算术类型时使用多累加器；否则按顺序折叠。
+ */
+template<typename InputIterator, typename T, typename BinaryOperation, typename UnaryOperation>
+T transform_reduce(InputIterator first, InputIterator last, T init,
+                   BinaryOperation reduce_op, UnaryOperation transform_op) {
+    return mystl::transform_reduce_dispatch(first, last, init, reduce_op, transform_op,
+                                            typename iterator_traits<InputIterator>::iterator_category(),
+                                            m_bool_constant<std::is_arithmetic<T>::value>());
+}
+
+template<typename RandomIterator1, typename RandomIterator2, typename T,
+         typename BinaryOperation1, typename BinaryOperation2>
+T transform_reduce_dispatch2(RandomIterator1 first1, RandomIterator1 last1, RandomIterator2 first2, T init,
+                             BinaryOperation1 reduce_op, BinaryOperation2 transform_op,
+                             random_access_iterator_tag, random_access_iterator_tag, m_true_type) {
+    return mystl::reduce_lanes(last1 - first1, init, reduce_op,
+                               [&](ptrdiff_t i) -> T { return transform_op(first1[i], first2[i]); });
+}
+
+template<typename InputIterator1, typename InputIterator2, typename T,
+         typename BinaryOperation1, typename BinaryOperation2,
+         typename Category1, typename Category2, typename Arithmetic>
+T transform_reduce_dispatch2(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                             BinaryOperation1 reduce_op, BinaryOperation2 transform_op,
+                             Category1, Category2, Arithmetic) {
+    for(; first1 != last1; ++first1, ++first2) {
+        init = reduce_op(init, transform_op(*first1, *first2));
+    }
+    return init;
+}
+
+/**
+ * @brief 对两个范围逐对变换后归约（可重新结合的 inner_product）
+ * @param first1 第一个范围的开始迭代器
+ * @param last1 第一个范围的结束迭代器
+ * @param first2 第二个范围的开始迭代器
+ * @param init 初始值
+ * @param reduce_op 归约操作，须满足结合律与交换律
+ * @param transform_op 二元变换操作
+ * @return T 归约结果
+ */
+template<typename InputIterator1, typename InputIterator2, typename T,
+         typename BinaryOperation1, typename BinaryOperation2>
+T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+                   BinaryOperation1 reduce_op, BinaryOperation2 transform_op) {
+    return mystl::transform_reduce_dispatch2(first1, last1, first2, init, reduce_op, transform_op,
+                                             typename iterator_traits<InputIterator1>::iterator_category(),
+                                             typename iterator_traits<InputIterator2>::iterator_category(),
+                                             m_bool_constant<std::is_arithmetic<T>::value>());
+}
+
+/**
+ * @brief 计算两个范围的内积，允许重新结合加法
+ */
+template<typename InputIterator1, typename InputIterator2, typename T>
+T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init) {
+    return mystl::transform_reduce(first1, last1, first2, init, mystl::plus<T>(), mystl::multiplies<T>());
+}
+
+/**
+ * @brief 使用自定义二元操作归约范围内的元素
+ * @tparam InputIterator 输入迭代器类型
+ * @tparam T 结果类型
+ * @tparam BinaryOperation 二元操作类型，须满足结合律与交换律
+ * @param first 范围的开始迭代器
+ * @param last 范围的结束迭代器
+ * @param init 初始值
+ * @param binary_op 二元操作函数对象
+ * @return T 归约结果
+ */
+template<typename InputIterator, typename T, typename BinaryOperation>
+T reduce(InputIterator first, InputIterator last, T init, BinaryOperation binary_op) {
+    return mystl::transform_reduce(first, last, init, binary_op, reduce_identity());
+}
+
+/**
+ * @brief 计算范围内元素的和，允许重新结合加法
+ * @param first 范围的开始迭代器
+ * @param last 范围的结束迭代器
+ * @param init 初始值
+ * @return T 求和结果
+ */
+template<typename InputIterator, typename T>
+T reduce(InputIterator first, InputIterator last, T init) {
+    return mystl::reduce(first, last, init, mystl::plus<T>());
+}
+
+/**
+ * @brief 计算范围内元素的和，初始值为值类型的零值
+ */
+template<typename InputIterator>
+typename mystl::iterator_traits<InputIterator>::value_type
+reduce(InputIterator first, InputIterator last) {
+    typedef typename mystl::iterator_traits<InputIterator>::value_type value_type;
+    return mystl::reduce(first, last, value_type());
+}
+
+// ----------------------------------------------------------------------------
+// 高精度浮点求和
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Neumaier 补偿累加一项：Kahan 求和的改进，加数比部分和大时同样能补偿
+ */
+template<typename T>
+void neumaier_add(T& sum, T& comp, T x) {
+    const T t = sum + x;
+    // 条件选择而非分支，便于编译器生成无分支代码
+    comp += (sum < 0 ? -sum : sum) >= (x < 0 ? -x : x) ? (sum - t) + x : (x - t) + sum;
+    sum = t;
+}
+
+/**
+ * @brief 补偿求和：4 路独立的 Neumaier 补偿累加以保持指令级并行，最后合并各路
+ * @param n 元素个数
+ * @param init 初始值
+ * @param get get(i) 返回第 i 个加数
+ * @return 未合并的部分和与补偿量，结果为 first + second；分块求和时合并补偿量可避免逐块舍入
+ */
+template<typename T, typename Getter>
+mystl::pair<T, T> kahan_sum_parts_n(ptrdiff_t n, T init, Getter get) {
+    T sum[4] = {T(), T(), T(), T()};
+    T comp[4] = {T(), T(), T(), T()};
+    ptrdiff_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int j = 0; j < 4; ++j) {
+            mystl::neumaier_add(sum[j], comp[j], static_cast<T>(get(i + j)));
+        }
+    }
+    T total = init;
+    T total_comp = T();
+    for (; i < n; ++i) {
+        mystl::neumaier_add(total, total_comp, static_cast<T>(get(i)));
+    }
+    for (int j = 0; j < 4; ++j) {
+        mystl::neumaier_add(total, total_comp, sum[j]);
+        total_comp += comp[j];
+    }
+    return mystl::pair<T, T>(total, total_comp);
+}
+
+/**
+ * @brief 补偿求和，返回合并后的结果
+ */
+template<typename T, typename Getter>
+T kahan_sum_n(ptrdiff_t n, T init, Getter get) {
+    const mystl::pair<T, T> parts = mystl::kahan_sum_parts_n(n, init, get);
+    return parts.first + parts.second;
+}
+
+/**
+ * @brief 成对求和：区间对半递归，块长不超过 kPairwiseSumBlock 时用多累加器直接求和
+ */
+template<typename T, typename Getter>
+T pairwise_sum_n(ptrdiff_t offset, ptrdiff_t n, Getter& get) {
+    if (n <= kPairwiseSumBlock) {
+        return mystl::reduce_lanes(n, T(), mystl::plus<T>(),
+                                   [&](ptrdiff_t i) -> T { return get(offset + i); });
+    }
+    const ptrdiff_t half = n / 2;
+    return mystl::pairwise_sum_n<T>(offset, half, get) + mystl::pairwise_sum_n<T>(offset + half, n - half, get);
+}
+
+/**
+ * @brief 使用 Kahan 补偿求和计算范围内元素的和，适用于浮点类型
+ * @param first 范围的开始迭代器（随机访问）
+ * @param last 范围的结束迭代器
+ * @param init 初始值
+ * @return T 求和结果
+ */
+template<typename RandomIterator, typename T>
+T reduce(RandomIterator first, RandomIterator last, T init, kahan_summation_tag) {
+    return mystl::kahan_sum_n(last - first, init, [&](ptrdiff_t i) -> T { return first[i]; });
+}
+
+/**
+ * @brief 使用成对求和计算范围内元素的和，适用于浮点类型
+ * @param first 范围的开始迭代器（随机访问）
+ * @param last 范围的结束迭代器
+ * @param init 初始值
+ * @return T 求和结果
+ */
+template<typename RandomIterator, typename T>
+T reduce(RandomIterator first, RandomIterator last, T init, pairwise_summation_tag) {
+    auto get = [&](ptrdiff_t i) -> T { return first[i]; };
+    return init + mystl::pairwise_sum_n<T>(0, last - first, get);
+}
+
+/**
+ * @brief 使用 Kahan 补偿求和计算两个范围的内积
+ */
+template<typename RandomIterator1, typename RandomIterator2, typename T>
+T transform_reduce(RandomIterator1 first1, RandomIterator1 last1, RandomIterator2 first2, T init,
+                   kahan_summation_tag) {
+    return mystl::kahan_sum_n(last1 - first1, init,
+                              [&](ptrdiff_t i) -> T { return static_cast<T>(first1[i]) * first2[i]; });
+}
+
+/**
+ * @brief 使用成对求和计算两个范围的内积
+ */
+template<typename RandomIterator1, typename RandomIterator2, typename T>
+T transform_reduce(RandomIterator1 first1, RandomIterator1 last1, RandomIterator2 first2, T init,
+                   pairwise_summation_tag) {
+    auto get = [&](ptrdiff_t i) -> T { return static_cast<T>(first1[i]) * first2[i]; };
+    return init + mystl::pairwise_sum_n<T>(0, last1 - first1, get);
+}
+
 // ============================================================================
 // 部分和算法 (partial_sum)
 // ============================================================================
@@ -160,6 +537,330 @@ OutputIterator partial_sum(InputIterator first, InputIterator last, OutputIterat
     return result;
 }
 
+// ============================================================================
+// 扫描算法 (inclusive_scan / exclusive_scan)
+// ============================================================================
+
+// 与 partial_sum 不同，扫描只要求 binary_op 满足结合律，允许以任意方式组合，
+// 因此可以在寄存器内做对数步前缀和，也可以分块并行（见 execution.h）。
+// 输出区间可以与输入区间相同（原地扫描）。
+
+/**
+ * @brief 判断二元操作是否为 T 上的加法（mystl::plus<T> 或 std::plus<T>）
+ */
+template<typename Op, typename T>
+struct is_plus_operation : m_false_type {};
+
+template<typename T>
+struct is_plus_operation<mystl::plus<T>, T> : m_true_type {};
+
+template<typename T>
+struct is_plus_operation<std::plus<T>, T> : m_true_type {};
+
+#if defined(__SSE2__)
+
+/**
+ * @brief SSE2 寄存器内前缀和：每个 128 位寄存器内用 log2(lanes) 次移位相加完成扫描
+ */
+template<typename T>
+struct simd_scan_traits {
+    static constexpr bool enabled = false;
+};
+
+template<>
+struct simd_scan_traits<int32_t> {
+    static constexpr bool enabled = true;
+    static constexpr ptrdiff_t lanes = 4;
+    typedef __m128i vec;
+    static vec load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(int32_t* p, vec x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    static vec set1(int32_t x) { return _mm_set1_epi32(x); }
+    static vec add(vec a, vec b) { return _mm_add_epi32(a, b); }
+    static vec scan(vec x) {
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        return _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    }
+    static vec shift_one_lane(vec x) { return _mm_slli_si128(x, 4); }
+    static vec broadcast_last(vec x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static int32_t first_lane(vec x) { return _mm_cvtsi128_si32(x); }
+};
+
+template<>
+struct simd_scan_traits<int64_t> {
+    static constexpr bool enabled = true;
+    static constexpr ptrdiff_t lanes = 2;
+    typedef __m128i vec;
+    static vec load(const int64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(int64_t* p, vec x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    static vec set1(int64_t x) { return _mm_set1_epi64x(x); }
+    static vec add(vec a, vec b) { return _mm_add_epi64(a, b); }
+    static vec scan(vec x) { return _mm_add_epi64(x, _mm_slli_si128(x, 8)); }
+    static vec shift_one_lane(vec x) { return _mm_slli_si128(x, 8); }
+    static vec broadcast_last(vec x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2)); }
+    static int64_t first_lane(vec x) {
+        int64_t r;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&r), x);
+        return r;
+    }
+};
+
+template<>
+struct simd_scan_traits<float> {
+    static constexpr bool enabled = true;
+    static constexpr ptrdiff_t lanes = 4;
+    typedef __m128 vec;
+    static vec load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, vec x) { _mm_storeu_ps(p, x); }
+    static vec set1(float x) { return _mm_set1_ps(x); }
+    static vec add(vec a, vec b) { return _mm_add_ps(a, b); }
+    static vec shift_one_lane(vec x) { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)); }
+    static vec scan(vec x) {
+        x = _mm_add_ps(x, shift_one_lane(x));
+        return _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+    }
+    static vec broadcast_last(vec x) { return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static float first_lane(vec x) { return _mm_cvtss_f32(x); }
+};
+
+template<>
+struct simd_scan_traits<double> {
+    static constexpr bool enabled = true;
+    static constexpr ptrdiff_t lanes = 2;
+    typedef __m128d vec;
+    static vec load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, vec x) { _mm_storeu_pd(p, x); }
+    static vec set1(double x) { return _mm_set1_pd(x); }
+    static vec add(vec a, vec b) { return _mm_add_pd(a, b); }
+    static vec shift_one_lane(vec x) { return _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)); }
+    static vec scan(vec x) { return _mm_add_pd(x, shift_one_lane(x)); }
+    static vec broadcast_last(vec x) { return _mm_unpackhi_pd(x, x); }
+    static double first_lane(vec x) { return _mm_cvtsd_f64(x); }
+};
+
+/**
+ * @brief SIMD 加法扫描：每次处理一个寄存器，进位在寄存器间传递
+ * @param exclusive 为 true 时计算不含当前元素的前缀和
+ * @return 输出区间的结束位置
+ */
+template<typename T>
+T* simd_plus_scan(const T* first, const T* last, T* result, T carry, bool exclusive) {
+    typedef simd_scan_traits<T> traits;
+    typedef typename traits::vec vec;
+    const ptrdiff_t n = last - first;
+    const ptrdiff_t lanes = traits::lanes;
+    vec vcarry = traits::set1(carry);
+    ptrdiff_t i = 0;
+    // 每次处理两个寄存器：两者的寄存器内扫描互相独立，跨迭代的依赖链只有一次进位加法
+    for (; i + 2 * lanes <= n; i += 2 * lanes) {
+        const vec inc0 = traits::scan(traits::load(first + i));
+        const vec scan1 = traits::scan(traits::load(first + i + lanes));
+        const vec total0 = traits::broadcast_last(inc0);
+        const vec inc1 = traits::add(scan1, total0);
+        if (exclusive) {
+            traits::store(result + i, traits::add(traits::shift_one_lane(inc0), vcarry));
+            traits::store(result + i + lanes, traits::add(traits::add(traits::shift_one_lane(scan1), total0), vcarry));
+        } else {
+            traits::store(result + i, traits::add(inc0, vcarry));
+            traits::store(result + i + lanes, traits::add(inc1, vcarry));
+        }
+        vcarry = traits::add(traits::broadcast_last(inc1), vcarry);
+    }
+    for (; i + lanes <= n; i += lanes) {
+        const vec inc = traits::scan(traits::load(first + i));
+        if (exclusive) {
+            traits::store(result + i, traits::add(traits::shift_one_lane(inc), vcarry));
+        } else {
+            traits::store(result + i, traits::add(inc, vcarry));
+        }
+        vcarry = traits::add(traits::broadcast_last(inc), vcarry);
+    }
+    carry = traits::first_lane(vcarry);
+    for (; i < n; ++i) {
+        const T x = first[i];
+        if (exclusive) {
+            result[i] = carry;
+            carry = carry + x;
+        } else {
+            carry = carry + x;
+            result[i] = carry;
+        }
+    }
+    return result + n;
+}
+
+#endif // __SSE2__
+
+/**
+ * @brief 是否走 SIMD 加法扫描：输入为 T 指针、输出为 T*、操作为 T 上的加法、T 为 32/64 位整数或浮点数
+ */
+template<typename InputIterator, typename OutputIterator, typename BinaryOperation>
+struct simd_scan_eligible {
+    typedef typename std::remove_cv<typename std::remove_pointer<InputIterator>::type>::type value_type;
+#if defined(__SSE2__)
+    static constexpr bool value = std::is_pointer<InputIterator>::value &&
+                                  std::is_same<OutputIterator, value_type*>::value &&
+                                  is_plus_operation<BinaryOperation, value_type>::value &&
+                                  simd_scan_traits<value_type>::enabled;
+#else
+    static constexpr bool value = false;
+#endif
+};
+
+/**
+ * @brief 顺序扫描的公共实现
+ * @param carry 进位（已包含 init 与之前的元素），has_carry 为 false 时第一个元素直接作为进位
+ */
+template<typename InputIterator, typename OutputIterator, typename T,
+         typename BinaryOperation, typename UnaryOperation>
+OutputIterator scan_loop(InputIterator first, InputIterator last, OutputIterator result, T carry, bool has_carry,
+                         bool exclusive, BinaryOperation op, UnaryOperation transform) {
+    if (!has_carry) {
+        if (first == last) {
+            return result;
+        }
+        carry = transform(*first);
+        *result = carry;
+        ++first;
+        ++result;
+    }
+    for(; first != last; ++first, ++result) {
+        if (exclusive) {
+            // 先读后写，支持原地扫描
+            T next = op(carry, transform(*first));
+            *result = carry;
+            carry = mystl::move(next);
+        } else {
+            carry = op(carry, transform(*first));
+            *result = carry;
+        }
+    }
+    return result;
+}
+
+template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+OutputIterator scan_dispatch(InputIterator first, InputIterator last, OutputIterator result, T carry,
+                             bool has_carry, bool exclusive, BinaryOperation op, m_false_type) {
+    return mystl::scan_loop(first, last, result, carry, has_carry, exclusive, op, reduce_identity());
+}
+
+#if defined(__SSE2__)
+template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+OutputIterator scan_dispatch(InputIterator first, InputIterator last, OutputIterator result, T carry,
+                             bool has_carry, bool exclusive, BinaryOperation, m_true_type) {
+    typedef typename simd_scan_eligible<InputIterator, OutputIterator, BinaryOperation>::value_type value_type;
+    return mystl::simd_plus_scan<value_type>(first, last, result,
+                                             has_carry ? static_cast<value_type>(carry) : value_type(),
+                                             exclusive);
+}
+#endif
+
+/**
+ * @brief 扫描的统一入口：对 T 指针上的加法使用 SIMD，其余情况逐个元素扫描
+ */
+template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+OutputIterator scan_impl(InputIterator first, InputIterator last, OutputIterator result, T carry,
+                         bool has_carry, bool exclusive, BinaryOperation op) {
+    // 只有进位类型与元素类型相同时才能走 SIMD，否则会改变中间结果的类型
+    typedef simd_scan_eligible<InputIterator, OutputIterator, BinaryOperation> eligible;
+    return mystl::scan_dispatch(first, last, result, carry, has_carry, exclusive, op,
+                                m_bool_constant<eligible::value &&
+                                                std::is_same<T, typename eligible::value_type>::value>());
+}
+
+/**
+ * @brief 计算包含当前元素的前缀和（可重新结合的 partial_sum）
+ * @tparam InputIterator 输入迭代器类型
+ * @tparam OutputIterator 输出迭代器类型
+ * @param first 输入范围的开始迭代器
+ * @param last 输入范围的结束迭代器
+ * @param result 输出范围的开始迭代器，可以等于 first
+ * @return OutputIterator 输出范围的结束迭代器
+ *
+ * 输入为 int32_t / int64_t / float / double 指针时在 SSE2 寄存器内扫描。
+ */
+template<typename InputIterator, typename OutputIterator>
+OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result) {
+    typedef typename mystl::iterator_traits<InputIterator>::value_type value_type;
+    return mystl::scan_impl(first, last, result, value_type(), false, false, mystl::plus<value_type>());
+}
+
+/**
+ * @brief 使用自定义二元操作计算包含当前元素的前缀和
+ * @param binary_op 二元操作函数对象，须满足结合律
+ */
+template<typename InputIterator, typename OutputIterator, typename BinaryOperation>
+OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                              BinaryOperation binary_op) {
+    typedef typename mystl::iterator_traits<InputIterator>::value_type value_type;
+    return mystl::scan_impl(first, last, result, value_type(), false, false, binary_op);
+}
+
+/**
+ * @brief 使用自定义二元操作和初始值计算包含当前元素的前缀和
+ * @param binary_op 二元操作函数对象，须满足结合律
+ * @param init 初始值，第 i 个输出为 init op x0 op ... op xi
+ */
+template<typename InputIterator, typename OutputIterator, typename BinaryOperation, typename T>
+OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                              BinaryOperation binary_op, T init) {
+    return mystl::scan_impl(first, last, result, init, true, false, binary_op);
+}
+
+/**
+ * @brief 计算不包含当前元素的前缀和
+ * @param first 输入范围的开始迭代器
+ * @param last 输入范围的结束迭代器
+ * @param result 输出范围的开始迭代器，可以等于 first
+ * @param init 初始值，第 i 个输出为 init + x0 + ... + x(i-1)
+ * @return OutputIterator 输出范围的结束迭代器
+ */
+template<typename InputIterator, typename OutputIterator, typename T>
+OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init) {
+    return mystl::scan_impl(first, last, result, init, true, true, mystl::plus<T>());
+}
+
+/**
+ * @brief 使用自定义二元操作计算不包含当前元素的前缀和
+ * @param binary_op 二元操作函数对象，须满足结合律
+ */
+template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init,
+                              BinaryOperation binary_op) {
+    return mystl::scan_impl(first, last, result, init, true, true, binary_op);
+}
+
+/**
+ * @brief 对每个元素做变换后计算包含当前元素的前缀和
+ * @param binary_op 二元操作函数对象，须满足结合律
+ * @param unary_op 变换操作
+ */
+template<typename InputIterator, typename OutputIterator, typename BinaryOperation, typename UnaryOperation>
+OutputIterator transform_inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                        BinaryOperation binary_op, UnaryOperation unary_op) {
+    typedef typename std::decay<decltype(unary_op(*first))>::type value_type;
+    return mystl::scan_loop(first, last, result, value_type(), false, false, binary_op, unary_op);
+}
+
+/**
+ * @brief 对每个元素做变换后，使用初始值计算包含当前元素的前缀和
+ */
+template<typename InputIterator, typename OutputIterator, typename BinaryOperation, typename UnaryOperation,
+         typename T>
+OutputIterator transform_inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                        BinaryOperation binary_op, UnaryOperation unary_op, T init) {
+    return mystl::scan_loop(first, last, result, init, true, false, binary_op, unary_op);
+}
+
+/**
+ * @brief 对每个元素做变换后计算不包含当前元素的前缀和
+ */
+template<typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation,
+         typename UnaryOperation>
+OutputIterator transform_exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init,
+                                        BinaryOperation binary_op, UnaryOperation unary_op) {
+    return mystl::scan_loop(first, last, result, init, true, true, binary_op, unary_op);
+}
+
 // ============================================================================
 // 相邻差分算法 (adjacent_difference)
 // ============================================================================
@@ -0,0 +1,390 @@
+#ifndef MYTINYSTL_RADIX_SORT_H
+#define MYTINYSTL_RADIX_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "iterator.h"
+#include "memory.h"
+#include "vector.h"
+#include "algo.h"
+
+namespace mystl {
+
+// ============================================================================
+// 基数排序
+// ============================================================================
+//
+// radix_sort(first, last)          对整数、浮点数或 std::string 区间排序
+// radix_sort(first, last, key_fn)  按 key_fn(元素) 返回的键排序，键可以是整数、浮点数或 std::string
+//
+// 整数与浮点键使用 LSD 基数排序：每趟处理 8 位，一次扫描算出全部趟的直方图，
+// 所有元素在某一位上相同的趟直接跳过；需要一块与区间等长的临时缓冲区，结果是稳定的。
+// std::string 键使用 MSD American-flag 排序：按字节原地分桶，不需要额外缓冲区，结果不稳定。
+
+// 区间长度小于该值时不做基数排序，直接按键比较排序
+constexpr ptrdiff_t kRadixSortThreshold = 128;
+
+// 字符串桶小于该值时改用插入排序
+constexpr ptrdiff_t kRadixStringInsertionThreshold = 32;
+
+// 扫描时提前预取的元素个数
+constexpr size_t kRadixPrefetchDistance = 64;
+
+/**
+ * @brief 预取 p 指向的数据到缓存
+ */
+inline void radix_prefetch(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 0, 0);
+#else
+    (void)p;
+#endif
+}
+
+// ============================================================================
+// 键的无符号映射
+// ============================================================================
+
+/**
+ * @brief 将键映射为等宽无符号整数，映射后按无符号比较的次序与原键次序一致
+ * @tparam K 键类型
+ *
+ * 未特化的类型（bool、long double 等）不支持基数排序。
+ */
+template <class K, class Enable = void>
+struct radix_traits;
+
+// 无符号整数：原样使用
+template <class K>
+struct radix_traits<K, typename std::enable_if<std::is_integral<K>::value && std::is_unsigned<K>::value &&
+                                               !std::is_same<K, bool>::value>::type> {
+    typedef K unsigned_type;
+    static unsigned_type to_unsigned(K key) noexcept { return key; }
+};
+
+// 有符号整数：翻转符号位，负数排在非负数之前
+template <class K>
+struct radix_traits<K, typename std::enable_if<std::is_integral<K>::value && std::is_signed<K>::value>::type> {
+    typedef typename std::make_unsigned<K>::type unsigned_type;
+    static unsigned_type to_unsigned(K key) noexcept {
+        return static_cast<unsigned_type>(static_cast<unsigned_type>(key) ^
+                                          (unsigned_type(1) << (sizeof(K) * 8 - 1)));
+    }
+};
+
+// float：负数取反全部位，非负数只置符号位；-0.0 排在 +0.0 之前，NaN 按符号排在两端
+template <>
+struct radix_traits<float> {
+    typedef uint32_t unsigned_type;
+    static unsigned_type to_unsigned(float key) noexcept {
+        static_assert(sizeof(float) == sizeof(uint32_t), "float must be 32 bits");
+        uint32_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+};
+
+// double：同 float
+template <>
+struct radix_traits<double> {
+    typedef uint64_t unsigned_type;
+    static unsigned_type to_unsigned(double key) noexcept {
+        static_assert(sizeof(double) == sizeof(uint64_t), "double must be 64 bits");
+        uint64_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+    }
+};
+
+// 有 radix_traits 特化的键类型：除 bool 外的整数、float、double
+template <class K>
+struct is_radix_key
+    : m_bool_constant<(std::is_integral<K>::value && !std::is_same<K, bool>::value) ||
+                      std::is_same<K, float>::value || std::is_same<K, double>::value> {};
+
+/**
+ * @brief 取元素自身作为键
+ */
+struct radix_identity {
+    template <class T>
+    const T& operator()(const T& x) const noexcept { return x; }
+};
+
+/**
+ * @brief key_fn 作用于 T 后得到的键类型
+ */
+template <class KeyFn, class T>
+struct radix_key_of {
+    typedef typename std::decay<decltype(std::declval<KeyFn&>()(std::declval<const T&>()))>::type type;
+};
+
+/**
+ * @brief 按映射后的键比较，用于短区间或申请不到缓冲区时的比较排序
+ */
+template <class KeyFn, class Traits>
+struct radix_key_less {
+    KeyFn key_fn;
+
+    template <class T>
+    bool operator()(const T& a, const T& b) const {
+        return Traits::to_unsigned(key_fn(a)) < Traits::to_unsigned(key_fn(b));
+    }
+};
+
+// ============================================================================
+// LSD 基数排序（整数 / 浮点键）
+// ============================================================================
+
+/**
+ * @brief 一次扫描统计全部趟的直方图
+ * @param first 起始迭代器
+ * @param n 元素个数
+ * @param key_fn 键提取函数
+ * @param counts counts[p][d] 为第 p 趟（第 p 个字节）取值为 d 的元素个数
+ */
+template <class Traits, class RandomIter, class KeyFn, size_t Passes>
+void radix_histogram(RandomIter first, size_t n, KeyFn& key_fn, size_t (&counts)[Passes][256]) {
+    for (size_t i = 0; i < n; ++i) {
+        if (i + kRadixPrefetchDistance < n) {
+            mystl::radix_prefetch(&*(first + (i + kRadixPrefetchDistance)));
+        }
+        const typename Traits::unsigned_type key = Traits::to_unsigned(key_fn(first[i]));
+        for (size_t p = 0; p < Passes; ++p) {
+            ++counts[p][(key >> (p * 8)) & 0xff];
+        }
+    }
+}
+
+/**
+ * @brief 按第 shift 位开始的字节将 src 中的元素分散到 dst
+ * @param offsets 每个桶的下一个写入位置，分散过程中递增
+ */
+template <class Traits, class SrcIter, class DstIter, class KeyFn>
+void radix_scatter(SrcIter src, size_t n, DstIter dst, KeyFn& key_fn, size_t* offsets, unsigned shift) {
+    for (size_t i = 0; i < n; ++i) {
+        if (i + kRadixPrefetchDistance < n) {
+            mystl::radix_prefetch(&*(src + (i + kRadixPrefetchDistance)));
+        }
+        const size_t digit = static_cast<size_t>((Traits::to_unsigned(key_fn(src[i])) >> shift) & 0xff);
+        dst[offsets[digit]++] = mystl::move(src[i]);
+    }
+}
+
+/**
+ * @brief LSD 基数排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param key_fn 键提取函数，返回整数或浮点数
+ *
+ * 区间较短或申请不到完整缓冲区时退化为按键比较的 stable_sort。
+ */
+template <class RandomIter, class KeyFn>
+void radix_sort_lsd(RandomIter first, RandomIter last, KeyFn key_fn) {
+    typedef typename iterator_traits<RandomIter>::value_type     value_type;
+    typedef typename radix_key_of<KeyFn, value_type>::type        key_type;
+    typedef radix_traits<key_type>                                traits;
+    typedef typename traits::unsigned_type                        unsigned_type;
+    const size_t kPasses = sizeof(unsigned_type);
+
+    const ptrdiff_t len = last - first;
+    if (len < 2) {
+        return;
+    }
+    if (len < kRadixSortThreshold) {
+        mystl::stable_sort(first, last, radix_key_less<KeyFn, traits>{key_fn});
+        return;
+    }
+    temporary_buffer<value_type> buf(first, len);
+    if (buf.size() < len) {
+        mystl::stable_sort(first, last, radix_key_less<KeyFn, traits>{key_fn});
+        return;
+    }
+
+    const size_t n = static_cast<size_t>(len);
+    size_t counts[kPasses][256] = {};
+    mystl::radix_histogram<traits>(first, n, key_fn, counts);
+
+    const unsigned_type first_key = traits::to_unsigned(key_fn(*first));
+    bool in_buffer = false;
+    for (size_t p = 0; p < kPasses; ++p) {
+        const unsigned shift = static_cast<unsigned>(p * 8);
+        // 所有元素在这一趟落入同一个桶，分散后次序不变，跳过
+        if (counts[p][(first_key >> shift) & 0xff] == n) {
+            continue;
+        }
+        size_t offsets[256];
+        size_t sum = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            offsets[d] = sum;
+            sum += counts[p][d];
+        }
+        if (in_buffer) {
+            mystl::radix_scatter<traits>(buf.begin(), n, first, key_fn, offsets, shift);
+        } else {
+            mystl::radix_scatter<traits>(first, n, buf.begin(), key_fn, offsets, shift);
+        }
+        in_buffer = !in_buffer;
+    }
+    if (in_buffer) {
+        mystl::move(buf.begin(), buf.end(), first);
+    }
+}
+
+// ============================================================================
+// MSD American-flag 排序（std::string 键）
+// ============================================================================
+
+/**
+ * @brief 字符串在第 depth 个字节上的桶号：已结束的字符串为 0，否则为字节值加一
+ */
+inline size_t radix_string_bucket(const std::string& s, size_t depth) noexcept {
+    return depth < s.size() ? static_cast<size_t>(static_cast<unsigned char>(s[depth])) + 1 : 0;
+}
+
+/**
+ * @brief 对前 depth 个字节都相同的短区间做插入排序，只比较 depth 之后的部分
+ */
+template <class RandomIter, class KeyFn>
+void radix_string_insertion_sort(RandomIter first, RandomIter last, size_t depth, KeyFn& key_fn) {
+    if (first == last) {
+        return;
+    }
+    for (RandomIter i = first + 1; i != last; ++i) {
+        for (RandomIter j = i; j != first; --j) {
+            const std::string& a = key_fn(*(j - 1));
+            const std::string& b = key_fn(*j);
+            if (b.compare(depth, std::string::npos, a, depth, std::string::npos) >= 0) {
+                break;
+            }
+            mystl::iter_swap(j - 1, j);
+        }
+    }
+}
+
+/**
+ * @brief MSD American-flag 排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param key_fn 键提取函数，返回 std::string（最好返回引用）
+ *
+ * 每层统计一次桶大小，再用交换把元素原地放入各自的桶，然后对每个桶处理下一个字节。
+ * 用显式栈代替递归，公共前缀很长时也不会栈溢出；所有元素落入同一桶时直接进入下一字节。
+ */
+template <class RandomIter, class KeyFn>
+void radix_sort_msd_string(RandomIter first, RandomIter last, KeyFn key_fn) {
+    struct bucket_range {
+        ptrdiff_t lo;
+        ptrdiff_t hi;
+        size_t    depth;
+    };
+
+    if (last - first < 2) {
+        return;
+    }
+    mystl::vector<bucket_range> stack;
+    stack.push_back(bucket_range{0, last - first, 0});
+    while (!stack.empty()) {
+        const bucket_range r = stack.back();
+        stack.pop_back();
+        RandomIter lo = first + r.lo;
+        RandomIter hi = first + r.hi;
+        if (r.hi - r.lo < kRadixStringInsertionThreshold) {
+            mystl::radix_string_insertion_sort(lo, hi, r.depth, key_fn);
+            continue;
+        }
+
+        ptrdiff_t counts[257] = {};
+        for (RandomIter it = lo; it != hi; ++it) {
+            ++counts[mystl::radix_string_bucket(key_fn(*it), r.depth)];
+        }
+        // 全部落入同一个桶：桶 0 表示全部相等，否则直接看下一个字节
+        const size_t only = mystl::radix_string_bucket(key_fn(*lo), r.depth);
+        if (counts[only] == r.hi - r.lo) {
+            if (only != 0) {
+                stack.push_back(bucket_range{r.lo, r.hi, r.depth + 1});
+            }
+            continue;
+        }
+
+        ptrdiff_t next[257];
+        ptrdiff_t end[257];
+        ptrdiff_t sum = 0;
+        for (size_t b = 0; b < 257; ++b) {
+            next[b] = sum;
+            sum += counts[b];
+            end[b] = sum;
+        }
+        // 原地置换：把当前位置的元素交换到它所属桶的下一个空位
+        for (size_t b = 0; b < 257; ++b) {
+            while (next[b] < end[b]) {
+                const size_t target = mystl::radix_string_bucket(key_fn(lo[next[b]]), r.depth);
+                if (target == b) {
+                    ++next[b];
+                } else {
+                    mystl::iter_swap(lo + next[b], lo + next[target]++);
+                }
+            }
+        }
+        // 桶 0 中的字符串已经结束，彼此相等
+        for (size_t b = 1; b < 257; ++b) {
+            if (counts[b] > 1) {
+                stack.push_back(bucket_range{r.lo + end[b] - counts[b], r.lo + end[b], r.depth + 1});
+            }
+        }
+    }
+}
+
+// ============================================================================
+// 对外接口
+// ============================================================================
+
+/**
+ * @brief 按键类型选择 LSD（整数、浮点）或 MSD（std::string）基数排序
+ */
+template <class RandomIter, class KeyFn>
+void radix_sort_dispatch(RandomIter first, RandomIter last, KeyFn key_fn, m_true_type /* 字符串键 */) {
+    mystl::radix_sort_msd_string(first, last, key_fn);
+}
+
+template <class RandomIter, class KeyFn>
+void radix_sort_dispatch(RandomIter first, RandomIter last, KeyFn key_fn, m_false_type /* 数值键 */) {
+    mystl::radix_sort_lsd(first, last, key_fn);
+}
+
+/**
+ * @brief 按 key_fn 提取的键对[first, last)区间内的元素进行基数排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ * @param key_fn 键提取函数，返回整数、float、double 或 std::string
+ *
+ * 数值键排序是稳定的，次序与按 < 比较一致（浮点数中 -0.0 排在 +0.0 之前）；
+ * 字符串键按字节字典序排序，不保证稳定。
+ */
+template <class RandomIter, class KeyFn>
+void radix_sort(RandomIter first, RandomIter last, KeyFn key_fn) {
+    typedef typename iterator_traits<RandomIter>::value_type value_type;
+    typedef typename radix_key_of<KeyFn, value_type>::type    key_type;
+    static_assert(is_radix_key<key_type>::value || std::is_same<key_type, std::string>::value,
+                  "radix_sort key must be an integer other than bool, float, double or std::string");
+    mystl::radix_sort_dispatch(first, last, key_fn,
+                               m_bool_constant<std::is_same<key_type, std::string>::value>());
+}
+
+/**
+ * @brief 对[first, last)区间内的整数、浮点数或 std::string 进行基数排序
+ * @param first 起始迭代器
+ * @param last 结束迭代器
+ */
+template <class RandomIter>
+void radix_sort(RandomIter first, RandomIter last) {
+    mystl::radix_sort(first, last, radix_identity());
+}
+
+} // namespace mystl
+
+#endif // !MYTINYSTL_RADIX_SORT_H
@@ -0,0 +1,650 @@
+#ifndef MYTINYSTL_SMALL_VECTOR_H_
+#define MYTINYSTL_SMALL_VECTOR_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#include "allocator.h"
+#include "construct.h"
+#include "uninitialized.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace mystl {
+
+/**
+ * @brief 带内联存储的动态数组
+ * @tparam T 元素类型
+ * @tparam N 内联容量：元素不超过 N 个时存放在对象内部，不分配内存
+ * @tparam Alloc 超过 N 个元素后使用的分配器，默认为 mystl::allocator<T>
+ *
+ * 接口与 vector 相同。元素超过 N 个时整体搬到分配器分配的缓冲区，之后按容量翻倍增长；
+ * shrink_to_fit 在元素不超过 N 个时搬回内联存储。堆状态下移动与交换只交换指针，
+ * 内联状态下需要逐个移动元素，因此移动之后原对象为空但不会分配内存。
+ */
+template<typename T, size_t N, typename Alloc = mystl::allocator<T>>
+class small_vector {
+    static_assert(N > 0, "small_vector: 内联容量必须大于 0");
+
+private:
+    T* begin_;           // 指向第一个元素，内联状态下指向 inline_
+    T* end_;             // 指向最后一个元素的下一个位置
+    T* cap_;             // 指向存储的末尾
+    Alloc allocator_;    // 分配器对象
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inline_;  // 内联存储
+
+public:
+    // ============================================================================
+    // 类型定义
+    // ============================================================================
+
+    typedef T                                           value_type;
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef T&                                          reference;
+    typedef const T&                                    const_reference;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
+    typedef T*                                          iterator;
+    typedef const T*                                    const_iterator;
+    typedef mystl::reverse_iterator<iterator>           reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator>     const_reverse_iterator;
+    typedef Alloc                                       allocator_type;
+
+    // ============================================================================
+    // 构造函数和析构函数
+    // ============================================================================
+
+    /**
+     * @brief 默认构造函数
+     * 创建一个空的 small_vector，使用内联存储
+     */
+    small_vector() noexcept : begin_(inline_data()), end_(inline_data()), cap_(inline_data() + N) {}
+
+    /**
+     * @brief 指定分配器的构造函数
+     * @param alloc 分配器，元素超过 N 个后由它分配内存
+     */
+    explicit small_vector(const allocator_type& alloc) noexcept
+        : begin_(inline_data()), end_(inline_data()), cap_(inline_data() + N), allocator_(alloc) {}
+
+    /**
+     * @brief 指定大小的构造函数
+     * @param n 初始大小
+     * @param alloc 分配器
+     * 创建包含 n 个默认构造元素的 small_vector
+     */
+    explicit small_vector(size_type n, const allocator_type& alloc = allocator_type())
+        : small_vector(alloc) {
+        resize(n);
+    }
+
+    /**
+     * @brief 指定大小和值的构造函数
+     * @param n 初始大小
+     * @param value 初始值
+     * @param alloc 分配器
+     */
+    small_vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : small_vector(alloc) {
+        assign(n, value);
+    }
+
+    /**
+     * @brief 区间构造函数
+     * @param first 起始迭代器
+     * @param last 结束迭代器
+     * @param alloc 分配器
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    small_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+        : small_vector(alloc) {
+        assign(first, last);
+    }
+
+    /**
+     * @brief 初始化列表构造函数
+     * @param ilist 初始化列表
+     * @param alloc 分配器
+     */
+    small_vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : small_vector(alloc) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 拷贝构造函数
+     * @param other 要拷贝的 small_vector
+     * 元素不超过 N 个时副本使用内联存储
+     */
+    small_vector(const small_vector& other) : small_vector(other.allocator_) {
+        assign(other.begin_, other.end_);
+    }
+
+    /**
+     * @brief 移动构造函数
+     * @param other 要移动的 small_vector，之后为空
+     * other 在堆上时接管其缓冲区，否则逐个移动内联元素
+     */
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : small_vector(other.allocator_) {
+        steal(other);
+    }
+
+    /**
+     * @brief 析构函数
+     * 销毁所有元素，释放堆缓冲区
+     */
+    ~small_vector() {
+        mystl::destroy(begin_, end_);
+        release_heap();
+    }
+
+    /**
+     * @brief 拷贝赋值操作符
+     * 已有元素通过赋值复用，容量足够时不分配内存
+     */
+    small_vector& operator=(const small_vector& other) {
+        if (this != &other) {
+            assign(other.begin_, other.end_);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 移动赋值操作符
+     * @param other 要移动的 small_vector，之后为空
+     */
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            mystl::destroy(begin_, end_);
+            release_heap();
+            reset_inline();
+            allocator_ = other.allocator_;
+            steal(other);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    /**
+     * @brief 返回分配器的副本
+     */
+    allocator_type get_allocator() const noexcept { return allocator_; }
+
+    // ============================================================================
+    // 迭代器
+    // ============================================================================
+
+    iterator begin() noexcept { return begin_; }
+    const_iterator begin() const noexcept { return begin_; }
+    const_iterator cbegin() const noexcept { return begin_; }
+
+    iterator end() noexcept { return end_; }
+    const_iterator end() const noexcept { return end_; }
+    const_iterator cend() const noexcept { return end_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // ============================================================================
+    // 元素访问
+    // ============================================================================
+
+    reference operator[](size_type pos) { return begin_[pos]; }
+    const_reference operator[](size_type pos) const { return begin_[pos]; }
+
+    /**
+     * @brief 边界检查访问
+     * @throws std::out_of_range 如果 pos 超出范围
+     */
+    reference at(size_type pos) {
+        if (pos >= size()) {
+            throw std::out_of_range("small_vector::at: pos out of range");
+        }
+        return begin_[pos];
+    }
+
+    const_reference at(size_type pos) const {
+        if (pos >= size()) {
+            throw std::out_of_range("small_vector::at: pos out of range");
+        }
+        return begin_[pos];
+    }
+
+    reference front() { return *begin_; }
+    const_reference front() const { return *begin_; }
+    reference back() { return *(end_ - 1); }
+    const_reference back() const { return *(end_ - 1); }
+
+    pointer data() noexcept { return begin_; }
+    const_pointer data() const noexcept { return begin_; }
+
+    // ============================================================================
+    // 容量
+    // ============================================================================
+
+    size_type size() const noexcept { return static_cast<size_type>(end_ - begin_); }
+    size_type capacity() const noexcept { return static_cast<size_type>(cap_ - begin_); }
+    bool empty() const noexcept { return begin_ == end_; }
+
+    size_type max_size() const noexcept {
+        return static_cast<size_type>(mystl::numeric_limits<difference_type>::max()) / sizeof(value_type);
+    }
+
+    /**
+     * @brief 内联容量 N
+     */
+    static constexpr size_type inline_capacity() noexcept { return N; }
+
+    /**
+     * @brief 元素是否存放在对象内部
+     */
+    bool is_inline() const noexcept { return begin_ == inline_data(); }
+
+    void reserve(size_type new_cap) {
+        if (new_cap > capacity()) {
+            if (new_cap > max_size()) {
+                throw std::length_error("small_vector::reserve: too many elements");
+            }
+            reallocate(new_cap);
+        }
+    }
+
+    /**
+     * @brief 释放多余容量：元素不超过 N 个时搬回内联存储
+     */
+    void shrink_to_fit() {
+        if (is_inline()) {
+            return;
+        }
+        if (size() <= N) {
+            pointer old_begin = begin_;
+            const size_type old_capacity = capacity();
+            pointer new_end = mystl::uninitialized_relocate(begin_, end_, inline_data());
+            allocator_.deallocate(old_begin, old_capacity);
+            begin_ = inline_data();
+            end_ = new_end;
+            cap_ = inline_data() + N;
+        } else if (size() < capacity()) {
+            reallocate(size());
+        }
+    }
+
+    void resize(size_type count) {
+        if (count < size()) {
+            erase(begin_ + count, end_);
+        } else if (count > size()) {
+            if (count > capacity()) {
+                reallocate(next_capacity(count - size()));
+            }
+            for (; end_ != begin_ + count; ++end_) {
+                mystl::construct(end_);
+            }
+        }
+    }
+
+    void resize(size_type count, const value_type& value) {
+        if (count < size()) {
+            erase(begin_ + count, end_);
+        } else if (count > size()) {
+            insert(end_, count - size(), value);
+        }
+    }
+
+    /**
+     * @brief 清空元素，保留容量
+     */
+    void clear() noexcept {
+        mystl::destroy(begin_, end_);
+        end_ = begin_;
+    }
+
+    // ============================================================================
+    // 插入与删除
+    // ============================================================================
+
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
+
+    /**
+     * @brief 在末尾原地构造元素
+     * @param args 构造参数，可以引用自身的元素
+     * @return 新元素的引用
+     */
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (end_ == cap_) {
+            return grow_and_emplace_back(mystl::forward<Args>(args)...);
+        }
+        mystl::construct(end_, mystl::forward<Args>(args)...);
+        ++end_;
+        return *(end_ - 1);
+    }
+
+    void pop_back() {
+        if (end_ > begin_) {
+            --end_;
+            mystl::destroy(end_);
+        }
+    }
+
+    /**
+     * @brief 在 pos 处原地构造元素
+     * @return 指向新元素的迭代器
+     */
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const size_type offset = static_cast<size_type>(pos - begin_);
+        if (offset == size()) {
+            emplace_back(mystl::forward<Args>(args)...);
+            return begin_ + offset;
+        }
+        // 先构造临时对象：参数可能引用即将后移或被搬走的元素
+        value_type tmp(mystl::forward<Args>(args)...);
+        if (end_ == cap_) {
+            reallocate(next_capacity(1));
+        }
+        mystl::shift_insert(begin_ + offset, end_, std::make_move_iterator(&tmp), std::make_move_iterator(&tmp + 1), 1);
+        return begin_ + offset;
+    }
+
+    iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, mystl::move(value)); }
+
+    /**
+     * @brief 在 pos 处插入 n 个 value
+     * @return 指向第一个新元素的迭代器；n 为 0 时返回 pos
+     */
+    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        const size_type offset = static_cast<size_type>(pos - begin_);
+        if (n != 0) {
+            // value 可能引用自身的元素，扩容或后移前先拷贝一份
+            const value_type copy(value);
+            if (n > static_cast<size_type>(cap_ - end_)) {
+                reallocate(next_capacity(n));
+            }
+            mystl::shift_fill(begin_ + offset, end_, n, copy);
+        }
+        return begin_ + offset;
+    }
+
+    /**
+     * @brief 在 pos 处插入区间 [first, last)
+     * @return 指向第一个新元素的迭代器；区间为空时返回 pos
+     * 前向迭代器先求出区间长度，最多扩容一次。[first, last) 不能指向自身。
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        const size_type offset = static_cast<size_type>(pos - begin_);
+        range_insert(offset, first, last, typename mystl::iterator_traits<InputIt>::iterator_category());
+        return begin_ + offset;
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    /**
+     * @brief 删除 [first, last) 的元素，之后的元素一次性前移
+     * @return 指向被删区间之后元素的迭代器
+     */
+    iterator erase(const_iterator first, const_iterator last) {
+        pointer f = begin_ + (first - begin_);
+        mystl::shift_erase(f, begin_ + (last - begin_), end_);
+        return f;
+    }
+
+    /**
+     * @brief 把内容替换为 n 个 value
+     */
+    void assign(size_type n, const value_type& value) {
+        if (n > capacity()) {
+            const value_type copy(value);
+            clear();
+            reallocate(n);
+            end_ = mystl::uninitialized_fill_n(begin_, n, copy);
+        } else if (n > size()) {
+            std::fill(begin_, end_, value);
+            const size_type extra = n - size();
+            end_ = mystl::uninitialized_fill_n(end_, extra, value);
+        } else {
+            std::fill_n(begin_, n, value);
+            erase(begin_ + n, end_);
+        }
+    }
+
+    /**
+     * @brief 把内容替换为 [first, last)
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    void assign(InputIt first, InputIt last) {
+        range_assign(first, last, typename mystl::iterator_traits<InputIt>::iterator_category());
+    }
+
+    void assign(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 与 other 交换内容
+     *
+     * 双方都在堆上时只交换指针和分配器；一方内联时把它的元素搬进另一方的内联存储，
+     * 再把堆缓冲区转过来；双方都内联时交换公共部分，多出的元素搬到较短的一方。
+     */
+    void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this == &other) {
+            return;
+        }
+        if (!is_inline() && !other.is_inline()) {
+            pointer t;
+            t = begin_; begin_ = other.begin_; other.begin_ = t;
+            t = end_; end_ = other.end_; other.end_ = t;
+            t = cap_; cap_ = other.cap_; other.cap_ = t;
+        } else if (is_inline() && other.is_inline()) {
+            small_vector& shorter = size() < other.size() ? *this : other;
+            small_vector& longer = size() < other.size() ? other : *this;
+            pointer mid = longer.begin_ + shorter.size();
+            using mystl::swap;
+            for (pointer a = shorter.begin_, b = longer.begin_; a != shorter.end_; ++a, ++b) {
+                swap(*a, *b);
+            }
+            shorter.end_ = mystl::uninitialized_relocate(mid, longer.end_, shorter.end_);
+            longer.end_ = mid;
+        } else {
+            small_vector& inl = is_inline() ? *this : other;
+            small_vector& heap = is_inline() ? other : *this;
+            pointer heap_begin = heap.begin_;
+            pointer heap_end = heap.end_;
+            pointer heap_cap = heap.cap_;
+            heap.begin_ = heap.inline_data();
+            heap.cap_ = heap.inline_data() + N;
+            heap.end_ = mystl::uninitialized_relocate(inl.begin_, inl.end_, heap.begin_);
+            inl.begin_ = heap_begin;
+            inl.end_ = heap_end;
+            inl.cap_ = heap_cap;
+        }
+        allocator_type a = allocator_;
+        allocator_ = other.allocator_;
+        other.allocator_ = a;
+    }
+
+private:
+    pointer inline_data() noexcept { return reinterpret_cast<pointer>(&inline_); }
+    const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(&inline_); }
+
+    // 回到空的内联状态，调用前元素已析构、堆缓冲区已释放
+    void reset_inline() noexcept {
+        begin_ = end_ = inline_data();
+        cap_ = inline_data() + N;
+    }
+
+    // 释放堆缓冲区，不析构元素
+    void release_heap() noexcept {
+        if (!is_inline()) {
+            allocator_.deallocate(begin_, capacity());
+        }
+    }
+
+    /**
+     * @brief 接管 other 的元素，other 变为空的内联状态；调用前 *this 为空且处于内联状态
+     * other 在堆上时直接转移缓冲区，否则把内联元素逐个搬过来
+     */
+    void steal(small_vector& other) {
+        if (other.is_inline()) {
+            end_ = mystl::uninitialized_relocate(other.begin_, other.end_, begin_);
+            other.end_ = other.begin_;
+        } else {
+            begin_ = other.begin_;
+            end_ = other.end_;
+            cap_ = other.cap_;
+            other.reset_inline();
+        }
+    }
+
+    /**
+     * @brief 再容纳 n 个元素所需的新容量：容量翻倍，不足时取恰好够用的大小
+     * @throws std::length_error 如果元素个数超过 max_size()
+     */
+    size_type next_capacity(size_type n) const {
+        const size_type old_size = size();
+        if (n > max_size() - old_size) {
+            throw std::length_error("small_vector: capacity overflow");
+        }
+        const size_type doubled = capacity() > max_size() / 2 ? max_size() : capacity() * 2;
+        return doubled < old_size + n ? old_size + n : doubled;
+    }
+
+    /**
+     * @brief 把元素搬到容量为 new_capacity 的堆缓冲区，new_capacity 不小于 size()
+     * 搬移抛出异常时释放新缓冲区，原元素不变
+     */
+    void reallocate(size_type new_capacity) {
+        pointer new_begin = allocator_.allocate(new_capacity);
+        pointer new_end = new_begin;
+        try {
+            new_end = mystl::uninitialized_relocate(begin_, end_, new_begin);
+        } catch (...) {
+            allocator_.deallocate(new_begin, new_capacity);
+            throw;
+        }
+        release_heap();
+        begin_ = new_begin;
+        end_ = new_end;
+        cap_ = new_begin + new_capacity;
+    }
+
+    // 存储已满时在末尾构造：先在新缓冲区构造新元素，参数可能引用旧元素
+    template<typename... Args>
+    reference grow_and_emplace_back(Args&&... args) {
+        const size_type new_capacity = next_capacity(1);
+        pointer new_begin = allocator_.allocate(new_capacity);
+        pointer slot = new_begin + size();
+        bool constructed = false;
+        try {
+            mystl::construct(slot, mystl::forward<Args>(args)...);
+            constructed = true;
+            mystl::uninitialized_relocate(begin_, end_, new_begin);
+        } catch (...) {
+            if (constructed) {
+                mystl::destroy(slot);
+            }
+            allocator_.deallocate(new_begin, new_capacity);
+            throw;
+        }
+        release_heap();
+        begin_ = new_begin;
+        end_ = slot + 1;
+        cap_ = new_begin + new_capacity;
+        return *slot;
+    }
+
+    // 输入迭代器只能遍历一次：末尾直接逐个追加，否则先收集到临时对象再整体移入
+    template<typename InputIt>
+    void range_insert(size_type offset, InputIt first, InputIt last, input_iterator_tag) {
+        if (offset == size()) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            return;
+        }
+        small_vector tmp(allocator_);
+        for (; first != last; ++first) {
+            tmp.emplace_back(*first);
+        }
+        range_insert(offset, std::make_move_iterator(tmp.begin_), std::make_move_iterator(tmp.end_),
+                     forward_iterator_tag());
+    }
+
+    template<typename ForwardIt>
+    void range_insert(size_type offset, ForwardIt first, ForwardIt last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(mystl::distance(first, last));
+        if (n == 0) {
+            return;
+        }
+        if (n > static_cast<size_type>(cap_ - end_)) {
+            reallocate(next_capacity(n));
+        }
+        mystl::shift_insert(begin_ + offset, end_, first, last, n);
+    }
+
+    // 输入迭代器：先覆盖已有元素，多余的删除，不足的追加
+    template<typename InputIt>
+    void range_assign(InputIt first, InputIt last, input_iterator_tag) {
+        pointer cur = begin_;
+        for (; first != last && cur != end_; ++first, ++cur) {
+            *cur = *first;
+        }
+        if (first == last) {
+            erase(cur, end_);
+        } else {
+            range_insert(size(), first, last, input_iterator_tag());
+        }
+    }
+
+    // 前向迭代器：容量不足时清空后一次分配恰好 n 个元素
+    template<typename ForwardIt>
+    void range_assign(ForwardIt first, ForwardIt last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(mystl::distance(first, last));
+        if (n > capacity()) {
+            if (n > max_size()) {
+                throw std::length_error("small_vector::assign: too many elements");
+            }
+            clear();
+            reallocate(n);
+            end_ = mystl::uninitialized_copy(first, last, begin_);
+        } else if (n <= size()) {
+            pointer new_end = std::copy(first, last, begin_);
+            erase(new_end, end_);
+        } else {
+            ForwardIt mid = first;
+            mystl::advance(mid, size());
+            std::copy(first, mid, begin_);
+            end_ = mystl::uninitialized_copy(mid, last, end_);
+        }
+    }
+};
+
+template<typename T, size_t N, typename Alloc>
+inline void swap(small_vector<T, N, Alloc>& a, small_vector<T, N, Alloc>& b)
+    noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+} // namespace mystl
+
+#endif // MYTINYSTL_SMALL_VECTOR_H_
@@ -0,0 +1,535 @@
+#ifndef MYTINYSTL_STATIC_VECTOR_H_
+#define MYTINYSTL_STATIC_VECTOR_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <new>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#include "construct.h"
+#include "uninitialized.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace mystl {
+
+// ============================================================================
+// static_vector 的存储
+// ============================================================================
+//
+// 元素个数与 N 个元素的未初始化存储都在对象内部。元素可平凡拷贝时存储类不声明任何
+// 特殊成员函数，static_vector 因此也可平凡拷贝，可以直接 memcpy；否则逐个拷贝、移动和析构。
+// 只记录元素个数而不记录指向自身的指针，按字节搬移对象不会使其失效。
+
+template<typename T, size_t N, bool = std::is_trivially_copyable<T>::value>
+class static_vector_storage;
+
+template<typename T, size_t N>
+class static_vector_storage<T, N, true> {
+protected:
+    size_t size_;                                                            // 元素个数
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage_; // 元素存储
+
+    static_vector_storage() noexcept : size_(0) {}
+
+    T* storage() noexcept { return reinterpret_cast<T*>(&storage_); }
+    const T* storage() const noexcept { return reinterpret_cast<const T*>(&storage_); }
+};
+
+template<typename T, size_t N>
+class static_vector_storage<T, N, false> {
+protected:
+    size_t size_;                                                            // 元素个数
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage_; // 元素存储
+
+    static_vector_storage() noexcept : size_(0) {}
+
+    static_vector_storage(const static_vector_storage& other) : size_(0) {
+        mystl::uninitialized_copy(other.storage(), other.storage() + other.size_, storage());
+        size_ = other.size_;
+    }
+
+    // 被移动的对象保留同样个数的已移动元素
+    static_vector_storage(static_vector_storage&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : size_(0) {
+        mystl::uninitialized_move(other.storage(), other.storage() + other.size_, storage());
+        size_ = other.size_;
+    }
+
+    ~static_vector_storage() {
+        mystl::destroy(storage(), storage() + size_);
+    }
+
+    static_vector_storage& operator=(const static_vector_storage& other) {
+        if (this != &other) {
+            assign_elements(other.storage(), other.size_);
+        }
+        return *this;
+    }
+
+    static_vector_storage& operator=(static_vector_storage&& other) noexcept(
+        std::is_nothrow_move_assignable<T>::value && std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            assign_elements(std::make_move_iterator(other.storage()), other.size_);
+        }
+        return *this;
+    }
+
+    T* storage() noexcept { return reinterpret_cast<T*>(&storage_); }
+    const T* storage() const noexcept { return reinterpret_cast<const T*>(&storage_); }
+
+private:
+    // 已有元素通过赋值复用，多出的构造，不足的析构
+    template<typename InputIt>
+    void assign_elements(InputIt src, size_t n) {
+        T* p = storage();
+        const size_t common = n < size_ ? n : size_;
+        for (size_t i = 0; i < common; ++i, ++src) {
+            p[i] = *src;
+        }
+        for (; size_ < n; ++size_, ++src) {
+            mystl::construct(p + size_, *src);
+        }
+        mystl::destroy(p + n, p + size_);
+        if (n < size_) {
+            size_ = n;
+        }
+    }
+};
+
+// ============================================================================
+// static_vector
+// ============================================================================
+
+/**
+ * @brief 固定容量、从不分配内存的动态数组
+ * @tparam T 元素类型
+ * @tparam N 容量，元素存放在对象内部
+ *
+ * 接口与 vector 相同，迭代器为指针，可直接用于 mystl 的算法。容量在编译期确定：
+ * 超过 N 个元素的插入、构造和 reserve 抛出 std::bad_alloc，不修改容器；
+ * try_push_back / try_emplace_back 在已满时返回 nullptr，供不使用异常的实时路径调用。
+ * T 可平凡拷贝时 static_vector 本身也可平凡拷贝。
+ */
+template<typename T, size_t N>
+class static_vector : private static_vector_storage<T, N> {
+    static_assert(N > 0, "static_vector: 容量必须大于 0");
+
+    typedef static_vector_storage<T, N> storage_type;
+    using storage_type::size_;
+    using storage_type::storage;
+
+public:
+    // ============================================================================
+    // 类型定义
+    // ============================================================================
+
+    typedef T                                           value_type;
+    typedef T*                                          pointer;
+    typedef const T*                                    const_pointer;
+    typedef T&                                          reference;
+    typedef const T&                                    const_reference;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
+    typedef T*                                          iterator;
+    typedef const T*                                    const_iterator;
+    typedef mystl::reverse_iterator<iterator>           reverse_iterator;
+    typedef mystl::reverse_iterator<const_iterator>     const_reverse_iterator;
+
+    // ============================================================================
+    // 构造函数
+    // ============================================================================
+    //
+    // 拷贝、移动与析构由存储类提供
+
+    /**
+     * @brief 默认构造函数，创建空的 static_vector
+     */
+    static_vector() noexcept {}
+
+    /**
+     * @brief 指定大小的构造函数
+     * @param n 初始大小
+     * @throws std::bad_alloc 如果 n 超过 N
+     */
+    explicit static_vector(size_type n) {
+        resize(n);
+    }
+
+    /**
+     * @brief 指定大小和值的构造函数
+     * @param n 初始大小
+     * @param value 初始值
+     * @throws std::bad_alloc 如果 n 超过 N
+     */
+    static_vector(size_type n, const value_type& value) {
+        assign(n, value);
+    }
+
+    /**
+     * @brief 区间构造函数
+     * @throws std::bad_alloc 如果区间长度超过 N
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    static_vector(InputIt first, InputIt last) {
+        assign(first, last);
+    }
+
+    static_vector(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    static_vector& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // ============================================================================
+    // 迭代器
+    // ============================================================================
+
+    iterator begin() noexcept { return storage(); }
+    const_iterator begin() const noexcept { return storage(); }
+    const_iterator cbegin() const noexcept { return storage(); }
+
+    iterator end() noexcept { return storage() + size_; }
+    const_iterator end() const noexcept { return storage() + size_; }
+    const_iterator cend() const noexcept { return storage() + size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // ============================================================================
+    // 元素访问
+    // ============================================================================
+
+    reference operator[](size_type pos) { return storage()[pos]; }
+    const_reference operator[](size_type pos) const { return storage()[pos]; }
+
+    /**
+     * @brief 边界检查访问
+     * @throws std::out_of_range 如果 pos 超出范围
+     */
+    reference at(size_type pos) {
+        if (pos >= size_) {
+            throw std::out_of_range("static_vector::at: pos out of range");
+        }
+        return storage()[pos];
+    }
+
+    const_reference at(size_type pos) const {
+        if (pos >= size_) {
+            throw std::out_of_range("static_vector::at: pos out of range");
+        }
+        return storage()[pos];
+    }
+
+    reference front() { return storage()[0]; }
+    const_reference front() const { return storage()[0]; }
+    reference back() { return storage()[size_ - 1]; }
+    const_reference back() const { return storage()[size_ - 1]; }
+
+    pointer data() noexcept { return storage(); }
+    const_pointer data() const noexcept { return storage(); }
+
+    // ============================================================================
+    // 容量
+    // ============================================================================
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return size_ == N; }
+    static constexpr size_type capacity() noexcept { return N; }
+    static constexpr size_type max_size() noexcept { return N; }
+
+    /**
+     * @brief 容量固定，只检查 n 不超过 N
+     * @throws std::bad_alloc 如果 n 超过 N
+     */
+    void reserve(size_type n) {
+        check_room(n, 0);
+    }
+
+    void shrink_to_fit() noexcept {}
+
+    void resize(size_type count) {
+        if (count < size_) {
+            erase(begin() + count, end());
+        } else if (count > size_) {
+            check_room(count, 0);
+            for (; size_ != count; ++size_) {
+                mystl::construct(storage() + size_);
+            }
+        }
+    }
+
+    void resize(size_type count, const value_type& value) {
+        if (count < size_) {
+            erase(begin() + count, end());
+        } else if (count > size_) {
+            insert(end(), count - size_, value);
+        }
+    }
+
+    void clear() noexcept {
+        mystl::destroy(storage(), storage() + size_);
+        size_ = 0;
+    }
+
+    // ============================================================================
+    // 插入与删除
+    // ============================================================================
+
+    void push_back(const value_type& value) { emplace_back(value); }
+    void push_back(value_type&& value) { emplace_back(mystl::move(value)); }
+
+    /**
+     * @brief 在末尾原地构造元素
+     * @return 新元素的引用
+     * @throws std::bad_alloc 如果已满
+     */
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        check_room(size_, 1);
+        return unchecked_emplace_back(mystl::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 未满时在末尾原地构造元素
+     * @return 指向新元素的指针；已满时返回 nullptr，不构造元素
+     */
+    template<typename... Args>
+    pointer try_emplace_back(Args&&... args) {
+        if (size_ == N) {
+            return nullptr;
+        }
+        return &unchecked_emplace_back(mystl::forward<Args>(args)...);
+    }
+
+    pointer try_push_back(const value_type& value) { return try_emplace_back(value); }
+    pointer try_push_back(value_type&& value) { return try_emplace_back(mystl::move(value)); }
+
+    void pop_back() {
+        if (size_ > 0) {
+            --size_;
+            mystl::destroy(storage() + size_);
+        }
+    }
+
+    /**
+     * @brief 在 pos 处原地构造元素
+     * @return 指向新元素的迭代器
+     * @throws std::bad_alloc 如果已满
+     */
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const size_type offset = static_cast<size_type>(pos - begin());
+        check_room(size_, 1);
+        if (offset == size_) {
+            unchecked_emplace_back(mystl::forward<Args>(args)...);
+        } else {
+            // 先构造临时对象：参数可能引用即将后移的元素
+            value_type tmp(mystl::forward<Args>(args)...);
+            end_sync e(*this);
+            mystl::shift_insert(begin() + offset, e.end, std::make_move_iterator(&tmp),
+                                std::make_move_iterator(&tmp + 1), 1);
+        }
+        return begin() + offset;
+    }
+
+    iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, mystl::move(value)); }
+
+    /**
+     * @brief 在 pos 处插入 n 个 value
+     * @return 指向第一个新元素的迭代器；n 为 0 时返回 pos
+     * @throws std::bad_alloc 如果插入后超过 N 个元素
+     */
+    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        const size_type offset = static_cast<size_type>(pos - begin());
+        if (n != 0) {
+            check_room(size_, n);
+            // value 可能引用自身的元素，后移前先拷贝一份
+            const value_type copy(value);
+            end_sync e(*this);
+            mystl::shift_fill(begin() + offset, e.end, n, copy);
+        }
+        return begin() + offset;
+    }
+
+    /**
+     * @brief 在 pos 处插入区间 [first, last)
+     * @return 指向第一个新元素的迭代器；区间为空时返回 pos
+     * @throws std::bad_alloc 如果插入后超过 N 个元素；前向迭代器在修改前检查，
+     *         输入迭代器在末尾逐个追加，超出时已追加的元素保留
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        const size_type offset = static_cast<size_type>(pos - begin());
+        range_insert(offset, first, last, typename mystl::iterator_traits<InputIt>::iterator_category());
+        return begin() + offset;
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    /**
+     * @brief 删除 [first, last) 的元素，之后的元素一次性前移
+     * @return 指向被删区间之后元素的迭代器
+     */
+    iterator erase(const_iterator first, const_iterator last) {
+        pointer f = begin() + (first - begin());
+        end_sync e(*this);
+        mystl::shift_erase(f, begin() + (last - begin()), e.end);
+        return f;
+    }
+
+    /**
+     * @brief 把内容替换为 n 个 value
+     * @throws std::bad_alloc 如果 n 超过 N，不修改容器
+     */
+    void assign(size_type n, const value_type& value) {
+        check_room(n, 0);
+        if (n > size_) {
+            std::fill(begin(), end(), value);
+            for (; size_ != n; ++size_) {
+                mystl::construct(storage() + size_, value);
+            }
+        } else {
+            std::fill_n(begin(), n, value);
+            erase(begin() + n, end());
+        }
+    }
+
+    /**
+     * @brief 把内容替换为 [first, last)
+     * @throws std::bad_alloc 如果区间长度超过 N
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    void assign(InputIt first, InputIt last) {
+        range_assign(first, last, typename mystl::iterator_traits<InputIt>::iterator_category());
+    }
+
+    void assign(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 与 other 交换内容：交换公共部分，多出的元素搬到较短的一方
+     */
+    void swap(static_vector& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        static_vector& shorter = size_ < other.size_ ? *this : other;
+        static_vector& longer = size_ < other.size_ ? other : *this;
+        using mystl::swap;
+        for (size_type i = 0; i < shorter.size_; ++i) {
+            swap(shorter[i], longer[i]);
+        }
+        pointer mid = longer.begin() + shorter.size_;
+        mystl::uninitialized_relocate(mid, longer.end(), shorter.end());
+        shorter.size_ = longer.size_;
+        longer.size_ = static_cast<size_type>(mid - longer.begin());
+    }
+
+private:
+    // shift_* 以尾指针的引用推进，离开作用域时（包括抛出异常）把结果写回元素个数
+    struct end_sync {
+        static_vector& self;
+        pointer end;
+
+        explicit end_sync(static_vector& v) noexcept : self(v), end(v.storage() + v.size_) {}
+        ~end_sync() { self.size_ = static_cast<size_type>(end - self.storage()); }
+    };
+
+    // 已有 size 个元素时再放入 n 个，超过 N 时抛出 std::bad_alloc
+    static void check_room(size_type size, size_type n) {
+        if (size > N || n > N - size) {
+            throw std::bad_alloc();
+        }
+    }
+
+    template<typename... Args>
+    reference unchecked_emplace_back(Args&&... args) {
+        pointer p = storage() + size_;
+        mystl::construct(p, mystl::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    // 输入迭代器只能遍历一次：末尾直接逐个追加，否则先收集到临时对象再整体移入
+    template<typename InputIt>
+    void range_insert(size_type offset, InputIt first, InputIt last, input_iterator_tag) {
+        if (offset == size_) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            return;
+        }
+        static_vector tmp(first, last);
+        range_insert(offset, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()),
+                     forward_iterator_tag());
+    }
+
+    template<typename ForwardIt>
+    void range_insert(size_type offset, ForwardIt first, ForwardIt last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(mystl::distance(first, last));
+        if (n == 0) {
+            return;
+        }
+        check_room(size_, n);
+        end_sync e(*this);
+        mystl::shift_insert(begin() + offset, e.end, first, last, n);
+    }
+
+    // 输入迭代器：先覆盖已有元素，多余的删除，不足的追加
+    template<typename InputIt>
+    void range_assign(InputIt first, InputIt last, input_iterator_tag) {
+        pointer cur = begin();
+        for (; first != last && cur != end(); ++first, ++cur) {
+            *cur = *first;
+        }
+        if (first == last) {
+            erase(cur, end());
+        } else {
+            range_insert(size_, first, last, input_iterator_tag());
+        }
+    }
+
+    template<typename ForwardIt>
+    void range_assign(ForwardIt first, ForwardIt last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(mystl::distance(first, last));
+        check_room(n, 0);
+        if (n <= size_) {
+            pointer new_end = std::copy(first, last, begin());
+            erase(new_end, end());
+        } else {
+            ForwardIt mid = first;
+            mystl::advance(mid, size_);
+            std::copy(first, mid, begin());
+            end_sync e(*this);
+            e.end = mystl::uninitialized_copy(mid, last, e.end);
+        }
+    }
+};
+
+template<typename T, size_t N>
+inline void swap(static_vector<T, N>& a, static_vector<T, N>& b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+// 元素存放在对象内部且不记录指向自身的指针，元素可平凡重定位时 static_vector 也可以
+template<typename T, size_t N>
+struct is_trivially_relocatable<static_vector<T, N>> : is_trivially_relocatable<T> {};
+
+} // namespace mystl
+
+#endif // MYTINYSTL_STATIC_VECTOR_H_
@@ -0,0 +1,305 @@
+// mystl::alloc 线程缓存内存池的正确性与多线程扩展性测试，与 mystl::allocator、glibc malloc 对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_alloc_scaling_performance.cpp -o test_alloc_scaling_performance
+// 运行：./test_alloc_scaling_performance [每线程操作数，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <list>
+#include <deque>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "memory.h"
+
+// ============================================================================
+// 工具
+// ============================================================================
+
+// 链表节点等小对象的典型大小
+static const size_t kSizes[] = {8, 16, 24, 32, 40, 48, 64, 96, 128};
+static const size_t kSizeCount = sizeof(kSizes) / sizeof(kSizes[0]);
+
+struct block {
+    unsigned char* p;
+    size_t         size;
+    unsigned char  tag;
+};
+
+void fill_block(block& b) {
+    std::memset(b.p, b.tag, b.size);
+}
+
+bool check_block(const block& b) {
+    for (size_t i = 0; i < b.size; ++i) {
+        if (b.p[i] != b.tag) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+// 每个线程维护一个存活窗口，随机释放再分配；写入的内容在释放前必须完好，
+// 若两个存活块重叠或被其他线程重复分配，内容就会被覆盖
+bool churn_worker(unsigned seed, size_t ops) {
+    std::mt19937 gen(seed);
+    std::vector<block> live(256);
+    for (auto& b : live) {
+        b.size = kSizes[gen() % kSizeCount];
+        b.tag = static_cast<unsigned char>(gen());
+        b.p = static_cast<unsigned char*>(mystl::alloc::allocate(b.size));
+        fill_block(b);
+    }
+    bool ok = true;
+    for (size_t i = 0; i < ops; ++i) {
+        block& b = live[gen() % live.size()];
+        if (!check_block(b)) ok = false;
+        mystl::alloc::deallocate(b.p, b.size);
+        b.size = kSizes[gen() % kSizeCount];
+        b.tag = static_cast<unsigned char>(gen());
+        b.p = static_cast<unsigned char*>(mystl::alloc::allocate(b.size));
+        fill_block(b);
+    }
+    for (auto& b : live) {
+        if (!check_block(b)) ok = false;
+        mystl::alloc::deallocate(b.p, b.size);
+    }
+    return ok;
+}
+
+bool test_concurrent_churn() {
+    const int threads = 8;
+    std::vector<std::thread> workers;
+    std::vector<int> results(threads, 0);
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([t, &results] { results[t] = churn_worker(100 + t, 200000) ? 1 : 0; }));
+    }
+    for (auto& w : workers) w.join();
+    for (int r : results) {
+        if (!r) return false;
+    }
+    return true;
+}
+
+// 生产者分配、消费者释放：对象经消费者的线程缓存回到中心池，再被生产者复用
+bool test_cross_thread_free() {
+    const size_t rounds = 20;
+    const size_t per_round = 20000;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<block> queue;
+    bool done = false;
+    bool ok = true;
+
+    size_t heap_after_first = 0;
+    std::thread consumer([&] {
+        for (;;) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return done || !queue.empty(); });
+            if (queue.empty()) return;
+            block b = queue.front();
+            queue.pop_front();
+            lock.unlock();
+            if (!check_block(b)) ok = false;
+            mystl::alloc::deallocate(b.p, b.size);
+            lock.lock();
+            if (queue.empty()) cv.notify_all();
+        }
+    });
+    std::thread producer([&] {
+        std::mt19937 gen(42);
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < per_round; ++i) {
+                block b;
+                b.size = kSizes[gen() % kSizeCount];
+                b.tag = static_cast<unsigned char>(gen());
+                b.p = static_cast<unsigned char*>(mystl::alloc::allocate(b.size));
+                fill_block(b);
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(b);
+                cv.notify_all();
+            }
+            // 等消费者释放完本轮对象再开始下一轮
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return queue.empty(); });
+            if (r == 0) heap_after_first = mystl::alloc::get_heap_size();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cv.notify_all();
+    });
+    producer.join();
+    consumer.join();
+
+    // 若释放的对象不能回到生产者手中，每一轮都要申请新内存，堆会增长约 rounds 倍
+    const size_t heap_final = mystl::alloc::get_heap_size();
+    if (heap_final > heap_after_first * 8) {
+        std::cout << "跨线程释放的对象未被复用: " << heap_after_first << " -> " << heap_final << std::endl;
+        return false;
+    }
+    return ok;
+}
+
+// 线程退出时，缓存的对象应归还中心池
+bool test_thread_exit_flush() {
+    const size_t n = 1000;
+    const size_t size = 72;
+    std::thread([=] {
+        std::vector<void*> ptrs(n);
+        for (auto& p : ptrs) p = mystl::alloc::allocate(size);
+        for (auto p : ptrs) mystl::alloc::deallocate(p, size);
+    }).join();
+    mystl::alloc::flush_thread_cache();
+    return mystl::alloc::get_free_list_size(size / mystl::ALIGN - 1) >= n;
+}
+
+int test_correctness() {
+    if (!churn_worker(1, 100000)) {
+        std::cout << "单线程分配内容被覆盖" << std::endl;
+        return 1;
+    }
+    if (!test_concurrent_churn()) {
+        std::cout << "多线程分配内容被覆盖" << std::endl;
+        return 2;
+    }
+    if (!test_cross_thread_free()) {
+        std::cout << "跨线程释放错误" << std::endl;
+        return 3;
+    }
+    if (!test_thread_exit_flush()) {
+        std::cout << "线程退出时未归还缓存" << std::endl;
+        return 4;
+    }
+
+    // pool_allocator 作为标准容器的分配器，多线程各自构建链表
+    std::vector<std::thread> workers;
+    std::vector<long> sums(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        workers.push_back(std::thread([t, &sums] {
+            std::list<long, mystl::pool_allocator<long>> l;
+            for (long i = 0; i < 100000; ++i) l.push_back(i);
+            for (int k = 0; k < 5; ++k) {
+                l.pop_front();
+                l.push_back(k);
+            }
+            for (long x : l) sums[t] += x;
+        }));
+    }
+    for (auto& w : workers) w.join();
+    const long expect = 99999L * 100000 / 2;   // 弹出的 0..4 又被追加回去
+    for (long s : sums) {
+        if (s != expect) {
+            std::cout << "pool_allocator 链表结果错误" << std::endl;
+            return 5;
+        }
+    }
+
+    // 0 字节与大块内存
+    void* z = mystl::alloc::allocate(0);
+    void* big = mystl::alloc::allocate(4096);
+    if (z == nullptr || big == nullptr) return 6;
+    mystl::alloc::deallocate(z, 0);
+    mystl::alloc::deallocate(big, 4096);
+    return 0;
+}
+
+// ============================================================================
+// 扩展性测试
+// ============================================================================
+
+struct pool_backend {
+    static void* allocate(size_t n) { return mystl::alloc::allocate(n); }
+    static void deallocate(void* p, size_t n) { mystl::alloc::deallocate(p, n); }
+};
+
+struct mystl_allocator_backend {
+    static void* allocate(size_t n) { return mystl::allocator<char>().allocate(n); }
+    static void deallocate(void* p, size_t n) { mystl::allocator<char>().deallocate(static_cast<char*>(p), n); }
+};
+
+struct malloc_backend {
+    static void* allocate(size_t n) { return std::malloc(n); }
+    static void deallocate(void* p, size_t) { std::free(p); }
+};
+
+std::atomic<uintptr_t> g_sink(0);
+
+// 模拟链表节点的增删：存活窗口中随机释放一个再分配一个
+template <class Backend>
+void bench_worker(unsigned seed, size_t ops) {
+    const size_t window = 1024;
+    std::vector<void*> live(window);
+    std::vector<size_t> sizes(window);
+    uint32_t x = seed | 1;
+    auto next = [&x] {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    };
+    for (size_t i = 0; i < window; ++i) {
+        sizes[i] = kSizes[next() % kSizeCount];
+        live[i] = Backend::allocate(sizes[i]);
+    }
+    uintptr_t acc = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        const size_t k = next() % window;
+        Backend::deallocate(live[k], sizes[k]);
+        sizes[k] = kSizes[next() % kSizeCount];
+        live[k] = Backend::allocate(sizes[k]);
+        *static_cast<char*>(live[k]) = static_cast<char>(i);
+        acc += reinterpret_cast<uintptr_t>(live[k]);
+    }
+    for (size_t i = 0; i < window; ++i) Backend::deallocate(live[i], sizes[i]);
+    g_sink.fetch_add(acc, std::memory_order_relaxed);
+}
+
+// 返回吞吐量（百万次分配+释放 / 秒）
+template <class Backend>
+double bench_threads(size_t threads, size_t ops_per_thread) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.push_back(std::thread(bench_worker<Backend>, static_cast<unsigned>(t + 1), ops_per_thread));
+    }
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return seconds > 0 ? threads * ops_per_thread / seconds / 1e6 : 0.0;
+}
+
+void run_benchmark(size_t ops_per_thread) {
+    std::cout << "\n=== 多线程小对象分配吞吐量（每线程 " << ops_per_thread << " 次分配+释放，硬件线程 "
+              << std::thread::hardware_concurrency() << "，单位：百万次/秒）===" << std::endl;
+    std::cout << std::left << std::setw(10) << "线程数" << std::setw(16) << "mystl::alloc" << std::setw(20)
+              << "mystl::allocator" << std::setw(14) << "malloc" << "alloc/malloc" << std::endl;
+    const size_t thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+    for (size_t threads : thread_counts) {
+        const double pool = bench_threads<pool_backend>(threads, ops_per_thread);
+        const double std_alloc = bench_threads<mystl_allocator_backend>(threads, ops_per_thread);
+        const double libc = bench_threads<malloc_backend>(threads, ops_per_thread);
+        std::cout << std::left << std::setw(10) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(16) << pool << std::setw(20) << std_alloc << std::setw(14) << libc
+                  << (libc > 0 ? pool / libc : 0.0) << "x" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t ops = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_alloc_scaling_performance: 正确性测试通过" << std::endl;
+
+    run_benchmark(ops);
+    return 0;
+}
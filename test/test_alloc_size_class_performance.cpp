@@ -0,0 +1,239 @@
+// mystl::alloc 多级大小类（8B 到 32KB）的正确性测试与混合大小负载性能测试，与 glibc malloc 对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_alloc_size_class_performance.cpp -o test_alloc_size_class_performance
+// 运行：./test_alloc_size_class_performance [每线程操作数，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "memory.h"
+
+using mystl::alloc;
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+// 大小类表：严格递增，每个字节数落在能容纳它的最小大小类，内部碎片不超过 25%
+bool check_size_classes() {
+    for (size_t i = 1; i < mystl::NFREELISTS; ++i) {
+        if (alloc::class_size(i) <= alloc::class_size(i - 1)) return false;
+    }
+    if (alloc::class_size(mystl::NFREELISTS - 1) != mystl::MAX_BYTES) return false;
+    for (size_t bytes = 1; bytes <= mystl::MAX_BYTES; ++bytes) {
+        const size_t c = alloc::size_class(bytes);
+        const size_t size = alloc::class_size(c);
+        if (size < bytes || (c > 0 && alloc::class_size(c - 1) >= bytes)) return false;
+        if (bytes > mystl::SMALL_MAX_BYTES && (size - bytes) * 4 > bytes) return false;
+    }
+    return true;
+}
+
+// 每种大小都分配一批，写满后检查内容，确认对象互不重叠且对齐
+bool check_all_sizes() {
+    std::vector<std::pair<unsigned char*, size_t>> blocks;
+    for (size_t bytes = 1; bytes <= mystl::MAX_BYTES + 1000; bytes += (bytes < 512 ? 1 : 97)) {
+        for (int k = 0; k < 3; ++k) {
+            auto p = static_cast<unsigned char*>(alloc::allocate(bytes));
+            if (reinterpret_cast<uintptr_t>(p) % mystl::ALIGN != 0) return false;
+            std::memset(p, static_cast<int>(blocks.size() & 0xff), bytes);
+            blocks.push_back(std::make_pair(p, bytes));
+        }
+    }
+    bool ok = true;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        for (size_t j = 0; j < blocks[i].second; ++j) {
+            if (blocks[i].first[j] != static_cast<unsigned char>(i & 0xff)) ok = false;
+        }
+        alloc::deallocate(blocks[i].first, blocks[i].second);
+    }
+    return ok;
+}
+
+// 混合大小随机增删，多线程并发，释放前校验内容
+bool mixed_churn(unsigned seed, size_t ops) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> lg(3.0, 15.0);
+    struct block {
+        unsigned char* p;
+        size_t         size;
+        unsigned char  tag;
+    };
+    std::vector<block> live(128);
+    auto fresh = [&](block& b) {
+        b.size = static_cast<size_t>(std::pow(2.0, lg(gen)));
+        b.tag = static_cast<unsigned char>(gen());
+        b.p = static_cast<unsigned char*>(alloc::allocate(b.size));
+        std::memset(b.p, b.tag, b.size);
+    };
+    auto intact = [](const block& b) {
+        for (size_t i = 0; i < b.size; ++i) {
+            if (b.p[i] != b.tag) return false;
+        }
+        return true;
+    };
+    for (auto& b : live) fresh(b);
+    bool ok = true;
+    for (size_t i = 0; i < ops; ++i) {
+        block& b = live[gen() % live.size()];
+        if (!intact(b)) ok = false;
+        alloc::deallocate(b.p, b.size);
+        fresh(b);
+    }
+    for (auto& b : live) {
+        if (!intact(b)) ok = false;
+        alloc::deallocate(b.p, b.size);
+    }
+    return ok;
+}
+
+int test_correctness() {
+    if (!check_size_classes()) {
+        std::cout << "大小类表错误" << std::endl;
+        return 1;
+    }
+    if (!check_all_sizes()) {
+        std::cout << "各大小分配内容被覆盖或未对齐" << std::endl;
+        return 2;
+    }
+
+    std::vector<std::thread> workers;
+    std::vector<int> results(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        workers.push_back(std::thread([t, &results] { results[t] = mixed_churn(10 + t, 50000) ? 1 : 0; }));
+    }
+    for (auto& w : workers) w.join();
+    for (int r : results) {
+        if (!r) {
+            std::cout << "多线程混合大小分配内容被覆盖" << std::endl;
+            return 3;
+        }
+    }
+
+    // 同一大小类内 reallocate 原地完成，跨大小类保留内容
+    auto p = static_cast<char*>(alloc::allocate(300));
+    std::memset(p, 'x', 300);
+    if (alloc::reallocate(p, 300, 310) != p) {
+        std::cout << "同一大小类 reallocate 未原地完成" << std::endl;
+        return 4;
+    }
+    auto q = static_cast<char*>(alloc::reallocate(p, 310, 5000));
+    for (int i = 0; i < 300; ++i) {
+        if (q[i] != 'x') return 4;
+    }
+    alloc::deallocate(q, 5000);
+
+    // 每个用到的大小类都有自己的板
+    if (alloc::get_slab_count(alloc::size_class(300)) == 0 ||
+        alloc::get_slab_count(alloc::size_class(32768)) == 0) {
+        std::cout << "板计数错误" << std::endl;
+        return 5;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 混合大小负载性能测试
+// ============================================================================
+
+struct workload {
+    const char* name;
+    double      lg_min;   // 大小按对数均匀分布于 [2^lg_min, 2^lg_max)
+    double      lg_max;
+};
+
+struct pool_backend {
+    static void* allocate(size_t n) { return alloc::allocate(n); }
+    static void deallocate(void* p, size_t n) { alloc::deallocate(p, n); }
+};
+
+struct malloc_backend {
+    static void* allocate(size_t n) { return std::malloc(n); }
+    static void deallocate(void* p, size_t) { std::free(p); }
+};
+
+std::atomic<uintptr_t> g_sink(0);
+
+// 预先生成大小序列，计时只包含分配与释放
+template <class Backend>
+void bench_worker(const std::vector<size_t>* sizes, size_t ops) {
+    const size_t window = 512;
+    std::vector<void*> live(window);
+    std::vector<size_t> live_size(window);
+    const size_t m = sizes->size();
+    for (size_t i = 0; i < window; ++i) {
+        live_size[i] = (*sizes)[i % m];
+        live[i] = Backend::allocate(live_size[i]);
+    }
+    uintptr_t acc = 0;
+    for (size_t i = 0; i < ops; ++i) {
+        const size_t k = (i * 7919) % window;
+        Backend::deallocate(live[k], live_size[k]);
+        live_size[k] = (*sizes)[i % m];
+        live[k] = Backend::allocate(live_size[k]);
+        *static_cast<char*>(live[k]) = static_cast<char>(i);
+        acc += reinterpret_cast<uintptr_t>(live[k]);
+    }
+    for (size_t i = 0; i < window; ++i) Backend::deallocate(live[i], live_size[i]);
+    g_sink.fetch_add(acc, std::memory_order_relaxed);
+}
+
+template <class Backend>
+double bench(const std::vector<size_t>& sizes, size_t threads, size_t ops) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.push_back(std::thread(bench_worker<Backend>, &sizes, ops));
+    }
+    for (auto& w : workers) w.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return seconds > 0 ? threads * ops / seconds / 1e6 : 0.0;
+}
+
+void run_benchmark(size_t ops) {
+    const workload workloads[] = {
+        {"小对象 8B-128B", 3.0, 7.0},
+        {"中等 128B-4KB", 7.0, 12.0},
+        {"deque 块 256B-4KB", 8.0, 12.0},
+        {"大对象 4KB-32KB", 12.0, 15.0},
+        {"混合 8B-32KB", 3.0, 15.0},
+    };
+    std::cout << "\n=== 混合大小分配吞吐量（每线程 " << ops << " 次分配+释放，单位：百万次/秒）===" << std::endl;
+    std::cout << std::left << std::setw(24) << "负载" << std::setw(8) << "线程" << std::setw(14) << "mystl::alloc"
+              << std::setw(14) << "malloc" << "alloc/malloc" << std::endl;
+    for (const workload& w : workloads) {
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<double> lg(w.lg_min, w.lg_max);
+        std::vector<size_t> sizes(4096);
+        for (auto& s : sizes) s = static_cast<size_t>(std::pow(2.0, lg(gen)));
+        const size_t thread_counts[] = {1, 4};
+        for (size_t threads : thread_counts) {
+            const double pool = bench<pool_backend>(sizes, threads, ops);
+            const double libc = bench<malloc_backend>(sizes, threads, ops);
+            std::cout << std::left << std::setw(24) << w.name << std::setw(8) << threads << std::fixed
+                      << std::setprecision(2) << std::setw(14) << pool << std::setw(14) << libc
+                      << (libc > 0 ? pool / libc : 0.0) << "x" << std::endl;
+        }
+    }
+    std::cout << "内存池堆大小: " << alloc::get_heap_size() / 1024 << " KB" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t ops = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_alloc_size_class_performance: 正确性测试通过" << std::endl;
+
+    run_benchmark(ops);
+    return 0;
+}
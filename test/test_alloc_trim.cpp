@@ -0,0 +1,258 @@
+// mystl::alloc 内存归还测试：trim、自动阈值、后台衰减，以及常驻内存与在用内存统计
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_alloc_trim.cpp -o test_alloc_trim
+// 运行：./test_alloc_trim [突发分配的对象数，默认 400000，至少 100000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "memory.h"
+
+using mystl::alloc;
+
+// ============================================================================
+// 工具
+// ============================================================================
+
+struct burst {
+    std::vector<char*>  ptrs;
+    std::vector<size_t> sizes;
+};
+
+// 模拟一次链表节点的突发分配：以小对象为主，夹杂 deque 块大小的对象
+burst allocate_burst(size_t n) {
+    burst b;
+    b.ptrs.reserve(n);
+    b.sizes.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t size = i % 16 == 0 ? 1024 : 48;
+        char* p = static_cast<char*>(alloc::allocate(size));
+        std::memset(p, static_cast<int>(i & 0x7f), size);
+        b.ptrs.push_back(p);
+        b.sizes.push_back(size);
+    }
+    return b;
+}
+
+// 释放除每 keep_every 个之外的全部对象，保留的对象留在 b 中
+void free_burst(burst& b, size_t keep_every) {
+    burst kept;
+    for (size_t i = 0; i < b.ptrs.size(); ++i) {
+        if (keep_every != 0 && i % keep_every == 0) {
+            kept.ptrs.push_back(b.ptrs[i]);
+            kept.sizes.push_back(b.sizes[i]);
+        } else {
+            alloc::deallocate(b.ptrs[i], b.sizes[i]);
+        }
+    }
+    b = kept;
+}
+
+bool intact(const burst& b, size_t keep_every) {
+    for (size_t k = 0; k < b.ptrs.size(); ++k) {
+        const size_t i = k * keep_every;
+        for (size_t j = 0; j < b.sizes[k]; ++j) {
+            if (b.ptrs[k][j] != static_cast<char>(i & 0x7f)) return false;
+        }
+    }
+    return true;
+}
+
+void print_stats(const char* stage) {
+    const mystl::alloc_stats s = alloc::get_stats();
+    std::cout << std::left << std::setw(26) << stage << std::fixed << std::setprecision(1)
+              << std::setw(12) << s.heap_bytes / 1048576.0 << std::setw(12) << s.slab_bytes / 1048576.0
+              << std::setw(12) << s.allocated_bytes / 1048576.0 << std::setw(12)
+              << s.central_free_bytes / 1048576.0 << std::setw(12) << s.rss_bytes / 1048576.0
+              << s.released_bytes / 1048576.0 << std::endl;
+}
+
+template <class Pred>
+bool wait_until(Pred pred, int timeout_ms) {
+    for (int waited = 0; waited < timeout_ms; waited += 10) {
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return pred();
+}
+
+// ============================================================================
+// 测试
+// ============================================================================
+
+int test_trim(size_t n) {
+    std::cout << std::left << std::setw(26) << "阶段（MB）" << std::setw(12) << "堆" << std::setw(12) << "板"
+              << std::setw(12) << "在用" << std::setw(12) << "中心池空闲" << std::setw(12) << "常驻内存"
+              << "累计归还" << std::endl;
+    print_stats("初始");
+
+    // 1. 突发分配后全部释放，trim 应归还几乎全部增长
+    const size_t heap0 = alloc::get_heap_size();
+    burst b = allocate_burst(n);
+    print_stats("突发分配后");
+    const mystl::alloc_stats peak = alloc::get_stats();
+    free_burst(b, 0);
+    alloc::flush_thread_cache();
+    print_stats("全部释放后");
+    const size_t released = alloc::trim();
+    print_stats("trim() 后");
+    const mystl::alloc_stats after = alloc::get_stats();
+    if (released == 0 || after.heap_bytes > heap0 + (peak.heap_bytes - heap0) / 10) {
+        std::cout << "trim 未归还突发分配的内存: 归还 " << released << " 字节" << std::endl;
+        return 1;
+    }
+    if (after.rss_bytes != 0 && after.rss_bytes >= peak.rss_bytes) {
+        std::cout << "trim 后常驻内存未下降" << std::endl;
+        return 1;
+    }
+
+    // 2. 保留分散的少量对象：它们所在的板不能回收，内容必须完好；其余板释放物理页
+    b = allocate_burst(n);
+    const size_t keep_every = 512;
+    free_burst(b, keep_every);
+    alloc::flush_thread_cache();
+    print_stats("保留 1/512 后");
+    const size_t rss_before = alloc::get_rss();
+    alloc::trim();
+    print_stats("trim() 后");
+    if (!intact(b, keep_every)) {
+        std::cout << "trim 破坏了仍在使用的对象" << std::endl;
+        return 2;
+    }
+    if (rss_before != 0 && alloc::get_rss() >= rss_before) {
+        std::cout << "部分空闲时 trim 未释放物理页" << std::endl;
+        return 2;
+    }
+    // 回收后的内存可以再次分配
+    burst again = allocate_burst(n / 4);
+    if (!intact(b, keep_every)) return 2;
+    free_burst(again, 0);
+    free_burst(b, 0);
+    alloc::flush_thread_cache();
+    alloc::trim();
+
+    // 3. trim(keep_bytes) 保留一部分空闲内存
+    b = allocate_burst(n);
+    free_burst(b, 0);
+    const size_t keep = 4u << 20;
+    const size_t heap_before = alloc::get_heap_size();
+    alloc::trim(keep);
+    const size_t heap_kept = alloc::get_heap_size();
+    alloc::trim();
+    if (heap_kept >= heap_before || heap_kept <= alloc::get_heap_size()) {
+        std::cout << "trim(keep_bytes) 未保留空闲内存" << std::endl;
+        return 3;
+    }
+
+    // 4. 线程退出时其缓存归还中心池，之后可以整体 trim
+    std::thread([n] {
+        burst local = allocate_burst(n);
+        free_burst(local, 0);
+    }).join();
+    print_stats("线程退出后");
+    alloc::trim();
+    print_stats("trim() 后");
+    if (alloc::get_heap_size() > heap0 + (peak.heap_bytes - heap0) / 10) {
+        std::cout << "退出线程释放的内存未能归还" << std::endl;
+        return 4;
+    }
+    return 0;
+}
+
+int test_policies(size_t n) {
+    // 自动阈值：释放路径上超过阈值即自动 trim
+    const size_t trims = alloc::get_stats().trim_count;
+    alloc::set_trim_threshold(2u << 20);
+    burst b = allocate_burst(n);
+    const size_t peak = alloc::get_heap_size();
+    free_burst(b, 0);
+    alloc::set_trim_threshold(0);
+    print_stats("自动阈值 trim 后");
+    if (alloc::get_stats().trim_count == trims || alloc::get_heap_size() >= peak) {
+        std::cout << "自动阈值 trim 未触发" << std::endl;
+        return 5;
+    }
+    alloc::flush_thread_cache();
+    alloc::trim();
+
+    // 后台衰减：每次归还一半可回收内存
+    b = allocate_burst(n);
+    const size_t peak2 = alloc::get_heap_size();
+    free_burst(b, 0);
+    alloc::flush_thread_cache();
+    alloc::start_background_trim(std::chrono::milliseconds(20));
+    const bool shrunk = wait_until([peak2] { return alloc::get_heap_size() < peak2 / 4; }, 5000);
+    alloc::stop_background_trim();
+    print_stats("后台衰减 trim 后");
+    if (!shrunk) {
+        std::cout << "后台 trim 未归还内存" << std::endl;
+        return 6;
+    }
+    return 0;
+}
+
+// 其他线程持续分配释放时反复 trim，对象内容必须完好
+int test_concurrent_trim() {
+    std::atomic<bool> stop(false);
+    std::atomic<int> bad(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.push_back(std::thread([t, &stop, &bad] {
+            uint32_t x = 2463534242u + t;
+            std::vector<char*> live(2048, nullptr);
+            std::vector<size_t> sizes(2048, 0);
+            while (!stop.load()) {
+                for (int k = 0; k < 1000; ++k) {
+                    x ^= x << 13;
+                    x ^= x >> 17;
+                    x ^= x << 5;
+                    const size_t i = x % live.size();
+                    if (live[i] != nullptr) {
+                        for (size_t j = 0; j < sizes[i]; ++j) {
+                            if (live[i][j] != static_cast<char>(i)) bad.fetch_add(1);
+                        }
+                        alloc::deallocate(live[i], sizes[i]);
+                    }
+                    sizes[i] = (x >> 8) % 3000 + 1;
+                    live[i] = static_cast<char*>(alloc::allocate(sizes[i]));
+                    std::memset(live[i], static_cast<int>(static_cast<char>(i)), sizes[i]);
+                }
+                if (t == 0) alloc::flush_thread_cache();
+            }
+            for (size_t i = 0; i < live.size(); ++i) alloc::deallocate(live[i], sizes[i]);
+        }));
+    }
+    for (int i = 0; i < 50; ++i) {
+        alloc::trim();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    stop.store(true);
+    for (auto& w : workers) w.join();
+    if (bad.load() != 0) {
+        std::cout << "并发 trim 破坏了对象内容" << std::endl;
+        return 7;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 400000;
+    if (n < 100000) {
+        n = 100000;   // 突发规模太小时堆只有一两个内存块，无法检验 trim(keep_bytes)
+    }
+
+    int rc = test_trim(n);
+    if (rc == 0) rc = test_policies(n);
+    if (rc == 0) rc = test_concurrent_trim();
+    if (rc != 0) {
+        return rc;
+    }
+    alloc::trim();
+    print_stats("结束");
+    std::cout << "test_alloc_trim: 全部测试通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,251 @@
+// mystl::monotonic_arena / arena_allocator 的正确性测试，以及请求级临时容器负载下与默认分配器的性能对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_arena.cpp -o test_arena
+// 运行：./test_arena [模拟请求数，默认 20000]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "arena.h"
+#include "vector.h"
+#include "list.h"
+#include "deque.h"
+
+// ============================================================================
+// 全局 operator new 计数：容器跑在内存区上时不应再访问全局堆
+// ============================================================================
+
+static size_t g_new_calls = 0;
+
+void* operator new(size_t n) {
+    ++g_new_calls;
+    void* p = std::malloc(n == 0 ? 1 : n);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+template <class T>
+using arena_vector = mystl::vector<T, mystl::arena_allocator<T>>;
+template <class T>
+using arena_list = mystl::list<T, mystl::arena_allocator<T>>;
+template <class T>
+using arena_deque = mystl::deque<T, mystl::arena_allocator<T>>;
+
+struct record {
+    int    id;
+    double score;
+    record(int i, double s) : id(i), score(s) {}
+};
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+int test_arena_basics() {
+    // 对齐：各种对齐要求交错分配
+    mystl::monotonic_arena arena;
+    const size_t aligns[] = {1, 2, 4, 8, 16, 32, 64, 128, 256, 4096};
+    for (int round = 0; round < 100; ++round) {
+        for (size_t a : aligns) {
+            void* p = arena.allocate(static_cast<size_t>(round) * 3 + 1, a);
+            if (reinterpret_cast<uintptr_t>(p) % a != 0) {
+                std::cout << "对齐错误: align=" << a << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // 几何增长：上游块数只与总字节数的对数成正比
+    arena.release();
+    if (arena.chunk_count() != 0 || arena.upstream_bytes() != 0 || arena.bytes_allocated() != 0) {
+        std::cout << "release() 未归还上游内存" << std::endl;
+        return 2;
+    }
+    const size_t total = 64u << 20;
+    for (size_t done = 0; done < total; done += 48) arena.allocate(48);
+    if (arena.chunk_count() > 20 || arena.upstream_bytes() > total * 3) {
+        std::cout << "上游内存块未几何增长: " << arena.chunk_count() << " 块, " << arena.upstream_bytes()
+                  << " 字节" << std::endl;
+        return 2;
+    }
+
+    // 超过下一块大小的单次大分配
+    char* big = static_cast<char*>(arena.allocate(100u << 20, 64));
+    big[0] = big[(100u << 20) - 1] = 1;
+    arena.release();
+
+    // 调用者提供的缓冲区：先用完缓冲区，再向上游申请，release() 后回到缓冲区开头
+    alignas(16) char buffer[256];
+    mystl::monotonic_arena buffered(buffer, sizeof(buffer));
+    void* first = buffered.allocate(16, 16);
+    if (first != buffer) return 3;
+    for (int i = 0; i < 14; ++i) buffered.allocate(16, 16);
+    if (buffered.chunk_count() != 0) {
+        std::cout << "初始缓冲区未用满就申请了上游内存" << std::endl;
+        return 3;
+    }
+    buffered.allocate(64);
+    if (buffered.chunk_count() != 1 || buffered.upstream_bytes() < 2 * sizeof(buffer)) return 3;
+    buffered.release();
+    if (buffered.allocate(16, 16) != buffer || buffered.chunk_count() != 0) {
+        std::cout << "release() 后未回到初始缓冲区" << std::endl;
+        return 3;
+    }
+    return 0;
+}
+
+int test_containers() {
+    mystl::inline_arena<1 << 16> arena;
+    mystl::arena_allocator<int> alloc(arena);
+    mystl::arena_allocator<record> rebound(alloc);
+    if (!(alloc == rebound) || rebound.arena() != &arena) return 10;
+
+    const size_t calls = g_new_calls;
+
+    // vector：增长、拷贝、移动都在内存区上
+    arena_vector<int> v(arena);
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+    arena_vector<int> copy(v);
+    arena_vector<int> moved(mystl::move(copy));
+    arena_vector<int> filled(100, 7, alloc);
+    arena_vector<int> listed({1, 2, 3}, alloc);
+    long sum = 0;
+    for (int x : moved) sum += x;
+    if (sum != 999L * 1000 / 2 || filled[99] != 7 || listed.size() != 3 ||
+        moved.get_allocator() != alloc || !copy.empty()) {
+        std::cout << "内存区上的 vector 结果错误" << std::endl;
+        return 11;
+    }
+
+    // list：节点类型由 rebind 得到
+    arena_list<record> l(rebound);
+    for (int i = 0; i < 500; ++i) l.push_back(record(i, i * 0.5));
+    l.erase(l.begin());
+    l.insert(l.cbegin(), record(-1, 0));
+    arena_list<record> l2(l);
+    arena_list<record> l3(mystl::move(l2));
+    l3.pop_back();
+    if (l3.size() != 499 || l3.front().id != -1 || l3.back().id != 498 || l3.get_allocator() != rebound) {
+        std::cout << "内存区上的 list 结果错误" << std::endl;
+        return 12;
+    }
+
+    // deque：块与 map 区都在内存区上，两端增长触发 map 扩容
+    arena_deque<int> d(arena);
+    for (int i = 0; i < 3000; ++i) {
+        d.push_back(i);
+        d.push_front(-i);
+    }
+    arena_deque<int> d2(d);
+    arena_deque<int> d3(mystl::move(d2));
+    if (d3.size() != 6000 || d3.front() != -2999 || d3.back() != 2999 || d3[3000] != 0 ||
+        d3.get_allocator() != alloc) {
+        std::cout << "内存区上的 deque 结果错误" << std::endl;
+        return 13;
+    }
+
+    if (g_new_calls != calls) {
+        std::cout << "容器在内存区上仍调用了全局 operator new: " << g_new_calls - calls << " 次" << std::endl;
+        return 14;
+    }
+    if (arena.bytes_allocated() == 0) return 15;
+    return 0;
+}
+
+// ============================================================================
+// 性能测试：每个请求创建一批短命容器，请求结束时整体丢弃
+// ============================================================================
+
+static const int kContainersPerRequest = 24;
+static const int kElementsPerContainer = 16;
+
+volatile long g_sink = 0;
+
+template <class Vector, class List, class Deque, class Alloc>
+long handle_request(const Alloc& alloc, int seed) {
+    long acc = 0;
+    for (int c = 0; c < kContainersPerRequest; ++c) {
+        Vector v(alloc);
+        List l(alloc);
+        for (int i = 0; i < kElementsPerContainer; ++i) {
+            v.push_back(seed + i);
+            l.push_back(seed - i);
+        }
+        for (int x : v) acc += x;
+        for (int x : l) acc -= x;
+    }
+    Deque d(alloc);
+    for (int i = 0; i < kContainersPerRequest * kElementsPerContainer; ++i) d.push_back(i);
+    acc += d.back();
+    return acc;
+}
+
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void run_benchmark(int requests) {
+    typedef mystl::allocator<int> heap_alloc;
+    const double t_heap = time_ms([requests] {
+        long acc = 0;
+        for (int r = 0; r < requests; ++r) {
+            acc += handle_request<mystl::vector<int>, mystl::list<int>, mystl::deque<int>>(heap_alloc(), r);
+        }
+        g_sink = acc;
+    });
+
+    mystl::monotonic_arena arena(1 << 16);
+    const double t_arena = time_ms([requests, &arena] {
+        long acc = 0;
+        for (int r = 0; r < requests; ++r) {
+            acc += handle_request<arena_vector<int>, arena_list<int>, arena_deque<int>>(
+                mystl::arena_allocator<int>(arena), r);
+            arena.release();
+        }
+        g_sink = acc;
+    });
+
+    mystl::inline_arena<1 << 16> local;
+    const double t_inline = time_ms([requests, &local] {
+        long acc = 0;
+        for (int r = 0; r < requests; ++r) {
+            acc += handle_request<arena_vector<int>, arena_list<int>, arena_deque<int>>(
+                mystl::arena_allocator<int>(local), r);
+            local.release();
+        }
+        g_sink = acc;
+    });
+
+    std::cout << "\n=== 请求级临时容器（每请求 " << kContainersPerRequest << " 个 vector + " << kContainersPerRequest
+              << " 个 list，各 " << kElementsPerContainer << " 个元素，外加 1 个 deque；" << requests
+              << " 个请求，单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(28) << "分配器" << std::setw(14) << "耗时" << "相对默认分配器" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(28) << "mystl::allocator" << std::setw(14) << t_heap << "1.00x" << std::endl;
+    std::cout << std::left << std::setw(28) << "monotonic_arena(64KB)" << std::setw(14) << t_arena
+              << (t_arena > 0 ? t_heap / t_arena : 0.0) << "x" << std::endl;
+    std::cout << std::left << std::setw(28) << "inline_arena<64KB>" << std::setw(14) << t_inline
+              << (t_inline > 0 ? t_heap / t_inline : 0.0) << "x" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int requests = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    int rc = test_arena_basics();
+    if (rc == 0) rc = test_containers();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_arena: 正确性测试通过" << std::endl;
+
+    run_benchmark(requests);
+    return 0;
+}
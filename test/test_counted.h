@@ -0,0 +1,52 @@
+#ifndef MYTINYSTL_TEST_COUNTED_H_
+#define MYTINYSTL_TEST_COUNTED_H_
+
+// 容器测试共用的计数类型：统计存活对象数，可在第 n 次拷贝时抛出异常
+
+#include <stdexcept>
+
+// 不可平凡拷贝、带存活计数的类型；countdown() 减到 0 的那次拷贝构造或拷贝赋值抛出异常
+struct counted {
+    int value;
+
+    counted(int v = 0) : value(v) { ++live(); }
+    counted(const counted& o) : value(o.value) {
+        tick();
+        ++live();
+    }
+    counted(counted&& o) noexcept : value(o.value) { ++live(); }
+    counted& operator=(const counted& o) {
+        tick();
+        value = o.value;
+        return *this;
+    }
+    counted& operator=(counted&& o) noexcept {
+        value = o.value;
+        return *this;
+    }
+    ~counted() { --live(); }
+
+    bool operator==(const counted& o) const { return value == o.value; }
+    bool operator!=(const counted& o) const { return value != o.value; }
+
+    // 当前存活的对象数
+    static long& live() {
+        static long n = 0;
+        return n;
+    }
+
+    // 大于 0 时每次拷贝减一，减到 0 的那次抛出；0 表示不抛出
+    static long& countdown() {
+        static long n = 0;
+        return n;
+    }
+
+private:
+    static void tick() {
+        if (countdown() > 0 && --countdown() == 0) {
+            throw std::runtime_error("counted: copy failed");
+        }
+    }
+};
+
+#endif // MYTINYSTL_TEST_COUNTED_H_
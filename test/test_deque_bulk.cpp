@@ -0,0 +1,125 @@
+#include "deque.h"
+#include "test_counted.h"
+#include <cassert>
+#include <deque>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// 大小不是 2 的幂的元素，块大小取 2 的幂后每块留有空隙
+struct triple {
+    int a, b, c;
+    triple(int v = 0) : a(v), b(v + 1), c(v + 2) {}
+};
+
+static_assert(mystl::deque_buf_size<triple>::value == 32, "12 字节元素的块应取 32 个");
+static_assert(mystl::deque_buf_size<int>::is_pow2, "默认块大小应为 2 的幂");
+static_assert(!mystl::deque_buf_size<int, 6>::is_pow2, "显式块大小保持原值");
+
+template <class Deque>
+bool same(const Deque& d, const std::deque<int>& s) {
+    if (d.size() != s.size()) return false;
+    auto it = d.begin();
+    for (size_t i = 0; i < s.size(); ++i, ++it) {
+        if (*it != s[i] || d[i] != s[i] || d.begin()[static_cast<long>(i)] != s[i]) return false;
+    }
+    return it == d.end();
+}
+
+// 块内、跨块、多块的批量插入删除与 std::deque 对照
+template <class Deque>
+void check_bulk_ops() {
+    std::mt19937 rng(7);
+    Deque d;
+    std::deque<int> s;
+    for (int step = 0; step < 2000; ++step) {
+        const long pos = static_cast<long>(rng() % (s.size() + 1));
+        const size_t n = rng() % 300;
+        switch (rng() % 4) {
+        case 0:
+            d.insert(d.begin() + pos, n, step);
+            s.insert(s.begin() + pos, n, step);
+            break;
+        case 1: {
+            std::vector<int> src(n, -step);
+            d.insert(d.begin() + pos, src.begin(), src.end());
+            s.insert(s.begin() + pos, src.begin(), src.end());
+            break;
+        }
+        case 2: {
+            const long last = pos + static_cast<long>(rng() % (s.size() - pos + 1));
+            auto it = d.erase(d.begin() + pos, d.begin() + last);
+            s.erase(s.begin() + pos, s.begin() + last);
+            assert(it - d.begin() == pos);
+            (void)it;
+            break;
+        }
+        default:
+            if (!s.empty()) {  // 源区间来自本容器，走 const_iterator 重载
+                const long first = static_cast<long>(rng() % s.size());
+                const std::vector<int> copy(s.begin() + first, s.end());
+                const Deque& cd = d;
+                d.insert(d.begin() + pos, cd.begin() + first, cd.end());
+                s.insert(s.begin() + pos, copy.begin(), copy.end());
+            }
+        }
+        if (s.size() > 20000) {
+            d.erase(d.begin() + 100, d.end() - 100);
+            s.erase(s.begin() + 100, s.end() - 100);
+        }
+        assert(same(d, s));
+    }
+}
+
+int main() {
+    check_bulk_ops<mystl::deque<int>>();
+    // 显式指定非 2 的幂的块大小时下标换算退回除法
+    check_bulk_ops<mystl::deque<int, mystl::allocator<int>, 6>>();
+
+    // 单趟迭代器、初始化列表与 emplace
+    std::istringstream in("1 2 3 4 5");
+    mystl::deque<int> d{0, 0, 0, 0, 0};
+    d.insert(d.begin() + 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    d.insert(d.end() - 1, {7, 8});
+    d.emplace(d.begin() + 4, 9);
+    d.emplace(d.end(), 6);
+    assert(same(d, std::deque<int>{0, 0, 1, 2, 9, 3, 4, 5, 0, 0, 7, 8, 0, 6}));
+
+    {
+        // 插入时拷贝抛出：元素不泄漏，容器仍可用
+        mystl::deque<counted> c;
+        for (int i = 0; i < 2000; ++i) c.push_back(counted(i));
+        std::list<counted> src(700, counted(-1));
+        const counted value(1);
+        const long positions[] = {0, 3, 1000, 1997, 2000};
+        for (long pos : positions) {
+            for (long k = 1; k <= 700; k += 233) {
+                int thrown = 0;
+                counted::countdown() = k;
+                try {
+                    c.insert(c.begin() + pos, src.begin(), src.end());
+                } catch (const std::runtime_error&) {
+                    ++thrown;
+                }
+                counted::countdown() = k;
+                try {
+                    c.insert(c.begin() + pos, 700, value);
+                } catch (const std::runtime_error&) {
+                    ++thrown;
+                }
+                counted::countdown() = 0;
+                assert(thrown == 2);
+                (void)thrown;
+                assert(counted::live() == static_cast<long>(c.size()) + 700 + 1);
+                c.erase(c.begin(), c.begin() + static_cast<long>(c.size() - 2000));
+            }
+        }
+    }
+    assert(counted::live() == 0);
+
+    std::cout << "test_deque_bulk OK\n";
+    return 0;
+}
@@ -0,0 +1,84 @@
+// mystl::deque 下标直接换算与按块批量插入/删除的性能测试：千万级元素的随机访问、中间插入删除，与 std::deque 对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_deque_bulk_performance.cpp -o test_deque_bulk_performance
+// 运行：./test_deque_bulk_performance [元素个数，默认 10000000]
+#include <iostream>
+#include <iomanip>
+#include <deque>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "deque.h"
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+volatile long g_sink = 0;
+
+template <class Deque>
+void bench_random_access(const char* name, size_t n) {
+    Deque d;
+    for (size_t i = 0; i < n; ++i) d.push_back(static_cast<int>(i));
+    std::mt19937 rng(1);
+    std::vector<size_t> idx(n);
+    for (size_t i = 0; i < n; ++i) idx[i] = rng() % n;
+    auto start = std::chrono::high_resolution_clock::now();
+    long sum = 0;
+    for (size_t i = 0; i < n; ++i) sum += d[idx[i]];
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) sum += d[i];
+    auto end = std::chrono::high_resolution_clock::now();
+    g_sink = sum;
+    std::cout << std::left << std::setw(20) << name << std::setw(16)
+              << std::chrono::duration<double, std::milli>(mid - start).count()
+              << std::chrono::duration<double, std::milli>(end - mid).count() << std::endl;
+}
+
+// 在中间位置反复批量插入、删除，每次 batch 个元素
+template <class Deque>
+void bench_middle(const char* name, size_t n, size_t batch, size_t rounds) {
+    Deque d;
+    for (size_t i = 0; i < n; ++i) d.push_back(static_cast<int>(i));
+    std::vector<int> src(batch, 7);
+    std::mt19937 rng(2);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        const size_t pos = n / 4 + rng() % (n / 2);
+        d.insert(d.begin() + static_cast<long>(pos), src.begin(), src.end());
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        const size_t pos = n / 4 + rng() % (n / 2);
+        d.erase(d.begin() + static_cast<long>(pos), d.begin() + static_cast<long>(pos + batch));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    g_sink = static_cast<long>(d.size()) + d[n / 2];
+    std::cout << std::left << std::setw(20) << name << std::setw(10) << batch << std::setw(16)
+              << std::chrono::duration<double, std::milli>(mid - start).count()
+              << std::chrono::duration<double, std::milli>(end - mid).count() << std::endl;
+}
+
+void run_benchmark(size_t n) {
+    std::cout << "\n=== " << n << " 个 int 的下标访问 ===" << std::endl;
+    std::cout << std::left << std::setw(24) << "容器" << std::setw(18) << "随机(ms)" << "顺序(ms)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    bench_random_access<mystl::deque<int>>("mystl::deque", n);
+    bench_random_access<std::deque<int>>("std::deque", n);
+
+    std::cout << "\n=== " << n << " 个 int 的中间插入、删除，各 20 次 ===" << std::endl;
+    std::cout << std::left << std::setw(24) << "容器" << std::setw(12) << "批量" << std::setw(18) << "插入(ms)"
+              << "删除(ms)" << std::endl;
+    const size_t batches[] = {1, 1000, 100000};
+    for (size_t batch : batches) {
+        bench_middle<mystl::deque<int>>("mystl::deque", n, batch, 20);
+        bench_middle<std::deque<int>>("std::deque", n, batch, 20);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 10000000;
+    if (n < 1000000) n = 1000000;
+    run_benchmark(n);
+    return 0;
+}
@@ -0,0 +1,272 @@
+// 分段迭代器萃取与 copy / fill / find / for_each / accumulate 在 deque 上逐块执行的正确性测试与性能对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_deque_segmented.cpp -o test_deque_segmented
+// 运行：./test_deque_segmented [元素个数，默认 10000000]
+#include <iostream>
+#include <iomanip>
+#include <deque>
+#include <vector>
+#include <list>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "deque.h"
+#include "vector.h"
+#include "algo.h"
+#include "numeric.h"
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+static_assert(mystl::segmented_iterator_traits<mystl::deque<int>::iterator>::is_segmented,
+              "deque 迭代器应为分段迭代器");
+static_assert(mystl::segmented_iterator_traits<mystl::deque<int>::const_iterator>::is_segmented,
+              "deque 常量迭代器应为分段迭代器");
+static_assert(!mystl::segmented_iterator_traits<int*>::is_segmented, "指针不是分段迭代器");
+
+// 对元素求和并计数的函数对象
+struct summer {
+    long sum = 0;
+    long calls = 0;
+    void operator()(int v) {
+        sum += v;
+        ++calls;
+    }
+};
+
+// 与顺序相关的二元运算，能发现分段时漏算或重复的元素
+unsigned long hash_step(unsigned long x, int y) { return (x * 31) ^ static_cast<unsigned long>(y); }
+
+// 起止位置覆盖同一块内、块边界、跨多块
+std::vector<std::pair<size_t, size_t>> ranges_of(size_t n, size_t block) {
+    std::vector<std::pair<size_t, size_t>> r;
+    const size_t points[] = {0, 1, block - 1, block, block + 1, 2 * block, 3 * block - 1, n / 2, n - block, n - 1, n};
+    for (size_t a : points) {
+        for (size_t b : points) {
+            if (a <= b && b <= n) r.push_back(std::make_pair(a, b));
+        }
+    }
+    return r;
+}
+
+int test_int_ranges() {
+    const size_t block = mystl::deque_buf_size<int>::value;
+    mystl::deque<int> d;
+    std::deque<int> s;
+    // 头部也插入，使首元素不在块首
+    for (int i = 0; i < static_cast<int>(10 * block); ++i) {
+        d.push_back(i);
+        s.push_back(i);
+    }
+    for (int i = 1; i < 37; ++i) {
+        d.push_front(-i);
+        s.push_front(-i);
+    }
+    const size_t n = s.size();
+    for (auto r : ranges_of(n, block)) {
+        const long a = static_cast<long>(r.first), b = static_cast<long>(r.second);
+        const mystl::deque<int>& cd = d;
+        // accumulate / for_each
+        if (mystl::accumulate(cd.begin() + a, cd.begin() + b, 0L) != std::accumulate(s.begin() + a, s.begin() + b, 0L) ||
+            mystl::accumulate(d.begin() + a, d.begin() + b, 1UL, hash_step) !=
+                std::accumulate(s.begin() + a, s.begin() + b, 1UL, hash_step)) {
+            std::cout << "accumulate 结果错误 [" << a << ", " << b << ")" << std::endl;
+            return 1;
+        }
+        summer f = mystl::for_each(cd.begin() + a, cd.begin() + b, summer());
+        if (f.calls != b - a || f.sum != std::accumulate(s.begin() + a, s.begin() + b, 0L)) {
+            std::cout << "for_each 结果错误 [" << a << ", " << b << ")" << std::endl;
+            return 1;
+        }
+        // find：找得到、找不到，返回的迭代器与逐元素查找一致
+        const int targets[] = {s[static_cast<size_t>(a + (b - a) / 2) < n ? static_cast<size_t>(a + (b - a) / 2) : 0],
+                               -1000000, s[static_cast<size_t>(b == 0 ? 0 : b - 1) < n ? static_cast<size_t>(b == 0 ? 0 : b - 1) : 0]};
+        for (int t : targets) {
+            auto it = mystl::find(cd.begin() + a, cd.begin() + b, t);
+            auto sit = std::find(s.begin() + a, s.begin() + b, t);
+            if (it - cd.begin() != sit - s.begin() || (it != cd.begin() + b && *it != t)) {
+                std::cout << "find 结果错误 [" << a << ", " << b << ") 查找 " << t << std::endl;
+                return 1;
+            }
+        }
+        // copy：deque -> 指针、指针 -> deque、deque -> deque（目标块偏移不同）
+        std::vector<int> out(static_cast<size_t>(b - a) + 1, 7);
+        int* end = mystl::copy(cd.begin() + a, cd.begin() + b, out.data());
+        if (end != out.data() + (b - a) || !std::equal(out.begin(), out.begin() + (b - a), s.begin() + a) || out.back() != 7) {
+            std::cout << "copy 到指针结果错误 [" << a << ", " << b << ")" << std::endl;
+            return 1;
+        }
+        mystl::deque<int> dst;
+        std::deque<int> sdst;
+        for (int i = 0; i < static_cast<int>(n) + 50; ++i) {
+            dst.push_back(-i);
+            sdst.push_back(-i);
+        }
+        for (int i = 0; i < 5; ++i) {
+            dst.push_front(i);
+            sdst.push_front(i);
+        }
+        auto dit = mystl::copy(cd.begin() + a, cd.begin() + b, dst.begin() + 3);
+        std::copy(s.begin() + a, s.begin() + b, sdst.begin() + 3);
+        if (dit - dst.begin() != 3 + (b - a) || !std::equal(sdst.begin(), sdst.end(), dst.begin())) {
+            std::cout << "copy 到 deque 结果错误 [" << a << ", " << b << ")" << std::endl;
+            return 1;
+        }
+        dit = mystl::copy(out.data(), out.data() + (b - a), dst.begin() + 11);
+        std::copy(out.data(), out.data() + (b - a), sdst.begin() + 11);
+        if (dit - dst.begin() != 11 + (b - a) || !std::equal(sdst.begin(), sdst.end(), dst.begin())) {
+            std::cout << "指针区间 copy 到 deque 结果错误 [" << a << ", " << b << ")" << std::endl;
+            return 1;
+        }
+        // fill
+        mystl::fill(dst.begin() + a, dst.begin() + b, 42);
+        std::fill(sdst.begin() + a, sdst.begin() + b, 42);
+        if (!std::equal(sdst.begin(), sdst.end(), dst.begin())) {
+            std::cout << "fill 结果错误 [" << a << ", " << b << ")" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 非平凡类型与非分段迭代器仍走逐元素路径
+int test_other_types() {
+    mystl::deque<std::string> d;
+    for (int i = 0; i < 300; ++i) d.push_back(std::to_string(i));
+    std::list<std::string> l(d.begin(), d.end());
+    mystl::deque<std::string> copy_dst(d);
+    mystl::fill(copy_dst.begin(), copy_dst.end(), std::string("x"));
+    mystl::copy(l.begin(), l.end(), copy_dst.begin());
+    if (!(copy_dst == d) || *mystl::find(d.begin(), d.end(), std::string("123")) != "123" ||
+        mystl::find(d.begin(), d.end(), std::string("none")) != d.end()) {
+        std::cout << "std::string 的 deque 算法结果错误" << std::endl;
+        return 2;
+    }
+    std::string joined = mystl::accumulate(d.begin() + 10, d.begin() + 13, std::string());
+    mystl::vector<int> v;
+    for (int i = 0; i < 10; ++i) v.push_back(i);
+    size_t chars = 0;
+    mystl::for_each(l.begin(), l.end(), [&chars](const std::string& x) { chars += x.size(); });
+    if (joined != "101112" || mystl::accumulate(v.begin(), v.end(), 0) != 45 || chars != 10 + 2 * 90 + 3 * 200) {
+        std::cout << "非分段迭代器上的算法结果错误" << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+volatile long g_sink = 0;
+
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 逐元素经过迭代器的写法，作为没有分段路径时的对照
+template <class It>
+long naive_accumulate(It first, It last) {
+    long sum = 0;
+    for (; first != last; ++first) sum += *first;
+    return sum;
+}
+
+void run_benchmark(size_t n) {
+    mystl::deque<int> d;
+    std::deque<int> s;
+    for (size_t i = 0; i < n; ++i) {
+        d.push_back(static_cast<int>(i % 1000));
+        s.push_back(static_cast<int>(i % 1000));
+    }
+    std::vector<int> buf(n);
+    mystl::deque<int> d2(d);
+    const int absent = -1;
+
+    std::cout << "\n=== " << n << " 个 int 的 deque 上的算法 ===" << std::endl;
+    std::cout << std::left << std::setw(16) << "算法" << std::setw(22) << "逐元素迭代(ms)" << std::setw(22)
+              << "mystl 分段(ms)" << "std::deque + std(ms)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    struct row {
+        const char* name;
+        double naive, mine, theirs;
+    };
+    const int reps = 5;
+    std::vector<row> rows;
+    rows.push_back({"accumulate",
+                    time_ms([&] { for (int r = 0; r < reps; ++r) g_sink = naive_accumulate(d.begin(), d.end()); }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) g_sink = mystl::accumulate(d.begin(), d.end(), 0L); }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) g_sink = std::accumulate(s.begin(), s.end(), 0L); })});
+    rows.push_back({"find",
+                    time_ms([&] {
+                        for (int r = 0; r < reps; ++r) {
+                            auto it = d.begin();
+                            while (it != d.end() && *it != absent) ++it;
+                            g_sink = it - d.begin();
+                        }
+                    }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) g_sink = mystl::find(d.begin(), d.end(), absent) - d.begin(); }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) g_sink = std::find(s.begin(), s.end(), absent) - s.begin(); })});
+    rows.push_back({"for_each",
+                    time_ms([&] {
+                        for (int r = 0; r < reps; ++r) {
+                            summer f;
+                            for (auto it = d.begin(); it != d.end(); ++it) f(*it);
+                            g_sink = f.sum;
+                        }
+                    }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) g_sink = mystl::for_each(d.begin(), d.end(), summer()).sum; }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) g_sink = std::for_each(s.begin(), s.end(), summer()).sum; })});
+    rows.push_back({"fill",
+                    time_ms([&] {
+                        for (int r = 0; r < reps; ++r)
+                            for (auto it = d2.begin(); it != d2.end(); ++it) *it = r;
+                    }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) mystl::fill(d2.begin(), d2.end(), r); }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) std::fill(s.begin(), s.end(), r); })});
+    rows.push_back({"copy->vector",
+                    time_ms([&] {
+                        for (int r = 0; r < reps; ++r) {
+                            int* out = buf.data();
+                            for (auto it = d.begin(); it != d.end(); ++it) *out++ = *it;
+                        }
+                    }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) mystl::copy(d.begin(), d.end(), buf.data()); }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) std::copy(s.begin(), s.end(), buf.data()); })});
+    rows.push_back({"copy->deque",
+                    time_ms([&] {
+                        for (int r = 0; r < reps; ++r) {
+                            auto out = d2.begin() + 1;
+                            for (auto it = d.begin(); it != d.end() - 1; ++it, ++out) *out = *it;
+                        }
+                    }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) mystl::copy(d.begin(), d.end() - 1, d2.begin() + 1); }),
+                    time_ms([&] { for (int r = 0; r < reps; ++r) std::copy(s.begin(), s.end() - 1, s.begin() + 1); })});
+    g_sink = d2[n / 2] + buf[n / 3];
+    for (const row& r : rows) {
+        std::cout << std::left << std::setw(16) << r.name << std::setw(18) << r.naive / reps << std::setw(18)
+                  << r.mine / reps << r.theirs / reps << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 10000000;
+    if (n < 100000) n = 100000;
+
+    int rc = test_int_ranges();
+    if (rc == 0) rc = test_other_types();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_deque_segmented: 正确性测试通过" << std::endl;
+
+    run_benchmark(n);
+    return 0;
+}
@@ -0,0 +1,280 @@
+// deque 备用块缓存与 map 就地居中的正确性测试，以及队列式负载下的分配器调用次数/耗时对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_deque_spare_blocks.cpp -o test_deque_spare_blocks
+// 运行：./test_deque_spare_blocks [每轮队列操作次数，默认 4000000]
+#include <iostream>
+#include <iomanip>
+#include <deque>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "alloc.h"
+#include "arena.h"
+#include "deque.h"
+#include "test_counted.h"
+
+// ============================================================================
+// 测试类型
+// ============================================================================
+
+static long g_allocations = 0;    // counting_allocator 的分配次数（块与 map 区）
+static long g_deallocations = 0;  // counting_allocator 的释放次数
+
+// 统计分配、释放次数的分配器，mystl::deque 与 std::deque 共用
+template <class T>
+struct counting_allocator {
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef size_t size_type;
+    template <class U>
+    struct rebind {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator() noexcept {}
+    template <class U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++g_allocations;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) noexcept {
+        ++g_deallocations;
+        ::operator delete(p);
+    }
+    bool operator==(const counting_allocator&) const noexcept { return true; }
+    bool operator!=(const counting_allocator&) const noexcept { return false; }
+};
+
+template <class T, class A>
+using counting_deque = mystl::deque<T, counting_allocator<A>>;
+
+template <class Deque, class T>
+bool same(const Deque& d, const std::deque<T>& s) {
+    if (d.size() != s.size()) return false;
+    auto it = d.begin();
+    for (size_t i = 0; i < s.size(); ++i, ++it) {
+        if (!(*it == s[i])) return false;
+    }
+    return it == d.end();
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+// 随机在两端进出、清空、交换、移动，每一步与 std::deque 比较；结束后分配与释放次数相等
+int test_random_ops() {
+    g_allocations = g_deallocations = 0;
+    counted::live() = 0;
+    {
+        std::mt19937 rng(99);
+        counting_deque<counted, counted> d;
+        std::deque<counted> s;
+        for (int step = 0; step < 200000; ++step) {
+            const int op = static_cast<int>(rng() % 100);
+            if (op < 30) {
+                d.push_back(counted(step));
+                s.push_back(counted(step));
+            } else if (op < 50) {
+                d.push_front(counted(step));
+                s.push_front(counted(step));
+            } else if (op < 75) {
+                d.pop_front();
+                if (!s.empty()) s.pop_front();
+            } else if (op < 98) {
+                d.pop_back();
+                if (!s.empty()) s.pop_back();
+            } else if (op == 98) {
+                counting_deque<counted, counted> other;
+                for (int i = 0; i < step % 700; ++i) other.push_back(counted(-i));
+                for (int i = 0; i < step % 300; ++i) other.pop_front();
+                d.swap(other);
+                counting_deque<counted, counted> moved(mystl::move(other));
+                d = mystl::move(moved);
+                d.shrink_to_fit();
+            } else if (step % 7 == 0) {
+                d.clear();
+                s.clear();
+            }
+            if (step % 97 == 0 && !same(d, s)) {
+                std::cout << "第 " << step << " 步后与 std::deque 不一致" << std::endl;
+                return 1;
+            }
+        }
+        if (!same(d, s)) return 1;
+    }
+    if (counted::live() != 0 || g_allocations != g_deallocations) {
+        std::cout << "存活对象 " << counted::live() << "，分配 " << g_allocations << " 次、释放 " << g_deallocations << " 次"
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// 稳态队列（在块边界来回、有效区在 map 中持续漂移）不再调用分配器
+int test_steady_state() {
+    g_allocations = g_deallocations = 0;
+    {
+        counting_deque<int, int> q;
+        const size_t block = mystl::deque_buf_size<int>::value;
+        const size_t depths[] = {1, block - 1, block, block + 1, 5 * block};
+        int pushed = 0, popped = 0;  // 按序号进队，出队时检查顺序
+        for (size_t depth : depths) {
+            for (size_t i = 0; i < depth; ++i) q.push_back(pushed++);
+            for (int i = 0; i < 2000; ++i) {  // 预热：缓存与 map 达到稳态
+                q.push_back(pushed++);
+                if (q.front() != popped++) return 2;
+                q.pop_front();
+            }
+            const long before = g_allocations;
+            for (int i = 0; i < 1000000; ++i) {
+                q.push_back(pushed++);
+                if (q.front() != popped++) {
+                    std::cout << "队列顺序错误" << std::endl;
+                    return 2;
+                }
+                q.pop_front();
+            }
+            if (g_allocations != before) {
+                std::cout << "深度 " << depth << " 的稳态队列调用了分配器 " << g_allocations - before << " 次"
+                          << std::endl;
+                return 2;
+            }
+            popped += static_cast<int>(q.size());
+            q.clear();
+        }
+        // 反方向：push_front / pop_back
+        for (int i = 0; i < 3000; ++i) {
+            q.push_front(i);
+            q.pop_back();
+        }
+        const long before = g_allocations;
+        for (int i = 0; i < 1000000; ++i) {
+            q.push_front(i);
+            q.pop_back();
+        }
+        if (g_allocations != before || !q.empty()) {
+            std::cout << "反方向稳态队列调用了分配器" << std::endl;
+            return 2;
+        }
+    }
+    if (g_allocations != g_deallocations) {
+        std::cout << "备用块未归还: 分配 " << g_allocations << " 次、释放 " << g_deallocations << " 次" << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+// 池与内存区分配器上的队列
+int test_other_allocators() {
+    mystl::deque<int, mystl::pool_allocator<int>> p;
+    mystl::monotonic_arena arena(1 << 20);
+    mystl::deque<int, mystl::arena_allocator<int>> a(arena);
+    for (int i = 0; i < 500000; ++i) {
+        p.push_back(i);
+        a.push_back(i);
+        if (i % 3 != 0) {
+            p.pop_front();
+            a.pop_front();
+        }
+    }
+    // 内存区只增不减，稳态后不应继续增长
+    const size_t used = arena.bytes_allocated();
+    for (int i = 0; i < 500000; ++i) {
+        a.push_back(i);
+        a.pop_front();
+    }
+    if (p.size() != a.size() || p.front() != a.front() || p.back() != a.back() || arena.bytes_allocated() != used) {
+        std::cout << "pool_allocator / arena_allocator 上的 deque 结果错误" << std::endl;
+        return 3;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试：队列式负载
+// ============================================================================
+
+volatile long g_sink = 0;
+
+// 先填入 depth 个元素，再交替 push_back / pop_front n 次
+template <class Queue>
+void bench_fifo(const char* name, size_t depth, size_t n) {
+    Queue q;
+    for (size_t i = 0; i < depth; ++i) q.push_back(static_cast<int>(i));
+    g_allocations = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    long sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        q.push_back(static_cast<int>(i));
+        sum += q.front();
+        q.pop_front();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    g_sink = sum;
+    std::cout << std::left << std::setw(28) << name << std::setw(10) << depth << std::setw(14)
+              << std::chrono::duration<double, std::milli>(end - start).count() << g_allocations << std::endl;
+}
+
+// 突发：一次进 burst 个再全部出队
+template <class Queue>
+void bench_burst(const char* name, size_t burst, size_t n) {
+    Queue q;
+    g_allocations = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    long sum = 0;
+    for (size_t r = 0; r < n / burst; ++r) {
+        for (size_t i = 0; i < burst; ++i) q.push_back(static_cast<int>(i));
+        while (!q.empty()) {
+            sum += q.front();
+            q.pop_front();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    g_sink = sum;
+    std::cout << std::left << std::setw(28) << name << std::setw(10) << burst << std::setw(14)
+              << std::chrono::duration<double, std::milli>(end - start).count() << g_allocations << std::endl;
+}
+
+void run_benchmark(size_t n) {
+    typedef counting_deque<int, int> mine;
+    typedef std::deque<int, counting_allocator<int>> theirs;
+
+    std::cout << "\n=== 队列 push_back + pop_front " << n << " 次 ===" << std::endl;
+    std::cout << std::left << std::setw(32) << "容器" << std::setw(12) << "深度" << std::setw(16) << "耗时(ms)"
+              << "分配器调用" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    const size_t block = mystl::deque_buf_size<int>::value;
+    const size_t depths[] = {1, block, 100 * block};
+    for (size_t depth : depths) {
+        bench_fifo<mine>("mystl::deque", depth, n);
+        bench_fifo<theirs>("std::deque", depth, n);
+    }
+
+    std::cout << "\n=== 突发进队后全部出队，共 " << n << " 个元素 ===" << std::endl;
+    std::cout << std::left << std::setw(32) << "容器" << std::setw(12) << "批量" << std::setw(16) << "耗时(ms)"
+              << "分配器调用" << std::endl;
+    const size_t bursts[] = {2 * block, 4 * block, 64 * block};
+    for (size_t burst : bursts) {
+        bench_burst<mine>("mystl::deque", burst, n);
+        bench_burst<theirs>("std::deque", burst, n);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 4000000;
+    if (n < 100000) n = 100000;
+
+    int rc = test_random_ops();
+    if (rc == 0) rc = test_steady_state();
+    if (rc == 0) rc = test_other_allocators();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_deque_spare_blocks: 正确性测试通过" << std::endl;
+
+    run_benchmark(n);
+    return 0;
+}
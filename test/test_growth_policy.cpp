@@ -0,0 +1,213 @@
+// vector 增长策略（growth_policy.h）、按大小类预留与增长计数器的正确性测试，以及各策略的时间/内存对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_growth_policy.cpp -o test_growth_policy
+// 运行：./test_growth_policy [push_back 的 int 个数，默认 4000000]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include "alloc.h"
+#include "arena.h"
+#include "huge_page.h"
+#include "vector.h"
+
+typedef mystl::growth_tracked<mystl::growth_double> tracked_double;
+typedef mystl::growth_tracked<mystl::growth_one_and_half> tracked_half;
+typedef mystl::growth_tracked<mystl::growth_fixed<1024>> tracked_fixed;
+typedef mystl::growth_tracked<mystl::growth_size_class<mystl::growth_one_and_half>> tracked_class;
+
+// 不计数时计数器是空基类，vector 大小不变
+static_assert(sizeof(mystl::vector<int>) == sizeof(mystl::vector<int, mystl::allocator<int>, mystl::growth_fixed<8>>),
+              "no_growth_stats 不应占空间");
+static_assert(mystl::has_good_size<mystl::pool_allocator<int>>::value, "pool_allocator::good_size");
+static_assert(mystl::has_good_size<mystl::malloc_allocator<int>>::value, "malloc_allocator::good_size");
+static_assert(!mystl::has_good_size<mystl::allocator<int>>::value, "allocator 无 good_size");
+// 计数器属于 vector 对象，带计数器的 vector 不能按字节重定位
+static_assert(mystl::is_trivially_relocatable<mystl::vector<int>>::value, "vector<int> 可平凡重定位");
+static_assert(!mystl::is_trivially_relocatable<mystl::vector<int, mystl::allocator<int>, tracked_double>>::value,
+              "带计数器的 vector 不可平凡重定位");
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+// 逐个 push_back，记录每次容量变化
+template <class Vector>
+bool capacities(Vector& v, size_t n, const size_t* expected, size_t count) {
+    size_t seen = 0;
+    size_t last = v.capacity();
+    for (size_t i = 0; i < n; ++i) {
+        v.push_back(static_cast<typename Vector::value_type>(i));
+        if (v.capacity() != last) {
+            last = v.capacity();
+            if (seen >= count || expected[seen] != last) return false;
+            ++seen;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (v[i] != static_cast<typename Vector::value_type>(i)) return false;
+    }
+    return seen == count;
+}
+
+int test_policies() {
+    mystl::vector<int, mystl::allocator<int>, tracked_double> d;
+    const size_t d_caps[] = {1, 2, 4, 8, 16, 32};
+    mystl::vector<int, mystl::allocator<int>, tracked_half> h;
+    const size_t h_caps[] = {1, 2, 3, 5, 8, 12, 18, 27};
+    mystl::vector<int, mystl::allocator<int>, mystl::growth_fixed<10>> f;
+    const size_t f_caps[] = {10, 20, 30};
+    if (!capacities(d, 20, d_caps, 6) || !capacities(h, 20, h_caps, 8) || !capacities(f, 30, f_caps, 3)) {
+        std::cout << "增长策略的容量序列错误" << std::endl;
+        return 1;
+    }
+
+    // 一次插入多个元素只增长一次，固定增量按步长取整
+    mystl::vector<int, mystl::allocator<int>, mystl::growth_fixed<10>> g(25, 1);
+    g.insert(g.begin(), 12, 2);
+    mystl::vector<int, mystl::allocator<int>, tracked_half> big(100, 1);
+    big.insert(big.begin() + 50, 300, 2);
+    if (g.capacity() != 45 || big.capacity() != 400 || big[50] != 2 || big[399] != 1) {
+        std::cout << "批量插入的新容量错误: " << g.capacity() << ", " << big.capacity() << std::endl;
+        return 1;
+    }
+
+    // resize 增长也按策略摊还
+    mystl::vector<int> r;
+    for (size_t i = 1; i <= 1000; ++i) r.resize(i);
+    if (r.capacity() != 1024) {
+        std::cout << "resize 未按增长策略扩容: " << r.capacity() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int test_size_class() {
+    // pool_allocator：容量凑满大小类，元素字节数恰为大小类大小
+    mystl::vector<int, mystl::pool_allocator<int>, tracked_class> v;
+    for (int i = 0; i < 100000; ++i) {
+        v.push_back(i);
+        const size_t bytes = v.capacity() * sizeof(int);
+        if (bytes <= mystl::MAX_BYTES && mystl::alloc::class_size(mystl::alloc::size_class(bytes)) != bytes) {
+            std::cout << "容量未取整到大小类: " << v.capacity() << std::endl;
+            return 2;
+        }
+    }
+
+    mystl::vector<char, mystl::pool_allocator<char>> c;
+    c.reserve_at_least(129);
+    mystl::vector<int, mystl::malloc_allocator<int>> m;
+    m.reserve_at_least(3001);
+    mystl::vector<double, mystl::huge_page_allocator<double>> hp;
+    hp.reserve_at_least(mystl::HUGE_PAGE_THRESHOLD / sizeof(double) + 1);
+    mystl::vector<int> plain;
+    plain.reserve_at_least(3001);
+    const size_t hp_expect = 2 * mystl::HUGE_PAGE_SIZE / sizeof(double);
+    if (c.capacity() != mystl::alloc::class_size(mystl::alloc::size_class(129)) || m.capacity() < 3001 ||
+        hp.capacity() != hp_expect || plain.capacity() != 3001) {
+        std::cout << "reserve_at_least 结果错误: " << c.capacity() << ", " << m.capacity() << ", " << hp.capacity()
+                  << ", " << plain.capacity() << std::endl;
+        return 2;
+    }
+#if defined(MYSTL_HAS_MALLOC_USABLE_SIZE)
+    // 取整后的容量都在 malloc 块之内，再增长到该容量是原地扩展
+    if (::malloc_usable_size(m.data()) < m.capacity() * sizeof(int)) {
+        std::cout << "malloc_good_size 超出实际可用字节" << std::endl;
+        return 2;
+    }
+#endif
+    return 0;
+}
+
+int test_stats() {
+    mystl::vector<int, mystl::allocator<int>, tracked_double> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+    // 1 -> 1024 共 11 次重新分配，搬移 1+2+...+512 个元素；扩到 1024 时空闲 511 个
+    const mystl::growth_stats& s = v.growth_stats();
+    if (s.reallocations != 11 || s.bytes_moved != 1023 * sizeof(int) || s.in_place_expansions != 0 ||
+        s.peak_wasted_bytes != 511 * sizeof(int)) {
+        std::cout << "计数器错误: " << s << std::endl;
+        return 3;
+    }
+    v.shrink_to_fit();
+    if (s.reallocations != 12 || s.bytes_moved != 2023 * sizeof(int)) return 3;
+
+    // 计数器不随拷贝、移动、交换转移
+    mystl::vector<int, mystl::allocator<int>, tracked_double> w(v);
+    mystl::vector<int, mystl::allocator<int>, tracked_double> x(mystl::move(w));
+    swap(x, v);
+    if (w.growth_stats().reallocations != 0 || x.growth_stats().reallocations != 0 || s.reallocations != 12) {
+        std::cout << "计数器随对象转移" << std::endl;
+        return 3;
+    }
+    v.reset_growth_stats();
+    if (s.reallocations != 0 || s.peak_wasted_bytes != 0) return 3;
+
+    // 内存区上原地扩展单独计数
+    mystl::monotonic_arena arena(1 << 20);
+    mystl::vector<int, mystl::arena_allocator<int>, tracked_double> a(arena);
+    for (int i = 0; i < 10000; ++i) a.push_back(i);
+    if (a.growth_stats().reallocations != 1 || a.growth_stats().in_place_expansions != 14) {
+        std::cout << "内存区计数器错误: " << a.growth_stats() << std::endl;
+        return 3;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试：各策略逐个 push_back 到 n 个 int
+// ============================================================================
+
+volatile long g_sink = 0;
+
+template <class Alloc, class Policy>
+void bench_policy(const char* name, size_t n) {
+    mystl::vector<int, Alloc, Policy> v;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(i));
+    auto end = std::chrono::high_resolution_clock::now();
+    g_sink = v[n / 2];
+    const mystl::growth_stats& s = v.growth_stats();
+    std::cout << std::left << std::setw(40) << name << std::setw(12)
+              << std::chrono::duration<double, std::milli>(end - start).count() << std::setw(12) << s.reallocations
+              << std::setw(12) << s.in_place_expansions << std::setw(14) << (s.bytes_moved >> 10) << std::setw(14)
+              << (s.peak_wasted_bytes >> 10) << 100.0 * static_cast<double>(v.size()) / static_cast<double>(v.capacity())
+              << "%" << std::endl;
+}
+
+template <class Alloc>
+void bench_allocator(const char* alloc_name, size_t n) {
+    std::cout << "\n--- " << alloc_name << " ---" << std::endl;
+    bench_policy<Alloc, tracked_double>("2x", n);
+    bench_policy<Alloc, tracked_half>("1.5x", n);
+    bench_policy<Alloc, tracked_class>("1.5x + 大小类取整", n);
+    bench_policy<Alloc, mystl::growth_tracked<mystl::growth_size_class<>>>("2x + 大小类取整", n);
+    bench_policy<Alloc, tracked_fixed>("固定 +1024", n / 16);
+}
+
+void run_benchmark(size_t n) {
+    std::cout << "\n=== vector<int> 逐个 push_back 到 " << n << " 个元素（固定增量为 n/16 个）===" << std::endl;
+    std::cout << std::left << std::setw(44) << "增长策略" << std::setw(14) << "耗时(ms)" << std::setw(16) << "重新分配"
+              << std::setw(16) << "原地扩展" << std::setw(16) << "搬移(KB)" << std::setw(18) << "空闲峰值(KB)"
+              << "最终利用率" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    bench_allocator<mystl::allocator<int>>("mystl::allocator", n);
+    bench_allocator<mystl::pool_allocator<int>>("pool_allocator", n);
+    bench_allocator<mystl::malloc_allocator<int>>("malloc_allocator", n);
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 4000000;
+    if (n < 16) n = 16;
+
+    int rc = test_policies();
+    if (rc == 0) rc = test_size_class();
+    if (rc == 0) rc = test_stats();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_growth_policy: 正确性测试通过" << std::endl;
+
+    run_benchmark(n);
+    return 0;
+}
@@ -0,0 +1,172 @@
+// mystl::inplace_merge 正确性与性能测试：完整缓冲区 / 部分缓冲区 / 无缓冲区三条路径，与 std::inplace_merge 对比
+// 编译：g++ -std=c++11 -O2 -I.. test_inplace_merge_performance.cpp -o test_inplace_merge_performance
+// 运行：./test_inplace_merge_performance [最大规模，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "algorithm.h"
+
+// 记录原始位置，用于检查稳定性
+struct record {
+    int key;
+    size_t index;
+};
+
+bool record_key_less(const record& a, const record& b) {
+    return a.key < b.key;
+}
+
+// 生成 [0, mid) 与 [mid, n) 两段各自有序的数据
+std::vector<record> make_two_runs(size_t n, size_t mid, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<record> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = record{static_cast<int>(gen() % 1000), i};
+    std::stable_sort(v.begin(), v.begin() + mid, record_key_less);
+    std::stable_sort(v.begin() + mid, v.end(), record_key_less);
+    return v;
+}
+
+bool same_records(const std::vector<record>& a, const std::vector<record>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].key != b[i].key || a[i].index != b[i].index) return false;
+    }
+    return a.size() == b.size();
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+int test_correctness() {
+    const size_t sizes[] = {0, 1, 2, 3, 10, 100, 1000, 4097};
+
+    for (size_t n : sizes) {
+        for (size_t mid : {size_t(0), n / 5, n / 2, n - n / 7, n}) {
+            auto base = make_two_runs(n, mid, 42);
+            auto expect = base;
+            std::inplace_merge(expect.begin(), expect.begin() + mid, expect.end(), record_key_less);
+
+            auto v = base;
+            mystl::inplace_merge(v.begin(), v.begin() + mid, v.end(), record_key_less);
+            if (!same_records(v, expect)) {
+                std::cout << "inplace_merge 结果错误: n=" << n << " mid=" << mid << std::endl;
+                return 1;
+            }
+
+            // 直接指定缓冲区容量，覆盖部分缓冲区与无缓冲区路径
+            for (ptrdiff_t buf_size : {ptrdiff_t(0), ptrdiff_t(1), ptrdiff_t(7), ptrdiff_t(n / 8 + 1)}) {
+                auto w = base;
+                std::vector<record> buffer(static_cast<size_t>(buf_size));
+                mystl::merge_adaptive(w.begin(), w.begin() + mid, w.end(),
+                                      static_cast<ptrdiff_t>(mid), static_cast<ptrdiff_t>(n - mid),
+                                      buffer.data(), buf_size, record_key_less);
+                if (!same_records(w, expect)) {
+                    std::cout << "merge_adaptive 结果错误: n=" << n << " mid=" << mid
+                              << " buffer=" << buf_size << std::endl;
+                    return 2;
+                }
+            }
+        }
+    }
+
+    // 非平凡类型：temporary_buffer 以种子元素构造缓冲区，种子的值必须保持不变
+    std::vector<std::string> s;
+    std::mt19937 gen(1);
+    for (int i = 0; i < 3000; ++i) s.push_back(std::to_string(gen() % 1000));
+    {
+        mystl::temporary_buffer<std::string> buf(s.begin(), 100);
+        if (buf.size() != 100 || buf.requested_size() != 100 || s[0].empty()) {
+            std::cout << "temporary_buffer 错误" << std::endl;
+            return 3;
+        }
+    }
+    std::sort(s.begin(), s.begin() + 1000);
+    std::sort(s.begin() + 1000, s.end());
+    auto expect = s;
+    std::inplace_merge(expect.begin(), expect.begin() + 1000, expect.end());
+    mystl::inplace_merge(s.begin(), s.begin() + 1000, s.end());
+    if (s != expect) {
+        std::cout << "字符串合并错误" << std::endl;
+        return 4;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+template <class Merger>
+double time_merge(const std::vector<int>& data, size_t mid, Merger merger) {
+    auto v = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    merger(v, mid);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!std::is_sorted(v.begin(), v.end())) {
+        std::cout << "性能测试中合并结果错误" << std::endl;
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void run_benchmark(size_t max_n) {
+    std::cout << "\n=== mystl::inplace_merge vs std::inplace_merge（单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(12) << "规模" << std::setw(12) << "左段占比"
+              << std::setw(14) << "mystl" << std::setw(14) << "部分缓冲区" << std::setw(14) << "无缓冲区"
+              << std::setw(14) << "std" << "mystl/std" << std::endl;
+
+    std::mt19937 gen(2024);
+    for (size_t n = 10000; n <= max_n; n *= 10) {
+        for (int percent : {10, 50, 90}) {
+            const size_t mid = n * percent / 100;
+            std::vector<int> data(n);
+            for (auto& x : data) x = static_cast<int>(gen());
+            std::sort(data.begin(), data.begin() + mid);
+            std::sort(data.begin() + mid, data.end());
+
+            double t_my = time_merge(data, mid, [](std::vector<int>& v, size_t m) {
+                mystl::inplace_merge(v.begin(), v.begin() + m, v.end());
+            });
+            // 缓冲区只有较短一段的 1/16
+            double t_partial = time_merge(data, mid, [](std::vector<int>& v, size_t m) {
+                const ptrdiff_t len1 = static_cast<ptrdiff_t>(m);
+                const ptrdiff_t len2 = static_cast<ptrdiff_t>(v.size() - m);
+                std::vector<int> buffer(static_cast<size_t>(std::min(len1, len2) / 16 + 1));
+                mystl::merge_adaptive(v.begin(), v.begin() + m, v.end(), len1, len2,
+                                      buffer.data(), static_cast<ptrdiff_t>(buffer.size()),
+                                      mystl::less<int>());
+            });
+            double t_none = time_merge(data, mid, [](std::vector<int>& v, size_t m) {
+                mystl::merge_without_buffer(v.begin(), v.begin() + m, v.end(),
+                                            static_cast<ptrdiff_t>(m), static_cast<ptrdiff_t>(v.size() - m),
+                                            mystl::less<int>());
+            });
+            double t_std = time_merge(data, mid, [](std::vector<int>& v, size_t m) {
+                std::inplace_merge(v.begin(), v.begin() + m, v.end());
+            });
+            std::cout << std::left << std::setw(12) << n << std::setw(12) << percent
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(14) << t_my << std::setw(14) << t_partial << std::setw(14) << t_none
+                      << std::setw(14) << t_std
+                      << std::setprecision(2) << (t_std > 0 ? t_my / t_std : 0.0) << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_inplace_merge_performance: 正确性测试通过" << std::endl;
+
+    run_benchmark(max_n);
+    return 0;
+}
@@ -0,0 +1,331 @@
+// mystl::pmr 内存资源与 pmr::vector/list/deque 的正确性测试，以及运行时切换分配策略的性能对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_memory_resource.cpp -o test_memory_resource
+// 运行：./test_memory_resource [模拟请求数，默认 20000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "memory_resource.h"
+#include "vector.h"
+#include "list.h"
+#include "deque.h"
+
+namespace pmr = mystl::pmr;
+
+// ============================================================================
+// 工具
+// ============================================================================
+
+// 转发给上游并统计调用次数与未释放字节数的资源
+class counting_resource : public pmr::memory_resource {
+public:
+    explicit counting_resource(pmr::memory_resource* upstream = pmr::new_delete_resource())
+        : allocations(0), deallocations(0), outstanding(0), upstream_(upstream) {}
+
+    size_t allocations;
+    size_t deallocations;
+    long   outstanding;
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        ++allocations;
+        outstanding += static_cast<long>(bytes);
+        return upstream_->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        ++deallocations;
+        outstanding -= static_cast<long>(bytes);
+        upstream_->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override { return &other == this; }
+
+    pmr::memory_resource* upstream_;
+};
+
+struct alignas(64) padded {
+    int value;
+    explicit padded(int v = 0) : value(v) {}
+};
+
+struct alignas(16) vec4 {
+    float x, y, z, w;
+};
+
+// 同一份代码处理任意资源上的容器：调用方只在运行时决定资源
+long build(pmr::memory_resource* r, int n) {
+    pmr::vector<int> v(r);
+    pmr::list<int> l(r);
+    pmr::deque<int> d(r);
+    for (int i = 0; i < n; ++i) {
+        v.push_back(i);
+        l.push_back(2 * i);
+        d.push_front(3 * i);
+    }
+    pmr::vector<int> copy(v);
+    pmr::list<int> moved(mystl::move(l));
+    long sum = 0;
+    for (int x : copy) sum += x;
+    for (int x : moved) sum += x;
+    for (int i = 0; i < n; ++i) sum += d[static_cast<size_t>(i)];
+    return sum;
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+int test_resources() {
+    const int n = 5000;
+    const long expect = 6L * (n - 1) * n / 2;
+
+    pmr::synchronized_pool_resource sync_pool;
+    pmr::unsynchronized_pool_resource pool;
+    pmr::monotonic_buffer_resource mono;
+    char buffer[4096];
+    pmr::monotonic_buffer_resource buffered(buffer, sizeof(buffer));
+    counting_resource counted;
+
+    pmr::memory_resource* resources[] = {pmr::new_delete_resource(), &sync_pool, &pool, &mono, &buffered, &counted};
+    for (pmr::memory_resource* r : resources) {
+        if (build(r, n) != expect) {
+            std::cout << "资源上的容器结果错误" << std::endl;
+            return 1;
+        }
+    }
+    if (counted.allocations == 0 || counted.allocations != counted.deallocations || counted.outstanding != 0) {
+        std::cout << "容器未经资源分配或未全部释放: " << counted.allocations << " / " << counted.deallocations
+                  << std::endl;
+        return 2;
+    }
+
+    // 默认资源
+    counting_resource dflt;
+    pmr::memory_resource* old = pmr::set_default_resource(&dflt);
+    {
+        pmr::vector<int> v;
+        pmr::list<int> l;
+        v.push_back(1);
+        l.push_back(1);
+        if (v.get_allocator().resource() != &dflt) return 3;
+    }
+    pmr::set_default_resource(old);
+    if (dflt.allocations == 0 || dflt.outstanding != 0 || pmr::get_default_resource() != old) {
+        std::cout << "默认资源未生效" << std::endl;
+        return 3;
+    }
+
+    // 空资源
+    bool thrown = false;
+    try {
+        pmr::vector<int> v(pmr::null_memory_resource());
+        v.push_back(1);
+    } catch (const std::bad_alloc&) {
+        thrown = true;
+    }
+    if (!thrown) {
+        std::cout << "null_memory_resource 未抛出 bad_alloc" << std::endl;
+        return 4;
+    }
+
+    // 相等性
+    pmr::synchronized_pool_resource sync_pool2;
+    pmr::unsynchronized_pool_resource pool2;
+    if (!(sync_pool == sync_pool2) || pool == pool2 || !(*pmr::new_delete_resource() == *pmr::new_delete_resource()) ||
+        pmr::polymorphic_allocator<int>(&pool) == pmr::polymorphic_allocator<long>(&pool2)) {
+        std::cout << "资源相等性错误" << std::endl;
+        return 5;
+    }
+    return 0;
+}
+
+int test_alignment() {
+    pmr::synchronized_pool_resource sync_pool;
+    pmr::unsynchronized_pool_resource pool;
+    pmr::monotonic_buffer_resource mono;
+    pmr::memory_resource* resources[] = {pmr::new_delete_resource(), &sync_pool, &pool, &mono};
+    for (pmr::memory_resource* r : resources) {
+        pmr::vector<padded> a(r);
+        pmr::list<vec4> b(r);
+        for (int i = 0; i < 100; ++i) {
+            a.push_back(padded(i));
+            b.push_back(vec4());
+            pmr::vector<vec4> c(static_cast<size_t>(i + 1), vec4(), r);
+            if (reinterpret_cast<uintptr_t>(a.data()) % 64 != 0 || reinterpret_cast<uintptr_t>(&b.back()) % 16 != 0 ||
+                reinterpret_cast<uintptr_t>(c.data()) % 16 != 0) {
+                std::cout << "过对齐类型分配未对齐" << std::endl;
+                return 6;
+            }
+        }
+        if (a[99].value != 99) return 6;
+    }
+    return 0;
+}
+
+int test_unsynchronized_pool() {
+    counting_resource upstream;
+    {
+        pmr::unsynchronized_pool_resource pool(&upstream);
+        // 释放后同一大小类立即复用
+        void* p = pool.allocate(40);
+        pool.deallocate(p, 40);
+        if (pool.allocate(40) != p) {
+            std::cout << "单线程池未复用释放的对象" << std::endl;
+            return 7;
+        }
+        // 小对象按块向上游申请，块数远小于对象数
+        for (int i = 0; i < 100000; ++i) pool.allocate(static_cast<size_t>(i % 200 + 1));
+        if (upstream.allocations > 20) {
+            std::cout << "单线程池向上游申请过于频繁: " << upstream.allocations << std::endl;
+            return 7;
+        }
+        // 大块直接转给上游，可单独释放，也会在 release() 时归还
+        void* big = pool.allocate(1 << 20);
+        void* big2 = pool.allocate(100000, 4096);
+        if (reinterpret_cast<uintptr_t>(big2) % 4096 != 0) return 7;
+        pool.deallocate(big, 1 << 20);
+        pool.release();
+        if (upstream.outstanding != 0) {
+            std::cout << "release() 未归还全部上游内存" << std::endl;
+            return 8;
+        }
+        pool.allocate(16);
+    }
+    // 析构时归还
+    if (upstream.outstanding != 0) return 8;
+    return 0;
+}
+
+int test_synchronized_pool_threads() {
+    pmr::synchronized_pool_resource pool;
+    std::vector<std::thread> workers;
+    std::vector<long> sums(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        workers.push_back(std::thread([t, &pool, &sums] {
+            pmr::list<long> l(&pool);
+            pmr::vector<long> v(&pool);
+            for (long i = 0; i < 50000; ++i) {
+                l.push_back(i);
+                v.push_back(i);
+            }
+            for (long x : l) sums[t] += x;
+            for (long x : v) sums[t] -= x;
+        }));
+    }
+    for (auto& w : workers) w.join();
+    for (long s : sums) {
+        if (s != 0) {
+            std::cout << "多线程共享内存池结果错误" << std::endl;
+            return 9;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试：同一份 pmr 容器代码在不同资源上运行
+// ============================================================================
+
+static const int kContainersPerRequest = 24;
+static const int kElementsPerContainer = 16;
+
+volatile long g_sink = 0;
+
+template <class Vector, class List, class Deque, class Alloc>
+long handle_request(const Alloc& alloc, int seed) {
+    long acc = 0;
+    for (int c = 0; c < kContainersPerRequest; ++c) {
+        Vector v(alloc);
+        List l(alloc);
+        for (int i = 0; i < kElementsPerContainer; ++i) {
+            v.push_back(seed + i);
+            l.push_back(seed - i);
+        }
+        for (int x : v) acc += x;
+        for (int x : l) acc -= x;
+    }
+    Deque d(alloc);
+    for (int i = 0; i < kContainersPerRequest * kElementsPerContainer; ++i) d.push_back(i);
+    acc += d.back();
+    return acc;
+}
+
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double bench_pmr(pmr::memory_resource* r, pmr::monotonic_buffer_resource* mono, int requests) {
+    return time_ms([r, mono, requests] {
+        long acc = 0;
+        for (int i = 0; i < requests; ++i) {
+            acc += handle_request<pmr::vector<int>, pmr::list<int>, pmr::deque<int>>(
+                pmr::polymorphic_allocator<int>(r), i);
+            if (mono != nullptr) mono->release();
+        }
+        g_sink = acc;
+    });
+}
+
+void run_benchmark(int requests) {
+    const double t_static = time_ms([requests] {
+        long acc = 0;
+        for (int i = 0; i < requests; ++i) {
+            acc += handle_request<mystl::vector<int>, mystl::list<int>, mystl::deque<int>>(
+                mystl::allocator<int>(), i);
+        }
+        g_sink = acc;
+    });
+
+    pmr::synchronized_pool_resource sync_pool;
+    pmr::unsynchronized_pool_resource pool;
+    pmr::monotonic_buffer_resource mono(1 << 16);
+    const double t_new = bench_pmr(pmr::new_delete_resource(), nullptr, requests);
+    const double t_sync = bench_pmr(&sync_pool, nullptr, requests);
+    const double t_pool = bench_pmr(&pool, nullptr, requests);
+    const double t_mono = bench_pmr(&mono, &mono, requests);
+
+    std::cout << "\n=== 请求级临时容器（每请求 " << kContainersPerRequest << " 个 vector + " << kContainersPerRequest
+              << " 个 list，各 " << kElementsPerContainer << " 个元素，外加 1 个 deque；" << requests
+              << " 个请求，单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(40) << "分配方式" << std::setw(14) << "耗时" << "相对静态分配器" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    struct row {
+        const char* name;
+        double      ms;
+    } rows[] = {
+        {"mystl::allocator（静态类型）", t_static},
+        {"pmr new_delete_resource", t_new},
+        {"pmr synchronized_pool_resource", t_sync},
+        {"pmr unsynchronized_pool_resource", t_pool},
+        {"pmr monotonic_buffer_resource", t_mono},
+    };
+    for (const row& r : rows) {
+        std::cout << std::left << std::setw(40) << r.name << std::setw(14) << r.ms
+                  << (r.ms > 0 ? t_static / r.ms : 0.0) << "x" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int requests = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    int rc = test_resources();
+    if (rc == 0) rc = test_alignment();
+    if (rc == 0) rc = test_unsynchronized_pool();
+    if (rc == 0) rc = test_synchronized_pool_threads();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_memory_resource: 正确性测试通过" << std::endl;
+
+    run_benchmark(requests);
+    return 0;
+}
@@ -0,0 +1,242 @@
+// mystl::execution::par 并行排序的正确性与扩展性测试：sort / stable_sort / partial_sort
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_parallel_sort_performance.cpp -o test_parallel_sort_performance
+// 运行：./test_parallel_sort_performance [最大规模，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <cstdlib>
+#include "algorithm.h"
+#include "execution.h"
+
+// ============================================================================
+// 数据生成
+// ============================================================================
+
+std::vector<int> make_random(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<int> v(n);
+    for (auto& x : v) x = static_cast<int>(gen());
+    return v;
+}
+
+std::vector<int> make_few_unique(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<int> v(n);
+    for (auto& x : v) x = static_cast<int>(gen() % 16);
+    return v;
+}
+
+std::vector<int> make_sorted(size_t n) {
+    std::vector<int> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(i);
+    return v;
+}
+
+std::vector<int> make_reversed(size_t n) {
+    std::vector<int> v = make_sorted(n);
+    std::reverse(v.begin(), v.end());
+    return v;
+}
+
+struct record {
+    int    key;
+    size_t index;
+};
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+bool check_sort(mystl::thread_pool& pool, const std::vector<int>& data) {
+    auto expect = data;
+    std::sort(expect.begin(), expect.end());
+
+    auto a = data;
+    mystl::sort(mystl::execution::par.on(pool), a.begin(), a.end());
+    auto b = data;
+    mystl::stable_sort(mystl::execution::par.on(pool), b.begin(), b.end());
+    auto c = data;
+    mystl::sort(mystl::execution::par.on(pool), c.begin(), c.end(), std::greater<int>());
+    std::reverse(c.begin(), c.end());
+    auto d = data;
+    mystl::sort(mystl::execution::seq, d.begin(), d.end());
+    return a == expect && b == expect && c == expect && d == expect;
+}
+
+bool check_stable(mystl::thread_pool& pool, size_t n) {
+    std::mt19937 gen(7);
+    std::vector<record> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = record{static_cast<int>(gen() % 100), i};
+    mystl::stable_sort(mystl::execution::par.on(pool), v.begin(), v.end(),
+                       [](const record& x, const record& y) { return x.key < y.key; });
+    for (size_t i = 1; i < n; ++i) {
+        if (v[i - 1].key > v[i].key || (v[i - 1].key == v[i].key && v[i - 1].index > v[i].index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool check_partial_sort(mystl::thread_pool& pool, const std::vector<int>& data, size_t k) {
+    auto expect = data;
+    std::sort(expect.begin(), expect.end());
+
+    auto v = data;
+    mystl::partial_sort(mystl::execution::par.on(pool), v.begin(), v.begin() + k, v.end());
+    if (!std::equal(v.begin(), v.begin() + k, expect.begin())) {
+        return false;
+    }
+    // 剩余元素必须是原区间中其余元素的一个排列
+    std::sort(v.begin() + k, v.end());
+    return v == expect;
+}
+
+int test_correctness() {
+    mystl::thread_pool pool(4);
+    const size_t sizes[] = {0, 1, 2, 1000, 40000, 200000, 300001};
+
+    for (size_t n : sizes) {
+        if (!check_sort(pool, make_random(n, 1)) || !check_sort(pool, make_few_unique(n, 2)) ||
+            !check_sort(pool, make_sorted(n)) || !check_sort(pool, make_reversed(n))) {
+            std::cout << "并行 sort / stable_sort 结果错误: n=" << n << std::endl;
+            return 1;
+        }
+        if (!check_stable(pool, n)) {
+            std::cout << "并行 stable_sort 不稳定: n=" << n << std::endl;
+            return 2;
+        }
+        const size_t ks[] = {0, 1, 10, n / 100, n / 5, n / 2, n};
+        for (size_t k : ks) {
+            k = std::min(k, n);
+            if (!check_partial_sort(pool, make_random(n, 3), k) ||
+                !check_partial_sort(pool, make_few_unique(n, 4), k)) {
+                std::cout << "并行 partial_sort 结果错误: n=" << n << " k=" << k << std::endl;
+                return 3;
+            }
+        }
+    }
+
+    // 字符串：非平凡类型经过缓冲区移动
+    std::mt19937 gen(5);
+    std::vector<std::string> strs(100000);
+    for (auto& s : strs) s = std::to_string(gen());
+    auto expect = strs;
+    std::sort(expect.begin(), expect.end());
+    auto s1 = strs;
+    mystl::sort(mystl::execution::par.on(pool), s1.begin(), s1.end());
+    auto s2 = strs;
+    mystl::stable_sort(mystl::execution::par.on(pool), s2.begin(), s2.end());
+    if (s1 != expect || s2 != expect) {
+        std::cout << "并行字符串排序错误" << std::endl;
+        return 4;
+    }
+
+    // 在工作线程内嵌套调用，以及使用默认线程池
+    auto nested = make_random(100000, 6);
+    mystl::task_group group(pool);
+    group.run([&] { mystl::sort(mystl::execution::par.on(pool), nested.begin(), nested.end()); });
+    group.wait();
+    auto with_default = make_random(100000, 6);
+    mystl::sort(mystl::execution::par, with_default.begin(), with_default.end());
+    if (!std::is_sorted(nested.begin(), nested.end()) || nested != with_default) {
+        std::cout << "嵌套或默认线程池排序错误" << std::endl;
+        return 5;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 扩展性测试
+// ============================================================================
+
+template <class Sorter>
+double time_sort(const std::vector<int>& data, Sorter sorter) {
+    auto v = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    sorter(v);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!std::is_sorted(v.begin(), v.end())) {
+        std::cout << "性能测试中排序结果错误" << std::endl;
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// partial_sort 只检查前 k 个
+template <class Sorter>
+double time_partial_sort(const std::vector<int>& data, size_t k, Sorter sorter) {
+    auto v = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    sorter(v);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!std::is_sorted(v.begin(), v.begin() + k)) {
+        std::cout << "性能测试中部分排序结果错误" << std::endl;
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void print_row(const char* name, size_t threads, double t, double serial) {
+    std::cout << std::left << std::setw(18) << name << std::setw(10) << threads
+              << std::fixed << std::setprecision(3) << std::setw(14) << t
+              << std::setprecision(2) << (t > 0 ? serial / t : 0.0) << "x" << std::endl;
+}
+
+void run_benchmark(size_t max_n) {
+    const std::vector<int> data = make_random(max_n, 2024);
+    const size_t k = max_n / 100;
+
+    const double serial_sort = time_sort(data, [](std::vector<int>& v) { mystl::sort(v.begin(), v.end()); });
+    const double serial_stable =
+        time_sort(data, [](std::vector<int>& v) { mystl::stable_sort(v.begin(), v.end()); });
+    const double serial_partial = time_partial_sort(data, k, [k](std::vector<int>& v) {
+        mystl::partial_sort(v.begin(), v.begin() + k, v.end());
+    });
+
+    std::cout << "\n=== 并行排序扩展性（规模 " << max_n << "，partial_sort k=" << k
+              << "，硬件线程 " << mystl::thread_pool::default_thread_count() << "，单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(18) << "算法" << std::setw(10) << "线程数"
+              << std::setw(14) << "耗时" << "相对串行加速比" << std::endl;
+    print_row("sort", 0, serial_sort, serial_sort);
+    print_row("stable_sort", 0, serial_stable, serial_stable);
+    print_row("partial_sort", 0, serial_partial, serial_partial);
+
+    std::vector<size_t> thread_counts = {1, 2, 4, 8, 16};
+    const size_t all = mystl::thread_pool::default_thread_count();
+    if (std::find(thread_counts.begin(), thread_counts.end(), all) == thread_counts.end()) {
+        thread_counts.push_back(all);
+    }
+    for (size_t threads : thread_counts) {
+        mystl::thread_pool pool(threads);
+        auto policy = mystl::execution::par.on(pool);
+        print_row("par sort", threads, time_sort(data, [&](std::vector<int>& v) {
+            mystl::sort(policy, v.begin(), v.end());
+        }), serial_sort);
+        print_row("par stable_sort", threads, time_sort(data, [&](std::vector<int>& v) {
+            mystl::stable_sort(policy, v.begin(), v.end());
+        }), serial_stable);
+        print_row("par partial_sort", threads, time_partial_sort(data, k, [&](std::vector<int>& v) {
+            mystl::partial_sort(policy, v.begin(), v.begin() + k, v.end());
+        }), serial_partial);
+    }
+    std::cout << "（线程数 0 表示串行版本）" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_parallel_sort_performance: 正确性测试通过" << std::endl;
+
+    run_benchmark(max_n);
+    return 0;
+}
@@ -0,0 +1,212 @@
+// mystl::radix_sort 正确性与性能测试：整数、浮点与字符串键，与 mystl::sort / std::sort 对比
+// 编译：g++ -std=c++11 -O2 -I.. test_radix_sort_performance.cpp -o test_radix_sort_performance
+// 运行：./test_radix_sort_performance [最大规模，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstdlib>
+#include "algorithm.h"
+#include "vector.h"
+
+// ============================================================================
+// 数据生成
+// ============================================================================
+
+template <class T>
+std::vector<T> make_integers(size_t n, unsigned seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<T> v(n);
+    for (auto& x : v) x = static_cast<T>(gen());
+    return v;
+}
+
+// 取值范围很小的 ID：高位字节全部相同，对应的趟会被跳过
+template <class T>
+std::vector<T> make_small_ids(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<T> v(n);
+    for (auto& x : v) x = static_cast<T>(gen() % 50000);
+    return v;
+}
+
+template <class T>
+std::vector<T> make_floats(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<T> dist(-1e6, 1e6);
+    std::vector<T> v(n);
+    for (auto& x : v) x = dist(gen);
+    return v;
+}
+
+std::vector<std::string> make_strings(size_t n, unsigned seed, const std::string& prefix) {
+    std::mt19937 gen(seed);
+    std::vector<std::string> v(n);
+    for (auto& s : v) {
+        s = prefix;
+        const size_t len = gen() % 16;
+        for (size_t i = 0; i < len; ++i) s.push_back(static_cast<char>('a' + gen() % 26));
+    }
+    return v;
+}
+
+struct event {
+    uint64_t id;
+    double   score;
+    size_t   index;
+};
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+template <class T>
+bool check_sorted_like_std(std::vector<T> v) {
+    auto expect = v;
+    std::sort(expect.begin(), expect.end());
+    mystl::radix_sort(v.begin(), v.end());
+    return v == expect;
+}
+
+int test_correctness() {
+    const size_t sizes[] = {0, 1, 2, 100, 127, 128, 1000, 100000};
+
+    for (size_t n : sizes) {
+        if (!check_sorted_like_std(make_integers<int32_t>(n, 1)) ||
+            !check_sorted_like_std(make_integers<uint32_t>(n, 2)) ||
+            !check_sorted_like_std(make_integers<int64_t>(n, 3)) ||
+            !check_sorted_like_std(make_integers<uint64_t>(n, 4)) ||
+            !check_sorted_like_std(make_integers<int16_t>(n, 5)) ||
+            !check_sorted_like_std(make_integers<unsigned char>(n, 6)) ||
+            !check_sorted_like_std(make_small_ids<int64_t>(n, 7))) {
+            std::cout << "整数排序错误: n=" << n << std::endl;
+            return 1;
+        }
+        if (!check_sorted_like_std(make_floats<float>(n, 8)) ||
+            !check_sorted_like_std(make_floats<double>(n, 9))) {
+            std::cout << "浮点排序错误: n=" << n << std::endl;
+            return 2;
+        }
+        if (!check_sorted_like_std(make_strings(n, 10, "")) ||
+            !check_sorted_like_std(make_strings(n, 11, "user/2024/09/"))) {
+            std::cout << "字符串排序错误: n=" << n << std::endl;
+            return 3;
+        }
+    }
+
+    // 浮点特殊值
+    std::vector<double> special = {3.5, -0.0, 0.0, -1e300, std::numeric_limits<double>::infinity(),
+                                   -std::numeric_limits<double>::infinity(), 1e-300, -2.0, 2.0};
+    for (int i = 0; i < 200; ++i) special.push_back(i * 0.5 - 50);
+    auto special_expect = special;
+    std::sort(special_expect.begin(), special_expect.end());
+    mystl::radix_sort(special.begin(), special.end());
+    if (special != special_expect) {
+        std::cout << "浮点特殊值排序错误" << std::endl;
+        return 4;
+    }
+
+    // 键提取：按 id 排序且保持稳定，按 score 排序
+    std::mt19937 gen(12);
+    std::vector<event> events(20000);
+    for (size_t i = 0; i < events.size(); ++i) {
+        events[i] = event{gen() % 1000, (gen() % 2000) * 0.25 - 250, i};
+    }
+    auto by_id = events;
+    mystl::radix_sort(by_id.begin(), by_id.end(), [](const event& e) { return e.id; });
+    for (size_t i = 1; i < by_id.size(); ++i) {
+        if (by_id[i - 1].id > by_id[i].id ||
+            (by_id[i - 1].id == by_id[i].id && by_id[i - 1].index > by_id[i].index)) {
+            std::cout << "按 id 排序错误或不稳定" << std::endl;
+            return 5;
+        }
+    }
+    auto by_score = events;
+    mystl::radix_sort(by_score.begin(), by_score.end(), [](const event& e) { return e.score; });
+    for (size_t i = 1; i < by_score.size(); ++i) {
+        if (by_score[i - 1].score > by_score[i].score) {
+            std::cout << "按 score 排序错误" << std::endl;
+            return 6;
+        }
+    }
+
+    // mystl::vector 与原生指针区间
+    mystl::vector<uint32_t> mv;
+    for (auto x : make_integers<uint32_t>(5000, 13)) mv.push_back(x);
+    mystl::radix_sort(mv.begin(), mv.end());
+    if (!std::is_sorted(mv.begin(), mv.end())) {
+        std::cout << "mystl::vector 排序错误" << std::endl;
+        return 7;
+    }
+    auto raw = make_integers<int32_t>(3000, 14);
+    mystl::radix_sort(raw.data(), raw.data() + raw.size());
+    if (!std::is_sorted(raw.begin(), raw.end())) {
+        std::cout << "原生指针区间排序错误" << std::endl;
+        return 8;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+template <class T, class Sorter>
+double time_sort(const std::vector<T>& data, Sorter sorter) {
+    auto v = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    sorter(v);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!std::is_sorted(v.begin(), v.end())) {
+        std::cout << "性能测试中排序结果错误" << std::endl;
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <class T>
+void bench_row(const char* name, const std::vector<T>& data) {
+    double t_radix = time_sort(data, [](std::vector<T>& v) { mystl::radix_sort(v.begin(), v.end()); });
+    double t_sort = time_sort(data, [](std::vector<T>& v) { mystl::sort(v.begin(), v.end()); });
+    double t_std = time_sort(data, [](std::vector<T>& v) { std::sort(v.begin(), v.end()); });
+    std::cout << std::left << std::setw(20) << name << std::setw(12) << data.size()
+              << std::fixed << std::setprecision(3)
+              << std::setw(14) << t_radix << std::setw(14) << t_sort << std::setw(14) << t_std
+              << std::setprecision(2) << (t_sort > 0 ? t_radix / t_sort : 0.0) << std::endl;
+}
+
+void run_benchmark(size_t max_n) {
+    std::cout << "\n=== mystl::radix_sort vs mystl::sort / std::sort（单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(20) << "键类型" << std::setw(12) << "规模"
+              << std::setw(14) << "radix_sort" << std::setw(14) << "mystl::sort" << std::setw(14) << "std"
+              << "radix/sort" << std::endl;
+
+    for (size_t n = 10000; n <= max_n; n *= 10) {
+        bench_row("uint32", make_integers<uint32_t>(n, 2024));
+        bench_row("int32", make_integers<int32_t>(n, 2024));
+        bench_row("int64", make_integers<int64_t>(n, 2024));
+        bench_row("int64 small ids", make_small_ids<int64_t>(n, 2024));
+        bench_row("float", make_floats<float>(n, 2024));
+        bench_row("double", make_floats<double>(n, 2024));
+        bench_row("string", make_strings(n, 2024, ""));
+        bench_row("string prefix", make_strings(n, 2024, "user/2024/09/"));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_radix_sort_performance: 正确性测试通过" << std::endl;
+
+    run_benchmark(max_n);
+    return 0;
+}
@@ -0,0 +1,256 @@
+// mystl::reduce / transform_reduce / 并行 inner_product 的正确性、精度与性能测试
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_reduce_performance.cpp -o test_reduce_performance
+// 运行：./test_reduce_performance [最大规模，默认 10000000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <list>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include "algorithm.h"
+#include "execution.h"
+
+// ============================================================================
+// 数据生成
+// ============================================================================
+
+std::vector<double> make_doubles(size_t n, unsigned seed) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> v(n);
+    for (auto& x : v) x = dist(gen);
+    return v;
+}
+
+// 用 long double 与 Kahan 求和计算参考值
+long double reference_sum(const std::vector<double>& v) {
+    long double sum = 0, comp = 0;
+    for (double x : v) {
+        const long double y = x - comp;
+        const long double t = sum + y;
+        comp = (t - sum) - y;
+        sum = t;
+    }
+    return sum;
+}
+
+// 病态数据：数量级相差悬殊，正负大数相互抵消，朴素求和误差很大。
+// 大数是 2 的幂且成对抵消，精确和等于所有小数之和，由 exact 返回
+std::vector<double> make_ill_conditioned(size_t n, unsigned seed, double& exact) {
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<double> v, small;
+    v.reserve(n);
+    while (v.size() + 3 <= n) {
+        const double big = std::ldexp(1.0, static_cast<int>(gen() % 40));
+        small.push_back(dist(gen));
+        v.push_back(big);
+        v.push_back(small.back());
+        v.push_back(-big);
+    }
+    while (v.size() < n) {
+        small.push_back(dist(gen));
+        v.push_back(small.back());
+    }
+    exact = static_cast<double>(reference_sum(small));
+    return v;
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+int test_correctness() {
+    mystl::thread_pool pool(4);
+    auto par = mystl::execution::par.on(pool);
+    const size_t sizes[] = {0, 1, 7, 8, 9, 100, 1000, 70000, 300001};
+
+    for (size_t n : sizes) {
+        std::vector<int64_t> v(n);
+        std::mt19937 gen(static_cast<unsigned>(n));
+        for (auto& x : v) x = static_cast<int64_t>(gen() % 1000) - 500;
+        const int64_t expect = mystl::accumulate(v.begin(), v.end(), int64_t(7));
+
+        if (mystl::reduce(v.begin(), v.end(), int64_t(7)) != expect ||
+            mystl::reduce(par, v.begin(), v.end(), int64_t(7)) != expect ||
+            mystl::reduce(mystl::execution::seq, v.begin(), v.end(), int64_t(7)) != expect ||
+            mystl::reduce(par, v.begin(), v.end()) + 7 != expect) {
+            std::cout << "reduce 结果错误: n=" << n << std::endl;
+            return 1;
+        }
+        const int64_t max_expect = n == 0 ? INT64_MIN : *std::max_element(v.begin(), v.end());
+        auto max_op = [](int64_t a, int64_t b) { return a < b ? b : a; };
+        if (mystl::reduce(v.begin(), v.end(), INT64_MIN, max_op) != max_expect ||
+            mystl::reduce(par, v.begin(), v.end(), INT64_MIN, max_op) != max_expect) {
+            std::cout << "reduce(max) 结果错误: n=" << n << std::endl;
+            return 2;
+        }
+
+        const int64_t dot = mystl::inner_product(v.begin(), v.end(), v.begin(), int64_t(0));
+        auto square = [](int64_t x) { return x * x; };
+        if (mystl::transform_reduce(v.begin(), v.end(), v.begin(), int64_t(0)) != dot ||
+            mystl::transform_reduce(par, v.begin(), v.end(), v.begin(), int64_t(0)) != dot ||
+            mystl::inner_product(par, v.begin(), v.end(), v.begin(), int64_t(0)) != dot ||
+            mystl::inner_product(par, v.begin(), v.end(), v.begin(), int64_t(0),
+                                 mystl::plus<int64_t>(), mystl::multiplies<int64_t>()) != dot ||
+            mystl::transform_reduce(v.begin(), v.end(), int64_t(0), mystl::plus<int64_t>(), square) != dot ||
+            mystl::transform_reduce(par, v.begin(), v.end(), int64_t(0), mystl::plus<int64_t>(), square) != dot) {
+            std::cout << "transform_reduce / inner_product 结果错误: n=" << n << std::endl;
+            return 3;
+        }
+
+        // 浮点：各求和方式与参考值的差在误差界内
+        auto d = make_doubles(n, static_cast<unsigned>(n) + 1);
+        const long double ref = reference_sum(d);
+        const double tol = 1e-9 * (n + 1);
+        const double results[] = {
+            mystl::reduce(d.begin(), d.end(), 0.0),
+            mystl::reduce(par, d.begin(), d.end(), 0.0),
+            mystl::reduce(d.begin(), d.end(), 0.0, mystl::kahan_summation),
+            mystl::reduce(par, d.begin(), d.end(), 0.0, mystl::kahan_summation),
+            mystl::reduce(d.begin(), d.end(), 0.0, mystl::pairwise_summation),
+            mystl::reduce(par, d.begin(), d.end(), 0.0, mystl::pairwise_summation),
+        };
+        for (double r : results) {
+            if (std::fabs(r - static_cast<double>(ref)) > tol) {
+                std::cout << "浮点求和误差过大: n=" << n << std::endl;
+                return 4;
+            }
+        }
+    }
+
+    // 非算术类型：字符串拼接满足结合律但不满足交换律，结果必须保持顺序
+    std::vector<std::string> words(100000);
+    for (size_t i = 0; i < words.size(); ++i) words[i] = std::to_string(i % 10);
+    const std::string joined = mystl::accumulate(words.begin(), words.end(), std::string());
+    if (mystl::reduce(words.begin(), words.end(), std::string()) != joined ||
+        mystl::reduce(par, words.begin(), words.end(), std::string()) != joined) {
+        std::cout << "字符串 reduce 顺序错误" << std::endl;
+        return 5;
+    }
+
+    // 非随机访问迭代器
+    std::list<int> lst;
+    for (int i = 1; i <= 1000; ++i) lst.push_back(i);
+    if (mystl::reduce(lst.begin(), lst.end(), 0) != 500500 ||
+        mystl::reduce(par, lst.begin(), lst.end(), 0) != 500500 ||
+        mystl::transform_reduce(par, lst.begin(), lst.end(), lst.begin(), 0L) !=
+            mystl::inner_product(lst.begin(), lst.end(), lst.begin(), 0L)) {
+        std::cout << "list 迭代器 reduce 错误" << std::endl;
+        return 6;
+    }
+
+    // 精度：病态数据上 Kahan 与成对求和应明显优于朴素求和
+    double ref = 0;
+    auto ill = make_ill_conditioned(1000000, 3, ref);
+    const double err_kahan = std::fabs(mystl::reduce(ill.begin(), ill.end(), 0.0, mystl::kahan_summation) - ref);
+    const double err_par_kahan =
+        std::fabs(mystl::reduce(par, ill.begin(), ill.end(), 0.0, mystl::kahan_summation) - ref);
+    if (err_kahan > 1e-9 * ref || err_par_kahan > 1e-9 * ref) {
+        std::cout << "Kahan 求和精度不足: " << err_kahan << " " << err_par_kahan << std::endl;
+        return 7;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 精度与性能测试
+// ============================================================================
+
+// 结果写入 volatile 变量，防止编译器删除被测计算
+volatile double g_sink = 0;
+
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    g_sink = f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void run_accuracy() {
+    double ref = 0;
+    auto ill = make_ill_conditioned(1000000, 3, ref);
+    std::cout << "\n=== 病态数据求和的绝对误差（n=1000000，参考值 " << std::setprecision(10) << ref << "）===" << std::endl;
+    auto row = [ref](const char* name, double r) {
+        std::cout << std::left << std::setw(34) << name << std::scientific << std::setprecision(3)
+                  << std::fabs(r - ref) << std::defaultfloat << std::endl;
+    };
+    row("accumulate", mystl::accumulate(ill.begin(), ill.end(), 0.0));
+    row("reduce", mystl::reduce(ill.begin(), ill.end(), 0.0));
+    row("reduce(pairwise_summation)", mystl::reduce(ill.begin(), ill.end(), 0.0, mystl::pairwise_summation));
+    row("reduce(kahan_summation)", mystl::reduce(ill.begin(), ill.end(), 0.0, mystl::kahan_summation));
+    mystl::thread_pool pool(4);
+    row("reduce(par, pairwise_summation)",
+        mystl::reduce(mystl::execution::par.on(pool), ill.begin(), ill.end(), 0.0, mystl::pairwise_summation));
+    row("reduce(par, kahan_summation)",
+        mystl::reduce(mystl::execution::par.on(pool), ill.begin(), ill.end(), 0.0, mystl::kahan_summation));
+}
+
+void run_benchmark(size_t max_n) {
+    auto d = make_doubles(max_n, 2024);
+    auto e = make_doubles(max_n, 2025);
+    std::vector<float> f(d.begin(), d.end());
+    std::vector<int32_t> ints(max_n);
+    for (size_t i = 0; i < max_n; ++i) ints[i] = static_cast<int32_t>(i % 1000);
+    mystl::thread_pool pool;
+    auto par = mystl::execution::par.on(pool);
+
+    std::cout << "\n=== 归约性能（n=" << max_n << "，" << pool.size() << " 个工作线程，单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(44) << "算法" << std::setw(12) << "耗时" << "相对基准加速比" << std::endl;
+    double base = 0;
+    auto row = [&](const char* name, double ms) {
+        std::cout << std::left << std::setw(44) << name << std::fixed << std::setprecision(3) << std::setw(12) << ms
+                  << std::setprecision(2) << (ms > 0 ? base / ms : 0.0) << "x" << std::endl;
+    };
+
+    base = time_ms([&] { return mystl::accumulate(d.begin(), d.end(), 0.0); });
+    row("double accumulate（基准）", base);
+    row("double reduce", time_ms([&] { return mystl::reduce(d.begin(), d.end(), 0.0); }));
+    row("double reduce(pairwise_summation)",
+        time_ms([&] { return mystl::reduce(d.begin(), d.end(), 0.0, mystl::pairwise_summation); }));
+    row("double reduce(kahan_summation)",
+        time_ms([&] { return mystl::reduce(d.begin(), d.end(), 0.0, mystl::kahan_summation); }));
+    row("double reduce(par)", time_ms([&] { return mystl::reduce(par, d.begin(), d.end(), 0.0); }));
+    row("double reduce(par, kahan_summation)",
+        time_ms([&] { return mystl::reduce(par, d.begin(), d.end(), 0.0, mystl::kahan_summation); }));
+
+    base = time_ms([&] { return static_cast<double>(mystl::accumulate(f.begin(), f.end(), 0.0f)); });
+    row("float accumulate（基准）", base);
+    row("float reduce", time_ms([&] { return static_cast<double>(mystl::reduce(f.begin(), f.end(), 0.0f)); }));
+    row("float reduce(par)",
+        time_ms([&] { return static_cast<double>(mystl::reduce(par, f.begin(), f.end(), 0.0f)); }));
+
+    base = time_ms([&] { return static_cast<double>(mystl::accumulate(ints.begin(), ints.end(), int64_t(0))); });
+    row("int32 -> int64 accumulate（基准）", base);
+    row("int32 -> int64 reduce",
+        time_ms([&] { return static_cast<double>(mystl::reduce(ints.begin(), ints.end(), int64_t(0))); }));
+    row("int32 -> int64 reduce(par)",
+        time_ms([&] { return static_cast<double>(mystl::reduce(par, ints.begin(), ints.end(), int64_t(0))); }));
+
+    base = time_ms([&] { return mystl::inner_product(d.begin(), d.end(), e.begin(), 0.0); });
+    row("double inner_product（基准）", base);
+    row("double transform_reduce", time_ms([&] { return mystl::transform_reduce(d.begin(), d.end(), e.begin(), 0.0); }));
+    row("double transform_reduce(kahan_summation)",
+        time_ms([&] { return mystl::transform_reduce(d.begin(), d.end(), e.begin(), 0.0, mystl::kahan_summation); }));
+    row("double inner_product(par)",
+        time_ms([&] { return mystl::inner_product(par, d.begin(), d.end(), e.begin(), 0.0); }));
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 10000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_reduce_performance: 正确性测试通过" << std::endl;
+
+    run_accuracy();
+    run_benchmark(max_n);
+    return 0;
+}
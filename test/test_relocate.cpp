@@ -0,0 +1,296 @@
+// mystl::is_trivially_relocatable 与 vector/deque 扩容时按字节搬移元素的正确性测试和性能对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_relocate.cpp -o test_relocate
+// 运行：./test_relocate [元素个数，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include "memory.h"
+#include "vector.h"
+#include "deque.h"
+
+// ============================================================================
+// 测试类型
+// ============================================================================
+
+static long g_live = 0;   // 存活对象数
+static long g_moves = 0;  // 移动构造次数
+
+// 持有堆上的值，析构时计数；Reloc 为真时显式声明可平凡重定位
+template <bool Reloc>
+class boxed {
+public:
+    explicit boxed(int v = 0) : p_(new int(v)) { ++g_live; }
+    boxed(const boxed& other) : p_(new int(*other.p_)) { ++g_live; }
+    boxed(boxed&& other) noexcept : p_(other.p_) {
+        other.p_ = nullptr;
+        ++g_live;
+        ++g_moves;
+    }
+    boxed& operator=(boxed other) {
+        int* t = p_;
+        p_ = other.p_;
+        other.p_ = t;
+        return *this;
+    }
+    ~boxed() {
+        delete p_;
+        --g_live;
+    }
+    int value() const { return *p_; }
+
+private:
+    int* p_;
+};
+
+namespace mystl {
+template <>
+struct is_trivially_relocatable<boxed<true>> : m_true_type {};
+}
+
+// 第 n 次移动构造时抛出异常的类型
+struct fragile {
+    static int countdown;
+    int value;
+    explicit fragile(int v) : value(v) { ++g_live; }
+    fragile(const fragile& o) : value(o.value) { ++g_live; }
+    fragile(fragile&& o) : value(o.value) {
+        if (--countdown == 0) throw std::runtime_error("move failed");
+        ++g_live;
+    }
+    ~fragile() { --g_live; }
+};
+int fragile::countdown = -1;
+
+struct pod { int a; double b; };
+
+static_assert(mystl::is_trivially_relocatable<int>::value, "int");
+static_assert(mystl::is_trivially_relocatable<pod>::value, "平凡可拷贝");
+static_assert(mystl::is_trivially_relocatable<mystl::unique_ptr<int>>::value, "mystl::unique_ptr");
+static_assert(mystl::is_trivially_relocatable<std::unique_ptr<int>>::value, "std::unique_ptr");
+static_assert(mystl::is_trivially_relocatable<std::shared_ptr<int>>::value, "std::shared_ptr");
+static_assert(mystl::is_trivially_relocatable<mystl::vector<int>>::value, "mystl::vector");
+static_assert(mystl::is_trivially_relocatable<mystl::pair<mystl::unique_ptr<int>, int>>::value, "pair");
+static_assert(mystl::is_trivially_relocatable<boxed<true>>::value, "显式开启");
+static_assert(!mystl::is_trivially_relocatable<boxed<false>>::value, "默认关闭");
+static_assert(!mystl::is_trivially_relocatable<std::string>::value, "短字符串指向自身");
+static_assert(!mystl::is_trivially_relocatable<fragile>::value, "fragile");
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+template <bool Reloc>
+int check_boxed_growth() {
+    g_live = 0;
+    g_moves = 0;
+    {
+        mystl::vector<boxed<Reloc>> v;
+        for (int i = 0; i < 5000; ++i) v.push_back(boxed<Reloc>(i));
+        v.reserve(20000);
+        v.shrink_to_fit();
+        for (int i = 0; i < 5000; ++i) {
+            if (v[static_cast<size_t>(i)].value() != i) {
+                std::cout << "扩容后元素错误: " << i << std::endl;
+                return 1;
+            }
+        }
+        if (g_live != 5000) {
+            std::cout << "存活对象数错误: " << g_live << std::endl;
+            return 1;
+        }
+    }
+    if (g_live != 0) {
+        std::cout << "对象析构次数不匹配: " << g_live << std::endl;
+        return 1;
+    }
+    // 按字节搬移时只有 push_back 的实参被移动
+    if (Reloc && g_moves != 5000) {
+        std::cout << "可平凡重定位类型仍被逐个移动: " << g_moves << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int test_vector_growth() {
+    int rc = check_boxed_growth<true>();
+    if (rc == 0) rc = check_boxed_growth<false>();
+    if (rc != 0) return rc;
+
+    mystl::vector<mystl::unique_ptr<int>> ptrs;
+    for (int i = 0; i < 1000; ++i) ptrs.push_back(mystl::make_unique<int>(i));
+    ptrs.shrink_to_fit();
+    long sum = 0;
+    for (size_t i = 0; i < ptrs.size(); ++i) sum += *ptrs[i];
+
+    mystl::vector<mystl::vector<int>> nested;
+    for (int i = 0; i < 300; ++i) nested.push_back(mystl::vector<int>(static_cast<size_t>(i), i));
+    for (size_t i = 0; i < nested.size(); ++i) {
+        if (nested[i].size() != i || (i > 0 && nested[i][i - 1] != static_cast<int>(i))) return 2;
+    }
+
+    mystl::vector<std::string> strs;
+    for (int i = 0; i < 1000; ++i) strs.push_back(std::to_string(i));
+    if (sum != 999L * 1000 / 2 || strs[999] != "999" || strs[5] != "5") {
+        std::cout << "unique_ptr/string 扩容结果错误" << std::endl;
+        return 2;
+    }
+    return 0;
+}
+
+int test_self_reference() {
+    // 扩容时插入自身元素：新元素须在搬移旧元素之前构造
+    mystl::vector<std::string> s;
+    s.push_back(std::string(100, 'x'));
+    s.shrink_to_fit();
+    s.push_back(s[0]);
+    mystl::vector<boxed<true>> b;
+    b.push_back(boxed<true>(42));
+    b.shrink_to_fit();
+    b.push_back(b[0]);
+    if (s[1] != std::string(100, 'x') || b[1].value() != 42) {
+        std::cout << "扩容时插入自身元素结果错误" << std::endl;
+        return 3;
+    }
+    return 0;
+}
+
+int test_exception_safety() {
+    g_live = 0;
+    {
+        mystl::vector<fragile> v;
+        for (int i = 0; i < 10; ++i) v.push_back(fragile(i));
+        v.shrink_to_fit();
+        const long live = g_live;
+        fragile::countdown = 5;
+        bool thrown = false;
+        try {
+            v.push_back(fragile(10));
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        fragile::countdown = -1;
+        if (!thrown || v.size() != 10 || v[9].value != 9 || g_live != live) {
+            std::cout << "扩容时移动抛出异常后状态错误" << std::endl;
+            return 4;
+        }
+    }
+    return g_live == 0 ? 0 : 4;
+}
+
+int test_deque_map() {
+    // 两端交替增长多次触发 map 重新分配，之后收缩 map
+    mystl::deque<mystl::unique_ptr<int>> d;
+    for (int i = 0; i < 20000; ++i) {
+        d.push_back(mystl::make_unique<int>(i));
+        d.push_front(mystl::make_unique<int>(-i));
+    }
+    for (int i = 0; i < 15000; ++i) {
+        d.pop_back();
+        d.pop_front();
+    }
+    d.shrink_to_fit();
+    long sum = 0;
+    for (size_t i = 0; i < d.size(); ++i) sum += *d[i];
+    if (d.size() != 10000 || sum != 0 || *d.front() != -4999 || *d.back() != 4999) {
+        std::cout << "deque map 重新分配后结果错误" << std::endl;
+        return 5;
+    }
+    d.push_back(mystl::make_unique<int>(1));
+    d.push_front(mystl::make_unique<int>(1));
+    return *d.back() == 1 ? 0 : 5;
+}
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+volatile long g_sink = 0;
+
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// n 个元素反复 reserve(2n) 再 shrink_to_fit，每轮搬移两次全部元素；元素构造放在计时之外
+template <class T, class Make>
+double bench_relocation(size_t n, int rounds, Make make) {
+    mystl::vector<T> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(make(static_cast<int>(i)));
+    const double ms = time_ms([&v, n, rounds] {
+        for (int r = 0; r < rounds; ++r) {
+            v.reserve(2 * n);
+            v.shrink_to_fit();
+        }
+    });
+    g_sink = static_cast<long>(v.size());
+    return ms;
+}
+
+// 从空 vector 逐个 push_back 到 n 个元素，包含全部扩容
+template <class T, class Make>
+double bench_growth(size_t n, Make make) {
+    mystl::vector<T> src;
+    src.reserve(n);
+    for (size_t i = 0; i < n; ++i) src.push_back(make(static_cast<int>(i)));
+    return time_ms([&src, n] {
+        mystl::vector<T> v;
+        for (size_t i = 0; i < n; ++i) v.push_back(mystl::move(src[i]));
+        g_sink = static_cast<long>(v.size());
+        for (size_t i = 0; i < n; ++i) src[i] = mystl::move(v[i]);
+    });
+}
+
+void print_row(const char* name, double reloc, double move) {
+    std::cout << std::left << std::setw(44) << name << std::setw(16) << reloc << std::setw(16) << move
+              << (reloc > 0 ? move / reloc : 0.0) << "x" << std::endl;
+}
+
+void run_benchmark(size_t n) {
+    const int rounds = 10;
+    std::cout << "\n=== " << n << " 个元素，按字节搬移（可平凡重定位）与逐个移动构造+析构对比（单位：毫秒）==="
+              << std::endl;
+    std::cout << std::left << std::setw(44) << "场景" << std::setw(16) << "按字节搬移" << std::setw(16)
+              << "逐个移动" << "加速比" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    auto make_up = [](int i) { return mystl::make_unique<int>(i); };
+    auto make_bt = [](int i) { return boxed<true>(i); };
+    auto make_bf = [](int i) { return boxed<false>(i); };
+    print_row("unique_ptr<int> reserve+shrink_to_fit x10", bench_relocation<mystl::unique_ptr<int>>(n, rounds, make_up),
+              bench_relocation<boxed<false>>(n, rounds, make_bf));
+    print_row("boxed reserve+shrink_to_fit x10", bench_relocation<boxed<true>>(n, rounds, make_bt),
+              bench_relocation<boxed<false>>(n, rounds, make_bf));
+    print_row("unique_ptr<int> push_back 增长", bench_growth<mystl::unique_ptr<int>>(n, make_up),
+              bench_growth<boxed<false>>(n, make_bf));
+
+    // 与 std::string 同为 32 字节的元素：mystl::vector<int> 可按字节搬移，std::string 不行
+    const size_t m = n / 4 + 1;
+    print_row("vector<int> 对比 std::string reserve+shrink x10",
+              bench_relocation<mystl::vector<int>>(m, rounds, [](int i) { return mystl::vector<int>(4, i); }),
+              bench_relocation<std::string>(m, rounds, [](int i) { return std::string(40, static_cast<char>('a' + i % 26)); }));
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    if (n == 0) n = 1;
+
+    int rc = test_vector_growth();
+    if (rc == 0) rc = test_self_reference();
+    if (rc == 0) rc = test_exception_safety();
+    if (rc == 0) rc = test_deque_map();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_relocate: 正确性测试通过" << std::endl;
+
+    run_benchmark(n);
+    return 0;
+}
@@ -0,0 +1,233 @@
+// mystl::inclusive_scan / exclusive_scan / transform_*_scan 的正确性与性能测试，与 partial_sum 对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_scan_performance.cpp -o test_scan_performance
+// 运行：./test_scan_performance [最大规模，默认 10000000；传 1000000000 可测到 1G 元素，需约 8GB 内存]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <list>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include "algorithm.h"
+#include "execution.h"
+
+// ============================================================================
+// 数据生成
+// ============================================================================
+
+template <class T>
+std::vector<T> make_values(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<T> v(n);
+    for (auto& x : v) x = static_cast<T>(static_cast<int>(gen() % 2001) - 1000);
+    return v;
+}
+
+template <class T>
+bool nearly_equal(const std::vector<T>& a, const std::vector<T>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        const double scale = std::fabs(static_cast<double>(b[i])) + 1.0;
+        if (std::fabs(static_cast<double>(a[i]) - static_cast<double>(b[i])) > 1e-5 * scale * std::sqrt(i + 1.0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+// 以 partial_sum 为参照检查指针（SIMD 路径）与并行版本
+template <class T>
+bool check_plus_scans(mystl::thread_pool& pool, size_t n, bool exact) {
+    auto in = make_values<T>(n, static_cast<unsigned>(n) + 1);
+    auto par = mystl::execution::par.on(pool);
+
+    std::vector<T> expect(n);
+    mystl::partial_sum(in.begin(), in.end(), expect.begin());
+    std::vector<T> expect_excl(n);
+    T acc = T(5);
+    for (size_t i = 0; i < n; ++i) {
+        expect_excl[i] = acc;
+        acc = acc + in[i];
+    }
+    std::vector<T> expect_init(n);
+    for (size_t i = 0; i < n; ++i) expect_init[i] = expect[i] + T(5);
+
+    auto same = [exact](const std::vector<T>& a, const std::vector<T>& b) {
+        return exact ? a == b : nearly_equal(a, b);
+    };
+
+    std::vector<T> out(n);
+    const T* src = in.data();
+    mystl::inclusive_scan(src, src + n, out.data());
+    if (!same(out, expect)) return false;
+    mystl::inclusive_scan(par, src, src + n, out.data());
+    if (!same(out, expect)) return false;
+    mystl::inclusive_scan(src, src + n, out.data(), mystl::plus<T>(), T(5));
+    if (!same(out, expect_init)) return false;
+    mystl::inclusive_scan(par, src, src + n, out.data(), std::plus<T>(), T(5));
+    if (!same(out, expect_init)) return false;
+    mystl::exclusive_scan(src, src + n, out.data(), T(5));
+    if (!same(out, expect_excl)) return false;
+    mystl::exclusive_scan(par, src, src + n, out.data(), T(5));
+    if (!same(out, expect_excl)) return false;
+
+    // 原地扫描
+    auto inplace = in;
+    mystl::inclusive_scan(inplace.data(), inplace.data() + n, inplace.data());
+    if (!same(inplace, expect)) return false;
+    inplace = in;
+    mystl::exclusive_scan(par, inplace.data(), inplace.data() + n, inplace.data(), T(5));
+    if (!same(inplace, expect_excl)) return false;
+
+    // std::vector 迭代器：非指针，走通用路径
+    std::vector<T> out2(n);
+    mystl::inclusive_scan(par, in.begin(), in.end(), out2.begin());
+    return same(out2, expect);
+}
+
+int test_correctness() {
+    mystl::thread_pool pool(4);
+    auto par = mystl::execution::par.on(pool);
+    const size_t sizes[] = {0, 1, 2, 3, 4, 5, 7, 9, 1000, 70001, 300000};
+
+    for (size_t n : sizes) {
+        if (!check_plus_scans<int32_t>(pool, n, true) || !check_plus_scans<int64_t>(pool, n, true) ||
+            !check_plus_scans<uint32_t>(pool, n, true) || !check_plus_scans<short>(pool, n, true)) {
+            std::cout << "整数扫描错误: n=" << n << std::endl;
+            return 1;
+        }
+        if (!check_plus_scans<float>(pool, n, false) || !check_plus_scans<double>(pool, n, false)) {
+            std::cout << "浮点扫描错误: n=" << n << std::endl;
+            return 2;
+        }
+
+        // 只满足结合律、不满足交换律的操作：取最后一个非零元素，检查块间进位的顺序
+        std::vector<int> v(n);
+        std::mt19937 gen(static_cast<unsigned>(n));
+        for (auto& x : v) x = gen() % 4 == 0 ? static_cast<int>(gen() % 100) : 0;
+        auto last_nonzero = [](int a, int b) { return b != 0 ? b : a; };
+        std::vector<int> expect(n), out(n);
+        mystl::partial_sum(v.begin(), v.end(), expect.begin(), last_nonzero);
+        mystl::inclusive_scan(par, v.begin(), v.end(), out.begin(), last_nonzero);
+        if (out != expect) {
+            std::cout << "非交换操作并行扫描错误: n=" << n << std::endl;
+            return 3;
+        }
+
+        // 变换扫描：平方的前缀和
+        auto square = [](int x) { return static_cast<int64_t>(x) * x; };
+        std::vector<int64_t> sq_expect(n), sq_out(n);
+        int64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += square(v[i]);
+            sq_expect[i] = sum;
+        }
+        mystl::transform_inclusive_scan(v.begin(), v.end(), sq_out.begin(), mystl::plus<int64_t>(), square);
+        if (sq_out != sq_expect) return 4;
+        mystl::transform_inclusive_scan(par, v.begin(), v.end(), sq_out.begin(), mystl::plus<int64_t>(), square);
+        if (sq_out != sq_expect) return 4;
+        mystl::transform_inclusive_scan(par, v.begin(), v.end(), sq_out.begin(), mystl::plus<int64_t>(), square,
+                                        int64_t(0));
+        if (sq_out != sq_expect) return 4;
+        for (size_t i = 0; i < n; ++i) sq_expect[i] -= square(v[i]);
+        mystl::transform_exclusive_scan(v.begin(), v.end(), sq_out.begin(), int64_t(0), mystl::plus<int64_t>(), square);
+        if (sq_out != sq_expect) return 4;
+        mystl::transform_exclusive_scan(par, v.begin(), v.end(), sq_out.begin(), int64_t(0), mystl::plus<int64_t>(),
+                                        square);
+        if (sq_out != sq_expect) {
+            std::cout << "变换扫描错误: n=" << n << std::endl;
+            return 4;
+        }
+    }
+
+    // 非随机访问迭代器与插入迭代器
+    std::list<std::string> words = {"a", "b", "c", "d"};
+    std::vector<std::string> prefixes;
+    mystl::inclusive_scan(par, words.begin(), words.end(), std::back_inserter(prefixes), mystl::plus<std::string>());
+    if (prefixes != std::vector<std::string>{"a", "ab", "abc", "abcd"}) {
+        std::cout << "字符串扫描错误" << std::endl;
+        return 5;
+    }
+    std::vector<std::string> excl;
+    mystl::exclusive_scan(words.begin(), words.end(), std::back_inserter(excl), std::string(">"));
+    if (excl != std::vector<std::string>{">", ">a", ">ab", ">abc"}) {
+        std::cout << "字符串 exclusive_scan 错误" << std::endl;
+        return 6;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 原地扫描，每次计时前重新填充数据，只需一份缓冲区
+template <class T>
+void bench_type(const char* name, size_t n, mystl::thread_pool& pool) {
+    std::vector<T> buf(n);
+    auto refill = [&buf] {
+        for (size_t i = 0; i < buf.size(); ++i) buf[i] = static_cast<T>(i & 7);
+    };
+    T* p = buf.data();
+    auto par = mystl::execution::par.on(pool);
+
+    refill();
+    const double t_partial = time_ms([&] { mystl::partial_sum(p, p + n, p); });
+    refill();
+    const double t_incl = time_ms([&] { mystl::inclusive_scan(p, p + n, p); });
+    refill();
+    const double t_excl = time_ms([&] { mystl::exclusive_scan(p, p + n, p, T()); });
+    refill();
+    const double t_par = time_ms([&] { mystl::inclusive_scan(par, p, p + n, p); });
+    volatile T sink = buf[n - 1];
+    (void)sink;
+
+    std::cout << std::left << std::setw(10) << name << std::setw(14) << n << std::fixed << std::setprecision(3)
+              << std::setw(14) << t_partial << std::setw(14) << t_incl << std::setw(14) << t_excl
+              << std::setw(14) << t_par << std::setprecision(2)
+              << (t_incl > 0 ? t_partial / t_incl : 0.0) << "x / "
+              << (t_par > 0 ? t_partial / t_par : 0.0) << "x" << std::endl;
+}
+
+void run_benchmark(size_t max_n) {
+    mystl::thread_pool pool;
+    std::cout << "\n=== 前缀和性能（原地，" << pool.size() << " 个工作线程，单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(10) << "类型" << std::setw(14) << "规模" << std::setw(14) << "partial_sum"
+              << std::setw(14) << "incl_scan" << std::setw(14) << "excl_scan" << std::setw(14) << "par incl"
+              << "加速比(串行/并行)" << std::endl;
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        bench_type<int32_t>("int32", n, pool);
+        bench_type<int64_t>("int64", n, pool);
+        bench_type<float>("float", n, pool);
+        bench_type<double>("double", n, pool);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 10000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_scan_performance: 正确性测试通过" << std::endl;
+
+    run_benchmark(max_n);
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "small_vector.h"
+#include "test_counted.h"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static long g_allocations = 0;
+
+// 统计分配次数的分配器
+template <class T>
+struct counting_allocator : mystl::allocator<T> {
+    T* allocate(size_t n) {
+        ++g_allocations;
+        return mystl::allocator<T>::allocate(n);
+    }
+};
+
+int main() {
+    // 内联容量以内不分配，溢出后才上堆
+    typedef mystl::small_vector<int, 4, counting_allocator<int>> small;
+    small a;
+    for (int i = 0; i < 4; ++i) a.push_back(i);
+    small b(a);
+    b.erase(b.begin(), b.begin() + 3);
+    b.insert(b.begin() + 1, 3, 9);
+    assert(g_allocations == 0 && a.is_inline() && b.is_inline());
+    assert(b.size() == 4 && b[0] == 3 && b[3] == 9);
+
+    a.push_back(4);
+    assert(g_allocations == 1 && !a.is_inline() && a.capacity() == 8);
+
+    // 堆缓冲区的移动、交换只转移指针
+    const int* heap = a.data();
+    (void)heap;
+    small c(mystl::move(a));
+    assert(c.data() == heap && a.empty() && a.is_inline());
+    small d;
+    d.push_back(1);
+    swap(c, d);
+    assert(g_allocations == 1 && d.data() == heap && c.is_inline() && c[0] == 1);
+
+    // 元素不超过内联容量时 shrink_to_fit 搬回对象内部
+    d.erase(d.begin() + 1, d.end());
+    d.shrink_to_fit();
+    assert(d.is_inline() && d.size() == 1 && d[0] == 0);
+
+    // 存储已满时插入自身元素
+    mystl::small_vector<std::string, 2> s;
+    s.push_back(std::string(32, 'x'));
+    s.push_back("y");
+    s.push_back(s[0]);
+    s.insert(s.begin(), s[2]);
+    assert(s.size() == 4 && s[0] == std::string(32, 'x') && s[3] == s[0]);
+
+    {
+        // 内联/堆的四种组合之间交换与移动赋值，元素不丢失、不重复析构
+        const size_t sizes[] = {0, 3, 4, 7};
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                mystl::small_vector<counted, 4> x, y;
+                for (size_t k = 0; k < sizes[i]; ++k) x.emplace_back(static_cast<int>(k));
+                for (size_t k = 0; k < sizes[j]; ++k) y.emplace_back(static_cast<int>(100 + k));
+                x.swap(y);
+                assert(x.size() == sizes[j] && y.size() == sizes[i]);
+                assert(sizes[j] == 0 || x[0].value == 100);
+                y = mystl::move(x);
+                assert(x.empty() && y.size() == sizes[j]);
+                assert(counted::live() == static_cast<long>(sizes[j]));
+            }
+        }
+
+        // 溢出到堆时拷贝抛出异常：不泄漏、不重复析构
+        mystl::small_vector<counted, 4> v;
+        for (int i = 0; i < 4; ++i) v.emplace_back(i);
+        std::vector<counted> src(3, counted(7));
+        bool thrown = false;
+        counted::countdown() = 2;
+        try {
+            v.insert(v.begin() + 2, src.begin(), src.end());
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        counted::countdown() = 0;
+        assert(thrown);
+        (void)thrown;
+        assert(counted::live() == static_cast<long>(v.size() + src.size()));
+    }
+    assert(counted::live() == 0);
+
+    std::cout << "test_small_vector OK\n";
+    return 0;
+}
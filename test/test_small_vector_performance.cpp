@@ -0,0 +1,102 @@
+// small_vector（内联存储 + 溢出到堆）与 mystl::vector 的分配次数、耗时对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_small_vector_performance.cpp -o test_small_vector_performance
+// 运行：./test_small_vector_performance [基准创建的小数组个数，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include "small_vector.h"
+#include "vector.h"
+
+static long g_allocations = 0;  // counting_allocator 的分配次数
+
+// 统计分配次数的分配器
+template <class T>
+struct counting_allocator : mystl::allocator<T> {
+    T* allocate(size_t n) {
+        ++g_allocations;
+        return mystl::allocator<T>::allocate(n);
+    }
+};
+
+// ============================================================================
+// 性能测试：大量元素个数不超过 8 的小数组
+// ============================================================================
+
+volatile long g_sink = 0;
+
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 反复创建长度为 1..max_len 的小数组，逐个 push_back 后求和
+template <class Vector>
+void bench_build(const char* name, size_t count, size_t max_len) {
+    g_allocations = 0;
+    const double ms = time_ms([&] {
+        long sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            Vector v;
+            const size_t len = i % max_len + 1;
+            for (size_t k = 0; k < len; ++k) v.push_back(static_cast<int>(k + i));
+            for (size_t k = 0; k < v.size(); ++k) sum += v[k];
+        }
+        g_sink = sum;
+    });
+    std::cout << std::left << std::setw(44) << name << std::setw(14) << ms << std::setw(16) << g_allocations
+              << static_cast<double>(g_allocations) / static_cast<double>(count) << std::endl;
+}
+
+// 容器里存放 count 个小数组，再整体拷贝、遍历一次
+template <class Vector>
+void bench_nested(const char* name, size_t count, size_t max_len) {
+    g_allocations = 0;
+    const double ms = time_ms([&] {
+        mystl::vector<Vector> outer;
+        outer.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            outer.emplace_back();
+            const size_t len = i % max_len + 1;
+            for (size_t k = 0; k < len; ++k) outer.back().push_back(static_cast<int>(k));
+        }
+        mystl::vector<Vector> copy(outer);
+        long sum = 0;
+        for (size_t i = 0; i < copy.size(); ++i) {
+            for (size_t k = 0; k < copy[i].size(); ++k) sum += copy[i][k];
+        }
+        g_sink = sum;
+    });
+    std::cout << std::left << std::setw(44) << name << std::setw(14) << ms << std::setw(16) << g_allocations
+              << static_cast<double>(g_allocations) / static_cast<double>(count) << std::endl;
+}
+
+void run_benchmark(size_t count) {
+    typedef mystl::vector<int, counting_allocator<int>> vec;
+    typedef mystl::small_vector<int, 8, counting_allocator<int>> small8;
+    typedef mystl::small_vector<int, 4, counting_allocator<int>> small4;
+
+    std::cout << "\n=== 创建 " << count << " 个小数组并求和 ===" << std::endl;
+    std::cout << std::left << std::setw(48) << "容器" << std::setw(18) << "耗时(ms)" << std::setw(18) << "分配次数"
+              << "每个数组" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    bench_build<vec>("mystl::vector<int>，长度 1..8", count, 8);
+    bench_build<small8>("small_vector<int, 8>，长度 1..8", count, 8);
+    bench_build<small4>("small_vector<int, 4>，长度 1..8（部分溢出）", count, 8);
+    bench_build<vec>("mystl::vector<int>，长度 1..32", count / 4, 32);
+    bench_build<small8>("small_vector<int, 8>，长度 1..32（多数溢出）", count / 4, 32);
+
+    std::cout << "\n=== vector 中存放 " << count / 4 << " 个小数组，构建后整体拷贝并遍历 ===" << std::endl;
+    bench_nested<vec>("vector<mystl::vector<int>>", count / 4, 8);
+    bench_nested<small8>("vector<small_vector<int, 8>>", count / 4, 8);
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    if (count < 64) count = 64;
+    run_benchmark(count);
+    return 0;
+}
@@ -0,0 +1,197 @@
+// mystl::sort（内省排序）/ mystl::pdq_sort 正确性与性能测试：与 std::sort 在多种数据分布下对比
+// 编译：g++ -std=c++11 -O2 -I.. test_sort_performance.cpp -o test_sort_performance
+// 运行：./test_sort_performance [最大规模，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include "algorithm.h"
+
+// ============================================================================
+// 数据分布生成
+// ============================================================================
+
+enum class distribution {
+    random,          // 均匀随机
+    sorted,          // 已升序
+    reversed,        // 已降序
+    organ_pipe,      // 管风琴：先升后降
+    many_duplicates  // 大量重复值（仅 16 种取值）
+};
+
+const char* distribution_name(distribution d) {
+    switch (d) {
+        case distribution::random:          return "random";
+        case distribution::sorted:          return "sorted";
+        case distribution::reversed:        return "reversed";
+        case distribution::organ_pipe:      return "organ_pipe";
+        case distribution::many_duplicates: return "many_duplicates";
+    }
+    return "unknown";
+}
+
+template <class T = int>
+std::vector<T> make_data(distribution d, size_t n, unsigned seed) {
+    std::vector<T> v(n);
+    std::mt19937 gen(seed);
+    switch (d) {
+        case distribution::random:
+            for (auto& x : v) x = static_cast<T>(static_cast<int>(gen()));
+            break;
+        case distribution::sorted:
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(i);
+            break;
+        case distribution::reversed:
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(n - i);
+            break;
+        case distribution::organ_pipe:
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(i < n / 2 ? i : n - i);
+            break;
+        case distribution::many_duplicates:
+            for (auto& x : v) x = static_cast<T>(gen() % 16);
+            break;
+    }
+    return v;
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+int test_correctness() {
+    const distribution all[] = {
+        distribution::random, distribution::sorted, distribution::reversed,
+        distribution::organ_pipe, distribution::many_duplicates
+    };
+    const size_t sizes[] = {0, 1, 2, 3, 15, 16, 17, 100, 129, 1000, 100000};
+
+    for (auto d : all) {
+        for (size_t n : sizes) {
+            auto v = make_data(d, n, 42);
+            auto expect = v;
+            std::sort(expect.begin(), expect.end());
+            mystl::sort(v.begin(), v.end());
+            if (v != expect) {
+                std::cout << "排序结果错误: " << distribution_name(d) << " n=" << n << std::endl;
+                return 1;
+            }
+
+            // 自定义比较器（降序）
+            auto w = make_data(d, n, 7);
+            mystl::sort(w.begin(), w.end(), std::greater<int>());
+            if (!std::is_sorted(w.begin(), w.end(), std::greater<int>())) {
+                std::cout << "降序排序错误: " << distribution_name(d) << " n=" << n << std::endl;
+                return 2;
+            }
+
+            // pdq_sort：默认比较器走无分支分割，lambda 比较器走常规分割
+            auto p = make_data(d, n, 42);
+            mystl::pdq_sort(p.begin(), p.end());
+            if (p != expect) {
+                std::cout << "pdq_sort 结果错误: " << distribution_name(d) << " n=" << n << std::endl;
+                return 5;
+            }
+            auto q = make_data(d, n, 42);
+            mystl::pdq_sort(q.begin(), q.end(), [](int a, int b) { return a < b; });
+            if (q != expect) {
+                std::cout << "pdq_sort（自定义比较器）结果错误: " << distribution_name(d) << " n=" << n << std::endl;
+                return 6;
+            }
+            auto f = make_data<double>(d, n, 3);
+            mystl::pdq_sort(f.begin(), f.end(), std::greater<double>());
+            if (!std::is_sorted(f.begin(), f.end(), std::greater<double>())) {
+                std::cout << "pdq_sort（double 降序）结果错误: " << distribution_name(d) << " n=" << n << std::endl;
+                return 7;
+            }
+        }
+    }
+
+    // 非平凡类型
+    std::vector<std::string> s;
+    std::mt19937 gen(1);
+    for (int i = 0; i < 5000; ++i) s.push_back(std::to_string(gen() % 1000));
+    auto expect = s;
+    std::sort(expect.begin(), expect.end());
+    auto s2 = s;
+    mystl::sort(s.begin(), s.end());
+    mystl::pdq_sort(s2.begin(), s2.end());
+    if (s != expect || s2 != expect) {
+        std::cout << "字符串排序错误" << std::endl;
+        return 3;
+    }
+
+    // 原生指针区间
+    int arr[] = {9, 3, 7, 1, 8, 2, 6, 4, 5, 0};
+    mystl::sort(arr, arr + 10);
+    for (int i = 0; i < 10; ++i) {
+        if (arr[i] != i) {
+            std::cout << "原生数组排序错误" << std::endl;
+            return 4;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+template <class T, class Sorter>
+double time_sort(const std::vector<T>& data, Sorter sorter) {
+    auto v = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    sorter(v);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!std::is_sorted(v.begin(), v.end())) {
+        std::cout << "性能测试中排序结果错误" << std::endl;
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <class T>
+void run_benchmark(const char* type_name, size_t max_n) {
+    const distribution all[] = {
+        distribution::random, distribution::sorted, distribution::reversed,
+        distribution::organ_pipe, distribution::many_duplicates
+    };
+
+    std::cout << "\n=== " << type_name << "：mystl::sort / mystl::pdq_sort vs std::sort（单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(18) << "分布" << std::setw(12) << "规模"
+              << std::setw(12) << "sort" << std::setw(12) << "pdq_sort" << std::setw(12) << "std"
+              << std::setw(12) << "sort/std" << "pdq/std" << std::endl;
+
+    for (size_t n = 10000; n <= max_n; n *= 10) {
+        for (auto d : all) {
+            auto data = make_data<T>(d, n, 2024);
+            double t_sort = time_sort(data, [](std::vector<T>& v) { mystl::sort(v.begin(), v.end()); });
+            double t_pdq = time_sort(data, [](std::vector<T>& v) { mystl::pdq_sort(v.begin(), v.end()); });
+            double t_std = time_sort(data, [](std::vector<T>& v) { std::sort(v.begin(), v.end()); });
+            std::cout << std::left << std::setw(18) << distribution_name(d) << std::setw(12) << n
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(12) << t_sort << std::setw(12) << t_pdq << std::setw(12) << t_std
+                      << std::setprecision(2)
+                      << std::setw(12) << (t_std > 0 ? t_sort / t_std : 0.0)
+                      << (t_std > 0 ? t_pdq / t_std : 0.0) << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_sort_performance: 正确性测试通过" << std::endl;
+
+    run_benchmark<int>("int", max_n);
+    run_benchmark<double>("double", max_n);
+    return 0;
+}
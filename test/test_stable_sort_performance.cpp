@@ -0,0 +1,206 @@
+// mystl::stable_sort（TimSort）正确性与性能测试：与 std::stable_sort 在多种数据分布下对比
+// 编译：g++ -std=c++11 -O2 -I.. test_stable_sort_performance.cpp -o test_stable_sort_performance
+// 运行：./test_stable_sort_performance [最大规模，默认 1000000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include "algorithm.h"
+
+// ============================================================================
+// 数据分布生成
+// ============================================================================
+
+enum class distribution {
+    random,          // 均匀随机
+    sorted,          // 已升序
+    reversed,        // 已降序
+    mostly_sorted,   // 升序时间戳中约 1% 的元素被随机扰动
+    sorted_runs,     // 若干段各自有序的数据拼接（模拟多路日志追加）
+    many_duplicates  // 大量重复值（仅 16 种取值）
+};
+
+const char* distribution_name(distribution d) {
+    switch (d) {
+        case distribution::random:          return "random";
+        case distribution::sorted:          return "sorted";
+        case distribution::reversed:        return "reversed";
+        case distribution::mostly_sorted:   return "mostly_sorted";
+        case distribution::sorted_runs:     return "sorted_runs";
+        case distribution::many_duplicates: return "many_duplicates";
+    }
+    return "unknown";
+}
+
+std::vector<int> make_data(distribution d, size_t n, unsigned seed) {
+    std::vector<int> v(n);
+    std::mt19937 gen(seed);
+    switch (d) {
+        case distribution::random:
+            for (auto& x : v) x = static_cast<int>(gen());
+            break;
+        case distribution::sorted:
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(i);
+            break;
+        case distribution::reversed:
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(n - i);
+            break;
+        case distribution::mostly_sorted:
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(i * 4);
+            for (size_t i = 0; i < n / 100; ++i) v[gen() % n] = static_cast<int>(gen() % (n * 4 + 1));
+            break;
+        case distribution::sorted_runs: {
+            const size_t run = n / 8 + 1;
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>((i % run) * 8 + gen() % 8);
+            for (size_t i = 0; i < n; i += run) std::sort(v.begin() + i, v.begin() + std::min(n, i + run));
+            break;
+        }
+        case distribution::many_duplicates:
+            for (auto& x : v) x = static_cast<int>(gen() % 16);
+            break;
+    }
+    return v;
+}
+
+// 记录原始位置，用于检查稳定性
+struct record {
+    int key;
+    size_t index;
+};
+
+bool record_key_less(const record& a, const record& b) {
+    return a.key < b.key;
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+int test_correctness() {
+    const distribution all[] = {
+        distribution::random, distribution::sorted, distribution::reversed,
+        distribution::mostly_sorted, distribution::sorted_runs, distribution::many_duplicates
+    };
+    const size_t sizes[] = {0, 1, 2, 3, 31, 32, 33, 64, 65, 100, 1000, 4097, 100000};
+
+    for (auto d : all) {
+        for (size_t n : sizes) {
+            auto v = make_data(d, n, 42);
+            auto expect = v;
+            std::sort(expect.begin(), expect.end());
+            mystl::stable_sort(v.begin(), v.end());
+            if (v != expect) {
+                std::cout << "排序结果错误: " << distribution_name(d) << " n=" << n << std::endl;
+                return 1;
+            }
+
+            // 稳定性：键只取少量不同值，排序后等键元素须保持原始相对次序
+            auto keys = make_data(d, n, 7);
+            std::vector<record> r(n);
+            for (size_t i = 0; i < n; ++i) r[i] = record{keys[i] % 64, i};
+            auto r_expect = r;
+            std::stable_sort(r_expect.begin(), r_expect.end(), record_key_less);
+            mystl::stable_sort(r.begin(), r.end(), record_key_less);
+            for (size_t i = 0; i < n; ++i) {
+                if (r[i].key != r_expect[i].key || r[i].index != r_expect[i].index) {
+                    std::cout << "稳定性错误: " << distribution_name(d) << " n=" << n << std::endl;
+                    return 2;
+                }
+            }
+
+            // 自定义比较器（降序）
+            auto w = make_data(d, n, 9);
+            mystl::stable_sort(w.begin(), w.end(), std::greater<int>());
+            if (!std::is_sorted(w.begin(), w.end(), std::greater<int>())) {
+                std::cout << "降序排序错误: " << distribution_name(d) << " n=" << n << std::endl;
+                return 3;
+            }
+        }
+    }
+
+    // 非平凡类型
+    std::vector<std::string> s;
+    std::mt19937 gen(1);
+    for (int i = 0; i < 5000; ++i) s.push_back(std::to_string(gen() % 1000));
+    auto expect = s;
+    std::stable_sort(expect.begin(), expect.end());
+    mystl::stable_sort(s.begin(), s.end());
+    if (s != expect) {
+        std::cout << "字符串排序错误" << std::endl;
+        return 4;
+    }
+
+    // 无缓冲区合并（申请不到缓冲区时的兜底路径）
+    for (size_t n : {2, 3, 10, 1000, 4097}) {
+        auto a = make_data(distribution::random, n, 5);
+        const size_t mid = n / 3;
+        std::sort(a.begin(), a.begin() + mid);
+        std::sort(a.begin() + mid, a.end());
+        auto a_expect = a;
+        std::sort(a_expect.begin(), a_expect.end());
+        mystl::inplace_merge(a.begin(), a.begin() + mid, a.end());
+        if (a != a_expect) {
+            std::cout << "inplace_merge 结果错误: n=" << n << std::endl;
+            return 5;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+template <class Sorter>
+double time_sort(const std::vector<int>& data, Sorter sorter) {
+    auto v = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    sorter(v);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!std::is_sorted(v.begin(), v.end())) {
+        std::cout << "性能测试中排序结果错误" << std::endl;
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void run_benchmark(size_t max_n) {
+    const distribution all[] = {
+        distribution::random, distribution::sorted, distribution::reversed,
+        distribution::mostly_sorted, distribution::sorted_runs, distribution::many_duplicates
+    };
+
+    std::cout << "\n=== mystl::stable_sort vs std::stable_sort（单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(18) << "分布" << std::setw(12) << "规模"
+              << std::setw(14) << "mystl" << std::setw(14) << "std" << "mystl/std" << std::endl;
+
+    for (size_t n = 10000; n <= max_n; n *= 10) {
+        for (auto d : all) {
+            auto data = make_data(d, n, 2024);
+            double t_my = time_sort(data, [](std::vector<int>& v) { mystl::stable_sort(v.begin(), v.end()); });
+            double t_std = time_sort(data, [](std::vector<int>& v) { std::stable_sort(v.begin(), v.end()); });
+            std::cout << std::left << std::setw(18) << distribution_name(d) << std::setw(12) << n
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(14) << t_my << std::setw(14) << t_std
+                      << std::setprecision(2) << (t_std > 0 ? t_my / t_std : 0.0) << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_stable_sort_performance: 正确性测试通过" << std::endl;
+
+    run_benchmark(max_n);
+    return 0;
+}
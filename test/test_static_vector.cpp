@@ -0,0 +1,100 @@
+#include "static_vector.h"
+#include "test_counted.h"
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// 全局 operator new 计数：static_vector 的任何操作都不应访问堆
+static size_t g_new_calls = 0;
+
+void* operator new(size_t n) {
+    ++g_new_calls;
+    void* p = std::malloc(n == 0 ? 1 : n);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+typedef mystl::static_vector<int, 16> int16;
+
+// 元素可平凡拷贝时整个容器可平凡拷贝，容量是编译期常量
+static_assert(std::is_trivially_copyable<int16>::value, "static_vector<int> 应可平凡拷贝");
+static_assert(!std::is_trivially_copyable<mystl::static_vector<std::string, 4>>::value, "string 元素不可平凡拷贝");
+static_assert(int16::capacity() == 16 && int16::max_size() == 16, "容量为编译期常量");
+static_assert(sizeof(int16) == sizeof(size_t) + 16 * sizeof(int), "static_vector 只有元素个数和内联存储");
+
+template <class F>
+bool throws_bad_alloc(F f) {
+    try {
+        f();
+    } catch (const std::bad_alloc&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    std::vector<counted> src;
+    for (int i = 0; i < 6; ++i) src.push_back(counted(100 + i));
+    const long live_src = counted::live();
+
+    const size_t before = g_new_calls;
+    {
+        // 基本操作不访问全局堆，可平凡拷贝时可以按字节拷贝
+        int16 a(8, 3);
+        a.insert(a.begin() + 2, {9, 8, 7});
+        a.erase(a.begin());
+        int16 b(a);
+        b.resize(16);
+        b.swap(a);
+        int16 raw;
+        std::memcpy(static_cast<void*>(&raw), static_cast<const void*>(&b), sizeof(int16));
+        assert(raw.size() == 10 && raw[1] == 9 && raw.back() == 3 && a.size() == 16);
+
+        // 超出容量时抛出 bad_alloc 且不修改容器；try_ 版本返回 nullptr
+        int* full = a.try_push_back(1);
+        const bool push_threw = throws_bad_alloc([&] { a.push_back(1); });
+        const bool insert_threw = throws_bad_alloc([&] { b.insert(b.begin(), 7, 0); });
+        const bool resize_threw = throws_bad_alloc([&] { b.resize(17); });
+        assert(a.full() && full == nullptr);
+        assert(push_threw && insert_threw && resize_threw);
+        assert(a.size() == 16 && b.size() == 10 && b[1] == 9);
+        (void)full, (void)push_threw, (void)insert_threw, (void)resize_threw;
+
+        // 追加自身元素
+        int* p = b.try_emplace_back(b[1]);
+        assert(p == &b.back() && *p == 9 && b.size() == 11);
+        (void)p;
+    }
+    assert(g_new_calls == before);
+
+    // 中途拷贝抛出异常：不泄漏、不重复析构（异常对象本身会访问堆，放在计数之外）
+    for (int k = 1; k <= 6; ++k) {
+        mystl::static_vector<counted, 32> v;
+        for (int i = 0; i < 10; ++i) v.push_back(counted(i));
+        counted::countdown() = k;
+        try {
+            v.insert(v.begin() + 1, src.begin(), src.end());
+        } catch (const std::runtime_error&) {
+        }
+        counted::countdown() = 0;
+        assert(counted::live() == live_src + static_cast<long>(v.size()));
+    }
+    {
+        mystl::static_vector<counted, 4> f(4, counted(1));
+        const bool thrown = throws_bad_alloc([&] { f.insert(f.begin(), src.begin(), src.end()); });
+        assert(thrown && f.size() == 4);
+        (void)thrown;
+    }
+    assert(counted::live() == live_src);
+    (void)live_src, (void)before;
+
+    std::cout << "test_static_vector OK\n";
+    return 0;
+}
@@ -0,0 +1,238 @@
+// mystl::thread_pool 正确性与开销测试：Chase-Lev 队列、submit/future、parallel_invoke、shutdown
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_thread_pool.cpp -o test_thread_pool
+// 运行：./test_thread_pool [任务数，默认 100000]
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <cstdlib>
+#include "thread_pool.h"
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+// 所有者不断压入/弹出，多个窃取者同时窃取，每个元素必须恰好被取走一次
+bool test_chase_lev_deque() {
+    const int n = 200000;
+    const int thieves = 3;
+    std::vector<int> values(n);
+    std::vector<std::atomic<int>> taken(n);
+    for (int i = 0; i < n; ++i) {
+        values[i] = i;
+        taken[i].store(0);
+    }
+    mystl::chase_lev_deque<int*> dq(4);   // 初始容量很小，覆盖扩容路径
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; ++t) {
+        threads.push_back(std::thread([&] {
+            while (!done.load()) {
+                if (int* p = dq.steal()) {
+                    taken[*p].fetch_add(1);
+                }
+            }
+        }));
+    }
+    for (int i = 0; i < n; ++i) {
+        dq.push(&values[i]);
+        if (i % 3 == 0) {
+            if (int* p = dq.pop()) {
+                taken[*p].fetch_add(1);
+            }
+        }
+    }
+    while (int* p = dq.pop()) {
+        taken[*p].fetch_add(1);
+    }
+    done.store(true);
+    for (auto& th : threads) th.join();
+    // 窃取者退出后可能还有元素留在队列中
+    while (int* p = dq.steal()) {
+        taken[*p].fetch_add(1);
+    }
+    for (int i = 0; i < n; ++i) {
+        if (taken[i].load() != 1) {
+            std::cout << "元素 " << i << " 被取走 " << taken[i].load() << " 次" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+long fib_serial(int n) {
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+// 递归 fork-join：在工作线程内嵌套 parallel_invoke
+long fib_parallel(mystl::thread_pool& pool, int n) {
+    if (n < 16) {
+        return fib_serial(n);
+    }
+    long a = 0, b = 0;
+    mystl::parallel_invoke(pool,
+                           [&] { a = fib_parallel(pool, n - 1); },
+                           [&] { b = fib_parallel(pool, n - 2); });
+    return a + b;
+}
+
+int test_correctness() {
+    if (!test_chase_lev_deque()) {
+        std::cout << "chase_lev_deque 并发窃取错误" << std::endl;
+        return 1;
+    }
+
+    mystl::thread_pool pool(4);
+
+    // submit 返回值与参数
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 1000; ++i) {
+        futures.push_back(pool.submit([](int x, int y) { return x * y; }, i, 3));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        if (futures[i].get() != i * 3) {
+            std::cout << "submit 结果错误" << std::endl;
+            return 2;
+        }
+    }
+    std::future<std::string> s = pool.submit([] { return std::string("mystl"); });
+    std::future<void> v = pool.submit([] {});
+    v.get();
+    if (s.get() != "mystl") {
+        std::cout << "submit 字符串结果错误" << std::endl;
+        return 2;
+    }
+
+    // submit 的异常通过 future 传播
+    std::future<int> bad = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    try {
+        bad.get();
+        std::cout << "future 未传播异常" << std::endl;
+        return 3;
+    } catch (const std::runtime_error&) {
+    }
+
+    // parallel_invoke：多个可调用对象，嵌套递归
+    std::atomic<int> hits(0);
+    mystl::parallel_invoke(pool, [&] { ++hits; }, [&] { ++hits; }, [&] { ++hits; }, [&] { ++hits; });
+    if (hits.load() != 4 || fib_parallel(pool, 27) != fib_serial(27)) {
+        std::cout << "parallel_invoke 结果错误" << std::endl;
+        return 4;
+    }
+    try {
+        mystl::parallel_invoke(pool, [] {}, [] { throw std::logic_error("child"); });
+        std::cout << "parallel_invoke 未传播异常" << std::endl;
+        return 5;
+    } catch (const std::logic_error&) {
+    }
+
+    // shutdown：已提交的任务全部执行完，之后外部提交抛出异常
+    mystl::thread_pool small(2);
+    std::atomic<int> finished(0);
+    for (int i = 0; i < 2000; ++i) {
+        small.post([&] {
+            mystl::task_group group(small);
+            group.run([&] { ++finished; });   // 关闭期间工作线程仍可提交子任务
+            group.wait();
+        });
+    }
+    small.shutdown();
+    if (finished.load() != 2000 || small.accepting()) {
+        std::cout << "shutdown 未执行完已提交任务: " << finished.load() << std::endl;
+        return 6;
+    }
+    try {
+        small.post([] {});
+        std::cout << "shutdown 后提交未抛出异常" << std::endl;
+        return 7;
+    } catch (const std::runtime_error&) {
+    }
+    small.shutdown();   // 可重复调用
+    return 0;
+}
+
+// ============================================================================
+// 开销测试
+// ============================================================================
+
+double elapsed_ms(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void run_benchmark(size_t tasks) {
+    mystl::thread_pool pool;
+    std::atomic<size_t> counter(0);
+
+    std::cout << "\n=== 任务调度开销（" << tasks << " 个空任务，" << pool.size()
+              << " 个工作线程，单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(34) << "方式" << std::setw(14) << "耗时" << "每任务(ns)" << std::endl;
+
+    auto row = [](const char* name, double ms, size_t count) {
+        std::cout << std::left << std::setw(34) << name << std::fixed << std::setprecision(3)
+                  << std::setw(14) << ms << std::setprecision(1) << ms * 1e6 / count << std::endl;
+    };
+
+    // 外部线程 post，经注入队列
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        mystl::task_group group(pool);
+        for (size_t i = 0; i < tasks; ++i) group.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        group.wait();
+    }
+    row("task_group::run（外部线程）", elapsed_ms(start), tasks);
+
+    // 工作线程内 fork，走 Chase-Lev 队列
+    start = std::chrono::high_resolution_clock::now();
+    pool.submit([&pool, &counter, tasks] {
+        mystl::task_group group(pool);
+        for (size_t i = 0; i < tasks; ++i) group.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        group.wait();
+    }).get();
+    row("task_group::run（工作线程内）", elapsed_ms(start), tasks);
+
+    // submit + future
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<std::future<void>> futures;
+    futures.reserve(tasks);
+    for (size_t i = 0; i < tasks; ++i) futures.push_back(pool.submit([&counter] { counter.fetch_add(1); }));
+    for (auto& f : futures) f.get();
+    row("submit + future", elapsed_ms(start), tasks);
+
+    // 对比：每个任务一个 std::async（新建线程）
+    const size_t async_tasks = tasks / 10 > 0 ? tasks / 10 : 1;
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<std::future<void>> asyncs;
+    for (size_t i = 0; i < async_tasks; ++i) {
+        asyncs.push_back(std::async(std::launch::async, [&counter] { counter.fetch_add(1); }));
+    }
+    for (auto& f : asyncs) f.get();
+    row("std::async(launch::async)", elapsed_ms(start), async_tasks);
+
+    // 递归 fork-join
+    start = std::chrono::high_resolution_clock::now();
+    long r = fib_parallel(pool, 32);
+    double par_ms = elapsed_ms(start);
+    start = std::chrono::high_resolution_clock::now();
+    long s = fib_serial(32);
+    double ser_ms = elapsed_ms(start);
+    std::cout << "fib(32) 并行 " << std::setprecision(3) << par_ms << " ms，串行 " << ser_ms << " ms"
+              << (r == s ? "" : "（结果不一致）") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t tasks = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 100000;
+
+    int rc = test_correctness();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_thread_pool: 正确性测试通过" << std::endl;
+
+    run_benchmark(tasks);
+    return 0;
+}
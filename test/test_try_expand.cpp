@@ -0,0 +1,236 @@
+// 分配器原地扩展（try_expand）与按字节重新分配（realloc / mremap）的正确性测试，以及 vector 增长的性能对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_try_expand.cpp -o test_try_expand
+// 运行：./test_try_expand [push_back 的 int 个数，默认 33554432（128MB）]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "memory.h"
+#include "arena.h"
+#include "huge_page.h"
+#include "vector.h"
+
+static_assert(mystl::has_try_expand<mystl::pool_allocator<int>>::value, "pool_allocator");
+static_assert(mystl::has_try_expand<mystl::malloc_allocator<int>>::value, "malloc_allocator");
+static_assert(mystl::has_try_expand<mystl::huge_page_allocator<int>>::value, "huge_page_allocator");
+static_assert(mystl::has_try_expand<mystl::arena_allocator<int>>::value, "arena_allocator");
+static_assert(!mystl::has_try_expand<mystl::allocator<int>>::value, "allocator 不支持原地扩展");
+static_assert(mystl::has_reallocate<mystl::malloc_allocator<int>>::value, "malloc_allocator::reallocate");
+static_assert(mystl::has_reallocate<mystl::pool_allocator<int>>::value, "pool_allocator::reallocate");
+static_assert(!mystl::has_reallocate<mystl::arena_allocator<int>>::value, "arena_allocator 无 reallocate");
+
+bool aligned(const void* p, size_t a) {
+    return reinterpret_cast<uintptr_t>(p) % a == 0;
+}
+
+// 逐个 push_back 到 n 个元素，返回缓冲区地址变化的次数
+template <class Vector>
+size_t grow(Vector& v, size_t n) {
+    size_t moves = 0;
+    const void* last = v.data();
+    for (size_t i = 0; i < n; ++i) {
+        v.push_back(static_cast<typename Vector::value_type>(i));
+        if (v.data() != last) {
+            ++moves;
+            last = v.data();
+        }
+    }
+    return moves;
+}
+
+template <class Vector>
+bool check_iota(const Vector& v, size_t n) {
+    if (v.size() != n) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (v[i] != static_cast<typename Vector::value_type>(i)) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+int test_pool() {
+    // 同一大小类内原地扩展，跨类失败
+    void* p = mystl::alloc::allocate(33);
+    if (!mystl::alloc::try_expand(p, 33, 40) || mystl::alloc::try_expand(p, 40, 48) ||
+        mystl::alloc::try_expand(p, 40, 100000)) {
+        std::cout << "alloc::try_expand 大小类判断错误" << std::endl;
+        return 1;
+    }
+    mystl::alloc::deallocate(p, 40);
+
+    // 大块 realloc 保留内容
+    char* big = static_cast<char*>(mystl::alloc::allocate(100000));
+    for (int i = 0; i < 100000; ++i) big[i] = static_cast<char>(i);
+    big = static_cast<char*>(mystl::alloc::reallocate(big, 100000, 1000000));
+    for (int i = 0; i < 100000; ++i) {
+        if (big[i] != static_cast<char>(i)) return 1;
+    }
+    mystl::alloc::deallocate(big, 1000000);
+
+    mystl::vector<int, mystl::pool_allocator<int>> v;
+    grow(v, 100000);
+    v.shrink_to_fit();
+    mystl::vector<std::string, mystl::pool_allocator<std::string>> s;
+    for (int i = 0; i < 1000; ++i) s.push_back(std::to_string(i));
+    if (!check_iota(v, 100000) || s[999] != "999") {
+        std::cout << "pool_allocator 上的 vector 结果错误" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int test_arena() {
+    // 内存区中唯一在增长的 vector：第一次分配之后全部原地扩展
+    mystl::monotonic_arena arena(1 << 20);
+    mystl::vector<int, mystl::arena_allocator<int>> v(arena);
+    const size_t moves = grow(v, 100000);
+    if (moves != 1 || !check_iota(v, 100000) || arena.bytes_allocated() != v.capacity() * sizeof(int)) {
+        std::cout << "内存区上的 vector 未原地扩展: 地址变化 " << moves << " 次, 已分配 "
+                  << arena.bytes_allocated() << " 字节" << std::endl;
+        return 2;
+    }
+    // 中间插入其他分配后不能再原地扩展
+    arena.allocate(16);
+    v.reserve(v.capacity() * 2);
+    if (!check_iota(v, 100000)) return 2;
+    return 0;
+}
+
+int test_malloc() {
+    mystl::vector<int, mystl::malloc_allocator<int>> v;
+    grow(v, 1000000);
+    v.reserve(3000000);
+    v.shrink_to_fit();
+    if (!check_iota(v, 1000000) || v.capacity() != v.size()) {
+        std::cout << "malloc_allocator 上的 vector 结果错误" << std::endl;
+        return 3;
+    }
+    // 扩容时插入自身元素不能走 realloc
+    v.push_back(v[0]);
+    if (v.back() != 0 || v[999999] != 999999) return 3;
+
+    // 可平凡重定位的 unique_ptr 走 realloc，不可的 std::string 只尝试原地扩展
+    mystl::vector<mystl::unique_ptr<int>, mystl::malloc_allocator<mystl::unique_ptr<int>>> ptrs;
+    mystl::vector<std::string, mystl::malloc_allocator<std::string>> strs;
+    for (int i = 0; i < 10000; ++i) {
+        ptrs.push_back(mystl::make_unique<int>(i));
+        strs.push_back(std::string(20, static_cast<char>('a' + i % 26)) + std::to_string(i));
+    }
+    ptrs.shrink_to_fit();
+    long sum = 0;
+    for (size_t i = 0; i < ptrs.size(); ++i) sum += *ptrs[i];
+    if (sum != 9999L * 10000 / 2 || strs[9999].compare(20, 4, "9999") != 0) {
+        std::cout << "malloc_allocator 上的 unique_ptr/string 结果错误" << std::endl;
+        return 3;
+    }
+    return 0;
+}
+
+int test_huge_page() {
+    // huge_page_realloc：页面搬移后内容不变、仍 2MB 对齐；缩小时解除尾部映射
+    const size_t mb = 1u << 20;
+    char* p = static_cast<char*>(mystl::huge_page_alloc(4 * mb));
+    for (size_t i = 0; i < 4 * mb; i += 4096) p[i] = static_cast<char>(i >> 12);
+    void* blocker = mystl::huge_page_alloc(2 * mb);  // 可能占住 p 之后的地址空间
+    p = static_cast<char*>(mystl::huge_page_realloc(p, 4 * mb, 64 * mb));
+    if (p == nullptr || !aligned(p, mystl::HUGE_PAGE_SIZE)) return 4;
+    for (size_t i = 0; i < 4 * mb; i += 4096) {
+        if (p[i] != static_cast<char>(i >> 12)) {
+            std::cout << "huge_page_realloc 后内容错误" << std::endl;
+            return 4;
+        }
+    }
+    p[64 * mb - 1] = 1;
+    p = static_cast<char*>(mystl::huge_page_realloc(p, 64 * mb, 3 * mb));
+    if (p[4096] != 1 || !mystl::huge_page_try_expand(p, 3 * mb, 4 * mb)) return 4;
+    mystl::huge_page_free(p, 4 * mb);
+    mystl::huge_page_free(blocker, 2 * mb);
+
+    // vector 跨过阈值后在大页上按字节重新分配
+    mystl::vector<double, mystl::huge_page_allocator<double>> v;
+    for (size_t i = 0; i < 8 * mb; ++i) {
+        v.push_back(static_cast<double>(i));
+        if (v.capacity() * sizeof(double) >= mystl::HUGE_PAGE_THRESHOLD && !aligned(v.data(), mystl::HUGE_PAGE_SIZE)) {
+            std::cout << "大页 vector 未按 2MB 对齐" << std::endl;
+            return 4;
+        }
+    }
+    v.shrink_to_fit();
+    v.reserve(v.size() + 1);
+    if (!check_iota(v, 8 * mb)) {
+        std::cout << "大页 vector 结果错误" << std::endl;
+        return 4;
+    }
+    return 0;
+}
+
+// ============================================================================
+// 性能测试：push_back 到 n 个 int
+// ============================================================================
+
+volatile long g_sink = 0;
+
+struct grow_result {
+    double ms;
+    size_t moves;
+};
+
+template <class Vector>
+grow_result bench_grow(Vector v, size_t n) {
+    auto start = std::chrono::high_resolution_clock::now();
+    const size_t moves = grow(v, n);
+    auto end = std::chrono::high_resolution_clock::now();
+    g_sink = v[n / 2];
+    grow_result r;
+    r.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    r.moves = moves;
+    return r;
+}
+
+void print_row(const char* name, const grow_result& r, double base_ms) {
+    std::cout << std::left << std::setw(44) << name << std::setw(14) << r.ms << std::setw(18) << r.moves
+              << (r.ms > 0 ? base_ms / r.ms : 0.0) << "x" << std::endl;
+}
+
+void run_benchmark(size_t n) {
+    const grow_result base = bench_grow(mystl::vector<int>(), n);
+    const grow_result pool = bench_grow(mystl::vector<int, mystl::pool_allocator<int>>(), n);
+    const grow_result mall = bench_grow(mystl::vector<int, mystl::malloc_allocator<int>>(), n);
+    const grow_result huge = bench_grow(mystl::vector<int, mystl::huge_page_allocator<int>>(), n);
+    mystl::monotonic_arena arena(n * sizeof(int) * 2);
+    const grow_result area = bench_grow(mystl::vector<int, mystl::arena_allocator<int>>(arena), n);
+
+    std::cout << "\n=== vector<int> 逐个 push_back 到 " << n << " 个元素（" << (n * sizeof(int) >> 20)
+              << "MB，单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(44) << "分配器（扩容方式）" << std::setw(14) << "耗时" << std::setw(18)
+              << "缓冲区地址变化" << "加速比" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    print_row("mystl::allocator（分配+搬移+释放）", base, base.ms);
+    print_row("pool_allocator（大小类内原地 / realloc）", pool, base.ms);
+    print_row("malloc_allocator（realloc）", mall, base.ms);
+    print_row("huge_page_allocator（mremap）", huge, base.ms);
+    print_row("arena_allocator（游标原地推进）", area, base.ms);
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : (size_t(32) << 20);
+    if (n < 2) n = 2;
+
+    int rc = test_pool();
+    if (rc == 0) rc = test_arena();
+    if (rc == 0) rc = test_malloc();
+    if (rc == 0) rc = test_huge_page();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_try_expand: 正确性测试通过" << std::endl;
+
+    run_benchmark(n);
+    return 0;
+}
@@ -0,0 +1,368 @@
+// mystl::vector 的 insert/erase/emplace/assign 与 std::vector 逐步对照的随机正确性测试，以及性能对比
+// 编译：g++ -std=c++11 -O2 -pthread -I.. test_vector_modifiers.cpp -o test_vector_modifiers
+// 运行：./test_vector_modifiers [基准 vector 的元素个数，默认 100000]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <list>
+#include <forward_list>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include "vector.h"
+#include "test_counted.h"
+
+// ============================================================================
+// 测试类型
+// ============================================================================
+
+// 只能遍历一次的输入迭代器
+template <class T>
+class input_iter {
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    explicit input_iter(const T* p) : p_(p) {}
+    reference operator*() const { return *p_; }
+    input_iter& operator++() {
+        ++p_;
+        return *this;
+    }
+    bool operator==(const input_iter& o) const { return p_ == o.p_; }
+    bool operator!=(const input_iter& o) const { return p_ != o.p_; }
+
+private:
+    const T* p_;
+};
+
+template <class T> T make(int i);
+template <> int make<int>(int i) { return i; }
+template <> std::string make<std::string>(int i) { return std::string(i % 3 == 0 ? 24 : 3, 'a') + std::to_string(i); }
+template <> counted make<counted>(int i) { return counted(i); }
+
+template <class T>
+bool same(const mystl::vector<T>& v, const std::vector<T>& s) {
+    if (v.size() != s.size() || v.capacity() < v.size()) return false;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (!(v[i] == s[i])) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 正确性测试
+// ============================================================================
+
+// 先求出返回的迭代器再取 begin()：插入可能重新分配
+template <class Vector, class It>
+size_t index_of(const Vector& v, It it) {
+    return static_cast<size_t>(it - v.begin());
+}
+
+// 随机执行各种修改操作，每一步与 std::vector 比较
+template <class T>
+int random_ops(const char* name, int steps) {
+    std::mt19937 rng(12345);
+    mystl::vector<T> v;
+    std::vector<T> s;
+    auto pick = [&rng](size_t n) { return static_cast<size_t>(rng() % (n + 1)); };
+
+    for (int step = 0; step < steps; ++step) {
+        std::vector<T> src;
+        const int len = static_cast<int>(rng() % 20);
+        for (int i = 0; i < len; ++i) src.push_back(make<T>(step * 31 + i));
+        const size_t pos = pick(s.size());
+        const int op = static_cast<int>(rng() % 14);
+        size_t ret = 0, sret = 0;
+
+        switch (op) {
+        case 0:
+            ret = index_of(v, v.emplace(v.begin() + pos, make<T>(step)));
+            sret = index_of(s, s.emplace(s.begin() + pos, make<T>(step)));
+            break;
+        case 1:
+            if (!s.empty()) {  // 插入自身元素
+                const size_t k = pick(s.size() - 1);
+                ret = index_of(v, v.insert(v.begin() + pos, v[k]));
+                sret = index_of(s, s.insert(s.begin() + pos, s[k]));
+            }
+            break;
+        case 2:
+            if (!s.empty()) {  // 插入 n 个自身元素
+                const size_t k = pick(s.size() - 1);
+                ret = index_of(v, v.insert(v.begin() + pos, static_cast<size_t>(len), v[k]));
+                sret = index_of(s, s.insert(s.begin() + pos, static_cast<size_t>(len), s[k]));
+            }
+            break;
+        case 3:
+            ret = index_of(v, v.insert(v.begin() + pos, src.begin(), src.end()));
+            sret = index_of(s, s.insert(s.begin() + pos, src.begin(), src.end()));
+            break;
+        case 4: {
+            std::list<T> l(src.begin(), src.end());
+            ret = index_of(v, v.insert(v.begin() + pos, l.begin(), l.end()));
+            sret = index_of(s, s.insert(s.begin() + pos, l.begin(), l.end()));
+            break;
+        }
+        case 5: {
+            input_iter<T> first(src.data()), last(src.data() + src.size());
+            ret = index_of(v, v.insert(v.begin() + pos, first, last));
+            sret = index_of(s, s.insert(s.begin() + pos, first, last));
+            break;
+        }
+        case 6: {
+            const size_t last = pos + pick(s.size() - pos);
+            ret = index_of(v, v.erase(v.begin() + pos, v.begin() + last));
+            sret = index_of(s, s.erase(s.begin() + pos, s.begin() + last));
+            break;
+        }
+        case 7:
+            if (pos < s.size()) {
+                ret = index_of(v, v.erase(v.begin() + pos));
+                sret = index_of(s, s.erase(s.begin() + pos));
+            }
+            break;
+        case 8:
+            if (!s.empty()) {  // 扩容时追加自身元素
+                v.shrink_to_fit();
+                v.emplace_back(v[pos == s.size() ? 0 : pos]);
+                s.emplace_back(s[pos == s.size() ? 0 : pos]);
+            }
+            break;
+        case 9:
+            v.assign(src.begin(), src.end());
+            s.assign(src.begin(), src.end());
+            break;
+        case 10: {
+            input_iter<T> first(src.data()), last(src.data() + src.size());
+            v.assign(first, last);
+            s.assign(first, last);
+            break;
+        }
+        case 11:
+            v.assign(static_cast<size_t>(len) * 3, make<T>(step));
+            s.assign(static_cast<size_t>(len) * 3, make<T>(step));
+            break;
+        case 12:
+            if (s.size() < 200) {
+                v.insert(v.end(), src.begin(), src.end());
+                s.insert(s.end(), src.begin(), src.end());
+            } else {
+                v.erase(v.begin(), v.begin() + 100);
+                s.erase(s.begin(), s.begin() + 100);
+            }
+            break;
+        default: {
+            mystl::vector<T> w(src.begin(), src.end());
+            w.insert(w.begin(), {make<T>(-1), make<T>(-2)});
+            std::vector<T> sw(src.begin(), src.end());
+            sw.insert(sw.begin(), {make<T>(-1), make<T>(-2)});
+            if (!same(w, sw)) {
+                std::cout << name << ": 区间构造或初始化列表插入结果错误" << std::endl;
+                return 1;
+            }
+            swap(v, w);
+            s.swap(sw);
+            break;
+        }
+        }
+        if (ret != sret || !same(v, s)) {
+            std::cout << name << ": 第 " << step << " 步（操作 " << op << "）后与 std::vector 不一致" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int test_counted() {
+    counted::live() = 0;
+    int rc = random_ops<counted>("counted", 3000);
+    if (rc == 0 && counted::live() != 0) {
+        std::cout << "counted: 对象析构次数不匹配 " << counted::live() << std::endl;
+        rc = 2;
+    }
+    return rc;
+}
+
+// 插入中途拷贝抛出异常：不泄漏、不重复析构，vector 仍然可用
+int test_exception_safety() {
+    counted::live() = 0;
+    {
+        std::vector<counted> src;
+        for (int i = 0; i < 8; ++i) src.push_back(counted(100 + i));
+        for (int where = 0; where < 3; ++where) {
+            for (int k = 1; k <= 8; ++k) {
+                mystl::vector<counted> v;
+                v.reserve(where == 2 ? 10 : 64);  // 2：容量不足，走重新分配
+                for (int i = 0; i < 10; ++i) v.push_back(counted(i));
+                const size_t pos = where == 0 ? 1 : 8;  // 0：新区间短于尾部；1：长于尾部
+                counted::countdown() = k;
+                bool thrown = false;
+                try {
+                    v.insert(v.begin() + pos, src.begin(), src.end());
+                } catch (const std::runtime_error&) {
+                    thrown = true;
+                }
+                counted::countdown() = 0;
+                if (thrown && counted::live() != static_cast<long>(v.size() + src.size())) {
+                    std::cout << "插入时拷贝抛出异常后存活对象数错误: " << counted::live() << std::endl;
+                    return 3;
+                }
+                if (where == 2 && thrown && (v.size() != 10 || v[9].value != 9)) {
+                    std::cout << "重新分配时拷贝抛出异常后 vector 被修改" << std::endl;
+                    return 3;
+                }
+                v.insert(v.begin(), counted(-1));
+                v.erase(v.begin(), v.begin() + static_cast<long>(v.size() / 2));
+            }
+        }
+    }
+    return counted::live() == 0 ? 0 : 3;
+}
+
+int test_single_reallocation() {
+    // 容量不足的区间插入只重新分配一次，新容量至少是最终大小
+    mystl::vector<int> v(100, 1);
+    std::list<int> l(1000, 2);
+    const int* before = v.data();
+    v.insert(v.begin() + 50, l.begin(), l.end());
+    if (v.size() != 1100 || v.capacity() < 1100 || v.data() == before || v[50] != 2 || v[1050] != 1) return 4;
+    const int* after = v.data();
+    v.erase(v.begin() + 10, v.begin() + 1010);
+    v.insert(v.begin() + 3, l.begin(), l.end());  // 容量足够，不重新分配
+    return v.data() == after && v.size() == 1100 ? 0 : 4;
+}
+
+// ============================================================================
+// 性能测试
+// ============================================================================
+
+volatile long g_sink = 0;
+
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <class Vector, class Src>
+double bench_range_insert(size_t n, const Src& src, int rounds) {
+    return time_ms([&] {
+        for (int r = 0; r < rounds; ++r) {
+            Vector v(n, typename Vector::value_type());
+            v.insert(v.begin() + static_cast<long>(n / 2), src.begin(), src.end());
+            g_sink = static_cast<long>(v.size());
+        }
+    });
+}
+
+template <class Vector>
+double bench_erase(size_t n, int rounds) {
+    Vector v(n, typename Vector::value_type());
+    const size_t chunk = n / static_cast<size_t>(rounds) / 2 + 1;
+    return time_ms([&] {
+        for (int r = 0; r < rounds && v.size() > chunk; ++r) {
+            v.erase(v.begin() + static_cast<long>(chunk), v.begin() + static_cast<long>(2 * chunk));
+        }
+        g_sink = static_cast<long>(v.size());
+    });
+}
+
+template <class Vector>
+double bench_front_insert(size_t n) {
+    return time_ms([&] {
+        Vector v;
+        for (size_t i = 0; i < n; ++i) v.insert(v.begin(), typename Vector::value_type());
+        g_sink = static_cast<long>(v.size());
+    });
+}
+
+template <class Vector, class Src>
+double bench_assign(const Src& src, int rounds) {
+    Vector v;
+    return time_ms([&] {
+        for (int r = 0; r < rounds; ++r) {
+            v.assign(src.begin(), src.end());
+            v.erase(v.begin() + static_cast<long>(v.size() / 2), v.end());
+        }
+        g_sink = static_cast<long>(v.size());
+    });
+}
+
+// 旧写法：没有区间 insert 时只能逐个 push_back 再把尾部搬回去
+double bench_push_back_loop(size_t n, const std::vector<int>& src, int rounds) {
+    return time_ms([&] {
+        for (int r = 0; r < rounds; ++r) {
+            mystl::vector<int> v(n, 0);
+            mystl::vector<int> tail;
+            for (size_t i = n / 2; i < n; ++i) tail.push_back(v[i]);
+            v.resize(n / 2);
+            for (size_t i = 0; i < src.size(); ++i) v.push_back(src[i]);
+            for (size_t i = 0; i < tail.size(); ++i) v.push_back(tail[i]);
+            g_sink = static_cast<long>(v.size());
+        }
+    });
+}
+
+void print_row(const char* name, double mine, double theirs) {
+    std::cout << std::left << std::setw(56) << name << std::setw(16) << mine << std::setw(16) << theirs
+              << (mine > 0 ? theirs / mine : 0.0) << "x" << std::endl;
+}
+
+void run_benchmark(size_t n) {
+    const int rounds = 50;
+    std::vector<int> ints(n / 4, 7);
+    // 用 forward_list：libstdc++ 的 std::distance 对 std::list 迭代器直接读取节点计数，两边不可比
+    std::forward_list<int> int_list(n / 4, 7);
+    std::vector<std::string> strs(n / 16, std::string(32, 's'));
+
+    std::cout << "\n=== mystl::vector 与 std::vector 对比（基准 " << n << " 个元素，单位：毫秒）===" << std::endl;
+    std::cout << std::left << std::setw(56) << "操作" << std::setw(16) << "mystl::vector" << std::setw(16)
+              << "std::vector" << "std/mystl" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    print_row("int 中部插入 n/4 个（vector 区间）x50", bench_range_insert<mystl::vector<int>>(n, ints, rounds),
+              bench_range_insert<std::vector<int>>(n, ints, rounds));
+    print_row("int 中部插入 n/4 个（forward_list 区间）x50", bench_range_insert<mystl::vector<int>>(n, int_list, rounds),
+              bench_range_insert<std::vector<int>>(n, int_list, rounds));
+    print_row("string 中部插入 n/16 个 x50",
+              bench_range_insert<mystl::vector<std::string>>(n / 4, strs, rounds),
+              bench_range_insert<std::vector<std::string>>(n / 4, strs, rounds));
+    print_row("int 区间删除 x50", bench_erase<mystl::vector<int>>(n, rounds), bench_erase<std::vector<int>>(n, rounds));
+    print_row("string 区间删除 x50", bench_erase<mystl::vector<std::string>>(n / 4, rounds),
+              bench_erase<std::vector<std::string>>(n / 4, rounds));
+    print_row("int 头部逐个 insert n/10 次", bench_front_insert<mystl::vector<int>>(n / 10),
+              bench_front_insert<std::vector<int>>(n / 10));
+    print_row("string assign 区间 x50", bench_assign<mystl::vector<std::string>>(strs, rounds),
+              bench_assign<std::vector<std::string>>(strs, rounds));
+
+    std::cout << "\n区间 insert 对比逐个 push_back 拼接（int，vector 区间 x50）：" << std::endl;
+    print_row("mystl 区间 insert / push_back 循环", bench_range_insert<mystl::vector<int>>(n, ints, rounds),
+              bench_push_back_loop(n, ints, rounds));
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 100000;
+    if (n < 64) n = 64;
+
+    int rc = random_ops<int>("int", 3000);
+    if (rc == 0) rc = random_ops<std::string>("string", 3000);
+    if (rc == 0) rc = test_counted();
+    if (rc == 0) rc = test_exception_safety();
+    if (rc == 0) rc = test_single_reallocation();
+    if (rc != 0) {
+        return rc;
+    }
+    std::cout << "test_vector_modifiers: 正确性测试通过" << std::endl;
+
+    run_benchmark(n);
+    return 0;
+}
@@ -0,0 +1,576 @@
+#ifndef MYTINYSTL_THREAD_POOL_H
+#define MYTINYSTL_THREAD_POOL_H
+
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "memory.h"
+#include "vector.h"
+#include "util.h"
+
+namespace mystl {
+
+// ============================================================================
+// 任务
+// ============================================================================
+
+/**
+ * @brief 线程池中的任务：类型擦除的可调用对象，执行后由执行者释放
+ */
+class pool_task {
+public:
+    virtual ~pool_task() {}
+    virtual void run() = 0;
+};
+
+template <class F>
+class pool_task_impl : public pool_task {
+public:
+    explicit pool_task_impl(F&& f) : fn_(mystl::move(f)) {}
+    explicit pool_task_impl(const F& f) : fn_(f) {}
+
+    void run() override {
+        fn_();
+    }
+
+private:
+    F fn_;
+};
+
+// ============================================================================
+// Chase-Lev 工作窃取双端队列
+// ============================================================================
+
+/**
+ * @brief Chase-Lev 无锁工作窃取双端队列
+ *
+ * 只有所有者线程调用 push / pop，在底部操作（后进先出）；
+ * 任意线程可调用 steal，从顶部取（先进先出）。只有队列剩一个元素时
+ * 所有者和窃取者才需要通过 CAS 竞争。
+ * 实现参考 Lê 等人给出的 C11 内存模型版本（PPoPP 2013）。
+ *
+ * 扩容后旧的环形数组不会立即释放（窃取者可能仍在读），而是保留到队列析构。
+ */
+template <class T>
+class chase_lev_deque {
+    static_assert(std::is_pointer<T>::value, "chase_lev_deque stores pointers only");
+
+public:
+    explicit chase_lev_deque(ptrdiff_t capacity = 256)
+        : top_(0), bottom_(0) {
+        ptrdiff_t cap = 1;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        ring* r = new ring(cap);
+        rings_.push_back(mystl::unique_ptr<ring>(r));
+        array_.store(r, std::memory_order_relaxed);
+    }
+
+    chase_lev_deque(const chase_lev_deque&) = delete;
+    chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+    /**
+     * @brief 在底部压入元素，仅所有者线程调用
+     */
+    void push(T item) {
+        const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+        const ptrdiff_t t = top_.load(std::memory_order_acquire);
+        ring* r = array_.load(std::memory_order_relaxed);
+        if (b - t > r->capacity - 1) {
+            r = grow(r, t, b);
+        }
+        r->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 从底部弹出元素，仅所有者线程调用
+     * @return 队列为空时返回 nullptr
+     */
+    T pop() {
+        const ptrdiff_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        ring* r = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        ptrdiff_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            // 原本就是空的
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T item = r->get(b);
+        if (t == b) {
+            // 最后一个元素：与窃取者竞争
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * @brief 从顶部窃取元素，任意线程可调用
+     * @return 队列为空或与其他线程竞争失败时返回 nullptr
+     */
+    T steal() {
+        ptrdiff_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const ptrdiff_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+        ring* r = array_.load(std::memory_order_acquire);
+        T item = r->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    /**
+     * @brief 近似的元素个数，并发修改时仅供参考
+     */
+    ptrdiff_t size_hint() const noexcept {
+        const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+        const ptrdiff_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+private:
+    // 容量为 2 的幂的环形数组
+    struct ring {
+        explicit ring(ptrdiff_t cap) : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+        ~ring() {
+            delete[] slots;
+        }
+
+        T get(ptrdiff_t i) const noexcept {
+            return slots[i & mask].load(std::memory_order_relaxed);
+        }
+        void put(ptrdiff_t i, T item) noexcept {
+            slots[i & mask].store(item, std::memory_order_relaxed);
+        }
+
+        ptrdiff_t       capacity;
+        ptrdiff_t       mask;
+        std::atomic<T>* slots;
+    };
+
+    ring* grow(ring* old, ptrdiff_t t, ptrdiff_t b) {
+        ring* r = new ring(old->capacity * 2);
+        rings_.push_back(mystl::unique_ptr<ring>(r));
+        for (ptrdiff_t i = t; i < b; ++i) {
+            r->put(i, old->get(i));
+        }
+        array_.store(r, std::memory_order_release);
+        return r;
+    }
+
+private:
+    std::atomic<ptrdiff_t>                 top_;
+    std::atomic<ptrdiff_t>                 bottom_;
+    std::atomic<ring*>                     array_;
+    mystl::vector<mystl::unique_ptr<ring>> rings_;   // 所有用过的数组，仅所有者线程修改
+};
+
+// ============================================================================
+// 工作窃取线程池
+// ============================================================================
+
+/**
+ * @brief 工作窃取线程池
+ *
+ * 每个工作线程拥有一个 Chase-Lev 双端队列：工作线程内提交的任务压入自己的队列底部，
+ * 自己从底部取（后进先出，缓存友好），空闲时从其他队列顶部窃取（先进先出，
+ * 窃取到的通常是较大的任务）。外部线程提交的任务进入一个加锁的注入队列。
+ * 没有任务时工作线程在条件变量上休眠，只有存在休眠线程时提交任务才会加锁唤醒。
+ *
+ * - submit 返回 std::future，任务的返回值或异常通过 future 取得；
+ * - post 提交不关心结果的任务，抛出的异常会被忽略；
+ * - task_group / parallel_invoke 提供 fork-join 语义；
+ * - shutdown 拒绝新的外部任务，执行完已提交的任务后停止所有工作线程。
+ */
+class thread_pool {
+public:
+    /**
+     * @brief 创建线程池
+     * @param thread_count 工作线程数，为 0 时取 1
+     */
+    explicit thread_pool(size_t thread_count = default_thread_count())
+        : queued_(0), sleepers_(0), stop_(false), accepting_(true) {
+        if (thread_count == 0) {
+            thread_count = 1;
+        }
+        for (size_t i = 0; i < thread_count; ++i) {
+            deques_.push_back(mystl::unique_ptr<chase_lev_deque<pool_task*>>(new chase_lev_deque<pool_task*>));
+        }
+        try {
+            for (size_t i = 0; i < thread_count; ++i) {
+                threads_.push_back(std::thread(&thread_pool::worker_loop, this, i));
+            }
+        } catch (...) {
+            // 线程创建失败：停止已启动的线程后再抛出，否则 std::thread 析构会终止程序
+            shutdown();
+            throw;
+        }
+    }
+
+    /**
+     * @brief 等价于 shutdown()
+     */
+    ~thread_pool() {
+        shutdown();
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /**
+     * @brief 工作线程数
+     */
+    size_t size() const noexcept {
+        return deques_.size();
+    }
+
+    /**
+     * @brief 提交一个任务并返回其结果的 future
+     * @param f 可调用对象
+     * @param args 调用参数，按值保存
+     * @return 任务结果的 future，任务抛出的异常在 get() 时重新抛出
+     *
+     * 线程池已 shutdown 时从外部线程提交会抛出 std::runtime_error。
+     */
+    template <class F, class... Args>
+    std::future<decltype(std::declval<typename std::decay<F>::type&>()(
+        std::declval<typename std::decay<Args>::type&>()...))>
+    submit(F&& f, Args&&... args) {
+        // bind 保存 f 与参数的副本，以左值调用
+        typedef decltype(std::declval<typename std::decay<F>::type&>()(
+            std::declval<typename std::decay<Args>::type&>()...)) result_type;
+        // packaged_task 不可复制，用 shared_ptr 包装后放进任务
+        std::shared_ptr<std::packaged_task<result_type()>> task =
+            std::make_shared<std::packaged_task<result_type()>>(
+                std::bind(mystl::forward<F>(f), mystl::forward<Args>(args)...));
+        std::future<result_type> result = task->get_future();
+        post([task] { (*task)(); });
+        return result;
+    }
+
+    /**
+     * @brief 提交一个不关心结果的任务，任务抛出的异常会被忽略
+     * @param f 可调用对象
+     */
+    template <class F>
+    void post(F&& f) {
+        typedef pool_task_impl<typename std::decay<F>::type> task_type;
+        enqueue(new task_type(mystl::forward<F>(f)));
+    }
+
+    /**
+     * @brief 取出一个待执行的任务并在当前线程执行
+     * @return 没有可执行的任务时返回 false
+     *
+     * 供等待子任务的线程调用：与其阻塞，不如帮忙执行任务，也避免工作线程全部阻塞导致死锁。
+     */
+    bool run_pending_task() {
+        const worker_slot& slot = current_slot();
+        pool_task* task = slot.pool == this ? find_task(slot.index) : find_task(size());
+        if (task == nullptr) {
+            return false;
+        }
+        run_task(task);
+        return true;
+    }
+
+    /**
+     * @brief 当前线程是否为本线程池的工作线程
+     */
+    bool in_worker_thread() const noexcept {
+        return current_slot().pool == this;
+    }
+
+    /**
+     * @brief 停止线程池：不再接受外部提交，执行完所有已提交的任务后回收工作线程
+     *
+     * 已在执行的任务仍可继续提交子任务。可重复调用；不能在本线程池的工作线程中调用。
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            accepting_.store(false);
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_.store(true);
+        }
+        sleep_cv_.notify_all();
+        std::lock_guard<std::mutex> lock(join_mutex_);
+        for (size_t i = 0; i < threads_.size(); ++i) {
+            if (threads_[i].joinable()) {
+                threads_[i].join();
+            }
+        }
+    }
+
+    /**
+     * @brief 线程池是否仍接受外部提交的任务
+     */
+    bool accepting() const noexcept {
+        return accepting_.load();
+    }
+
+    /**
+     * @brief 默认线程数：硬件并发数，获取不到时为 1
+     */
+    static size_t default_thread_count() noexcept {
+        const unsigned n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    /**
+     * @brief 进程内共享的默认线程池，首次使用时创建
+     */
+    static thread_pool& default_pool() {
+        static thread_pool pool;
+        return pool;
+    }
+
+private:
+    // 当前线程所属的线程池及其队列下标，非工作线程的 pool 为空
+    struct worker_slot {
+        const thread_pool* pool;
+        size_t             index;
+    };
+
+    static worker_slot& current_slot() noexcept {
+        static thread_local worker_slot slot = {nullptr, 0};
+        return slot;
+    }
+
+    void enqueue(pool_task* task) {
+        const worker_slot& slot = current_slot();
+        if (slot.pool == this) {
+            deques_[slot.index]->push(task);
+            queued_.fetch_add(1);
+        } else {
+            // 计数也在锁内完成：shutdown 关闭提交之后，所有已注入的任务都已计入 queued_
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            if (!accepting_.load()) {
+                delete task;
+                throw std::runtime_error("thread_pool: submit after shutdown");
+            }
+            inject_.push_back(task);
+            queued_.fetch_add(1);
+        }
+        if (sleepers_.load() > 0) {
+            // 与休眠线程检查条件的过程互斥，避免丢失唤醒
+            { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+            sleep_cv_.notify_one();
+        }
+    }
+
+    pool_task* take_injected() {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        if (inject_.empty()) {
+            return nullptr;
+        }
+        pool_task* task = inject_.front();
+        inject_.pop_front();
+        return task;
+    }
+
+    // 依次尝试：自己的队列、注入队列、窃取其他队列；self 为自己的下标，外部线程传 size()
+    pool_task* find_task(size_t self) {
+        pool_task* task = nullptr;
+        if (self < deques_.size()) {
+            task = deques_[self]->pop();
+        }
+        if (task == nullptr && queued_.load(std::memory_order_relaxed) > 0) {
+            task = take_injected();
+            const size_t n = deques_.size();
+            for (size_t k = 1; task == nullptr && k <= n; ++k) {
+                const size_t victim = (self + k) % n;
+                if (victim != self) {
+                    task = deques_[victim]->steal();
+                }
+            }
+        }
+        if (task != nullptr) {
+            queued_.fetch_sub(1);
+        }
+        return task;
+    }
+
+    static void run_task(pool_task* task) noexcept {
+        try {
+            task->run();
+        } catch (...) {
+            // post 的任务没有接收异常的地方，直接忽略
+        }
+        delete task;
+    }
+
+    void worker_loop(size_t index) {
+        worker_slot& slot = current_slot();
+        slot.pool = this;
+        slot.index = index;
+        for (;;) {
+            pool_task* task = find_task(index);
+            if (task != nullptr) {
+                run_task(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleepers_.fetch_add(1);
+            sleep_cv_.wait(lock, [this] { return stop_.load() || queued_.load() > 0; });
+            sleepers_.fetch_sub(1);
+            if (stop_.load() && queued_.load() <= 0) {
+                return;
+            }
+        }
+    }
+
+private:
+    mystl::vector<mystl::unique_ptr<chase_lev_deque<pool_task*>>> deques_;
+    mystl::vector<std::thread>                                   threads_;
+    std::mutex                                                   inject_mutex_;
+    std::deque<pool_task*>                                       inject_;     // 外部线程提交的任务
+    std::mutex                                                   sleep_mutex_;
+    std::condition_variable                                      sleep_cv_;
+    std::mutex                                                   join_mutex_;
+    std::atomic<ptrdiff_t>                                       queued_;     // 尚未取出的任务总数
+    std::atomic<ptrdiff_t>                                       sleepers_;   // 正在休眠的工作线程数
+    std::atomic<bool>                                            stop_;
+    std::atomic<bool>                                            accepting_;
+};
+
+// ============================================================================
+// 任务组
+// ============================================================================
+
+/**
+ * @brief 一组在线程池上执行、可统一等待的任务（fork-join）
+ *
+ * wait 在等待期间会帮忙执行线程池中的任务，因此可以在工作线程内嵌套使用。
+ * 任务抛出的第一个异常会在 wait 中重新抛出。析构时会等待未完成的任务。
+ */
+class task_group {
+public:
+    explicit task_group(thread_pool& pool) : pool_(pool), pending_(0) {}
+
+    ~task_group() {
+        // 保证不会有任务在任务组销毁后访问它
+        help_until_done();
+    }
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    /**
+     * @brief 提交一个任务
+     * @param f 可调用对象
+     */
+    template <class F>
+    void run(F&& f) {
+        typedef typename std::decay<F>::type function_type;
+        function_type fn(mystl::forward<F>(f));
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        task_group* self = this;
+        try {
+            pool_.post([self, fn]() mutable {
+                try {
+                    fn();
+                } catch (...) {
+                    self->record_exception(std::current_exception());
+                }
+                self->pending_.fetch_sub(1, std::memory_order_release);
+            });
+        } catch (...) {
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    /**
+     * @brief 等待所有任务完成，期间帮忙执行线程池中的任务
+     */
+    void wait() {
+        help_until_done();
+        if (error_) {
+            std::exception_ptr e = error_;
+            error_ = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    void help_until_done() {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            if (!pool_.run_pending_task()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void record_exception(std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) {
+            error_ = e;
+        }
+    }
+
+private:
+    thread_pool&          pool_;
+    std::atomic<size_t>   pending_;
+    std::mutex            error_mutex_;
+    std::exception_ptr    error_;
+};
+
+// ============================================================================
+// parallel_invoke
+// ============================================================================
+
+inline void parallel_invoke_spawn(task_group&) {}
+
+template <class F, class... Rest>
+void parallel_invoke_spawn(task_group& group, F&& f, Rest&&... rest) {
+    group.run(mystl::forward<F>(f));
+    mystl::parallel_invoke_spawn(group, mystl::forward<Rest>(rest)...);
+}
+
+/**
+ * @brief 在线程池上并行执行若干个可调用对象，全部完成后返回
+ * @param pool 线程池
+ * @param f 第一个可调用对象，在当前线程执行
+ * @param rest 其余可调用对象，提交到线程池
+ *
+ * 任一可调用对象抛出的异常会在所有任务结束后重新抛出（多个时取第一个）。
+ */
+template <class F, class... Rest>
+void parallel_invoke(thread_pool& pool, F&& f, Rest&&... rest) {
+    task_group group(pool);
+    mystl::parallel_invoke_spawn(group, mystl::forward<Rest>(rest)...);
+    // f 抛出异常时由 task_group 的析构函数等待其余任务结束
+    f();
+    group.wait();
+}
+
+} // namespace mystl
+
+#endif // !MYTINYSTL_THREAD_POOL_H
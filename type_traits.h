@@ -384,6 +384,34 @@ struct is_smart_pointer<std::shared_ptr<T>> : m_true_type {};
 template<typename T>
 struct is_smart_pointer<std::weak_ptr<T>> : m_true_type {};
 
+/**
+ * @brief 判断类型是否可平凡重定位
+ * @tparam T 待检查的类型
+ *
+ * 可平凡重定位：把对象的字节 memcpy 到新地址、且不再析构原对象，
+ * 等价于移动构造到新地址后析构原对象。容器扩容时据此整块搬移元素。
+ * 平凡可拷贝的类型自动满足；只持有外部资源指针、不保存自身地址的类型
+ * （如 unique_ptr、shared_ptr）也满足，可以特化为 m_true_type 显式开启：
+ *   namespace mystl { template<> struct is_trivially_relocatable<handle> : m_true_type {}; }
+ * 保存指向自身成员指针的类型不满足，例如 libstdc++ 的 std::string（短字符串指向对象内缓冲区）。
+ */
+template<typename T>
+struct is_trivially_relocatable : m_bool_constant<std::is_trivially_copyable<T>::value> {};
+
+template<typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : m_true_type {};
+
+template<typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : m_true_type {};
+
+template<typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : m_true_type {};
+
+template<typename T1, typename T2>
+struct is_trivially_relocatable<std::pair<T1, T2>> : m_bool_constant<
+    is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value
+> {};
+
 /**
  * @brief 判断类型是否为容器
  * @tparam T 待检查的类型
@@ -1,9 +1,12 @@
 #ifndef MYTINYSTL_UNINITIALIZED_H_
 #define MYTINYSTL_UNINITIALIZED_H_
 
+#include <cstring>
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 #include "construct.h"
+#include "iterator.h"
 #include "type_traits.h"
 #include "exceptdef.h"
 
@@ -33,7 +36,7 @@ ForwardIterator uninitialized_copy(InputIterator first, InputIterator last, Forw
         return current;
     } catch (...) {
         // 异常安全：析构已构造的对象
-        destroy(result, current);
+        mystl::destroy(result, current);
         throw;
     }
 }
@@ -75,11 +78,46 @@ ForwardIterator uninitialized_move(InputIterator first, InputIterator last, Forw
         return current;
     } catch (...) {
         // 异常安全：析构已构造的对象
-        destroy(result, current);
+        mystl::destroy(result, current);
         throw;
     }
 }
 
+// 可平凡重定位：整块拷贝字节，源对象的生命周期随之结束，不再析构
+template<typename T>
+T* uninitialized_relocate_aux(T* first, T* last, T* result, m_true_type) noexcept {
+    if (first != last) {
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(first),
+                    static_cast<std::size_t>(last - first) * sizeof(T));
+    }
+    return result + (last - first);
+}
+
+// 一般类型：逐个移动构造，全部成功后再析构源对象
+template<typename T>
+T* uninitialized_relocate_aux(T* first, T* last, T* result, m_false_type) {
+    T* end = mystl::uninitialized_move(first, last, result);
+    mystl::destroy(first, last);
+    return end;
+}
+
+/**
+ * @brief 未初始化重定位：把 [first, last) 的对象搬到 result 开始的未初始化内存，并结束源对象的生命周期
+ * @tparam T 对象类型
+ * @param first 源起始指针
+ * @param last 源结束指针
+ * @param result 目标起始指针，与源区间不重叠
+ * @return 目标结束指针
+ *
+ * is_trivially_relocatable<T> 为真时是一次 memcpy，不会抛出；否则移动构造后析构源对象，
+ * 移动构造抛出时已构造的目标对象被析构，源对象保持原状。
+ */
+template<typename T>
+T* uninitialized_relocate(T* first, T* last, T* result) {
+    return uninitialized_relocate_aux(first, last, result,
+                                      m_bool_constant<is_trivially_relocatable<T>::value>());
+}
+
 /**
  * @brief 未初始化填充
  * @tparam ForwardIterator 前向迭代器类型
@@ -98,7 +136,7 @@ void uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& va
         }
     } catch (...) {
         // 异常安全：析构已构造的对象
-        destroy(first, current);
+        mystl::destroy(first, current);
         throw;
     }
 }
@@ -139,7 +177,7 @@ ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const T& val
         return current;
     } catch (...) {
         // 异常安全：析构已构造的对象
-        destroy(first, current);
+        mystl::destroy(first, current);
         throw;
     }
 }
@@ -162,6 +200,113 @@ uninitialized_fill_n(T* first, Size n, const T& value) {
     return first + n;
 }
 
+// ============================================================================
+// 连续存储中的插入与删除
+// ============================================================================
+//
+// 供 vector、small_vector 等连续存储容器共用：[p, end) 为已构造的元素，end 之后有足够的
+// 未初始化空间。end 以引用传入并随构造推进，抛出异常时仍指向已构造元素的末尾，
+// 容器据此保持基本异常保证。
+
+// 把 [src, src + n) 平移到 dest，区间可以重叠；仅用于可平凡拷贝的元素
+template<typename T>
+void move_bytes(T* dest, const T* src, std::size_t n) noexcept {
+    if (n != 0 && src != nullptr) {
+        std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+    }
+}
+
+/**
+ * @brief 在 p 处插入 [first, last) 的 n 个元素，p 之后的元素后移 n 位
+ * @param p 插入位置
+ * @param end 尾指针，之后至少有 n 个未初始化位置；返回时增加 n
+ *
+ * 可平凡拷贝的元素：尾部一次 memmove 后移，再拷入新元素。其他元素：新区间比 p 之后的
+ * 元素少时，把末尾 n 个元素移到未初始化区，其余后移；否则先在未初始化区构造多出的
+ * 新元素，再把 p 之后的元素整体移过去。每个元素只搬动一次。[first, last) 不能指向 [p, end)。
+ */
+template<typename T, typename ForwardIt>
+void shift_insert(T* p, T*& end, ForwardIt first, ForwardIt last, std::size_t n) {
+    T* old_end = end;
+    const std::size_t elems_after = static_cast<std::size_t>(old_end - p);
+    if (std::is_trivially_copyable<T>::value) {
+        mystl::move_bytes(p + n, p, elems_after);
+        std::copy(first, last, p);
+        end += n;
+    } else if (elems_after > n) {
+        mystl::uninitialized_move(old_end - n, old_end, old_end);
+        end += n;
+        std::move_backward(p, old_end - n, old_end);
+        std::copy(first, last, p);
+    } else {
+        ForwardIt mid = first;
+        mystl::advance(mid, elems_after);
+        mystl::uninitialized_copy(mid, last, old_end);
+        end += n - elems_after;
+        try {
+            mystl::uninitialized_move(p, old_end, end);
+        } catch (...) {
+            mystl::destroy(old_end, end);
+            end = old_end;
+            throw;
+        }
+        end += elems_after;
+        std::copy(first, mid, p);
+    }
+}
+
+/**
+ * @brief 在 p 处插入 n 个 value，p 之后的元素后移 n 位，步骤同 shift_insert
+ * @param value 不能引用 [p, end) 中的元素
+ */
+template<typename T>
+void shift_fill(T* p, T*& end, std::size_t n, const T& value) {
+    T* old_end = end;
+    const std::size_t elems_after = static_cast<std::size_t>(old_end - p);
+    if (std::is_trivially_copyable<T>::value) {
+        mystl::move_bytes(p + n, p, elems_after);
+        std::fill_n(p, n, value);
+        end += n;
+    } else if (elems_after > n) {
+        mystl::uninitialized_move(old_end - n, old_end, old_end);
+        end += n;
+        std::move_backward(p, old_end - n, old_end);
+        std::fill_n(p, n, value);
+    } else {
+        end = mystl::uninitialized_fill_n(old_end, n - elems_after, value);
+        try {
+            mystl::uninitialized_move(p, old_end, end);
+        } catch (...) {
+            mystl::destroy(old_end, end);
+            end = old_end;
+            throw;
+        }
+        end += elems_after;
+        std::fill(p, old_end, value);
+    }
+}
+
+/**
+ * @brief 删除 [first, last)，之后的元素一次性前移
+ * @param end 尾指针，返回时减少 last - first
+ *
+ * 可平凡拷贝时一次 memmove，否则逐个移动赋值，最后只析构末尾多出来的元素。
+ */
+template<typename T>
+void shift_erase(T* first, T* last, T*& end) {
+    if (first == last) {
+        return;
+    }
+    if (std::is_trivially_copyable<T>::value) {
+        mystl::move_bytes(first, last, static_cast<std::size_t>(end - last));
+        end -= (last - first);
+    } else {
+        T* new_end = std::move(last, end, first);
+        mystl::destroy(new_end, end);
+        end = new_end;
+    }
+}
+
 // ============================================================================
 // 未初始化存储的异常安全版本
 // ============================================================================
@@ -186,7 +331,7 @@ uninitialized_copy_safe(InputIterator first, InputIterator last, ForwardIterator
             ++count;
         } else {
             // 构造失败，析构已构造的对象
-            destroy(result, current);
+            mystl::destroy(result, current);
             break;
         }
     }
@@ -214,7 +359,7 @@ uninitialized_fill_safe(ForwardIterator first, ForwardIterator last, const T& va
             ++count;
         } else {
             // 构造失败，析构已构造的对象
-            destroy(first, current);
+            mystl::destroy(first, current);
             break;
         }
     }
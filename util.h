@@ -89,6 +89,12 @@ struct pair {
     }
 };
 
+// 两个成员都可平凡重定位时 pair 也可平凡重定位
+template<typename T1, typename T2>
+struct is_trivially_relocatable<pair<T1, T2>> : m_bool_constant<
+    is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value
+> {};
+
 // ============================================================================
 // pair 比较操作符
 // ============================================================================
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <initializer_list>
 #include <stdexcept>
@@ -10,6 +11,7 @@
 #include <iterator>
 
 #include "allocator.h"
+#include "growth_policy.h"
 #include "construct.h"
 #include "uninitialized.h"
 #include "iterator.h"
@@ -22,12 +24,14 @@ namespace mystl {
  * @brief 动态数组容器
  * @tparam T 元素类型
  * @tparam Alloc 分配器类型，默认为 mystl::allocator<T>
+ * @tparam Growth 增长策略（见 growth_policy.h），默认为容量翻倍
  * 
  * vector 是一个动态数组容器，支持随机访问，在末尾插入和删除元素的时间复杂度为 O(1)。
- * 当容量不足时会自动扩容，扩容策略为容量翻倍。
+ * 当容量不足时会自动扩容，新容量由 Growth 决定。Growth 声明了计数器时（如 growth_tracked），
+ * 每个实例记录重新分配次数、搬移字节数与空闲容量峰值，通过 growth_stats() 读取。
  */
-template<typename T, typename Alloc = mystl::allocator<T>>
-class vector {
+template<typename T, typename Alloc = mystl::allocator<T>, typename Growth = growth_double>
+class vector : private growth_stats_type<Growth>::type {
 private:
     T* begin_;           // 指向第一个元素
     T* end_;            // 指向最后一个元素的下一个位置
@@ -51,6 +55,8 @@ public:
     typedef mystl::reverse_iterator<iterator>           reverse_iterator;
     typedef mystl::reverse_iterator<const_iterator>     const_reverse_iterator;
     typedef Alloc                                       allocator_type;
+    typedef Growth                                      growth_policy;
+    typedef typename growth_stats_type<Growth>::type    stats_type;
 
     // ============================================================================
     // 构造函数和析构函数
@@ -62,12 +68,22 @@ public:
      */
     vector() noexcept : begin_(nullptr), end_(nullptr), cap_(nullptr) {}
 
+    /**
+     * @brief 指定分配器的构造函数
+     * @param alloc 分配器，之后的所有内存都由它分配
+     * 创建一个空的 vector，不分配内存
+     */
+    explicit vector(const allocator_type& alloc) noexcept
+        : begin_(nullptr), end_(nullptr), cap_(nullptr), allocator_(alloc) {}
+
     /**
      * @brief 指定大小的构造函数
      * @param n 初始大小
+     * @param alloc 分配器
      * 创建包含 n 个默认构造元素的 vector
      */
-    explicit vector(size_type n) : begin_(nullptr), end_(nullptr), cap_(nullptr) {
+    explicit vector(size_type n, const allocator_type& alloc = allocator_type())
+        : begin_(nullptr), end_(nullptr), cap_(nullptr), allocator_(alloc) {
         if (n > 0) {
             begin_ = allocator_.allocate(n);
             end_ = mystl::uninitialized_fill_n(begin_, n, T{});
@@ -79,9 +95,11 @@ public:
      * @brief 指定大小和值的构造函数
      * @param n 初始大小
      * @param value 初始值
+     * @param alloc 分配器
      * 创建包含 n 个 value 值的 vector
      */
-    vector(size_type n, const value_type& value) : begin_(nullptr), end_(nullptr), cap_(nullptr) {
+    vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : begin_(nullptr), end_(nullptr), cap_(nullptr), allocator_(alloc) {
         if (n > 0) {
             begin_ = allocator_.allocate(n);
             end_ = mystl::uninitialized_fill_n(begin_, n, value);
@@ -92,13 +110,26 @@ public:
     /**
      * @brief 拷贝构造函数
      * @param other 要拷贝的 vector
-     * 创建 other 的副本
+     * 创建 other 的副本，使用 other 的分配器
+     */
+    vector(const vector& other) : vector(other, other.allocator_) {}
+
+    /**
+     * @brief 指定分配器的拷贝构造函数
+     * @param other 要拷贝的 vector
+     * @param alloc 副本使用的分配器
      */
-    vector(const vector& other) : begin_(nullptr), end_(nullptr), cap_(nullptr) {
+    vector(const vector& other, const allocator_type& alloc)
+        : begin_(nullptr), end_(nullptr), cap_(nullptr), allocator_(alloc) {
         if (other.size() > 0) {
-            begin_ = allocator_.allocate(other.capacity());
+            begin_ = allocator_.allocate(other.size());
             end_ = cap_ = begin_ + other.size();
-            mystl::uninitialized_copy(other.begin_, other.end_, begin_);
+            try {
+                mystl::uninitialized_copy(other.begin_, other.end_, begin_);
+            } catch (...) {
+                allocator_.deallocate(begin_, other.size());
+                throw;
+            }
         }
     }
 
@@ -111,18 +142,22 @@ public:
      * 2. 异常安全：移动操作本身不应该失败（只是指针赋值）
      * 3. 标准兼容：与std::vector保持一致
      * 4. 容器优化：作为其他容器的元素时性能更好
+     *
+     * 内存随分配器一起转移，以便之后由同一分配器释放
      */
     vector(vector&& other) noexcept 
-        : begin_(other.begin_), end_(other.end_), cap_(other.cap_) {
+        : begin_(other.begin_), end_(other.end_), cap_(other.cap_), allocator_(other.allocator_) {
         other.begin_ = other.end_ = other.cap_ = nullptr;
     }
     
     /**
      * @brief 初始化列表构造函数
      * @param ilist 初始化列表
+     * @param alloc 分配器
      * 使用初始化列表创建 vector
      */
-    vector(std::initializer_list<value_type> ilist) : begin_(nullptr), end_(nullptr), cap_(nullptr) {
+    vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : begin_(nullptr), end_(nullptr), cap_(nullptr), allocator_(alloc) {
         if (ilist.size() > 0) {
             begin_ = allocator_.allocate(ilist.size());
             end_ = cap_ = begin_ + ilist.size();
@@ -130,6 +165,20 @@ public:
         }
     }
 
+    /**
+     * @brief 区间构造函数
+     * @param first 起始迭代器
+     * @param last 结束迭代器
+     * @param alloc 分配器
+     * 前向迭代器一次分配恰好够用的内存
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+        : begin_(nullptr), end_(nullptr), cap_(nullptr), allocator_(alloc) {
+        assign(first, last);
+    }
+
     /**
      * @brief 析构函数
      * 销毁所有元素并释放内存
@@ -141,6 +190,44 @@ public:
         }
     }
 
+    /**
+     * @brief 返回分配器的副本
+     */
+    allocator_type get_allocator() const noexcept { return allocator_; }
+
+    /**
+     * @brief 返回本实例的增长计数器；计数器属于 vector 对象，不随拷贝、移动或交换转移
+     */
+    const stats_type& growth_stats() const noexcept { return *this; }
+
+    void reset_growth_stats() noexcept { stats_type::reset(); }
+
+    // ============================================================================
+    // 迭代器
+    // ============================================================================
+
+    /**
+     * @brief 返回指向第一个元素的迭代器
+     */
+    iterator begin() noexcept { return begin_; }
+    const_iterator begin() const noexcept { return begin_; }
+    const_iterator cbegin() const noexcept { return begin_; }
+
+    /**
+     * @brief 返回指向最后一个元素下一个位置的迭代器
+     */
+    iterator end() noexcept { return end_; }
+    const_iterator end() const noexcept { return end_; }
+    const_iterator cend() const noexcept { return end_; }
+
+    /**
+     * @brief 返回反向迭代器
+     */
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
     // ============================================================================
     // 基础操作
     // ============================================================================
@@ -156,7 +243,7 @@ public:
             ++end_;
         } else {
             // 容量不足，需要扩容
-            reallocate_and_insert(end_, value);
+            reallocate_and_emplace(end_, value);
         }
     }
 
@@ -171,7 +258,7 @@ public:
             ++end_;
         } else {
             // 容量不足，需要扩容
-            reallocate_and_insert(end_, mystl::move(value));
+            reallocate_and_emplace(end_, mystl::move(value));
         }
     }
 
@@ -186,6 +273,174 @@ public:
         }
     }
 
+    /**
+     * @brief 在末尾原地构造元素
+     * @param args 构造参数，可以引用 vector 自身的元素
+     * @return 新元素的引用
+     */
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (end_ < cap_) {
+            mystl::construct(end_, mystl::forward<Args>(args)...);
+            ++end_;
+        } else {
+            reallocate_and_emplace(end_, mystl::forward<Args>(args)...);
+        }
+        return *(end_ - 1);
+    }
+
+    // ============================================================================
+    // 插入与删除
+    // ============================================================================
+
+    /**
+     * @brief 在 pos 处原地构造元素
+     * @param pos 插入位置
+     * @param args 构造参数，可以引用 vector 自身的元素
+     * @return 指向新元素的迭代器
+     *
+     * 容量足够时 pos 之后的元素后移一位：可平凡拷贝的元素一次 memmove，其他元素
+     * 逐个移动赋值。
+     */
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const size_type offset = static_cast<size_type>(pos - begin_);
+        pointer p = begin_ + offset;
+        if (end_ == cap_) {
+            reallocate_and_emplace(p, mystl::forward<Args>(args)...);
+            return begin_ + offset;
+        }
+        if (p == end_) {
+            mystl::construct(end_, mystl::forward<Args>(args)...);
+            ++end_;
+            return p;
+        }
+        // 先构造临时对象：参数可能引用即将后移的元素
+        value_type tmp(mystl::forward<Args>(args)...);
+        mystl::shift_insert(p, end_, std::make_move_iterator(&tmp), std::make_move_iterator(&tmp + 1), 1);
+        return p;
+    }
+
+    /**
+     * @brief 在 pos 处插入元素
+     * @return 指向新元素的迭代器
+     */
+    iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, mystl::move(value));
+    }
+
+    /**
+     * @brief 在 pos 处插入 n 个 value
+     * @return 指向第一个新元素的迭代器；n 为 0 时返回 pos
+     */
+    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+        const size_type offset = static_cast<size_type>(pos - begin_);
+        if (n == 0) {
+            return begin_ + offset;
+        }
+        if (n <= static_cast<size_type>(cap_ - end_)) {
+            // value 可能引用将被覆盖的元素，先拷贝一份
+            const value_type copy(value);
+            mystl::shift_fill(begin_ + offset, end_, n, copy);
+        } else {
+            realloc_insert(begin_ + offset, n, [&](pointer slot) { mystl::uninitialized_fill_n(slot, n, value); });
+        }
+        return begin_ + offset;
+    }
+
+    /**
+     * @brief 在 pos 处插入区间 [first, last)
+     * @return 指向第一个新元素的迭代器；区间为空时返回 pos
+     *
+     * 前向迭代器先求出区间长度，最终大小一次算定：容量不足时只重新分配一次，
+     * 容量足够时 pos 之后的元素只平移一次。[first, last) 不能指向 vector 自身。
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        const size_type offset = static_cast<size_type>(pos - begin_);
+        range_insert(begin_ + offset, first, last,
+                     typename mystl::iterator_traits<InputIt>::iterator_category());
+        return begin_ + offset;
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 删除 pos 处的元素
+     * @return 指向被删元素之后元素的迭代器
+     */
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    /**
+     * @brief 删除 [first, last) 的元素
+     * @return 指向被删区间之后元素的迭代器
+     *
+     * 后面的元素一次性前移：可平凡拷贝时一次 memmove，否则逐个移动赋值，
+     * 最后只析构末尾多出来的元素。
+     */
+    iterator erase(const_iterator first, const_iterator last) {
+        pointer f = begin_ + (first - begin_);
+        mystl::shift_erase(f, begin_ + (last - begin_), end_);
+        return f;
+    }
+
+    /**
+     * @brief 把内容替换为 n 个 value
+     * 容量足够时复用已有元素和缓冲区
+     */
+    void assign(size_type n, const value_type& value) {
+        if (n > capacity()) {
+            vector tmp(n, value, allocator_);
+            swap(tmp);
+            record_growth(0, false);
+        } else if (n > size()) {
+            std::fill(begin_, end_, value);
+            const size_type extra = n - size();
+            end_ = mystl::uninitialized_fill_n(end_, extra, value);
+        } else {
+            std::fill_n(begin_, n, value);
+            mystl::destroy(begin_ + n, end_);
+            end_ = begin_ + n;
+        }
+    }
+
+    /**
+     * @brief 把内容替换为 [first, last)
+     * 前向迭代器先求出长度，容量不足时只分配一次；已有元素通过赋值复用
+     */
+    template<typename InputIt,
+             typename std::enable_if<!std::is_integral<InputIt>::value, int>::type = 0>
+    void assign(InputIt first, InputIt last) {
+        range_assign(first, last, typename mystl::iterator_traits<InputIt>::iterator_category());
+    }
+
+    void assign(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 与 other 交换内容，分配器随缓冲区一起交换
+     */
+    void swap(vector& other) noexcept {
+        pointer t;
+        t = begin_; begin_ = other.begin_; other.begin_ = t;
+        t = end_; end_ = other.end_; other.end_ = t;
+        t = cap_; cap_ = other.cap_; other.cap_ = t;
+
+        allocator_type a = allocator_;
+        allocator_ = other.allocator_;
+        other.allocator_ = a;
+    }
+
     // ============================================================================
     // 基础容量查询
     // ============================================================================
@@ -215,42 +470,268 @@ public:
     }
 
 private:
+    typedef mystl::allocator_traits<allocator_type> alloc_traits;
+
+    // 元素可平凡重定位且分配器提供 reallocate 时，扩容可以按字节交给分配器完成；
+    // 编译期分派，其他类型不会实例化按字节搬移的路径
+    typedef m_bool_constant<mystl::is_trivially_relocatable<value_type>::value &&
+                            mystl::has_reallocate<allocator_type>::value> bytewise_realloc_tag;
+
     /**
-     * @brief 重新分配内存并插入元素
+     * @brief 再容纳 n 个元素所需的新容量：由增长策略决定，不足时取恰好够用的大小
+     * @throws std::length_error 如果元素个数超过 max_size()
+     */
+    size_type next_capacity(size_type n) const {
+        const size_type old_size = size();
+        if (n > max_size() - old_size) {
+            throw std::length_error("vector: capacity overflow");
+        }
+        const size_type required = old_size + n;
+        const size_type new_capacity = Growth::next_capacity(allocator_, capacity(), required);
+        if (new_capacity < required) {
+            return required;
+        }
+        return new_capacity > max_size() ? max_size() : new_capacity;
+    }
+
+    // 容量变化后更新增长计数器，moved 为搬到新缓冲区的元素个数
+    void record_growth(size_type moved, bool in_place) noexcept {
+        if (in_place) {
+            stats_type::on_expand_in_place();
+        } else {
+            stats_type::on_reallocate(moved * sizeof(value_type));
+        }
+        stats_type::on_capacity_change(static_cast<size_type>(cap_ - end_) * sizeof(value_type));
+    }
+
+    /**
+     * @brief 由分配器原地扩展缓冲区到 new_capacity，地址不变
+     * @return 成功返回 true；分配器不支持或无法扩展时返回 false，缓冲区不变
+     */
+    bool expand_in_place(size_type new_capacity) {
+        if (begin_ == nullptr || new_capacity <= capacity() ||
+            !alloc_traits::try_expand(allocator_, begin_, capacity(), new_capacity)) {
+            return false;
+        }
+        cap_ = begin_ + new_capacity;
+        record_growth(0, true);
+        return true;
+    }
+
+    /**
+     * @brief 由分配器直接把缓冲区调整到 new_capacity，不逐个搬移元素
+     * @return 成功返回 true；分配器不支持或无法调整时返回 false，缓冲区不变
+     *
+     * 依次尝试：分配器的 try_expand 原地扩展（地址不变）；元素可平凡重定位且分配器
+     * 提供 reallocate（realloc、mremap 等）时按字节重新分配。
+     */
+    bool adjust_buffer(size_type new_capacity) {
+        if (begin_ == nullptr || new_capacity < size()) {
+            return false;
+        }
+        if (expand_in_place(new_capacity)) {
+            return true;
+        }
+        return reallocate_bytewise(new_capacity, bytewise_realloc_tag());
+    }
+
+    // 按字节把缓冲区交给分配器的 reallocate 调整到 new_capacity
+    bool reallocate_bytewise(size_type new_capacity, m_true_type) {
+        const size_type n = size();
+        begin_ = alloc_traits::reallocate(allocator_, begin_, capacity(), new_capacity);
+        end_ = begin_ + n;
+        cap_ = begin_ + new_capacity;
+        record_growth(n, false);
+        return true;
+    }
+
+    bool reallocate_bytewise(size_type, m_false_type) {
+        return false;
+    }
+
+    /**
+     * @brief 分配新缓冲区，在 pos 处留出 n 个位置由 construct_new 构造，其余元素搬到两侧
      * @param pos 插入位置
-     * @param value 要插入的值
+     * @param n 新元素个数
+     * @param construct_new 可调用对象，接收新缓冲区中第一个空位的指针并构造 n 个元素
+     * @return 新缓冲区中第一个新元素的位置
+     *
+     * 新元素先于旧元素的搬移构造：它们可能引用旧缓冲区中的元素。任何一步抛出异常时
+     * 已构造的对象被析构、新缓冲区被释放，vector 保持原状。
      */
-    template<typename U>
-    void reallocate_and_insert(pointer pos, U&& value) {
-        size_type old_size = size();
-        size_type new_capacity = old_size == 0 ? 1 : old_size * 2;
-        
+    template<typename Construct>
+    pointer realloc_insert(pointer pos, size_type n, Construct construct_new) {
+        const size_type new_capacity = next_capacity(n);
+        const size_type old_size = size();
         pointer new_begin = allocator_.allocate(new_capacity);
-        pointer new_end = new_begin;
-        
+        pointer slot = new_begin + (pos - begin_);
+
         try {
-            // 拷贝前半部分
-            new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-            // 构造新元素
-            mystl::construct(new_end, mystl::forward<U>(value));
-            ++new_end;
-            // 拷贝后半部分
-            new_end = mystl::uninitialized_move(pos, end_, new_end);
+            construct_new(slot);
         } catch (...) {
-            // 异常安全：清理已构造的元素
-            mystl::destroy(new_begin, new_end);
             allocator_.deallocate(new_begin, new_capacity);
             throw;
         }
-        
-        // 销毁旧元素并释放旧内存
-        mystl::destroy(begin_, end_);
-        allocator_.deallocate(begin_, cap_ - begin_);
-        
+
+        if (mystl::is_trivially_relocatable<value_type>::value) {
+            // 整块搬移，旧元素不再析构
+            mystl::uninitialized_relocate(begin_, pos, new_begin);
+            mystl::uninitialized_relocate(pos, end_, slot + n);
+        } else {
+            pointer moved = new_begin;
+            try {
+                // 移动前半部分
+                mystl::uninitialized_move(begin_, pos, new_begin);
+                moved = slot;
+                // 移动后半部分
+                mystl::uninitialized_move(pos, end_, slot + n);
+            } catch (...) {
+                // 异常安全：清理已构造的元素
+                mystl::destroy(new_begin, moved);
+                mystl::destroy(slot, slot + n);
+                allocator_.deallocate(new_begin, new_capacity);
+                throw;
+            }
+            // 销毁旧元素
+            mystl::destroy(begin_, end_);
+        }
+
+        // 释放旧内存
+        if (begin_) {
+            allocator_.deallocate(begin_, cap_ - begin_);
+        }
+
         // 更新指针
         begin_ = new_begin;
-        end_ = new_end;
+        end_ = new_begin + old_size + n;
         cap_ = new_begin + new_capacity;
+        record_growth(old_size, false);
+        return slot;
+    }
+
+    /**
+     * @brief 容量已满时在 pos 处构造一个元素
+     * @param pos 插入位置
+     * @param args 构造参数，可以引用 vector 自身的元素
+     */
+    template<typename... Args>
+    void reallocate_and_emplace(pointer pos, Args&&... args) {
+        const size_type new_capacity = next_capacity(1);
+        if (pos == end_ && expand_in_place(new_capacity)) {
+            mystl::construct(end_, mystl::forward<Args>(args)...);
+            ++end_;
+            return;
+        }
+        reallocate_and_emplace_aux(pos, new_capacity, bytewise_realloc_tag(), mystl::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void reallocate_and_emplace_aux(pointer pos, size_type new_capacity, m_true_type, Args&&... args) {
+        if (pos != end_ || begin_ == nullptr) {
+            reallocate_and_emplace_aux(pos, new_capacity, m_false_type(), mystl::forward<Args>(args)...);
+            return;
+        }
+        // 先构造到栈上：参数可能引用旧缓冲区，重新分配后再按字节搬到末尾
+        typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type buf;
+        pointer tmp = reinterpret_cast<pointer>(&buf);
+        mystl::construct(tmp, mystl::forward<Args>(args)...);
+        try {
+            // 上面的 try_expand 刚失败过，这里直接按字节重新分配
+            if (!reallocate_bytewise(new_capacity, m_true_type())) {
+                // 分配器未能调整缓冲区：走常规扩容，把 tmp 重定位到新缓冲区
+                realloc_insert(pos, 1, [&](pointer slot) { mystl::uninitialized_relocate(tmp, tmp + 1, slot); });
+                return;
+            }
+        } catch (...) {
+            mystl::destroy(tmp);
+            throw;
+        }
+        mystl::uninitialized_relocate(tmp, tmp + 1, end_);
+        ++end_;
+    }
+
+    template<typename... Args>
+    void reallocate_and_emplace_aux(pointer pos, size_type, m_false_type, Args&&... args) {
+        realloc_insert(pos, 1, [&](pointer slot) { mystl::construct(slot, mystl::forward<Args>(args)...); });
+    }
+
+    // 输入迭代器只能遍历一次：末尾直接逐个追加，否则先收集到临时 vector 再整体移入
+    template<typename InputIt>
+    void range_insert(pointer p, InputIt first, InputIt last, input_iterator_tag) {
+        if (p == end_) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            return;
+        }
+        vector tmp(allocator_);
+        for (; first != last; ++first) {
+            tmp.emplace_back(*first);
+        }
+        range_insert(p, std::make_move_iterator(tmp.begin_), std::make_move_iterator(tmp.end_),
+                     forward_iterator_tag());
+    }
+
+    // 前向迭代器先求出区间长度，最多重新分配一次
+    template<typename ForwardIt>
+    void range_insert(pointer p, ForwardIt first, ForwardIt last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(mystl::distance(first, last));
+        if (n == 0) {
+            return;
+        }
+        if (n <= static_cast<size_type>(cap_ - end_)) {
+            mystl::shift_insert(p, end_, first, last, n);
+        } else {
+            realloc_insert(p, n, [&](pointer slot) { mystl::uninitialized_copy(first, last, slot); });
+        }
+    }
+
+    // 输入迭代器：先覆盖已有元素，多余的删除，不足的追加
+    template<typename InputIt>
+    void range_assign(InputIt first, InputIt last, input_iterator_tag) {
+        pointer cur = begin_;
+        for (; first != last && cur != end_; ++first, ++cur) {
+            *cur = *first;
+        }
+        if (first == last) {
+            erase(cur, end_);
+        } else {
+            range_insert(end_, first, last, input_iterator_tag());
+        }
+    }
+
+    // 前向迭代器：容量不足时一次分配恰好 n 个元素的缓冲区
+    template<typename ForwardIt>
+    void range_assign(ForwardIt first, ForwardIt last, forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(mystl::distance(first, last));
+        if (n > capacity()) {
+            if (n > max_size()) {
+                throw std::length_error("vector::assign: too many elements");
+            }
+            pointer new_begin = allocator_.allocate(n);
+            try {
+                mystl::uninitialized_copy(first, last, new_begin);
+            } catch (...) {
+                allocator_.deallocate(new_begin, n);
+                throw;
+            }
+            if (begin_) {
+                mystl::destroy(begin_, end_);
+                allocator_.deallocate(begin_, cap_ - begin_);
+            }
+            begin_ = new_begin;
+            end_ = cap_ = new_begin + n;
+            record_growth(0, false);
+        } else if (n <= size()) {
+            pointer new_end = std::copy(first, last, begin_);
+            mystl::destroy(new_end, end_);
+            end_ = new_end;
+        } else {
+            ForwardIt mid = first;
+            mystl::advance(mid, size());
+            std::copy(first, mid, begin_);
+            end_ = mystl::uninitialized_copy(mid, last, end_);
+        }
     }
 
 public:
@@ -296,12 +777,15 @@ public:
         if(this != &other) {
             //销毁当前元素
             mystl::destroy(begin_,end_);
-            allocator_.deallocate(begin_,cap_ - begin_);
+            if(begin_) {
+                allocator_.deallocate(begin_,cap_ - begin_);
+            }
 
-            //移动other到当前对象
+            //移动other到当前对象，分配器随内存一起转移
             begin_ = other.begin_;
             end_ = other.end_;
             cap_ = other.cap_;
+            allocator_ = other.allocator_;
 
             //将other置空
             other.begin_ = other.end_ = other.cap_ = nullptr;
@@ -394,6 +878,23 @@ void reserve(size_type new_cap) {
     }
 }
 
+/**
+ * @brief 预留至少 new_cap 个元素的容量，并向上取整到分配器的大小类
+ * @param new_cap 至少需要的容量
+ *
+ * 容量取 allocator_traits::good_size(new_cap)：分配器为这次申请实际给出的整块都记为容量，
+ * 不多占内存，之后的增长可以晚一次发生。
+ */
+void reserve_at_least(size_type new_cap) {
+    if(new_cap > capacity()) {
+        if(new_cap > max_size()) {
+            throw std::length_error("vector::reserve_at_least: too many elements");
+        }
+        const size_type rounded = alloc_traits::good_size(allocator_, new_cap);
+        reallocate(rounded > max_size() ? new_cap : rounded);
+    }
+}
+
 void resize(size_type count) {
     resize(count,value_type{});
 }
@@ -409,7 +910,8 @@ void resize(size_type count, const value_type& value){
         end_ = begin_ + count;
     }else if (count > size()) {
         if(count > capacity()) {
-            reallocate(count);
+            //按增长策略扩容，反复 resize 增长时摊还 O(1)
+            reallocate(next_capacity(count - size()));
         }
         mystl::uninitialized_fill_n(end_, count - size(), value);
         end_ = begin_ + count;
@@ -431,8 +933,9 @@ void shrink_to_fit() {
     }
 }
 
+//指针差值须能用 difference_type 表示
 size_type max_size() const noexcept{
-    return mystl::numeric_limits<size_type>::max() / sizeof(value_type);
+    return static_cast<size_type>(mystl::numeric_limits<difference_type>::max()) / sizeof(value_type);
 }
 /**
  * @brief 重新分配内存到指定容量
@@ -449,27 +952,56 @@ void reallocate(size_type new_capacity) {
         }
         return ;
     }
+     //先尝试由分配器原地扩展或按字节重新分配
+     if (adjust_buffer(new_capacity)) {
+        return;
+     }
      pointer new_begin = allocator_.allocate(new_capacity);
      pointer new_end = new_begin;
 
-     try {
-        new_end = mystl::uninitialized_move(begin_,end_,new_begin);
+     if (mystl::is_trivially_relocatable<value_type>::value) {
+        //可平凡重定位：一次memcpy，旧元素不再析构
+        new_end = mystl::uninitialized_relocate(begin_,end_,new_begin);
+     } else {
+        try {
+           new_end = mystl::uninitialized_move(begin_,end_,new_begin);
+        }
+        catch(...) {
+           allocator_.deallocate(new_begin,new_capacity);
+           throw;
+        }
+//如果try抛出异常，以下代码不会执行
+        mystl::destroy(begin_,end_);
      }
-     catch(...) {
-        mystl::destroy(new_begin,new_end);
-        allocator_.deallocate(new_begin,new_capacity);
-        throw;
+     if(begin_) {
+        allocator_.deallocate(begin_,cap_ - begin_);
      }
-//如果try抛出异常，以下代码不会执行
-     mystl::destroy(begin_,end_);
-     allocator_.deallocate(begin_,cap_ - begin_);
 
      begin_ = new_begin;
      end_ = new_end;
      cap_ = new_begin + new_capacity;
+     record_growth(size(), false);
 }
 };
 
+template<typename T, typename Alloc, typename Growth>
+inline void swap(vector<T, Alloc, Growth>& a, vector<T, Alloc, Growth>& b) noexcept { a.swap(b); }
+
+// vector 只持有指向堆缓冲区的指针和分配器，分配器可平凡重定位时 vector 也可以；
+// 带增长计数器时不行：按字节搬移会把计数器一起带走，而计数器不应随对象转移
+template<typename T, typename Alloc, typename Growth>
+struct is_trivially_relocatable<vector<T, Alloc, Growth>>
+    : m_bool_constant<is_trivially_relocatable<Alloc>::value &&
+                      std::is_same<typename growth_stats_type<Growth>::type, no_growth_stats>::value> {};
+
+namespace pmr {
+template <typename T> class polymorphic_allocator;
+
+// 使用多态分配器的 vector，分配策略在运行时由 memory_resource 决定（需包含 memory_resource.h）
+template <typename T>
+using vector = mystl::vector<T, polymorphic_allocator<T>>;
+} // namespace pmr
+
 } // namespace mystl
 
 #endif // MYTINYSTL_VECTOR_H
\ No newline at end of file